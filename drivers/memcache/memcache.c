@@ -0,0 +1,202 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2016 OpenCyphal.
+
+#include "memcache.h"
+#include <assert.h>
+#include <string.h>
+
+/// Define these macros to use the cache on compilers that do not offer the GCC/Clang atomic built-ins, which are used
+/// by default if available. The first argument is a pointer to a pointer. The load shall have the acquire semantics.
+/// The compare-exchange shall replace the value with the desired one and evaluate to true if the value equals the one
+/// pointed to by the expected pointer, otherwise store the value into the latter and evaluate to false, with
+/// the acquire-release semantics. There is no single-threaded fallback because the cache is pointless without threads.
+#ifndef MEMCACHE_ATOMIC_LOAD
+#    if defined(__GNUC__)
+#        define MEMCACHE_ATOMIC_LOAD(x) __atomic_load_n((x), __ATOMIC_ACQUIRE)
+#    else
+#        error "Define MEMCACHE_ATOMIC_LOAD"
+#    endif
+#endif
+#ifndef MEMCACHE_ATOMIC_COMPARE_EXCHANGE
+#    if defined(__GNUC__)
+#        define MEMCACHE_ATOMIC_COMPARE_EXCHANGE(x, expected, desired) \
+            __atomic_compare_exchange_n((x), (expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#    else
+#        error "Define MEMCACHE_ATOMIC_COMPARE_EXCHANGE"
+#    endif
+#endif
+
+/// The header in front of every block of MemCache. The link is the owning cache while the block is in use,
+/// and the next free block while it is in a free list (whose owner is implied by the list).
+typedef struct
+{
+    void*  link;
+    size_t size_class;  ///< MEMCACHE_CLASS_COUNT if the block bypasses the cache.
+} MemCacheHeader;
+
+/// Returns the smallest size class that fits the amount with the header, or MEMCACHE_CLASS_COUNT if none.
+static size_t getClass(const size_t amount)
+{
+    size_t out = 0U;
+    if (amount <= (SIZE_MAX - MEMCACHE_HEADER_SIZE))
+    {
+        const size_t total = amount + MEMCACHE_HEADER_SIZE;
+        size_t       size  = MEMCACHE_BLOCK_SIZE_MIN;
+        while ((out < MEMCACHE_CLASS_COUNT) && (size < total))
+        {
+            size <<= 1U;
+            out++;
+        }
+    }
+    else
+    {
+        out = MEMCACHE_CLASS_COUNT;
+    }
+    return out;
+}
+
+/// Keeps the free block in the cache if the limit permits, otherwise returns it to the shared heap.
+static void keep(MemCache* const cache, CanardInstance* const ins, MemCacheHeader* const header)
+{
+    assert(header->size_class < MEMCACHE_CLASS_COUNT);
+    const size_t k = header->size_class;
+    if (cache->block_count[k] < cache->block_limit)
+    {
+        header->link     = cache->blocks[k];
+        cache->blocks[k] = header;
+        cache->block_count[k]++;
+    }
+    else
+    {
+        cache->upstream_free(ins, header);
+    }
+}
+
+/// Takes over the blocks returned by other threads. The whole list is detached at once, so there is no ABA problem:
+/// the other threads only ever push onto it.
+static void drainRemote(MemCache* const cache, CanardInstance* const ins)
+{
+    void* head     = MEMCACHE_ATOMIC_LOAD(&cache->remote);
+    bool  detached = (head == NULL);
+    while (!detached)
+    {
+        detached = MEMCACHE_ATOMIC_COMPARE_EXCHANGE(&cache->remote, &head, NULL);
+    }
+    while (head != NULL)
+    {
+        MemCacheHeader* const header = (MemCacheHeader*) head;
+        head                         = header->link;
+        keep(cache, ins, header);
+    }
+}
+
+int8_t memcacheInit(MemCache* const            cache,
+                    const CanardMemoryAllocate upstream_allocate,
+                    const CanardMemoryFree     upstream_free,
+                    const size_t               block_limit)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((cache != NULL) && (upstream_allocate != NULL) && (upstream_free != NULL))
+    {
+        assert(MEMCACHE_HEADER_SIZE >= sizeof(MemCacheHeader));
+        (void) memset(cache, 0, sizeof(MemCache));
+        cache->upstream_allocate = upstream_allocate;
+        cache->upstream_free     = upstream_free;
+        cache->block_limit       = block_limit;
+        out                      = 0;
+    }
+    return out;
+}
+
+void* memcacheAllocate(MemCache* const cache, CanardInstance* const ins, const size_t amount)
+{
+    void* out = NULL;
+    if (cache != NULL)
+    {
+        const size_t k = getClass(amount);
+        if ((k < MEMCACHE_CLASS_COUNT) && (cache->blocks[k] == NULL))
+        {
+            drainRemote(cache, ins);  // Only when needed to keep the cache line of the list cold.
+        }
+        MemCacheHeader* header = NULL;
+        if ((k < MEMCACHE_CLASS_COUNT) && (cache->blocks[k] != NULL))
+        {
+            header           = (MemCacheHeader*) cache->blocks[k];
+            cache->blocks[k] = header->link;
+            cache->block_count[k]--;
+        }
+        else if (k < MEMCACHE_CLASS_COUNT)
+        {
+            const size_t size = ((size_t) MEMCACHE_BLOCK_SIZE_MIN) << k;
+            header            = (MemCacheHeader*) cache->upstream_allocate(ins, size);
+            cache->upstream_allocation_count++;
+        }
+        else if (amount <= (SIZE_MAX - MEMCACHE_HEADER_SIZE))
+        {
+            header = (MemCacheHeader*) cache->upstream_allocate(ins, amount + MEMCACHE_HEADER_SIZE);
+            cache->upstream_allocation_count++;
+        }
+        else
+        {
+            header = NULL;  // The size cannot be represented.
+        }
+        if (header != NULL)
+        {
+            header->link       = cache;
+            header->size_class = k;
+            out                = ((uint8_t*) header) + MEMCACHE_HEADER_SIZE;
+        }
+    }
+    return out;
+}
+
+void memcacheFree(MemCache* const cache, CanardInstance* const ins, void* const pointer)
+{
+    if ((cache != NULL) && (pointer != NULL))
+    {
+        // Intentional violation of MISRA: pointer arithmetic to locate the header. The header is max-aligned.
+        MemCacheHeader* const header = (MemCacheHeader*) (void*) (((uint8_t*) pointer) - MEMCACHE_HEADER_SIZE);
+        MemCache* const       owner  = (MemCache*) header->link;
+        if (header->size_class >= MEMCACHE_CLASS_COUNT)
+        {
+            cache->upstream_free(ins, header);  // Not a cached size.
+        }
+        else if (owner == cache)
+        {
+            keep(cache, ins, header);
+        }
+        else
+        {
+            // The block is handed back to its owner, which may be using its free lists concurrently.
+            void* head   = MEMCACHE_ATOMIC_LOAD(&owner->remote);
+            bool  pushed = false;
+            while (!pushed)
+            {
+                header->link = head;
+                pushed       = MEMCACHE_ATOMIC_COMPARE_EXCHANGE(&owner->remote, &head, (void*) header);
+            }
+        }
+    }
+}
+
+int32_t memcacheTrim(MemCache* const cache, CanardInstance* const ins)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if (cache != NULL)
+    {
+        drainRemote(cache, ins);
+        out = 0;
+        for (size_t k = 0; k < MEMCACHE_CLASS_COUNT; k++)
+        {
+            while (cache->blocks[k] != NULL)
+            {
+                MemCacheHeader* const header = (MemCacheHeader*) cache->blocks[k];
+                cache->blocks[k]             = header->link;
+                cache->upstream_free(ins, header);
+                out = (out < INT32_MAX) ? (out + 1) : out;
+            }
+            cache->block_count[k] = 0U;
+        }
+    }
+    return out;
+}
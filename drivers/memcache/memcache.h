@@ -0,0 +1,109 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2016 OpenCyphal.
+///
+/// An optional per-thread memory cache that reduces the contention on the shared heap when several instances run on
+/// different threads. Each thread owns one cache, and the memory management callbacks of its instances forward
+/// the calls to memcacheAllocate() and memcacheFree() with the cache of the calling thread (e.g., found via
+/// a thread-local variable or the user reference of the instance). The shared heap is then only accessed when a cache
+/// runs out of blocks of the requested size class or has too many of them.
+///
+/// To integrate it, add memcache.c to the build of the application next to canard.c. The cache uses the GCC/Clang
+/// atomic built-ins by default; see MEMCACHE_ATOMIC_LOAD et al. in memcache.c for other compilers.
+
+#ifndef MEMCACHE_H_INCLUDED
+#define MEMCACHE_H_INCLUDED
+
+#include <canard.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The number of block size classes of MemCache. The block sizes are powers of two starting from
+/// MEMCACHE_BLOCK_SIZE_MIN, including the block header; larger allocations bypass the cache.
+/// With the default values, the requests of up to 2 KiB less the header are served from the cache,
+/// which covers the TX frames, the RX sessions, and the RX payloads of most subscriptions.
+#define MEMCACHE_CLASS_COUNT 6U
+#define MEMCACHE_BLOCK_SIZE_MIN 64U
+
+/// Every block of MemCache is prefixed with a header of this size that identifies its owner and size class.
+/// It shall be a multiple of the alignment of max_align_t and not less than two pointers.
+#ifndef MEMCACHE_HEADER_SIZE
+#    define MEMCACHE_HEADER_SIZE 16U
+#endif
+
+/// A per-thread cache of memory blocks placed in front of a shared (thread-safe) heap; see memcacheInit().
+/// The storage is supplied by the application. Do not access the fields except where stated otherwise.
+typedef struct MemCache
+{
+    /// The shared heap that the cache draws the blocks from and returns them to.
+    /// The instance passed to the cache functions is forwarded to these callbacks.
+    CanardMemoryAllocate upstream_allocate;
+    CanardMemoryFree     upstream_free;
+
+    /// The maximum number of free blocks kept per size class; the excess is returned to the shared heap.
+    /// This value can be changed by the owning thread at any moment.
+    size_t block_limit;
+
+    /// The number of blocks requested from the shared heap, which is the number of cache misses.
+    /// The owning thread may read and reset it at any time.
+    uint64_t upstream_allocation_count;
+
+    void*  blocks[MEMCACHE_CLASS_COUNT];  ///< The free lists of the size classes.
+    size_t block_count[MEMCACHE_CLASS_COUNT];
+
+    uint8_t padding_0[CANARD_CACHE_LINE_SIZE];
+
+    void* remote;  ///< The blocks of this cache freed by other threads; written by those threads.
+
+    uint8_t padding_1[CANARD_CACHE_LINE_SIZE];
+} MemCache;
+
+/// Initializes the cache of one thread.
+///
+/// A block may be freed by a thread other than the one that allocated it, which is common with RX payloads that are
+/// handed over to another thread for processing: the block is then passed back to the owning cache through
+/// a lock-free list, which is drained by the owning thread when it runs out of blocks of some size class.
+/// Consequently, a cache shall not be destroyed or re-initialized until all blocks allocated from it are freed.
+/// Only the owning thread may invoke the functions of the cache except memcacheFree(), which may be invoked
+/// concurrently by any thread with its own cache. The upstream callbacks shall be thread-safe.
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if any of the pointers
+/// are NULL.
+///
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int8_t memcacheInit(MemCache* const            cache,
+                    const CanardMemoryAllocate upstream_allocate,
+                    const CanardMemoryFree     upstream_free,
+                    const size_t               block_limit);
+
+/// Allocates a block of at least the specified size from the cache of the calling thread. The semantics are those of
+/// CanardMemoryAllocate; the instance is forwarded to the upstream allocator. Returns NULL if the cache is NULL or
+/// the shared heap is exhausted.
+///
+/// The time complexity is constant unless the list of the blocks freed by other threads is drained, which is linear
+/// of its length. The shared heap is invoked at most once.
+void* memcacheAllocate(MemCache* const cache, CanardInstance* const ins, const size_t amount);
+
+/// Frees a block allocated by memcacheAllocate() from any cache; the cache argument is that of the calling thread.
+/// The semantics are those of CanardMemoryFree. The block is kept in the cache if it is owned by it and the limit is
+/// not reached, returned to the owning cache if it is owned by another one, or freed upstream otherwise.
+/// Does nothing if any of the pointers are NULL.
+///
+/// The time complexity is constant. The shared heap is invoked at most once.
+void memcacheFree(MemCache* const cache, CanardInstance* const ins, void* const pointer);
+
+/// Returns all free blocks kept by the cache, including those returned by other threads, to the shared heap.
+/// The blocks that are still in use are not affected; they are returned to the cache when freed as usual.
+/// This can be invoked by the owning thread when it becomes idle or before it terminates.
+///
+/// The return value is the number of blocks returned to the shared heap. The return value is a negated invalid
+/// argument error if the cache is NULL.
+///
+/// The time complexity is linear of the number of the returned blocks.
+int32_t memcacheTrim(MemCache* const cache, CanardInstance* const ins);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,590 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2016 OpenCyphal.
+
+// syscall() is a GNU extension.
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE  // NOLINT(bugprone-reserved-identifier)
+#endif
+
+#include "shmcan.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/// Identifies a shared-memory object that holds a bus; the version is incremented when the layout changes.
+#define SHMCAN_MAGIC 0x4E414353U
+#define SHMCAN_VERSION 2U
+
+#if SHMCAN_ENDPOINT_MAX > 256U
+#    error "SHMCAN_ENDPOINT_MAX shall not exceed 256 because the sender of a frame is stored as an 8-bit index"
+#endif
+
+#define CAPACITY_MIN 2U
+#define CAPACITY_MAX 1048576U
+
+/// The cursor of an endpoint that does not receive; it never holds back the ring.
+#define NOT_RECEIVING UINT64_MAX
+
+/// The sequence number of a slot of the ring while a frame is being written into it.
+#define SEQUENCE_WRITING UINT64_MAX
+
+/// The time an attaching process waits for the creator of the bus to initialize it.
+#define READY_TIMEOUT_USEC 1000000U
+#define READY_POLL_NSEC 1000000L
+
+/// A frame in the ring or in a TX mailbox.
+typedef struct
+{
+    /// The sequence number of the frame in the ring, which is stored last, so that a receiver can tell whether
+    /// the frame has been overwritten while it was being read. Unused in the mailboxes.
+    uint64_t          sequence;
+    CanardMicrosecond timestamp_usec;
+    uint32_t          extended_can_id;
+    uint8_t           payload_size;
+    uint8_t           source;  ///< The index of the transmitting endpoint.
+    uint8_t           payload[CANARD_MTU_MAX];
+} ShmCANSlot;
+
+typedef struct
+{
+    /// The sequence number of the next frame to read, or NOT_RECEIVING. Written by the owner only, read by all.
+    uint64_t cursor;
+    /// The process that owns the endpoint, or zero if the endpoint is free. Guarded by the mutex.
+    pid_t      pid;
+    bool       lossless;  ///< Whether the endpoint holds back the ring. Guarded by the mutex.
+    bool       mailbox_full;
+    ShmCANSlot mailbox;
+} ShmCANEndpoint;
+
+/// The header of the shared-memory object, which is followed by the ring of frames.
+typedef struct
+{
+    uint32_t magic;  ///< Set last by the creator once the rest is initialized.
+    uint32_t version;
+    uint32_t endpoint_max;
+    uint32_t slot_size;
+    uint64_t capacity;
+
+    pthread_mutex_t mutex;  ///< Guards the mailboxes, the allocation of the endpoints, and the writing into the ring.
+
+    /// The sequence number of the next frame to be committed to the ring. Written under the mutex, read by all.
+    uint64_t head;
+
+    /// Incremented after every commitment so that the receivers blocked in shmcanWait() can be woken up
+    /// via a futex; the waking system call is skipped if there are no waiters.
+    uint32_t futex_word;
+    uint32_t waiters;
+
+    ShmCANEndpoint endpoints[SHMCAN_ENDPOINT_MAX];
+} ShmCANBus;
+
+static CanardMicrosecond getMonotonicMicroseconds(void)
+{
+    struct timespec ts = {0};
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((CanardMicrosecond) ts.tv_sec) * 1000000ULL) + (((CanardMicrosecond) ts.tv_nsec) / 1000ULL);
+}
+
+static size_t getBusSize(const size_t capacity)
+{
+    return sizeof(ShmCANBus) + (capacity * sizeof(ShmCANSlot));
+}
+
+static ShmCANSlot* getSlot(ShmCANBus* const bus, const uint64_t sequence)
+{
+    ShmCANSlot* const ring = (ShmCANSlot*) (void*) (((uint8_t*) bus) + sizeof(ShmCANBus));
+    return &ring[sequence & (bus->capacity - 1U)];
+}
+
+static void lock(ShmCANBus* const bus)
+{
+    // If the previous owner has died while holding the mutex, the state is still usable because the head of
+    // the ring is advanced only after the frame is written completely.
+    if (pthread_mutex_lock(&bus->mutex) == EOWNERDEAD)
+    {
+        (void) pthread_mutex_consistent(&bus->mutex);
+    }
+}
+
+static void unlock(ShmCANBus* const bus)
+{
+    (void) pthread_mutex_unlock(&bus->mutex);
+}
+
+/// A process that cannot be signaled due to the lack of permissions is alive.
+static bool isAlive(const pid_t pid)
+{
+    return (kill(pid, 0) == 0) || (errno != ESRCH);
+}
+
+/// Frees the endpoints of the terminated processes. If the cursor is not NOT_RECEIVING, only the endpoints at that
+/// cursor are considered, which are the ones holding back the ring. Must be invoked under the mutex.
+static void reclaim(ShmCANBus* const bus, const uint64_t cursor)
+{
+    for (size_t i = 0U; i < SHMCAN_ENDPOINT_MAX; i++)
+    {
+        ShmCANEndpoint* const ep = &bus->endpoints[i];
+        if ((ep->pid != 0) && ((cursor == NOT_RECEIVING) || (ep->cursor == cursor)) && !isAlive(ep->pid))
+        {
+            ep->mailbox_full = false;
+            ep->pid          = 0;
+        }
+    }
+}
+
+/// Returns the lowest cursor of the lossless endpoints, or the head if there are none; the frames before it may be
+/// overwritten. Must be invoked under the mutex.
+static uint64_t getTail(ShmCANBus* const bus)
+{
+    uint64_t out = bus->head;
+    for (size_t i = 0U; i < SHMCAN_ENDPOINT_MAX; i++)
+    {
+        const uint64_t cursor = __atomic_load_n(&bus->endpoints[i].cursor, __ATOMIC_ACQUIRE);
+        if ((bus->endpoints[i].pid != 0) && bus->endpoints[i].lossless && (cursor != NOT_RECEIVING) && (cursor < out))
+        {
+            out = cursor;
+        }
+    }
+    return out;
+}
+
+/// Commits the frame with the lowest CAN ID among the full mailboxes to the ring if it has space.
+/// Returns true if a frame has been committed. Must be invoked under the mutex.
+static bool arbitrate(ShmCANBus* const bus)
+{
+    ShmCANEndpoint* winner = NULL;
+    size_t          source = 0U;
+    for (size_t i = 0U; i < SHMCAN_ENDPOINT_MAX; i++)
+    {
+        ShmCANEndpoint* const ep = &bus->endpoints[i];
+        if ((ep->pid != 0) && ep->mailbox_full &&
+            ((winner == NULL) || (ep->mailbox.extended_can_id < winner->mailbox.extended_can_id)))
+        {
+            winner = ep;
+            source = i;
+        }
+    }
+    bool out = false;
+    if (winner != NULL)
+    {
+        uint64_t tail = getTail(bus);
+        if ((bus->head - tail) >= bus->capacity)
+        {
+            reclaim(bus, tail);
+            tail = getTail(bus);
+        }
+        out = (bus->head - tail) < bus->capacity;
+    }
+    if (out)
+    {
+        // The slot may be read concurrently by the receivers that have fallen behind; they discard what they have
+        // read unless the sequence number is the same before and after the reading.
+        ShmCANSlot* const slot = getSlot(bus, bus->head);
+        __atomic_store_n(&slot->sequence, SEQUENCE_WRITING, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        slot->timestamp_usec  = getMonotonicMicroseconds();
+        slot->extended_can_id = winner->mailbox.extended_can_id;
+        slot->payload_size    = winner->mailbox.payload_size;
+        slot->source          = (uint8_t) source;
+        (void) memcpy(&slot->payload[0], &winner->mailbox.payload[0], winner->mailbox.payload_size);
+        __atomic_store_n(&slot->sequence, bus->head, __ATOMIC_RELEASE);
+        winner->mailbox_full = false;
+        __atomic_store_n(&bus->head, bus->head + 1U, __ATOMIC_RELEASE);
+    }
+    return out;
+}
+
+static void wake(ShmCANBus* const bus)
+{
+    (void) __atomic_add_fetch(&bus->futex_word, 1U, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&bus->waiters, __ATOMIC_SEQ_CST) > 0U)
+    {
+        (void) syscall(SYS_futex, &bus->futex_word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+/// Returns true if the slot still holds the frame with the specified sequence number after it has been read,
+/// meaning that what has been read is not torn by a transmitter overwriting the slot in the meantime.
+static bool isIntact(const ShmCANSlot* const slot, const uint64_t sequence)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == sequence;
+}
+
+/// Advances the cursor past the frames transmitted by this endpoint and those overwritten before they could be read,
+/// counting the latter as overruns, and returns true if there is a frame to read.
+static bool skip(ShmCAN* const self)
+{
+    ShmCANBus* const      bus    = (ShmCANBus*) self->bus;
+    ShmCANEndpoint* const ep     = &bus->endpoints[self->endpoint];
+    const uint64_t        head   = __atomic_load_n(&bus->head, __ATOMIC_ACQUIRE);
+    uint64_t              cursor = ep->cursor;
+    bool                  out    = false;
+    if (cursor != NOT_RECEIVING)
+    {
+        while ((cursor != head) && !out)
+        {
+            if ((head - cursor) > bus->capacity)
+            {
+                self->overrun_count += (head - bus->capacity) - cursor;
+                cursor = head - bus->capacity;
+            }
+            const ShmCANSlot* const slot   = getSlot(bus, cursor);
+            const bool              valid  = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) == cursor;
+            const uint8_t           source = __atomic_load_n(&slot->source, __ATOMIC_RELAXED);
+            if (!valid || !isIntact(slot, cursor))
+            {
+                self->overrun_count++;  // Overwritten after the head has been loaded.
+                cursor++;
+            }
+            else if (source == self->endpoint)
+            {
+                cursor++;
+            }
+            else
+            {
+                out = true;
+            }
+        }
+        __atomic_store_n(&ep->cursor, cursor, __ATOMIC_RELEASE);
+    }
+    return out;
+}
+
+/// Initializes the newly created shared-memory object.
+static int16_t initialize(ShmCANBus* const bus, const size_t capacity)
+{
+    bus->version      = SHMCAN_VERSION;
+    bus->endpoint_max = SHMCAN_ENDPOINT_MAX;
+    bus->slot_size    = (uint32_t) sizeof(ShmCANSlot);
+    bus->capacity     = capacity;
+    pthread_mutexattr_t attr;
+    int                 result = pthread_mutexattr_init(&attr);
+    if (result == 0)
+    {
+        result = pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        if (result == 0)
+        {
+            result = pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        }
+        if (result == 0)
+        {
+            result = pthread_mutex_init(&bus->mutex, &attr);
+        }
+        (void) pthread_mutexattr_destroy(&attr);
+    }
+    if (result == 0)
+    {
+        __atomic_store_n(&bus->magic, SHMCAN_MAGIC, __ATOMIC_RELEASE);
+    }
+    return (int16_t) -result;
+}
+
+/// Waits for the creator to initialize the bus, validates its layout, and returns its capacity, or zero if it is
+/// not a compatible bus.
+static size_t getCapacity(const int fd)
+{
+    size_t                  out      = 0U;
+    bool                    more     = true;
+    const CanardMicrosecond deadline = getMonotonicMicroseconds() + READY_TIMEOUT_USEC;
+    while (more)
+    {
+        struct stat st = {0};
+        if ((fstat(fd, &st) == 0) && (((size_t) st.st_size) >= sizeof(ShmCANBus)))
+        {
+            ShmCANBus* const bus = (ShmCANBus*) mmap(NULL, sizeof(ShmCANBus), PROT_READ, MAP_SHARED, fd, 0);
+            if (bus != MAP_FAILED)
+            {
+                if (__atomic_load_n(&bus->magic, __ATOMIC_ACQUIRE) == SHMCAN_MAGIC)
+                {
+                    const bool valid = (bus->version == SHMCAN_VERSION) &&
+                                       (bus->endpoint_max == SHMCAN_ENDPOINT_MAX) &&
+                                       (bus->slot_size == sizeof(ShmCANSlot)) &&
+                                       (((size_t) st.st_size) == getBusSize((size_t) bus->capacity));
+                    out  = valid ? (size_t) bus->capacity : 0U;
+                    more = false;
+                }
+                (void) munmap(bus, sizeof(ShmCANBus));
+            }
+        }
+        if (more)
+        {
+            more = getMonotonicMicroseconds() < deadline;
+            const struct timespec delay = {0, READY_POLL_NSEC};
+            (void) nanosleep(&delay, NULL);
+        }
+    }
+    return out;
+}
+
+/// Allocates an endpoint for this process; returns SHMCAN_ENDPOINT_MAX if there are none.
+static size_t attach(ShmCANBus* const bus, const ShmCANReception reception)
+{
+    lock(bus);
+    size_t out = SHMCAN_ENDPOINT_MAX;
+    for (size_t attempt = 0U; (attempt < 2U) && (out == SHMCAN_ENDPOINT_MAX); attempt++)
+    {
+        if (attempt > 0U)
+        {
+            reclaim(bus, NOT_RECEIVING);
+        }
+        for (size_t i = 0U; (i < SHMCAN_ENDPOINT_MAX) && (out == SHMCAN_ENDPOINT_MAX); i++)
+        {
+            if (bus->endpoints[i].pid == 0)
+            {
+                out = i;
+            }
+        }
+    }
+    if (out < SHMCAN_ENDPOINT_MAX)
+    {
+        ShmCANEndpoint* const ep = &bus->endpoints[out];
+        ep->pid                  = getpid();
+        ep->lossless             = reception == ShmCANReceptionLossless;
+        ep->mailbox_full         = false;
+        __atomic_store_n(&ep->cursor, (reception != ShmCANReceptionNone) ? bus->head : NOT_RECEIVING, __ATOMIC_RELEASE);
+    }
+    unlock(bus);
+    return out;
+}
+
+int16_t shmcanOpen(ShmCAN* const         self,
+                   const char* const     name,
+                   const size_t          capacity,
+                   const ShmCANReception reception)
+{
+    int16_t    out   = -EINVAL;
+    const bool valid = (reception == ShmCANReceptionNone) || (reception == ShmCANReceptionOverrun) ||
+                       (reception == ShmCANReceptionLossless);
+    if ((self != NULL) && (name != NULL) && (capacity >= CAPACITY_MIN) && (capacity <= CAPACITY_MAX) &&
+        ((capacity & (capacity - 1U)) == 0U) && valid)
+    {
+        (void) memset(self, 0, sizeof(ShmCAN));
+        self->fd        = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        const bool  own = self->fd >= 0;
+        size_t      cap = capacity;
+        if (own)
+        {
+            out = (ftruncate(self->fd, (off_t) getBusSize(cap)) == 0) ? 0 : (int16_t) -errno;
+        }
+        else if (errno == EEXIST)
+        {
+            self->fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+            out      = (self->fd >= 0) ? 0 : (int16_t) -errno;
+            if (out == 0)
+            {
+                cap = getCapacity(self->fd);
+                out = (cap > 0U) ? 0 : -EPROTO;
+            }
+        }
+        else
+        {
+            out = (int16_t) -errno;
+        }
+        if (out == 0)
+        {
+            self->bus_size = getBusSize(cap);
+            self->bus      = mmap(NULL, self->bus_size, PROT_READ | PROT_WRITE, MAP_SHARED, self->fd, 0);
+            self->bus      = (self->bus != MAP_FAILED) ? self->bus : NULL;
+            out            = (self->bus != NULL) ? 0 : (int16_t) -errno;
+        }
+        if ((out == 0) && own)
+        {
+            out = initialize((ShmCANBus*) self->bus, cap);
+        }
+        if (out == 0)
+        {
+            self->endpoint  = attach((ShmCANBus*) self->bus, reception);
+            self->reception = reception;
+            out             = (self->endpoint < SHMCAN_ENDPOINT_MAX) ? 0 : -ENOSPC;
+        }
+        if (out != 0)
+        {
+            if (self->bus != NULL)
+            {
+                (void) munmap(self->bus, self->bus_size);
+            }
+            if (self->fd >= 0)
+            {
+                (void) close(self->fd);
+            }
+            if (own)
+            {
+                (void) shm_unlink(name);
+            }
+            (void) memset(self, 0, sizeof(ShmCAN));
+            self->fd = -1;
+        }
+    }
+    return out;
+}
+
+void shmcanClose(ShmCAN* const self)
+{
+    if ((self != NULL) && (self->bus != NULL))
+    {
+        ShmCANBus* const bus = (ShmCANBus*) self->bus;
+        lock(bus);
+        bus->endpoints[self->endpoint].mailbox_full = false;
+        bus->endpoints[self->endpoint].pid          = 0;
+        unlock(bus);
+        (void) munmap(self->bus, self->bus_size);
+        (void) close(self->fd);
+        self->bus = NULL;
+        self->fd  = -1;
+    }
+}
+
+int16_t shmcanUnlink(const char* const name)
+{
+    int16_t out = -EINVAL;
+    if (name != NULL)
+    {
+        out = (shm_unlink(name) == 0) ? 0 : (int16_t) -errno;
+    }
+    return out;
+}
+
+int32_t shmcanTransmit(ShmCAN* const           self,
+                       CanardTxQueue* const    que,
+                       CanardInstance* const   ins,
+                       const CanardMicrosecond now_usec)
+{
+    int32_t out = -EINVAL;
+    if ((self != NULL) && (self->bus != NULL) && (que != NULL) && (ins != NULL))
+    {
+        ShmCANBus* const      bus       = (ShmCANBus*) self->bus;
+        ShmCANEndpoint* const ep        = &bus->endpoints[self->endpoint];
+        size_t                count     = 0U;
+        bool                  committed = false;
+        bool                  more      = true;
+        lock(bus);
+        while (more)
+        {
+            bool loaded = false;
+            if (!ep->mailbox_full && (count < SHMCAN_BATCH_SIZE) && (canardTxPeek(que) != NULL))
+            {
+                CanardTxQueueItem* const item = canardTxPop(que, canardTxPeek(que));
+                if ((item->tx_deadline_usec == 0U) || (item->tx_deadline_usec > now_usec))
+                {
+                    ep->mailbox.extended_can_id = item->frame.extended_can_id;
+                    ep->mailbox.payload_size    = (uint8_t) item->frame.payload_size;
+                    if (item->frame.payload_size > 0U)
+                    {
+                        (void) memcpy(&ep->mailbox.payload[0], item->frame.payload, item->frame.payload_size);
+                    }
+                    ep->mailbox_full = true;
+                }
+                else
+                {
+                    self->drop_count++;
+                }
+                ins->memory_free(ins, item);
+                loaded = true;
+                count++;
+            }
+            const bool arbitrated = arbitrate(bus);
+            committed             = committed || arbitrated;
+            more                  = loaded || arbitrated;
+        }
+        unlock(bus);
+        if (committed)
+        {
+            wake(bus);
+        }
+        out = (int32_t) count;
+    }
+    return out;
+}
+
+int8_t shmcanPeek(ShmCAN* const self, CanardMicrosecond* const out_timestamp_usec, CanardFrame* const out_frame)
+{
+    int8_t out = -EINVAL;
+    if ((self != NULL) && (self->bus != NULL) && (out_timestamp_usec != NULL) && (out_frame != NULL))
+    {
+        ShmCANBus* const      bus  = (ShmCANBus*) self->bus;
+        ShmCANEndpoint* const ep   = &bus->endpoints[self->endpoint];
+        bool                  more = skip(self);
+        out                        = 0;
+        while (more)
+        {
+            // The lossless endpoints hold back the ring, so their frames cannot be overwritten while being read.
+            const uint64_t          cursor    = ep->cursor;
+            const ShmCANSlot* const slot      = getSlot(bus, cursor);
+            const bool              copy      = self->reception != ShmCANReceptionLossless;
+            const CanardMicrosecond timestamp = slot->timestamp_usec;
+            const uint32_t          can_id    = slot->extended_can_id;
+            const uint8_t           stored    = slot->payload_size;
+            const size_t            size      = (stored < CANARD_MTU_MAX) ? stored : CANARD_MTU_MAX;  // If torn.
+            if (copy)
+            {
+                (void) memcpy(&self->rx_payload[0], &slot->payload[0], size);
+            }
+            if (isIntact(slot, cursor))
+            {
+                *out_timestamp_usec        = timestamp;
+                out_frame->extended_can_id = can_id;
+                out_frame->payload_size    = size;
+                out_frame->payload         = copy ? &self->rx_payload[0] : &slot->payload[0];
+                out                        = 1;
+                more                       = false;
+            }
+            else
+            {
+                self->overrun_count++;
+                __atomic_store_n(&ep->cursor, cursor + 1U, __ATOMIC_RELEASE);
+                more = skip(self);
+            }
+        }
+    }
+    return out;
+}
+
+void shmcanPop(ShmCAN* const self)
+{
+    if ((self != NULL) && (self->bus != NULL) && skip(self))
+    {
+        ShmCANEndpoint* const ep = &((ShmCANBus*) self->bus)->endpoints[self->endpoint];
+        __atomic_store_n(&ep->cursor, ep->cursor + 1U, __ATOMIC_RELEASE);
+    }
+}
+
+int8_t shmcanWait(ShmCAN* const self, const CanardMicrosecond timeout_usec)
+{
+    int8_t out = -EINVAL;
+    if ((self != NULL) && (self->bus != NULL))
+    {
+        ShmCANBus* const bus = (ShmCANBus*) self->bus;
+        // The waiter is registered before the check so that a frame committed after the check cannot go unnoticed:
+        // either the transmitter sees the waiter and wakes it up, or the futex word has changed and the wait returns.
+        (void) __atomic_add_fetch(&bus->waiters, 1U, __ATOMIC_SEQ_CST);
+        const uint32_t observed = __atomic_load_n(&bus->futex_word, __ATOMIC_SEQ_CST);
+        out                     = skip(self) ? 1 : 0;
+        if ((out == 0) && (timeout_usec > 0U))
+        {
+            struct timespec ts = {0};
+            ts.tv_sec          = (time_t) (timeout_usec / 1000000U);
+            ts.tv_nsec         = (long) ((timeout_usec % 1000000U) * 1000U);
+            const long result  = syscall(SYS_futex, &bus->futex_word, FUTEX_WAIT, observed, &ts, NULL, 0);
+            if ((result == 0) || (errno == EAGAIN) || (errno == ETIMEDOUT) || (errno == EINTR))
+            {
+                out = skip(self) ? 1 : 0;
+            }
+            else
+            {
+                out = (int8_t) -errno;
+            }
+        }
+        (void) __atomic_sub_fetch(&bus->waiters, 1U, __ATOMIC_SEQ_CST);
+    }
+    return out;
+}
@@ -0,0 +1,139 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2016 OpenCyphal.
+///
+/// An optional virtual CAN bus in POSIX shared memory for running many nodes as separate processes on one Linux host
+/// (e.g., in simulation and HIL rigs) without routing every frame through vcan and the kernel network stack.
+///
+/// The bus is a broadcast ring of frames in a memory-mapped shared-memory object, which every process attaches to
+/// as an endpoint. Each endpoint has a TX mailbox that models the transmit buffer of a CAN controller and a read
+/// cursor of its own. The frames pending in the mailboxes of different endpoints are committed to the ring in the
+/// order of their CAN ID, lowest first, which mimics the bitwise arbitration of a real bus when it is busy.
+/// A committed frame is stamped with the time it appeared on the bus and is delivered to every receiving endpoint
+/// except its sender. By default, the ring overwrites the oldest frames when it is full, so a receiver that falls
+/// behind by more than its capacity loses frames, like a CAN controller whose RX FIFO overflows, and counts them;
+/// a stopped receiver never holds back the transmitters. A receiver may opt in to lossless reception instead,
+/// in which case the ring never overwrites a frame that it has not read yet and the transmission is postponed while
+/// the ring is full, just as a congested bus delays the frames of lower priority.
+///
+/// The transmitters copy the frames from the TX queue directly into the shared memory. The lossless receivers pass
+/// the frames to canardRxAccept() directly from it, so a frame is copied once on its way between two instances;
+/// the other receivers copy the payload out first because the frame may be overwritten while it is being read.
+///
+/// To integrate it, add shmcan.c to the build of the application next to canard.c and link it with -pthread.
+/// An instance of the adapter is to be used from one thread at a time; any number of processes and threads
+/// may use the same bus via separate instances.
+
+#ifndef SHMCAN_H_INCLUDED
+#define SHMCAN_H_INCLUDED
+
+#include <canard.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The maximum number of endpoints attached to one bus at the same time.
+#ifndef SHMCAN_ENDPOINT_MAX
+#    define SHMCAN_ENDPOINT_MAX 64U
+#endif
+
+/// The maximum number of frames picked from the TX queue per invocation of shmcanTransmit(). It bounds the time
+/// the bus is held locked by one transmitter.
+#ifndef SHMCAN_BATCH_SIZE
+#    define SHMCAN_BATCH_SIZE 32U
+#endif
+
+/// Whether and how an endpoint receives the frames; see shmcanOpen().
+typedef enum ShmCANReception
+{
+    ShmCANReceptionNone     = 0,  ///< The endpoint only transmits.
+    ShmCANReceptionOverrun  = 1,  ///< The frames are lost if the endpoint falls behind by more than the capacity.
+    ShmCANReceptionLossless = 2,  ///< The transmitters wait for the endpoint to read the frames.
+} ShmCANReception;
+
+/// The state of one endpoint. The fields are populated by shmcanOpen().
+typedef struct ShmCAN
+{
+    int             fd;         ///< The shared-memory object. Read-only.
+    void*           bus;        ///< The mapping of the shared-memory object. Do not access.
+    size_t          bus_size;   ///< The size of the mapping. Do not access.
+    size_t          endpoint;   ///< The index of the endpoint on the bus. Read-only.
+    ShmCANReception reception;  ///< Whether and how the endpoint receives frames. Read-only.
+
+    /// The number of frames that were not transmitted because their transmission deadline had expired.
+    /// The application may read and reset it at any time.
+    uint64_t drop_count;
+
+    /// The number of frames that this endpoint has lost because they were overwritten before it read them;
+    /// it is always zero for lossless reception. The application may read and reset it at any time.
+    uint64_t overrun_count;
+
+    /// The copy of the payload of the frame retrieved by shmcanPeek() unless the reception is lossless.
+    /// Do not access.
+    uint8_t rx_payload[CANARD_MTU_MAX];
+} ShmCAN;
+
+/// Attaches to the bus with the specified name (e.g., "/cyphal-bus-0"; see shm_open()), creating it if it does not
+/// exist yet, in which case the capacity of the ring is set to the specified number of frames, which shall be
+/// a power of two between 2 and 2**20; it is ignored otherwise. The endpoint sees the frames committed after it has
+/// attached. If the endpoint is not receiving, shmcanPeek() yields nothing.
+///
+/// The lossless reception holds back the ring while the endpoint has frames to read, so it shall only be chosen if
+/// the endpoint is polled continuously and it is acceptable that the whole bus stalls while it is not; otherwise,
+/// the overrun reception shall be used, which never holds back the ring.
+///
+/// The return value is zero on success. The return value is a negated errno on failure; it is -EINVAL if any of the
+/// pointers are NULL or the capacity or the reception is invalid, -ENOSPC if SHMCAN_ENDPOINT_MAX endpoints are
+/// attached already, and -EPROTO if the existing object is not a bus of a compatible layout.
+int16_t shmcanOpen(ShmCAN* const         self,
+                   const char* const     name,
+                   const size_t          capacity,
+                   const ShmCANReception reception);
+
+/// Detaches from the bus. The frame left in the TX mailbox of the endpoint is discarded. The bus continues to exist
+/// until it is removed by shmcanUnlink(). The endpoints of the processes that have terminated without detaching are
+/// reclaimed automatically when they hold back the ring or when the endpoints run out. The adapter may be reopened
+/// afterwards.
+void shmcanClose(ShmCAN* const self);
+
+/// Removes the name of the bus; the processes attached to it are not affected. Returns zero or a negated errno.
+int16_t shmcanUnlink(const char* const name);
+
+/// Transmits up to SHMCAN_BATCH_SIZE frames from the TX queue. The frames are picked via canardTxPeek() and
+/// canardTxPop(), copied into the TX mailbox of the endpoint one by one, and freed using the memory manager of
+/// the instance; the frames whose transmission deadline is not later than now_usec are dropped instead, where
+/// a zero deadline never expires. The mailboxes of all endpoints are arbitrated after each frame, so the frames
+/// of other endpoints that have been waiting for space in the ring may be committed in the process.
+///
+/// The return value is the number of frames taken from the TX queue, which is less than the number of the frames
+/// available if the ring is full, in which case the last one is left in the mailbox and the invocation should be
+/// repeated later. The return value is -EINVAL if any of the pointers are NULL or the adapter is not open.
+int32_t shmcanTransmit(ShmCAN* const           self,
+                       CanardTxQueue* const    que,
+                       CanardInstance* const   ins,
+                       const CanardMicrosecond now_usec);
+
+/// Retrieves the oldest frame that this endpoint has not read yet, without removing it; the frames transmitted by
+/// this endpoint are skipped, and so are those that have been overwritten, which are counted as overruns.
+/// The payload of the frame remains valid until shmcanPop() is invoked, so the frame can be passed to
+/// canardRxAccept() without copying; it points into the shared memory if the reception is lossless and into
+/// the adapter otherwise. The timestamp is the time of the commitment of the frame to the bus in microseconds
+/// of CLOCK_MONOTONIC.
+///
+/// The return value is 1 if a frame has been retrieved and 0 if there are none. The return value is -EINVAL if any
+/// of the pointers are NULL or the adapter is not open.
+int8_t shmcanPeek(ShmCAN* const self, CanardMicrosecond* const out_timestamp_usec, CanardFrame* const out_frame);
+
+/// Removes the frame retrieved by shmcanPeek(), allowing the transmitters to reuse its place in the ring.
+/// Has no effect if there is no such frame.
+void shmcanPop(ShmCAN* const self);
+
+/// Blocks until there is a frame for shmcanPeek() or the timeout expires, without consuming any processor time.
+/// The return value is 1 if a frame is available, 0 if the timeout has expired, or a negated errno on failure;
+/// it is -EINVAL if the pointer is NULL or the adapter is not open.
+int8_t shmcanWait(ShmCAN* const self, const CanardMicrosecond timeout_usec);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
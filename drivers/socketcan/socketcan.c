@@ -0,0 +1,289 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2016 OpenCyphal.
+
+// recvmmsg() and sendmmsg() are GNU extensions.
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE  // NOLINT(bugprone-reserved-identifier)
+#endif
+
+#include "socketcan.h"
+#include <errno.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/// The bit rate is switched in the data phase of the transmitted CAN FD frames.
+#ifdef CANFD_FDF
+#    define SOCKETCAN_FD_FLAGS (CANFD_BRS | CANFD_FDF)
+#else
+#    define SOCKETCAN_FD_FLAGS CANFD_BRS
+#endif
+
+/// The control message buffer of one received frame; the union ensures the alignment of struct cmsghdr,
+/// whose first member is a size_t.
+typedef union
+{
+    size_t  alignment;
+    uint8_t buffer[CMSG_SPACE(sizeof(struct timeval))];
+} SocketCANControl;
+
+static CanardMicrosecond getRealTimeMicroseconds(void)
+{
+    struct timespec ts = {0};
+    (void) clock_gettime(CLOCK_REALTIME, &ts);
+    return (((CanardMicrosecond) ts.tv_sec) * 1000000ULL) + (((CanardMicrosecond) ts.tv_nsec) / 1000ULL);
+}
+
+/// Returns true if the error indicates that the operation is to be retried later, as opposed to a genuine failure.
+static bool isTransient(const int error)
+{
+    return (error == EAGAIN) || (error == EWOULDBLOCK) || (error == ENOBUFS) || (error == EINTR);
+}
+
+/// Frees the specified number of the oldest pending TX frames and moves the remaining ones to the front.
+static void dropPending(SocketCAN* const self, CanardInstance* const ins, const size_t count)
+{
+    for (size_t i = 0U; i < count; i++)
+    {
+        ins->memory_free(ins, self->pending[i]);
+    }
+    for (size_t i = count; i < self->pending_count; i++)
+    {
+        self->pending[i - count] = self->pending[i];
+    }
+    self->pending_count -= count;
+}
+
+/// Returns the kernel timestamp from the control messages of the received frame, or zero if there is none.
+static CanardMicrosecond getTimestamp(struct msghdr* const msg)
+{
+    CanardMicrosecond out = 0U;
+    for (struct cmsghdr* cm = CMSG_FIRSTHDR(msg); cm != NULL; cm = CMSG_NXTHDR(msg, cm))
+    {
+        if ((cm->cmsg_level == SOL_SOCKET) && (cm->cmsg_type == SCM_TIMESTAMP))
+        {
+            struct timeval tv = {0};
+            (void) memcpy(&tv, CMSG_DATA(cm), sizeof(tv));  // The payload may be misaligned.
+            out = (((CanardMicrosecond) tv.tv_sec) * 1000000ULL) + ((CanardMicrosecond) tv.tv_usec);
+        }
+    }
+    return out;
+}
+
+int16_t socketcanOpen(SocketCAN* const self, const char* const iface_name, const bool can_fd)
+{
+    int16_t out = -EINVAL;
+    if ((self != NULL) && (iface_name != NULL) && (strlen(iface_name) < IFNAMSIZ))
+    {
+        const int fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+        out          = (fd >= 0) ? 0 : (int16_t) -errno;
+        if (out == 0)
+        {
+            struct ifreq ifr = {0};
+            (void) memcpy(ifr.ifr_name, iface_name, strlen(iface_name) + 1U);
+            out = (ioctl(fd, SIOCGIFINDEX, &ifr) == 0) ? 0 : (int16_t) -errno;
+            if (out == 0)
+            {
+                struct sockaddr_can addr = {0};
+                addr.can_family          = AF_CAN;
+                addr.can_ifindex         = ifr.ifr_ifindex;
+                out = (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) == 0) ? 0 : (int16_t) -errno;
+            }
+            const int on = 1;
+            if ((out == 0) && can_fd)
+            {
+                out = (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &on, sizeof(on)) == 0) ? 0 : (int16_t) -errno;
+            }
+            if (out == 0)
+            {
+                out = (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMP, &on, sizeof(on)) == 0) ? 0 : (int16_t) -errno;
+            }
+            if (out == 0)
+            {
+                out = socketcanAttach(self, fd, can_fd);
+            }
+            else
+            {
+                (void) close(fd);
+            }
+        }
+    }
+    return out;
+}
+
+int16_t socketcanAttach(SocketCAN* const self, const int fd, const bool can_fd)
+{
+    int16_t out = -EINVAL;
+    if ((self != NULL) && (fd >= 0))
+    {
+        (void) memset(self, 0, sizeof(SocketCAN));
+        self->fd     = fd;
+        self->can_fd = can_fd;
+        out          = 0;
+    }
+    return out;
+}
+
+void socketcanClose(SocketCAN* const self, CanardInstance* const ins)
+{
+    if (self != NULL)
+    {
+        if ((ins != NULL) && (self->pending_count > 0U))
+        {
+            dropPending(self, ins, self->pending_count);
+        }
+        if (self->fd >= 0)
+        {
+            (void) close(self->fd);
+        }
+        self->fd = -1;
+    }
+}
+
+int32_t socketcanTransmit(SocketCAN* const        self,
+                          CanardTxQueue* const    que,
+                          CanardInstance* const   ins,
+                          const CanardMicrosecond now_usec)
+{
+    int32_t out = -EINVAL;
+    if ((self != NULL) && (que != NULL) && (ins != NULL))
+    {
+        // The leftovers of the previous invocation may have expired while the interface was busy.
+        size_t kept = 0U;
+        for (size_t i = 0U; i < self->pending_count; i++)
+        {
+            CanardTxQueueItem* const item = self->pending[i];
+            if ((item->tx_deadline_usec == 0U) || (item->tx_deadline_usec > now_usec))
+            {
+                self->pending[kept++] = item;
+            }
+            else
+            {
+                ins->memory_free(ins, item);
+                self->drop_count++;
+            }
+        }
+        self->pending_count = kept;
+        const CanardTxQueueItem* ti = canardTxPeek(que);
+        while ((self->pending_count < SOCKETCAN_BATCH_SIZE) && (ti != NULL))
+        {
+            CanardTxQueueItem* const item = canardTxPop(que, ti);
+            if ((item->tx_deadline_usec == 0U) || (item->tx_deadline_usec > now_usec))
+            {
+                self->pending[self->pending_count++] = item;
+            }
+            else
+            {
+                ins->memory_free(ins, item);
+                self->drop_count++;
+            }
+            ti = canardTxPeek(que);
+        }
+
+        // struct can_frame is a prefix of struct canfd_frame, so the latter serves both formats.
+        struct canfd_frame frames[SOCKETCAN_BATCH_SIZE];
+        struct iovec       iov[SOCKETCAN_BATCH_SIZE];
+        struct mmsghdr     msgs[SOCKETCAN_BATCH_SIZE];
+        (void) memset(msgs, 0, sizeof(msgs));
+        for (size_t i = 0U; i < self->pending_count; i++)
+        {
+            const CanardFrame* const frame = &self->pending[i]->frame;
+            (void) memset(&frames[i], 0, sizeof(frames[i]));
+            frames[i].can_id = (canid_t) ((frame->extended_can_id & CAN_EFF_MASK) | CAN_EFF_FLAG);
+            frames[i].len    = (uint8_t) frame->payload_size;
+            frames[i].flags  = self->can_fd ? SOCKETCAN_FD_FLAGS : 0U;
+            if (frame->payload_size > 0U)
+            {
+                (void) memcpy(&frames[i].data[0], frame->payload, frame->payload_size);
+            }
+            iov[i].iov_base            = &frames[i];
+            iov[i].iov_len             = self->can_fd ? CANFD_MTU : CAN_MTU;
+            msgs[i].msg_hdr.msg_iov    = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1U;
+        }
+        out = 0;
+        if (self->pending_count > 0U)
+        {
+            const int sent = sendmmsg(self->fd, msgs, (unsigned int) self->pending_count, MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (sent >= 0)
+            {
+                dropPending(self, ins, (size_t) sent);
+                out = (int32_t) sent;
+            }
+            else if (isTransient(errno))
+            {
+                out = 0;
+            }
+            else
+            {
+                out = (int32_t) -errno;
+                dropPending(self, ins, 1U);
+                self->drop_count++;
+            }
+        }
+    }
+    return out;
+}
+
+int32_t socketcanReceive(SocketCAN* const self, CanardRxFrameSlot* const out_frames, const size_t capacity)
+{
+    int32_t out = -EINVAL;
+    if ((self != NULL) && (out_frames != NULL) && (capacity > 0U))
+    {
+        const size_t       batch = (capacity < SOCKETCAN_BATCH_SIZE) ? capacity : SOCKETCAN_BATCH_SIZE;
+        struct canfd_frame frames[SOCKETCAN_BATCH_SIZE];
+        struct iovec       iov[SOCKETCAN_BATCH_SIZE];
+        struct mmsghdr     msgs[SOCKETCAN_BATCH_SIZE];
+        SocketCANControl   control[SOCKETCAN_BATCH_SIZE];
+        (void) memset(msgs, 0, sizeof(msgs));
+        for (size_t i = 0U; i < batch; i++)
+        {
+            iov[i].iov_base                = &frames[i];
+            iov[i].iov_len                 = sizeof(frames[i]);
+            msgs[i].msg_hdr.msg_iov        = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen     = 1U;
+            msgs[i].msg_hdr.msg_control    = &control[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+        }
+        const int received = recvmmsg(self->fd, msgs, (unsigned int) batch, MSG_DONTWAIT, NULL);
+        if (received >= 0)
+        {
+            const CanardMicrosecond now   = getRealTimeMicroseconds();
+            size_t                  count = 0U;
+            for (size_t i = 0U; i < (size_t) received; i++)
+            {
+                const struct canfd_frame* const frame = &frames[i];
+                const bool valid_size = ((msgs[i].msg_len == CAN_MTU) && (frame->len <= CAN_MAX_DLEN)) ||
+                                        ((msgs[i].msg_len == CANFD_MTU) && (frame->len <= CANFD_MAX_DLEN));
+                const bool valid_kind = ((frame->can_id & CAN_EFF_FLAG) != 0U) &&
+                                        ((frame->can_id & (CAN_RTR_FLAG | CAN_ERR_FLAG)) == 0U);
+                if (valid_size && valid_kind)
+                {
+                    const CanardMicrosecond  ts     = getTimestamp(&msgs[i].msg_hdr);
+                    CanardRxFrameSlot* const slot   = &out_frames[count++];
+                    slot->timestamp_usec            = (ts > 0U) ? ts : now;
+                    slot->extended_can_id           = frame->can_id & CAN_EFF_MASK;
+                    slot->redundant_transport_index = self->redundant_transport_index;
+                    slot->payload_size              = frame->len;
+                    (void) memcpy(&slot->payload[0], &frame->data[0], frame->len);
+                }
+            }
+            out = (int32_t) count;
+        }
+        else if (isTransient(errno))
+        {
+            out = 0;
+        }
+        else
+        {
+            out = (int32_t) -errno;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,101 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2016 OpenCyphal.
+///
+/// An optional Linux SocketCAN media layer for libcanard. It moves the frames between the kernel and the library
+/// in batches, using one recvmmsg() or sendmmsg() system call per batch instead of one read() or write() per frame,
+/// which reduces the system call overhead severalfold at high frame rates. Both Classic CAN and CAN FD are supported.
+///
+/// The adapter is not part of the library and is not needed to use it; to integrate it, add socketcan.c to the build
+/// of the Linux application next to canard.c. It depends on the public API of the library only.
+///
+/// The sockets are non-blocking; the application is expected to wait for the readiness of the file descriptor
+/// (e.g., via poll() or epoll) in its event loop and then invoke socketcanReceive() or socketcanTransmit().
+/// The adapter is not thread-safe; each instance of it is to be used from one thread at a time.
+
+#ifndef SOCKETCAN_H_INCLUDED
+#define SOCKETCAN_H_INCLUDED
+
+#include <canard.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The maximum number of frames moved per system call. Larger values amortize the system call overhead better at
+/// the cost of the stack usage of socketcanReceive() and socketcanTransmit(), which is about 200 bytes per frame.
+#ifndef SOCKETCAN_BATCH_SIZE
+#    define SOCKETCAN_BATCH_SIZE 32U
+#endif
+
+/// The state of one CAN interface. The fields are populated by socketcanOpen() or socketcanAttach().
+typedef struct SocketCAN
+{
+    int  fd;      ///< The socket. Read-only.
+    bool can_fd;  ///< Whether the frames are exchanged as CAN FD frames. Read-only.
+
+    /// The value assigned to CanardRxFrameSlot::redundant_transport_index of the received frames.
+    /// The default is zero. The application may change it at any time.
+    uint8_t redundant_transport_index;
+
+    /// The frames popped from the TX queue that the kernel has not accepted yet, oldest first.
+    /// They are transmitted before any further frames from the queue. Do not access.
+    CanardTxQueueItem* pending[SOCKETCAN_BATCH_SIZE];
+    size_t             pending_count;
+
+    /// The number of frames that were not transmitted because their transmission deadline had expired or because
+    /// the kernel rejected them. The application may read and reset it at any time.
+    uint64_t drop_count;
+} SocketCAN;
+
+/// Opens a non-blocking raw CAN socket bound to the specified interface (e.g., "can0" or "vcan0") and initializes
+/// the adapter with it. If can_fd is true, the frames are exchanged as CAN FD frames; the interface shall support it.
+/// The kernel timestamps of the received frames are enabled.
+///
+/// The return value is zero on success. The return value is a negated errno on failure; it is -EINVAL if any of the
+/// pointers are NULL or the name of the interface is too long.
+int16_t socketcanOpen(SocketCAN* const self, const char* const iface_name, const bool can_fd);
+
+/// Initializes the adapter with an existing socket that exchanges struct can_frame or struct canfd_frame messages,
+/// such as a raw CAN socket configured by the application, or one end of a socketpair(AF_UNIX, SOCK_SEQPACKET)
+/// used as an in-process stand-in for the bus in tests. The adapter takes the ownership of the socket.
+/// The socket should be non-blocking; otherwise, the functions of the adapter may block.
+///
+/// The return value is zero on success, or -EINVAL if the pointer is NULL or the descriptor is negative.
+int16_t socketcanAttach(SocketCAN* const self, const int fd, const bool can_fd);
+
+/// Closes the socket and frees the frames that have been popped from the TX queue but not yet transmitted,
+/// using the memory manager of the instance. The instance may be NULL if there are no such frames.
+/// The adapter may be reinitialized afterwards.
+void socketcanClose(SocketCAN* const self, CanardInstance* const ins);
+
+/// Transmits the frames from the TX queue in one system call: the frames left over from the previous invocation
+/// are transmitted first, followed by the frames picked from the queue via canardTxPeek() and canardTxPop() until
+/// the batch is full or the queue is empty. The frames whose transmission deadline is not later than now_usec
+/// are dropped; a zero deadline never expires. The frames accepted by the kernel are freed using the memory manager
+/// of the instance; the frames that the kernel could not accept because its buffers are full are kept for
+/// the next invocation, which the application should make when the socket becomes writable.
+///
+/// The return value is the number of frames accepted by the kernel, which is zero if there is nothing to transmit
+/// or the kernel buffers are full. The return value is a negated errno if the kernel rejected the first frame of the
+/// batch, in which case that frame is dropped so that an invalid frame cannot block the interface; it is -EINVAL if
+/// any of the pointers are NULL.
+int32_t socketcanTransmit(SocketCAN* const        self,
+                          CanardTxQueue* const    que,
+                          CanardInstance* const   ins,
+                          const CanardMicrosecond now_usec);
+
+/// Receives up to the specified number of frames (but at most SOCKETCAN_BATCH_SIZE) in one system call without
+/// blocking. The frames are stored into the array in the order of reception, ready to be passed to canardRxAccept()
+/// or to canardRxBacklogPush(). The frames that cannot be Cyphal/CAN frames (base-format, remote, and error frames)
+/// are skipped. The timestamp is the kernel reception timestamp in microseconds of CLOCK_REALTIME; if the socket
+/// does not provide one, the time of the reception by this function is used instead.
+///
+/// The return value is the number of frames stored into the array, which is zero if none are pending.
+/// The return value is a negated errno on failure; it is -EINVAL if any of the pointers are NULL or the capacity
+/// is zero.
+int32_t socketcanReceive(SocketCAN* const self, CanardRxFrameSlot* const out_frames, const size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,618 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2016 OpenCyphal.
+
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE  // NOLINT(bugprone-reserved-identifier)
+#endif
+
+#include "socketcan_uring.h"
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/// The bit rate is switched in the data phase of the transmitted CAN FD frames.
+#ifdef CANFD_FDF
+#    define SOCKETCAN_FD_FLAGS (CANFD_BRS | CANFD_FDF)
+#else
+#    define SOCKETCAN_FD_FLAGS CANFD_BRS
+#endif
+
+/// Each receive buffer holds the header of the received message, the control messages, and the frame.
+#define RX_CONTROL_SIZE ((uint32_t) CMSG_SPACE(sizeof(struct timeval)))
+#define RX_BUFFER_SIZE 128U
+#define RX_BUFFER_GROUP 0U
+
+/// Enough submission entries for a full send chain preceded by a poll request and a receive request per interface,
+/// and a cancellation request.
+#define SQ_ENTRIES (SOCKETCAN_URING_INTERFACE_MAX * (SOCKETCAN_BATCH_SIZE + 2U) + 1U)
+#define CQ_ENTRIES (SOCKETCAN_URING_RX_BUFFERS + (2U * SQ_ENTRIES))
+
+/// The user data of a request identifies its kind, the interface, and the slot of the frame if it is a send request.
+#define USER_DATA_RX 0U
+#define USER_DATA_TX 1U
+#define USER_DATA_CANCEL 2U
+#define USER_DATA_TX_POLL 3U
+#define USER_DATA_INTERFACE_SHIFT 8U
+#define USER_DATA_SLOT_SHIFT 16U
+
+/// The time to wait for the cancellation of the requests in flight in socketcanUringClose().
+#define CLOSE_TIMEOUT_USEC 1000000U
+
+#if (SOCKETCAN_URING_RX_BUFFERS & (SOCKETCAN_URING_RX_BUFFERS - 1U)) != 0
+#    error "SOCKETCAN_URING_RX_BUFFERS shall be a power of two"
+#endif
+
+/// A compile-time check that the message header, the control messages, and the largest frame fit into a buffer.
+typedef char SocketCANUringRxBufferSizeCheck
+    [((sizeof(struct io_uring_recvmsg_out) + RX_CONTROL_SIZE + CANFD_MTU) <= RX_BUFFER_SIZE) ? 1 : -1];
+
+static CanardMicrosecond getRealTimeMicroseconds(void)
+{
+    struct timespec ts = {0};
+    (void) clock_gettime(CLOCK_REALTIME, &ts);
+    return (((CanardMicrosecond) ts.tv_sec) * 1000000ULL) + (((CanardMicrosecond) ts.tv_nsec) / 1000ULL);
+}
+
+/// Returns the kernel timestamp from the control messages of the received frame, or zero if there is none.
+static CanardMicrosecond getTimestamp(struct msghdr* const msg)
+{
+    CanardMicrosecond out = 0U;
+    for (struct cmsghdr* cm = CMSG_FIRSTHDR(msg); cm != NULL; cm = CMSG_NXTHDR(msg, cm))
+    {
+        if ((cm->cmsg_level == SOL_SOCKET) && (cm->cmsg_type == SCM_TIMESTAMP))
+        {
+            struct timeval tv = {0};
+            (void) memcpy(&tv, CMSG_DATA(cm), sizeof(tv));  // The payload may be misaligned.
+            out = (((CanardMicrosecond) tv.tv_sec) * 1000000ULL) + ((CanardMicrosecond) tv.tv_usec);
+        }
+    }
+    return out;
+}
+
+static size_t getRingMapSize(void)
+{
+    const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    return (((SOCKETCAN_URING_RX_BUFFERS * sizeof(struct io_uring_buf)) + page - 1U) / page) * page;
+}
+
+static uint8_t* getRxBuffer(const SocketCANUring* const self, const uint16_t bid)
+{
+    return ((uint8_t*) self->rx_buffers) + getRingMapSize() + (((size_t) bid) * RX_BUFFER_SIZE);
+}
+
+/// Returns the receive buffer to the kernel via the provided buffer ring.
+static void provideRxBuffer(SocketCANUring* const self, const uint16_t bid)
+{
+    struct io_uring_buf* const ring = (struct io_uring_buf*) self->rx_buffers;
+    uint16_t* const            tail = &ring[0].resv;  // The tail of the ring overlays this field of the first entry.
+    struct io_uring_buf* const buf  = &ring[*tail & (SOCKETCAN_URING_RX_BUFFERS - 1U)];
+    buf->addr                       = (uint64_t) (uintptr_t) getRxBuffer(self, bid);
+    buf->len                        = RX_BUFFER_SIZE;
+    buf->bid                        = bid;
+    __atomic_store_n(tail, (uint16_t) (*tail + 1U), __ATOMIC_RELEASE);
+}
+
+static uint32_t getSqSpace(const SocketCANUring* const self)
+{
+    return self->sq_entries - (*self->sq_tail - __atomic_load_n(self->sq_head, __ATOMIC_ACQUIRE));
+}
+
+/// Returns a zeroed submission entry that will be submitted by the next io_uring_enter(), or NULL if the ring is full.
+/// The entry may be populated after the tail is advanced because the kernel only reads it during the system call.
+static struct io_uring_sqe* getSqe(SocketCANUring* const self)
+{
+    struct io_uring_sqe* out = NULL;
+    if (getSqSpace(self) > 0U)
+    {
+        const uint32_t index = *self->sq_tail & self->sq_mask;
+        out                  = &((struct io_uring_sqe*) self->sqes)[index];
+        (void) memset(out, 0, sizeof(struct io_uring_sqe));
+        self->sq_array[index] = index;
+        __atomic_store_n(self->sq_tail, *self->sq_tail + 1U, __ATOMIC_RELEASE);
+        self->to_submit++;
+    }
+    return out;
+}
+
+static uint32_t getCqReady(const SocketCANUring* const self)
+{
+    return __atomic_load_n(self->cq_tail, __ATOMIC_ACQUIRE) - *self->cq_head;
+}
+
+/// Submits the prepared requests and waits for at least one completion if the timeout is positive.
+/// Returns a negated errno on failure; the expiration of the timeout and the interruption by a signal are not failures.
+static int32_t enter(SocketCANUring* const self, const CanardMicrosecond timeout_usec)
+{
+    struct __kernel_timespec      ts  = {0};
+    struct io_uring_getevents_arg arg = {0};
+    ts.tv_sec                         = (int64_t) (timeout_usec / 1000000U);
+    ts.tv_nsec                        = (int64_t) ((timeout_usec % 1000000U) * 1000U);
+    arg.sigmask_sz                    = (uint32_t) (_NSIG / 8);
+    arg.ts                            = (uint64_t) (uintptr_t) &ts;
+    const bool     wait               = timeout_usec > 0U;
+    const uint32_t flags              = wait ? (IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG) : 0U;
+    const long     result             = syscall(__NR_io_uring_enter,
+                                self->ring_fd,
+                                self->to_submit,
+                                wait ? 1U : 0U,
+                                flags,
+                                wait ? &arg : NULL,
+                                wait ? sizeof(arg) : 0U);
+    self->syscall_count++;
+    int32_t out = 0;
+    if (result >= 0)
+    {
+        self->to_submit = (((uint32_t) result) < self->to_submit) ? (self->to_submit - (uint32_t) result) : 0U;
+    }
+    else if ((errno == ETIME) || (errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY))
+    {
+        out = 0;
+    }
+    else
+    {
+        out = (int32_t) -errno;
+    }
+    return out;
+}
+
+static void armReceive(SocketCANUring* const self, const size_t index)
+{
+    struct io_uring_sqe* const sqe = getSqe(self);
+    if (sqe != NULL)
+    {
+        SocketCANUringInterface* const iface = &self->interfaces[index];
+        sqe->opcode                          = IORING_OP_RECVMSG;
+        sqe->fd                              = iface->fd;
+        sqe->addr                            = (uint64_t) (uintptr_t) &iface->rx_template;
+        sqe->len                             = 1U;
+        sqe->ioprio                          = IORING_RECV_MULTISHOT;
+        sqe->flags                           = IOSQE_BUFFER_SELECT;
+        sqe->buf_group                       = RX_BUFFER_GROUP;
+        sqe->user_data                       = USER_DATA_RX | (((uint64_t) index) << USER_DATA_INTERFACE_SHIFT);
+        iface->rx_armed                      = true;
+    }
+}
+
+/// Returns true if the send request is to be retried later because the socket buffer was full, or because it was
+/// canceled by the failure of an earlier request of the chain, as opposed to a genuine failure.
+static bool isTransient(const int32_t result)
+{
+    return (result == -EAGAIN) || (result == -ENOBUFS) || (result == -ECANCELED);
+}
+
+/// Moves the frames left over from the previous chain to the front, dropping those that have expired, and appends
+/// the frames picked from the TX queue of the interface. Returns the number of the frames ready for transmission.
+static size_t collectTransmission(SocketCANUringInterface* const iface,
+                                  CanardInstance* const          ins,
+                                  const CanardMicrosecond        now_usec)
+{
+    size_t count = 0U;
+    for (size_t i = 0U; i < SOCKETCAN_BATCH_SIZE; i++)
+    {
+        CanardTxQueueItem* const item = iface->tx_items[i];
+        iface->tx_items[i]            = NULL;
+        if ((item != NULL) && (item->tx_deadline_usec != 0U) && (item->tx_deadline_usec <= now_usec))
+        {
+            ins->memory_free(ins, item);
+            iface->drop_count++;
+        }
+        else if (item != NULL)
+        {
+            if (count != i)
+            {
+                iface->tx_frames[count] = iface->tx_frames[i];
+            }
+            iface->tx_items[count++] = item;
+        }
+        else
+        {
+            // The slot is vacant.
+        }
+    }
+    const CanardTxQueueItem* ti = canardTxPeek(iface->que);
+    while ((count < SOCKETCAN_BATCH_SIZE) && (ti != NULL))
+    {
+        CanardTxQueueItem* const item = canardTxPop(iface->que, ti);
+        if ((item->tx_deadline_usec == 0U) || (item->tx_deadline_usec > now_usec))
+        {
+            struct canfd_frame* const frame = &iface->tx_frames[count];
+            (void) memset(frame, 0, sizeof(struct canfd_frame));
+            frame->can_id = (canid_t) ((item->frame.extended_can_id & CAN_EFF_MASK) | CAN_EFF_FLAG);
+            frame->len    = (uint8_t) item->frame.payload_size;
+            frame->flags  = iface->can_fd ? SOCKETCAN_FD_FLAGS : 0U;
+            if (item->frame.payload_size > 0U)
+            {
+                (void) memcpy(&frame->data[0], item->frame.payload, item->frame.payload_size);
+            }
+            iface->tx_items[count++] = item;
+        }
+        else
+        {
+            ins->memory_free(ins, item);
+            iface->drop_count++;
+        }
+        ti = canardTxPeek(iface->que);
+    }
+    return count;
+}
+
+/// Submits the frames left over from the previous chain and those picked from the TX queue of the interface
+/// as a chain of linked send requests. The frames that do not fit into the submission ring stay for the next call.
+/// If the socket buffer was full last time, the chain waits for the socket to become writable in the kernel.
+static void submitTransmission(SocketCANUring* const   self,
+                               CanardInstance* const   ins,
+                               const size_t            index,
+                               const CanardMicrosecond now_usec)
+{
+    SocketCANUringInterface* const iface = &self->interfaces[index];
+    const size_t                   count = collectTransmission(iface, ins, now_usec);
+    size_t                         space = getSqSpace(self);
+    if (iface->tx_blocked && (count > 0U) && (space > 1U))
+    {
+        struct io_uring_sqe* const sqe = getSqe(self);  // Cannot fail because the space has been checked above.
+        if (sqe != NULL)
+        {
+            sqe->opcode        = IORING_OP_POLL_ADD;
+            sqe->fd            = iface->fd;
+            sqe->poll32_events = POLLOUT;
+            sqe->flags         = IOSQE_IO_LINK;
+            sqe->user_data     = USER_DATA_TX_POLL | (((uint64_t) index) << USER_DATA_INTERFACE_SHIFT);
+            iface->tx_blocked  = false;
+            space--;
+        }
+    }
+    const size_t limit = (space < count) ? space : count;
+    for (size_t i = 0U; i < limit; i++)
+    {
+        struct io_uring_sqe* const sqe = getSqe(self);  // Cannot fail because the space has been checked above.
+        if (sqe != NULL)
+        {
+            sqe->opcode    = IORING_OP_SEND;
+            sqe->fd        = iface->fd;
+            sqe->addr      = (uint64_t) (uintptr_t) &iface->tx_frames[i];
+            sqe->len       = iface->can_fd ? CANFD_MTU : CAN_MTU;
+            sqe->msg_flags = MSG_DONTWAIT;  // A full socket buffer fails the request instead of holding the chain.
+            sqe->flags     = ((i + 1U) < limit) ? IOSQE_IO_LINK : 0U;  // A failure cancels the rest of the chain.
+            sqe->user_data = USER_DATA_TX | (((uint64_t) index) << USER_DATA_INTERFACE_SHIFT) |
+                             (((uint64_t) i) << USER_DATA_SLOT_SHIFT);
+        }
+    }
+    iface->tx_in_flight = limit;
+}
+
+/// Converts the received message into a frame slot; returns false if it cannot be a Cyphal/CAN frame.
+static bool parseReceived(const SocketCANUringInterface* const iface,
+                          uint8_t* const                       buffer,
+                          const size_t                         size,
+                          const CanardMicrosecond              now,
+                          CanardRxFrameSlot* const             out_frame)
+{
+    struct io_uring_recvmsg_out header = {0};
+    struct canfd_frame          frame  = {0};
+    bool                        out    = false;
+    const size_t                offset = sizeof(header) + iface->rx_template.msg_namelen + RX_CONTROL_SIZE;
+    if (size >= offset)
+    {
+        (void) memcpy(&header, buffer, sizeof(header));
+        const size_t length = ((size - offset) < header.payloadlen) ? (size - offset) : header.payloadlen;
+        (void) memcpy(&frame, buffer + offset, (length < sizeof(frame)) ? length : sizeof(frame));
+        const bool valid_size = ((length == CAN_MTU) && (frame.len <= CAN_MAX_DLEN)) ||
+                                ((length == CANFD_MTU) && (frame.len <= CANFD_MAX_DLEN));
+        const bool valid_kind = ((frame.can_id & CAN_EFF_FLAG) != 0U) &&
+                                ((frame.can_id & (CAN_RTR_FLAG | CAN_ERR_FLAG)) == 0U);
+        out = valid_size && valid_kind && ((header.flags & MSG_TRUNC) == 0U);
+    }
+    if (out)
+    {
+        struct msghdr msg              = {0};
+        msg.msg_control                = buffer + sizeof(header) + iface->rx_template.msg_namelen;
+        msg.msg_controllen             = header.controllen;
+        const CanardMicrosecond ts     = getTimestamp(&msg);
+        out_frame->timestamp_usec            = (ts > 0U) ? ts : now;
+        out_frame->extended_can_id           = frame.can_id & CAN_EFF_MASK;
+        out_frame->redundant_transport_index = iface->redundant_transport_index;
+        out_frame->payload_size              = frame.len;
+        (void) memcpy(&out_frame->payload[0], &frame.data[0], frame.len);
+    }
+    return out;
+}
+
+/// Processes the completions until there are none left or the array of received frames is full.
+/// If the array is NULL, the received frames are discarded. Returns the number of the frames stored into the array.
+static size_t reap(SocketCANUring* const    self,
+                   CanardInstance* const    ins,
+                   CanardRxFrameSlot* const out_frames,
+                   const size_t             capacity)
+{
+    const CanardMicrosecond now   = getRealTimeMicroseconds();
+    size_t                  count = 0U;
+    uint32_t                head  = *self->cq_head;
+    const uint32_t          tail  = __atomic_load_n(self->cq_tail, __ATOMIC_ACQUIRE);
+    while ((head != tail) && ((out_frames == NULL) || (count < capacity)))
+    {
+        const struct io_uring_cqe* const cqe   = &((const struct io_uring_cqe*) self->cqes)[head & self->cq_mask];
+        const uint64_t                   kind  = cqe->user_data & 0xFFU;
+        const size_t                     index = (size_t) ((cqe->user_data >> USER_DATA_INTERFACE_SHIFT) & 0xFFU);
+        if ((kind == USER_DATA_RX) && (index < self->interface_count))
+        {
+            SocketCANUringInterface* const iface = &self->interfaces[index];
+            iface->rx_armed                      = iface->rx_armed && ((cqe->flags & IORING_CQE_F_MORE) != 0U);
+            if ((cqe->flags & IORING_CQE_F_BUFFER) != 0U)
+            {
+                const uint16_t bid = (uint16_t) (cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+                if ((cqe->res > 0) && (out_frames != NULL) &&
+                    parseReceived(iface, getRxBuffer(self, bid), (size_t) cqe->res, now, &out_frames[count]))
+                {
+                    count++;
+                }
+                provideRxBuffer(self, bid);
+            }
+        }
+        else if ((kind == USER_DATA_TX) && (index < self->interface_count))
+        {
+            SocketCANUringInterface* const iface = &self->interfaces[index];
+            const size_t slot = (size_t) ((cqe->user_data >> USER_DATA_SLOT_SHIFT) % SOCKETCAN_BATCH_SIZE);
+            if (isTransient(cqe->res))
+            {
+                // The frame stays in its slot; the slots are resubmitted in order, so it cannot be overtaken.
+                iface->tx_blocked = true;
+            }
+            else
+            {
+                if (cqe->res >= 0)
+                {
+                    iface->tx_count++;
+                }
+                else
+                {
+                    iface->drop_count++;
+                }
+                if ((ins != NULL) && (iface->tx_items[slot] != NULL))
+                {
+                    ins->memory_free(ins, iface->tx_items[slot]);
+                }
+                iface->tx_items[slot] = NULL;
+            }
+            iface->tx_in_flight -= (iface->tx_in_flight > 0U) ? 1U : 0U;
+        }
+        else
+        {
+            // The completions of the cancellation and poll requests require no action.
+        }
+        head++;
+    }
+    __atomic_store_n(self->cq_head, head, __ATOMIC_RELEASE);
+    return count;
+}
+
+static void release(SocketCANUring* const self)
+{
+    if (self->rx_buffers != NULL)
+    {
+        (void) munmap(self->rx_buffers, self->rx_buffers_size);
+    }
+    if (self->sqes != NULL)
+    {
+        (void) munmap(self->sqes, self->sqes_size);
+    }
+    if ((self->cq_ring != NULL) && (self->cq_ring != self->sq_ring))
+    {
+        (void) munmap(self->cq_ring, self->cq_ring_size);
+    }
+    if (self->sq_ring != NULL)
+    {
+        (void) munmap(self->sq_ring, self->sq_ring_size);
+    }
+    if (self->ring_fd >= 0)
+    {
+        (void) close(self->ring_fd);
+    }
+    (void) memset(self, 0, sizeof(SocketCANUring));
+    self->ring_fd = -1;
+}
+
+static void* mapRing(const int fd, const size_t size, const off_t offset)
+{
+    void* const out = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return (out != MAP_FAILED) ? out : NULL;
+}
+
+int16_t socketcanUringInit(SocketCANUring* const self)
+{
+    int16_t out = -EINVAL;
+    if (self != NULL)
+    {
+        (void) memset(self, 0, sizeof(SocketCANUring));
+        struct io_uring_params params = {0};
+        params.flags                  = IORING_SETUP_CQSIZE;
+        params.cq_entries             = CQ_ENTRIES;
+        self->ring_fd                 = (int) syscall(__NR_io_uring_setup, SQ_ENTRIES, &params);
+        out                           = (self->ring_fd >= 0) ? 0 : (int16_t) -errno;
+        if ((out == 0) && ((params.features & IORING_FEAT_EXT_ARG) == 0U))
+        {
+            out = -ENOSYS;
+        }
+        if (out == 0)
+        {
+            self->sq_ring_size = params.sq_off.array + (params.sq_entries * sizeof(uint32_t));
+            self->cq_ring_size = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+            if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0U)
+            {
+                // Both rings share one mapping, which is sized for the larger one.
+                if (self->cq_ring_size > self->sq_ring_size)
+                {
+                    self->sq_ring_size = self->cq_ring_size;
+                }
+                self->sq_ring = mapRing(self->ring_fd, self->sq_ring_size, IORING_OFF_SQ_RING);
+                self->cq_ring = self->sq_ring;
+            }
+            else
+            {
+                self->sq_ring = mapRing(self->ring_fd, self->sq_ring_size, IORING_OFF_SQ_RING);
+                self->cq_ring = mapRing(self->ring_fd, self->cq_ring_size, (off_t) IORING_OFF_CQ_RING);
+            }
+            self->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+            self->sqes      = mapRing(self->ring_fd, self->sqes_size, (off_t) IORING_OFF_SQES);
+            out             = ((self->sq_ring != NULL) && (self->cq_ring != NULL) && (self->sqes != NULL))
+                                  ? 0
+                                  : (int16_t) -errno;
+        }
+        if (out == 0)
+        {
+            uint8_t* const sq = (uint8_t*) self->sq_ring;
+            uint8_t* const cq = (uint8_t*) self->cq_ring;
+            self->sq_head     = (uint32_t*) (void*) (sq + params.sq_off.head);
+            self->sq_tail     = (uint32_t*) (void*) (sq + params.sq_off.tail);
+            self->sq_array    = (uint32_t*) (void*) (sq + params.sq_off.array);
+            self->sq_mask     = *(uint32_t*) (void*) (sq + params.sq_off.ring_mask);
+            self->sq_entries  = params.sq_entries;
+            self->cq_head     = (uint32_t*) (void*) (cq + params.cq_off.head);
+            self->cq_tail     = (uint32_t*) (void*) (cq + params.cq_off.tail);
+            self->cq_mask     = *(uint32_t*) (void*) (cq + params.cq_off.ring_mask);
+            self->cqes        = cq + params.cq_off.cqes;
+
+            // The buffer ring shall be page-aligned; the buffers follow it in the same mapping.
+            self->rx_buffers_size = getRingMapSize() + (SOCKETCAN_URING_RX_BUFFERS * RX_BUFFER_SIZE);
+            self->rx_buffers =
+                mmap(NULL, self->rx_buffers_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            self->rx_buffers = (self->rx_buffers != MAP_FAILED) ? self->rx_buffers : NULL;
+            out              = (self->rx_buffers != NULL) ? 0 : (int16_t) -errno;
+        }
+        if (out == 0)
+        {
+            struct io_uring_buf_reg reg = {0};
+            reg.ring_addr               = (uint64_t) (uintptr_t) self->rx_buffers;
+            reg.ring_entries            = SOCKETCAN_URING_RX_BUFFERS;
+            reg.bgid                    = RX_BUFFER_GROUP;
+            out = (syscall(__NR_io_uring_register, self->ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) == 0)
+                      ? 0
+                      : (int16_t) -errno;
+        }
+        if (out == 0)
+        {
+            for (uint32_t i = 0U; i < SOCKETCAN_URING_RX_BUFFERS; i++)
+            {
+                provideRxBuffer(self, (uint16_t) i);
+            }
+        }
+        else
+        {
+            release(self);
+        }
+    }
+    return out;
+}
+
+int16_t socketcanUringAdd(SocketCANUring* const self, const SocketCAN* const socket, CanardTxQueue* const que)
+{
+    int16_t out = -EINVAL;
+    if ((self != NULL) && (socket != NULL) && (self->ring_fd >= 0))
+    {
+        if (self->interface_count < SOCKETCAN_URING_INTERFACE_MAX)
+        {
+            const size_t                   index = self->interface_count++;
+            SocketCANUringInterface* const iface = &self->interfaces[index];
+            (void) memset(iface, 0, sizeof(SocketCANUringInterface));
+            iface->fd                          = socket->fd;
+            iface->can_fd                      = socket->can_fd;
+            iface->redundant_transport_index   = socket->redundant_transport_index;
+            iface->que                         = que;
+            iface->rx_template.msg_namelen     = 0U;
+            iface->rx_template.msg_controllen  = RX_CONTROL_SIZE;
+            armReceive(self, index);  // If the submission ring is full, it will be armed by socketcanUringPoll().
+            out = (int16_t) index;
+        }
+        else
+        {
+            out = -ENOSPC;
+        }
+    }
+    return out;
+}
+
+int32_t socketcanUringPoll(SocketCANUring* const    self,
+                           CanardInstance* const    ins,
+                           const CanardMicrosecond  now_usec,
+                           const CanardMicrosecond  timeout_usec,
+                           CanardRxFrameSlot* const out_frames,
+                           const size_t             capacity)
+{
+    int32_t out = -EINVAL;
+    if ((self != NULL) && (ins != NULL) && (out_frames != NULL) && (capacity > 0U) && (self->ring_fd >= 0))
+    {
+        for (size_t i = 0U; i < self->interface_count; i++)
+        {
+            if (!self->interfaces[i].rx_armed)
+            {
+                armReceive(self, i);
+            }
+            if ((self->interfaces[i].tx_in_flight == 0U) && (self->interfaces[i].que != NULL))
+            {
+                submitTransmission(self, ins, i, now_usec);
+            }
+        }
+        const bool wait = (timeout_usec > 0U) && (getCqReady(self) == 0U);
+        out             = 0;
+        if ((self->to_submit > 0U) || wait)
+        {
+            out = enter(self, wait ? timeout_usec : 0U);
+        }
+        if (out == 0)
+        {
+            out = (int32_t) reap(self, ins, out_frames, capacity);
+        }
+    }
+    return out;
+}
+
+void socketcanUringClose(SocketCANUring* const self, CanardInstance* const ins)
+{
+    if ((self != NULL) && (self->ring_fd >= 0))
+    {
+        bool busy = false;
+        for (size_t i = 0U; i < self->interface_count; i++)
+        {
+            busy = busy || self->interfaces[i].rx_armed || (self->interfaces[i].tx_in_flight > 0U);
+        }
+        if (busy)
+        {
+            struct io_uring_sqe* const sqe = getSqe(self);
+            if (sqe != NULL)
+            {
+                sqe->opcode       = IORING_OP_ASYNC_CANCEL;
+                sqe->fd           = -1;
+                sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+                sqe->user_data    = USER_DATA_CANCEL;
+            }
+        }
+        const CanardMicrosecond deadline = getRealTimeMicroseconds() + CLOSE_TIMEOUT_USEC;
+        while (busy && (getRealTimeMicroseconds() < deadline))
+        {
+            (void) enter(self, CLOSE_TIMEOUT_USEC / 10U);
+            (void) reap(self, ins, NULL, 0U);
+            busy = false;
+            for (size_t i = 0U; i < self->interface_count; i++)
+            {
+                busy = busy || self->interfaces[i].rx_armed || (self->interfaces[i].tx_in_flight > 0U);
+            }
+        }
+        for (size_t i = 0U; (i < self->interface_count) && (ins != NULL); i++)
+        {
+            for (size_t k = 0U; k < SOCKETCAN_BATCH_SIZE; k++)
+            {
+                if (self->interfaces[i].tx_items[k] != NULL)
+                {
+                    ins->memory_free(ins, self->interfaces[i].tx_items[k]);  // Left over or canceled above.
+                }
+            }
+        }
+        release(self);
+    }
+}
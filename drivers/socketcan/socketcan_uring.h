@@ -0,0 +1,153 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2016 OpenCyphal.
+///
+/// An optional io_uring-based I/O engine for the SocketCAN adapter that services several CAN interfaces with
+/// as few system calls as possible. Each interface has a multishot receive request armed permanently, which delivers
+/// every received frame into a buffer provided by the engine without a system call per frame or per wake-up, and
+/// a chain of linked send requests that transmits the frames picked from its TX queue in order. A single
+/// io_uring_enter() submits the new requests and waits for the completions of all interfaces at once, replacing
+/// the epoll_wait() plus recvmmsg()/sendmmsg() per interface of the plain adapter (see socketcan.h).
+///
+/// It requires Linux v6.0 or newer (multishot recvmsg with provided buffer rings) and does not depend on liburing.
+/// To integrate it, add socketcan_uring.c and socketcan.c to the build of the application.
+/// The engine is not thread-safe; it is to be used from one thread at a time.
+
+#ifndef SOCKETCAN_URING_H_INCLUDED
+#define SOCKETCAN_URING_H_INCLUDED
+
+#include "socketcan.h"
+#include <linux/can.h>
+#include <sys/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The maximum number of interfaces serviced by one engine.
+#ifndef SOCKETCAN_URING_INTERFACE_MAX
+#    define SOCKETCAN_URING_INTERFACE_MAX 4U
+#endif
+
+/// The number of receive buffers shared by all interfaces; a power of two not greater than 32768. It bounds the number
+/// of received frames that can await socketcanUringPoll(); if they run out, the kernel keeps the frames in the socket.
+#ifndef SOCKETCAN_URING_RX_BUFFERS
+#    define SOCKETCAN_URING_RX_BUFFERS 256U
+#endif
+
+/// The state of one interface of the engine. Do not access the fields except where stated otherwise.
+typedef struct SocketCANUringInterface
+{
+    int            fd;
+    bool           can_fd;
+    uint8_t        redundant_transport_index;
+    CanardTxQueue* que;
+    struct msghdr  rx_template;  ///< Describes the layout of the receive buffers to the kernel.
+    bool           rx_armed;     ///< Whether the multishot receive request is in flight.
+
+    /// The frames of the send chain in flight, which is submitted only when the previous one has completed
+    /// so that the frames cannot overtake each other. The frames that the kernel could not take because the socket
+    /// buffer was full, and those canceled by the failure of an earlier frame of the chain, remain here to be
+    /// submitted again ahead of the TX queue.
+    CanardTxQueueItem* tx_items[SOCKETCAN_BATCH_SIZE];
+    struct canfd_frame tx_frames[SOCKETCAN_BATCH_SIZE];
+    size_t             tx_in_flight;
+    bool               tx_blocked;  ///< The next chain waits for the socket to become writable first.
+
+    /// The number of frames transmitted successfully.
+    /// The application may read and reset it at any time.
+    uint64_t tx_count;
+
+    /// The number of frames that were not transmitted because their transmission deadline had expired or because
+    /// the kernel rejected them. The application may read and reset it at any time.
+    uint64_t drop_count;
+} SocketCANUringInterface;
+
+/// The state of the engine; see socketcanUringInit(). The storage is supplied by the application.
+/// Do not access the fields except where stated otherwise.
+typedef struct SocketCANUring
+{
+    int ring_fd;
+
+    void*  sq_ring;
+    size_t sq_ring_size;
+    void*  cq_ring;
+    size_t cq_ring_size;
+    void*  sqes;
+    size_t sqes_size;
+
+    // The pointers into the mapped rings.
+    uint32_t* sq_head;
+    uint32_t* sq_tail;
+    uint32_t* sq_array;
+    uint32_t  sq_mask;
+    uint32_t  sq_entries;
+    uint32_t* cq_head;
+    uint32_t* cq_tail;
+    uint32_t  cq_mask;
+    void*     cqes;
+
+    uint32_t to_submit;  ///< The number of the prepared requests that have not been submitted yet.
+
+    /// The provided buffer ring followed by the receive buffers.
+    void*  rx_buffers;
+    size_t rx_buffers_size;
+
+    SocketCANUringInterface interfaces[SOCKETCAN_URING_INTERFACE_MAX];
+    size_t                  interface_count;
+
+    /// The number of io_uring_enter() system calls made so far.
+    /// The application may read and reset it at any time.
+    uint64_t syscall_count;
+} SocketCANUring;
+
+/// Creates the io_uring instance and the receive buffers. The engine shall not be moved while it is in use.
+/// The return value is zero on success or a negated errno on failure; it is -EINVAL if the pointer is NULL.
+/// If the kernel does not support io_uring or its use is prohibited, the error is -ENOSYS or -EPERM, respectively,
+/// in which case the application may fall back to socketcanReceive() and socketcanTransmit().
+int16_t socketcanUringInit(SocketCANUring* const self);
+
+/// Adds the interface of the adapter, which has been opened with socketcanOpen() or socketcanAttach(), to the engine.
+/// The frames received from it are labeled with the redundant transport index of the adapter. The frames are picked
+/// for transmission from the specified TX queue, which may be NULL if the interface is used for reception only.
+/// The adapter keeps the ownership of the socket; it shall not be used directly while the engine is in use.
+///
+/// The return value is the index of the interface in the engine, or a negated errno on failure; it is -EINVAL
+/// if the pointers other than the queue are NULL and -ENOSPC if there are SOCKETCAN_URING_INTERFACE_MAX interfaces.
+int16_t socketcanUringAdd(SocketCANUring* const self, const SocketCAN* const socket, CanardTxQueue* const que);
+
+/// Services all interfaces with one io_uring_enter() system call or none:
+///
+///     1. For each interface that has no frames in flight, the frames left over from the previous chain followed by
+///        the frames picked from its TX queue via canardTxPeek() and canardTxPop() are submitted as a chain of up to
+///        SOCKETCAN_BATCH_SIZE linked send requests, oldest first. The frames whose transmission deadline is not later
+///        than now_usec are dropped; a zero deadline never expires. If the socket buffer was full last time, the chain
+///        is held in the kernel until the socket becomes writable.
+///     2. The multishot receive requests that have been terminated (e.g., due to the lack of buffers) are re-armed.
+///     3. The new requests are submitted, and if there are no completions to process and timeout_usec is positive,
+///        the engine waits until there are any, or the timeout expires. The system call is not made at all if
+///        there is nothing to submit and nothing to wait for.
+///     4. The completions are processed: the transmitted frames are freed using the memory manager of the instance,
+///        except those that failed with EAGAIN, ENOBUFS, or ECANCELED, which are kept for the next call, and the
+///        received frames are stored into the array in the order of reception, ready to be passed to
+///        canardRxAccept() or to canardRxBacklogPush(), up to its capacity; the rest are left for the next call.
+///
+/// The frames that cannot be Cyphal/CAN frames are skipped. The timestamps are obtained as in socketcanReceive().
+///
+/// The return value is the number of received frames stored into the array. The return value is a negated errno
+/// on failure; it is -EINVAL if any of the pointers are NULL or the capacity is zero.
+int32_t socketcanUringPoll(SocketCANUring* const    self,
+                           CanardInstance* const    ins,
+                           const CanardMicrosecond  now_usec,
+                           const CanardMicrosecond  timeout_usec,
+                           CanardRxFrameSlot* const out_frames,
+                           const size_t             capacity);
+
+/// Cancels the requests in flight, waits for their completion, and destroys the io_uring instance.
+/// The frames that have been popped from the TX queues but not transmitted are freed using the memory manager of
+/// the instance, which may be NULL if there are no such frames. The sockets of the interfaces are not closed.
+void socketcanUringClose(SocketCANUring* const self, CanardInstance* const ins);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -29,6 +29,88 @@
 #    define CANARD_CRC_TABLE 1
 #endif
 
+/// Define this macro to use a native count-trailing-zeros operation in the bitmap TX queue and in the RX timer wheel;
+/// it shall evaluate to the number of trailing zero bits in a non-zero uint32_t argument;
+/// e.g., on GCC: "-DCANARD_CTZ32=__builtin_ctz".
+/// By default, a portable implementation based on a de Bruijn sequence is used.
+
+/// Define CANARD_SINGLE_THREADED=1 to confirm that the library is only used from a single thread. This is required
+/// on compilers that offer neither the GCC/Clang atomic built-ins nor user definitions of the atomic operations below;
+/// the plain non-atomic operations are used then. Otherwise, the build fails rather than falling back silently.
+#ifndef CANARD_SINGLE_THREADED
+#    define CANARD_SINGLE_THREADED 0
+#endif
+
+/// Define these macros to make the reference counting of shared RX payloads (see canardRxSharePayload()) thread-safe
+/// on compilers that do not offer the GCC/Clang atomic built-ins, which are used by default if available.
+/// The argument is a pointer to size_t; the macros shall atomically increment or decrement the pointed-to value and
+/// evaluate to the new value.
+#ifndef CANARD_ATOMIC_INCREMENT
+#    if defined(__GNUC__)
+#        define CANARD_ATOMIC_INCREMENT(x) __atomic_add_fetch((x), 1U, __ATOMIC_RELAXED)
+#    elif CANARD_SINGLE_THREADED
+#        define CANARD_ATOMIC_INCREMENT(x) (++(*(x)))
+#    else
+#        error "Define CANARD_ATOMIC_INCREMENT, or define CANARD_SINGLE_THREADED=1 if atomics are not needed"
+#    endif
+#endif
+#ifndef CANARD_ATOMIC_DECREMENT
+#    if defined(__GNUC__)
+#        define CANARD_ATOMIC_DECREMENT(x) __atomic_sub_fetch((x), 1U, __ATOMIC_ACQ_REL)
+#    elif CANARD_SINGLE_THREADED
+#        define CANARD_ATOMIC_DECREMENT(x) (--(*(x)))
+#    else
+#        error "Define CANARD_ATOMIC_DECREMENT, or define CANARD_SINGLE_THREADED=1 if atomics are not needed"
+#    endif
+#endif
+
+/// Define these macros to make the subscription table (see canardRxSetSubscriptionTable()) usable from multiple threads
+/// on compilers that do not offer the GCC/Clang atomic built-ins, which are used by default if available.
+/// The first argument is a pointer to a pointer or to size_t. The load shall have the acquire semantics and the store
+/// the release semantics. The compare-exchange shall replace the value with the desired one and evaluate to true if
+/// the value equals the one pointed to by the expected pointer, otherwise store the value into the latter and evaluate
+/// to false, with the acquire-release semantics. The same applies to CANARD_SINGLE_THREADED as above.
+#ifndef CANARD_ATOMIC_LOAD
+#    if defined(__GNUC__)
+#        define CANARD_ATOMIC_LOAD(x) __atomic_load_n((x), __ATOMIC_ACQUIRE)
+#    elif CANARD_SINGLE_THREADED
+#        define CANARD_ATOMIC_LOAD(x) (*(x))
+#    else
+#        error "Define CANARD_ATOMIC_LOAD, or define CANARD_SINGLE_THREADED=1 if atomics are not needed"
+#    endif
+#endif
+#ifndef CANARD_ATOMIC_STORE
+#    if defined(__GNUC__)
+#        define CANARD_ATOMIC_STORE(x, value) __atomic_store_n((x), (value), __ATOMIC_RELEASE)
+#    elif CANARD_SINGLE_THREADED
+#        define CANARD_ATOMIC_STORE(x, value) ((void) (*(x) = (value)))
+#    else
+#        error "Define CANARD_ATOMIC_STORE, or define CANARD_SINGLE_THREADED=1 if atomics are not needed"
+#    endif
+#endif
+#ifndef CANARD_ATOMIC_COMPARE_EXCHANGE
+#    if defined(__GNUC__)
+#        define CANARD_ATOMIC_COMPARE_EXCHANGE(x, expected, desired) \
+            __atomic_compare_exchange_n((x), (expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#    elif CANARD_SINGLE_THREADED
+#        define CANARD_ATOMIC_COMPARE_EXCHANGE(x, expected, desired) \
+            ((*(x) == *(expected)) ? ((*(x) = (desired)), true) : ((*(expected) = *(x)), false))
+#    else
+#        error "Define CANARD_ATOMIC_COMPARE_EXCHANGE, or define CANARD_SINGLE_THREADED=1 if atomics are not needed"
+#    endif
+#endif
+
+/// Define CANARD_RX_COMPACT_SESSION=1 to reduce the size of the RX session state from 40 to 24 bytes on 64-bit
+/// platforms and from 32 to 20 bytes on 32-bit platforms. The payload sizes are then stored as 32-bit integers,
+/// so the extent of a subscription is effectively limited to UINT32_MAX bytes, and only the lower 32 bits of the
+/// transfer timestamp are stored, the full value being reconstructed relative to the timestamp of the current frame.
+/// The latter limits the time interval that can be measured correctly to about 35 minutes; a session that is left
+/// idle for longer may mistake a new transfer for a duplicate of the last one, unless its transfer-ID timeout is
+/// shorter than that and a timer wheel is used to destroy the expired sessions (see canardRxSetTimerWheel()).
+#ifndef CANARD_RX_COMPACT_SESSION
+#    define CANARD_RX_COMPACT_SESSION 0
+#endif
+
 /// This macro is needed for testing and for library development.
 #ifndef CANARD_PRIVATE
 #    define CANARD_PRIVATE static inline
@@ -66,12 +148,33 @@
 
 #define INITIAL_TOGGLE_STATE true
 
+#define TX_SEQUENCE_HALF_RANGE (UINT32_C(1) << 31U)
+
+#define TX_BITMAP_DEPTH 6U
+#define TX_BITMAP_BITS_PER_LEVEL 5U
+#define TX_BITMAP_INDEX_MASK (CANARD_TX_BITMAP_FANOUT - 1U)
+
 /// Used for inserting new items into AVL trees.
 CANARD_PRIVATE CanardTreeNode* avlTrivialFactory(void* const user_reference)
 {
     return (CanardTreeNode*) user_reference;
 }
 
+/// Returns the index of the least significant bit that is set. The argument shall not be zero.
+CANARD_PRIVATE uint_fast8_t countTrailingZeros32(const uint32_t x)
+{
+    CANARD_ASSERT(x != 0U);
+#ifdef CANARD_CTZ32
+    return (uint_fast8_t) CANARD_CTZ32(x);
+#else
+    static const uint8_t DeBruijnTable[32] = {0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U, 30U, 22U, 20U,
+                                              15U, 25U, 17U, 4U,  8U,  31U, 27U, 13U, 23U, 21U, 19U,
+                                              16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U};
+    // Isolate the lowest set bit; the product with the de Bruijn constant has a unique bit pattern in its top 5 bits.
+    return DeBruijnTable[((uint32_t) ((x & (0U - x)) * UINT32_C(0x077CB531))) >> 27U];
+#endif
+}
+
 // --------------------------------------------- TRANSFER CRC ---------------------------------------------
 
 typedef uint16_t TransferCRC;
@@ -154,6 +257,23 @@ typedef struct TxItem
     uint8_t           payload_buffer[CANARD_MTU_MAX];
 } TxItem;
 
+/// Links a frame into the deadline index of its queue; see canardTxSetDeadlineIndex().
+/// It is placed in the same memory fragment as the frame, after the payload, only if the index is enabled.
+typedef struct TxDeadlineNode
+{
+    CanardTreeNode     base;
+    CanardTxQueueItem* item;
+} TxDeadlineNode;
+
+/// Used to compute the alignment of TxDeadlineNode in C99, which lacks _Alignof.
+typedef struct
+{
+    uint8_t        offset;
+    TxDeadlineNode node;
+} TxDeadlineNodeAlignment;
+
+#define TX_DEADLINE_NODE_ALIGNMENT offsetof(TxDeadlineNodeAlignment, node)
+
 /// Chain of TX frames prepared for insertion into a TX queue.
 typedef struct
 {
@@ -291,21 +411,41 @@ CANARD_PRIVATE size_t txRoundFramePayloadSizeUp(const size_t x)
     return CanardCANDLCToLength[y];
 }
 
+/// Returns the offset of the deadline node from the beginning of the item; the node follows the payload.
+CANARD_PRIVATE size_t txGetDeadlineNodeOffset(const size_t payload_size)
+{
+    const size_t end = (sizeof(TxItem) - CANARD_MTU_MAX) + payload_size;
+    return ((end + TX_DEADLINE_NODE_ALIGNMENT - 1U) / TX_DEADLINE_NODE_ALIGNMENT) * TX_DEADLINE_NODE_ALIGNMENT;
+}
+
+/// Locates the deadline node of the item. The item shall be allocated for a queue with the deadline index enabled.
+CANARD_PRIVATE TxDeadlineNode* txGetDeadlineNode(CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT(item != NULL);
+    // Intentional violation of MISRA: pointer arithmetics is required to locate the node. Unavoidable.
+    uint8_t* const ptr = ((uint8_t*) (void*) item) + txGetDeadlineNodeOffset(item->frame.payload_size);  // NOSONAR
+    return (TxDeadlineNode*) (void*) ptr;
+}
+
 /// The item is only allocated and initialized, but NOT included into the queue! The caller needs to do that.
+/// If the deadline index is enabled, the memory fragment is extended to accommodate the deadline node.
 CANARD_PRIVATE TxItem* txAllocateQueueItem(CanardInstance* const   ins,
+                                           const bool              deadline_index,
                                            const uint32_t          id,
                                            const CanardMicrosecond deadline_usec,
                                            const size_t            payload_size)
 {
     CANARD_ASSERT(ins != NULL);
     CANARD_ASSERT(payload_size > 0U);
-    TxItem* const out = (TxItem*) ins->memory_allocate(ins, (sizeof(TxItem) - CANARD_MTU_MAX) + payload_size);
+    const size_t  size = deadline_index ? (txGetDeadlineNodeOffset(payload_size) + sizeof(TxDeadlineNode))
+                                        : ((sizeof(TxItem) - CANARD_MTU_MAX) + payload_size);
+    TxItem* const out  = (TxItem*) ins->memory_allocate(ins, size);
     if (out != NULL)
     {
-        out->base.base.up    = NULL;
-        out->base.base.lr[0] = NULL;
-        out->base.base.lr[1] = NULL;
-        out->base.base.bf    = 0;
+        out->base.base.node.up    = NULL;
+        out->base.base.node.lr[0] = NULL;
+        out->base.base.node.lr[1] = NULL;
+        out->base.base.node.bf    = 0;
 
         out->base.next_in_transfer = NULL;  // Last by default.
         out->base.tx_deadline_usec = deadline_usec;
@@ -329,6 +469,353 @@ CANARD_PRIVATE int8_t txAVLPredicate(void* const user_reference,  // NOSONAR Cav
     return (target->frame.extended_can_id >= other->frame.extended_can_id) ? +1 : -1;
 }
 
+/// Orders the items by the transmission deadline; the items with identical deadlines are kept in the FIFO order.
+CANARD_PRIVATE int8_t
+txAVLDeadlinePredicate(void* const user_reference,  // NOSONAR Cavl API requires pointer to non-const.
+                       const CanardTreeNode* const node)
+{
+    const TxDeadlineNode* const target = (const TxDeadlineNode*) user_reference;
+    const TxDeadlineNode* const other  = (const TxDeadlineNode*) (const void*) node;
+    CANARD_ASSERT((target != NULL) && (other != NULL));
+    return (target->item->tx_deadline_usec >= other->item->tx_deadline_usec) ? +1 : -1;
+}
+
+/// This is the heap counterpart of txAVLPredicate(): returns true if the frame "a" shall be transmitted before "b".
+/// Frames with identical CAN ID are ordered by their sequence numbers, which are compared using the serial number
+/// arithmetic to tolerate the wraparound. This is valid as long as fewer than 2**31 frames are enqueued while any
+/// given frame remains in the queue, which is guaranteed by any practical queue capacity.
+CANARD_PRIVATE bool txHeapIsBefore(const CanardTxQueueItem* const a, const CanardTxQueueItem* const b)
+{
+    CANARD_ASSERT((a != NULL) && (b != NULL));
+    bool out = a->frame.extended_can_id < b->frame.extended_can_id;
+    if (a->frame.extended_can_id == b->frame.extended_can_id)
+    {
+        out = (((uint32_t) (a->base.heap.sequence - b->base.heap.sequence)) & TX_SEQUENCE_HALF_RANGE) != 0U;
+    }
+    return out;
+}
+
+CANARD_PRIVATE void txHeapPlace(CanardTxQueue* const que, CanardTxQueueItem* const item, const size_t index)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL));
+    CANARD_ASSERT(index < que->heap_length);
+    que->heap[index] = item;
+    item->base.heap.index = index;
+}
+
+/// Moves the item at the specified index towards the root until the heap property is restored.
+/// Returns the new index of the item.
+CANARD_PRIVATE size_t txHeapSiftUp(CanardTxQueue* const que, const size_t index)
+{
+    CANARD_ASSERT((que != NULL) && (index < que->size));
+    CanardTxQueueItem* const item = que->heap[index];
+    size_t                   i    = index;
+    while ((i > 0U) && txHeapIsBefore(item, que->heap[(i - 1U) / 2U]))
+    {
+        const size_t parent = (i - 1U) / 2U;
+        txHeapPlace(que, que->heap[parent], i);
+        i = parent;
+    }
+    txHeapPlace(que, item, i);
+    return i;
+}
+
+/// Moves the item at the specified index towards the leaves until the heap property is restored.
+CANARD_PRIVATE void txHeapSiftDown(CanardTxQueue* const que, const size_t index)
+{
+    CANARD_ASSERT((que != NULL) && (index < que->size));
+    CanardTxQueueItem* const item = que->heap[index];
+    size_t                   i    = index;
+    bool                     done = false;
+    while (!done)
+    {
+        const size_t left  = (i * 2U) + 1U;
+        const size_t right = left + 1U;
+        size_t       child = left;
+        if ((right < que->size) && txHeapIsBefore(que->heap[right], que->heap[left]))
+        {
+            child = right;
+        }
+        if ((left < que->size) && txHeapIsBefore(que->heap[child], item))
+        {
+            txHeapPlace(que, que->heap[child], i);
+            i = child;
+        }
+        else
+        {
+            done = true;
+        }
+    }
+    txHeapPlace(que, item, i);
+}
+
+/// The CAN ID is split into 5-bit groups, the most significant group (which has only 4 bits) indexes the root.
+/// The least significant group indexes the leaf where the items are stored.
+CANARD_PRIVATE uint_fast8_t txBitmapIndex(const uint32_t can_id, const uint_fast8_t level)
+{
+    CANARD_ASSERT(level < TX_BITMAP_DEPTH);
+    const uint_fast8_t shift = (uint_fast8_t) (((TX_BITMAP_DEPTH - 1U) - level) * TX_BITMAP_BITS_PER_LEVEL);
+    return (uint_fast8_t) ((can_id >> shift) & TX_BITMAP_INDEX_MASK);
+}
+
+/// The free list is threaded through the first child pointer of the unused nodes.
+CANARD_PRIVATE CanardTxBitmapNode* txBitmapNodeTake(CanardTxQueue* const que)
+{
+    CANARD_ASSERT((que != NULL) && (que->bitmap_free != NULL) && (que->bitmap_free_count > 0U));
+    CanardTxBitmapNode* const out = que->bitmap_free;
+    que->bitmap_free              = (CanardTxBitmapNode*) out->children[0];
+    que->bitmap_free_count--;
+    out->mask = 0U;
+    return out;
+}
+
+CANARD_PRIVATE void txBitmapNodeGive(CanardTxQueue* const que, CanardTxBitmapNode* const node)
+{
+    CANARD_ASSERT((que != NULL) && (node != NULL) && (node->mask == 0U));
+    node->children[0] = que->bitmap_free;
+    que->bitmap_free  = node;
+    que->bitmap_free_count++;
+}
+
+/// Returns the number of nodes that have to be taken from the free list in order to insert the specified CAN ID.
+CANARD_PRIVATE size_t txBitmapNodesNeeded(const CanardTxQueue* const que, const uint32_t can_id)
+{
+    CANARD_ASSERT(que != NULL);
+    size_t                    out   = TX_BITMAP_DEPTH;
+    const CanardTxBitmapNode* node  = que->bitmap_root;
+    uint_fast8_t              level = 0U;
+    while (node != NULL)
+    {
+        out--;
+        const uint_fast8_t idx = txBitmapIndex(can_id, level);
+        level++;
+        node = ((level < TX_BITMAP_DEPTH) && ((node->mask & (UINT32_C(1) << idx)) != 0U))
+                   ? (const CanardTxBitmapNode*) node->children[idx]
+                   : NULL;
+    }
+    return out;
+}
+
+/// Items with identical CAN ID are kept in a doubly-linked list where lr[0] points to the previous item and lr[1]
+/// points to the next one. The previous pointer of the head points to the tail to make appending cheap.
+CANARD_PRIVATE void txBitmapInsert(CanardTxQueue* const que, CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL));
+    const uint32_t can_id = item->frame.extended_can_id;
+    CANARD_ASSERT(txBitmapNodesNeeded(que, can_id) <= que->bitmap_free_count);
+    if (NULL == que->bitmap_root)
+    {
+        que->bitmap_root = txBitmapNodeTake(que);
+    }
+    CanardTxBitmapNode* node = que->bitmap_root;
+    for (uint_fast8_t level = 0U; level < (TX_BITMAP_DEPTH - 1U); level++)
+    {
+        const uint_fast8_t idx = txBitmapIndex(can_id, level);
+        if ((node->mask & (UINT32_C(1) << idx)) == 0U)
+        {
+            node->children[idx] = txBitmapNodeTake(que);
+            node->mask |= UINT32_C(1) << idx;
+        }
+        node = (CanardTxBitmapNode*) node->children[idx];
+    }
+    const uint_fast8_t idx = txBitmapIndex(can_id, TX_BITMAP_DEPTH - 1U);
+    item->base.node.lr[1]  = NULL;
+    if ((node->mask & (UINT32_C(1) << idx)) != 0U)
+    {
+        CanardTxQueueItem* const head = (CanardTxQueueItem*) node->children[idx];
+        CanardTreeNode* const    tail = head->base.node.lr[0];
+        tail->lr[1]                   = &item->base.node;
+        item->base.node.lr[0]         = tail;
+        head->base.node.lr[0]         = &item->base.node;
+    }
+    else
+    {
+        node->children[idx] = item;
+        node->mask |= UINT32_C(1) << idx;
+        item->base.node.lr[0] = &item->base.node;
+    }
+}
+
+/// The nodes that become empty after the removal are returned to the free list.
+CANARD_PRIVATE void txBitmapRemove(CanardTxQueue* const que, const CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL) && (que->bitmap_root != NULL));
+    const uint32_t      can_id = item->frame.extended_can_id;
+    CanardTxBitmapNode* path[TX_BITMAP_DEPTH];
+    path[0] = que->bitmap_root;
+    for (uint_fast8_t level = 1U; level < TX_BITMAP_DEPTH; level++)
+    {
+        const uint_fast8_t idx = txBitmapIndex(can_id, (uint_fast8_t) (level - 1U));
+        CANARD_ASSERT((path[level - 1U]->mask & (UINT32_C(1) << idx)) != 0U);
+        path[level] = (CanardTxBitmapNode*) path[level - 1U]->children[idx];
+    }
+    CanardTxBitmapNode* const leaf = path[TX_BITMAP_DEPTH - 1U];
+    const uint_fast8_t        idx  = txBitmapIndex(can_id, TX_BITMAP_DEPTH - 1U);
+    CANARD_ASSERT((leaf->mask & (UINT32_C(1) << idx)) != 0U);
+    CanardTxQueueItem* const head = (CanardTxQueueItem*) leaf->children[idx];
+    CanardTreeNode* const    prev = item->base.node.lr[0];
+    CanardTreeNode* const    next = item->base.node.lr[1];
+    if (head == item)
+    {
+        if (next != NULL)
+        {
+            next->lr[0]         = prev;  // The previous pointer of the head is the tail.
+            leaf->children[idx] = next;
+        }
+        else  // This was the last item with this CAN ID, remove the path and prune the empty nodes.
+        {
+            uint_fast8_t level = TX_BITMAP_DEPTH;
+            bool         done  = false;
+            while (!done)
+            {
+                level--;
+                path[level]->mask &= (uint32_t) ~(UINT32_C(1) << txBitmapIndex(can_id, level));
+                if (path[level]->mask != 0U)
+                {
+                    done = true;
+                }
+                else
+                {
+                    txBitmapNodeGive(que, path[level]);
+                    if (0U == level)
+                    {
+                        que->bitmap_root = NULL;
+                        done             = true;
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        prev->lr[1] = next;
+        if (next != NULL)
+        {
+            next->lr[0] = prev;
+        }
+        else
+        {
+            head->base.node.lr[0] = prev;  // The removed item was the tail.
+        }
+    }
+}
+
+/// The highest-priority item is the head of the list found by following the lowest non-empty child at every level.
+CANARD_PRIVATE const CanardTxQueueItem* txBitmapPeek(const CanardTxQueue* const que)
+{
+    CANARD_ASSERT(que != NULL);
+    const CanardTxQueueItem*  out  = NULL;
+    const CanardTxBitmapNode* node = que->bitmap_root;
+    if (node != NULL)
+    {
+        for (uint_fast8_t level = 0U; level < (TX_BITMAP_DEPTH - 1U); level++)
+        {
+            node = (const CanardTxBitmapNode*) node->children[countTrailingZeros32(node->mask)];
+        }
+        out = (const CanardTxQueueItem*) node->children[countTrailingZeros32(node->mask)];
+    }
+    return out;
+}
+
+/// The heap cannot contain more frames than there are elements in its storage regardless of the configured capacity.
+CANARD_PRIVATE size_t txGetCapacity(const CanardTxQueue* const que)
+{
+    CANARD_ASSERT(que != NULL);
+    size_t out = que->capacity;
+    if ((CanardTxQueueKindHeap == que->kind) && (que->heap_length < out))
+    {
+        out = que->heap_length;
+    }
+    return out;
+}
+
+/// Returns true if the specified number of frames with the specified CAN ID can be added to the queue.
+CANARD_PRIVATE bool txCanAccept(const CanardTxQueue* const que, const uint32_t can_id, const size_t num_frames)
+{
+    CANARD_ASSERT(que != NULL);
+    bool out = (que->size + num_frames) <= txGetCapacity(que);
+    if (out && (CanardTxQueueKindBitmap == que->kind))
+    {
+        // All frames of a transfer share one path. The tree walk is avoided if there are enough nodes for any path.
+        out = (que->bitmap_free_count >= TX_BITMAP_DEPTH) ||
+              (txBitmapNodesNeeded(que, can_id) <= que->bitmap_free_count);
+    }
+    return out;
+}
+
+/// Inserts the item into the queue and increments the size counter. The caller shall check txCanAccept() first.
+CANARD_PRIVATE void txQueueInsert(CanardTxQueue* const que, CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL));
+    CANARD_ASSERT(que->size < txGetCapacity(que));
+    if (CanardTxQueueKindHeap == que->kind)
+    {
+        item->base.heap.sequence = que->sequence;
+        que->sequence++;
+        que->size++;
+        txHeapPlace(que, item, que->size - 1U);
+        (void) txHeapSiftUp(que, que->size - 1U);
+    }
+    else if (CanardTxQueueKindBitmap == que->kind)
+    {
+        txBitmapInsert(que, item);
+        que->size++;
+    }
+    else
+    {
+        const CanardTreeNode* const res =
+            cavlSearch(&que->root, &item->base.node, &txAVLPredicate, &avlTrivialFactory);
+        (void) res;
+        CANARD_ASSERT(res == &item->base.node);
+        CANARD_ASSERT(que->root != NULL);
+        que->size++;
+    }
+    if (que->deadline_index)
+    {
+        TxDeadlineNode* const dn = txGetDeadlineNode(item);
+        dn->item                 = item;
+        const CanardTreeNode* const res =
+            cavlSearch(&que->deadline_root, dn, &txAVLDeadlinePredicate, &avlTrivialFactory);
+        (void) res;
+        CANARD_ASSERT(res == &dn->base);
+    }
+}
+
+/// Removes the item from the queue and decrements the size counter. The item shall be in the queue.
+CANARD_PRIVATE void txQueueRemove(CanardTxQueue* const que, const CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL));
+    CANARD_ASSERT(que->size > 0U);
+    if (CanardTxQueueKindHeap == que->kind)
+    {
+        const size_t index = item->base.heap.index;
+        CANARD_ASSERT((index < que->size) && (que->heap[index] == item));
+        que->size--;
+        if (index < que->size)  // Fill the gap with the last item and restore the heap property.
+        {
+            txHeapPlace(que, que->heap[que->size], index);
+            txHeapSiftDown(que, txHeapSiftUp(que, index));
+        }
+    }
+    else if (CanardTxQueueKindBitmap == que->kind)
+    {
+        txBitmapRemove(que, item);
+        que->size--;
+    }
+    else
+    {
+        // Note that the highest-priority frame is always a leaf node in the AVL tree, which means that it is very
+        // cheap to remove.
+        cavlRemove(&que->root, &item->base.node);
+        que->size--;
+    }
+    if (que->deadline_index)
+    {
+        // Intentional violation of MISRA: casting away const qualifier. The item is mutable per canardTxPop().
+        cavlRemove(&que->deadline_root, &txGetDeadlineNode((CanardTxQueueItem*) item)->base);  // NOSONAR
+    }
+}
+
 /// Returns the number of frames enqueued or error (i.e., =1 or <0).
 CANARD_PRIVATE int32_t txPushSingleFrame(CanardTxQueue* const    que,
                                          CanardInstance* const   ins,
@@ -345,8 +832,9 @@ CANARD_PRIVATE int32_t txPushSingleFrame(CanardTxQueue* const    que,
     const size_t padding_size = frame_payload_size - payload_size - 1U;
     CANARD_ASSERT((padding_size + payload_size + 1U) == frame_payload_size);
     int32_t       out = 0;
-    TxItem* const tqi =
-        (que->size < que->capacity) ? txAllocateQueueItem(ins, can_id, deadline_usec, frame_payload_size) : NULL;
+    TxItem* const tqi = txCanAccept(que, can_id, 1U)
+                            ? txAllocateQueueItem(ins, que->deadline_index, can_id, deadline_usec, frame_payload_size)
+                            : NULL;
     if (tqi != NULL)
     {
         if (payload_size > 0U)  // The check is needed to avoid calling memcpy() with a NULL pointer, it's an UB.
@@ -361,11 +849,8 @@ CANARD_PRIVATE int32_t txPushSingleFrame(CanardTxQueue* const    que,
         (void) memset(&tqi->payload_buffer[payload_size], PADDING_BYTE_VALUE, padding_size);  // NOLINT
         tqi->payload_buffer[frame_payload_size - 1U] = txMakeTailByte(true, true, true, transfer_id);
         // Insert the newly created TX item into the queue.
-        const CanardTreeNode* const res = cavlSearch(&que->root, &tqi->base.base, &txAVLPredicate, &avlTrivialFactory);
-        (void) res;
-        CANARD_ASSERT(res == &tqi->base.base);
-        que->size++;
-        CANARD_ASSERT(que->size <= que->capacity);
+        txQueueInsert(que, &tqi->base);
+        CANARD_ASSERT(que->size <= txGetCapacity(que));
         out = 1;  // One frame enqueued.
     }
     else
@@ -378,6 +863,7 @@ CANARD_PRIVATE int32_t txPushSingleFrame(CanardTxQueue* const    que,
 
 /// Produces a chain of Tx queue items for later insertion into the Tx queue. The tail is NULL if OOM.
 CANARD_PRIVATE TxChain txGenerateMultiFrameChain(CanardInstance* const   ins,
+                                                 const bool              deadline_index,
                                                  const size_t            presentation_layer_mtu,
                                                  const CanardMicrosecond deadline_usec,
                                                  const uint32_t          can_id,
@@ -403,7 +889,8 @@ CANARD_PRIVATE TxChain txGenerateMultiFrameChain(CanardInstance* const   ins,
             ((payload_size_with_crc - offset) < presentation_layer_mtu)
                 ? txRoundFramePayloadSizeUp((payload_size_with_crc - offset) + 1U)  // Padding in the last frame only.
                 : (presentation_layer_mtu + 1U);
-        TxItem* const tqi = txAllocateQueueItem(ins, can_id, deadline_usec, frame_payload_size_with_tail);
+        TxItem* const tqi =
+            txAllocateQueueItem(ins, deadline_index, can_id, deadline_usec, frame_payload_size_with_tail);
         if (NULL == out.head)
         {
             out.head = tqi;
@@ -492,9 +979,10 @@ CANARD_PRIVATE int32_t txPushMultiFrame(CanardTxQueue* const    que,
     const size_t payload_size_with_crc = payload_size + CRC_SIZE_BYTES;
     const size_t num_frames = ((payload_size_with_crc + presentation_layer_mtu) - 1U) / presentation_layer_mtu;
     CANARD_ASSERT(num_frames >= 2);
-    if ((que->size + num_frames) <= que->capacity)  // Bail early if we can see that we won't fit anyway.
+    if (txCanAccept(que, can_id, num_frames))  // Bail early if we can see that we won't fit anyway.
     {
         const TxChain sq = txGenerateMultiFrameChain(ins,
+                                                     que->deadline_index,
                                                      presentation_layer_mtu,
                                                      deadline_usec,
                                                      can_id,
@@ -506,16 +994,11 @@ CANARD_PRIVATE int32_t txPushMultiFrame(CanardTxQueue* const    que,
             CanardTxQueueItem* next = &sq.head->base;
             do
             {
-                const CanardTreeNode* const res =
-                    cavlSearch(&que->root, &next->base, &txAVLPredicate, &avlTrivialFactory);
-                (void) res;
-                CANARD_ASSERT(res == &next->base);
-                CANARD_ASSERT(que->root != NULL);
+                txQueueInsert(que, next);
                 next = next->next_in_transfer;
             } while (next != NULL);
             CANARD_ASSERT(num_frames == sq.size);
-            que->size += sq.size;
-            CANARD_ASSERT(que->size <= que->capacity);
+            CANARD_ASSERT(que->size <= txGetCapacity(que));
             CANARD_ASSERT((sq.size + 0ULL) <= INT32_MAX);  // +0 is to suppress warning.
             out = (int32_t) sq.size;
         }
@@ -543,13 +1026,43 @@ CANARD_PRIVATE int32_t txPushMultiFrame(CanardTxQueue* const    que,
 
 #define RX_SESSIONS_PER_SUBSCRIPTION (CANARD_NODE_ID_MAX + 1U)
 
+#define RX_TRANSFER_ID_HALF_RANGE (1U << (CANARD_TRANSFER_ID_BIT_LENGTH - 1U))
+
+#define RX_DUPLICATE_CACHE_EMPTY UINT32_MAX  ///< Not a valid extended CAN ID.
+
+#define RX_TIMER_BITS_PER_LEVEL 5U
+#define RX_TIMER_SLOT_MASK (CANARD_RX_TIMER_WHEEL_SLOTS - 1U)
+#define RX_TIMER_LEVEL_OVERFLOW ((uint8_t) CANARD_RX_TIMER_WHEEL_LEVELS)
+
+#if CANARD_RX_COMPACT_SESSION
+typedef uint32_t RxSessionSize;
+typedef uint32_t RxSessionTimestamp;
+#    define RX_SESSION_SIZE_MAX UINT32_MAX
+#else
+typedef size_t            RxSessionSize;
+typedef CanardMicrosecond RxSessionTimestamp;
+#    define RX_SESSION_SIZE_MAX SIZE_MAX
+#endif
+
 /// The memory requirement model provided in the documentation assumes that the maximum size of this structure never
 /// exceeds 48 bytes on any conventional platform.
 /// A user that needs a detailed analysis of the worst-case memory consumption may compute the size of this structure
 /// for the particular platform at hand manually or by evaluating its sizeof().
 /// The fields are ordered to minimize the amount of padding on all conventional platforms.
+/// The compact layout packs the transfer-ID and the toggle bit into a single byte; see CANARD_RX_COMPACT_SESSION.
 typedef struct CanardInternalRxSession
 {
+#if CANARD_RX_COMPACT_SESSION
+    uint8_t*     payload;                    ///< Dynamically allocated and handed off to the application when done.
+    uint32_t     transfer_timestamp_usec;    ///< The lower 32 bits of the timestamp; see rxSessionGetTimestamp().
+    uint32_t     total_payload_size;         ///< The payload size before the implicit truncation, including the CRC.
+    uint32_t     payload_size;               ///< How many bytes received so far.
+    TransferCRC  calculated_crc;             ///< Updated with the received payload in real time.
+    uint8_t      redundant_transport_index;  ///< Arbitrary value in [0, 255].
+    unsigned int transfer_id : CANARD_TRANSFER_ID_BIT_LENGTH;
+    bool         toggle : 1;
+    bool         adaptive_payload : 1;
+#else
     CanardMicrosecond transfer_timestamp_usec;  ///< Timestamp of the last received start-of-transfer.
     size_t            total_payload_size;       ///< The payload size before the implicit truncation, including the CRC.
     size_t            payload_size;             ///< How many bytes received so far.
@@ -558,8 +1071,35 @@ typedef struct CanardInternalRxSession
     CanardTransferID  transfer_id;
     uint8_t           redundant_transport_index;  ///< Arbitrary value in [0, 255].
     bool              toggle;
+    bool              adaptive_payload;  ///< See rxSessionGrowPayload(). Never changes during the session lifetime.
+#endif
 } CanardInternalRxSession;
 
+/// When a timer wheel is installed, the sessions are allocated with this extended layout.
+/// The session is a member of the singly-linked list of the wheel slot it is placed in; the link points to the pointer
+/// that points to this session (either the head of the slot or the next pointer of the preceding session), which
+/// allows removing the session from the list in constant time.
+typedef struct
+{
+    CanardInternalRxSession base;  ///< Shall be the first member.
+    void*                   next;
+    void**                  link;  ///< NULL if the session is not in the wheel.
+    CanardRxSubscription*   subscription;
+    uint64_t                deadline_tick;  ///< The first tick at which the session is considered timed out.
+    CanardNodeID            source_node_id;
+    uint8_t                 level;  ///< CANARD_RX_TIMER_WHEEL_LEVELS if the session is in the overflow list.
+    uint8_t                 slot;
+} RxTimedSession;
+
+/// The per-source state of a single-frame subscription, which replaces the full session state;
+/// see canardRxSubscribeSingleFrame(). The fields have the same meaning as their counterparts in the full session.
+typedef struct
+{
+    RxSessionTimestamp transfer_timestamp_usec;  ///< Timestamp of the last accepted transfer.
+    CanardTransferID   transfer_id;              ///< The transfer-ID that is expected next.
+    uint8_t            redundant_transport_index;
+} RxSingleFrameSession;
+
 /// High-level transport frame model.
 typedef struct
 {
@@ -671,29 +1211,185 @@ CANARD_PRIVATE uint8_t rxComputeTransferIDDifference(const uint8_t a, const uint
     return (uint8_t) diff;
 }
 
-CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const          ins,
-                                            CanardInternalRxSession* const rxs,
-                                            const size_t                   extent,
-                                            const size_t                   payload_size,
-                                            const void* const              payload)
+/// The default layout places the payload at the beginning of the memory fragment without any extra space around it.
+CANARD_PRIVATE bool rxPayloadLayoutIsDefault(const CanardRxPayloadLayout* const layout)
+{
+    CANARD_ASSERT(layout != NULL);
+    return (layout->alignment <= 1U) && (layout->headroom == 0U) && (layout->tailroom == 0U);
+}
+
+/// The size of the memory fragment that accommodates a payload buffer of the specified capacity with the layout,
+/// including the worst-case alignment padding. The overflow is prevented by canardRxSetPayloadLayout().
+CANARD_PRIVATE size_t rxPayloadLayoutGetFragmentSize(const CanardRxPayloadLayout* const layout, const size_t capacity)
+{
+    CANARD_ASSERT(layout != NULL);
+    const size_t padding = (layout->alignment > 1U) ? (layout->alignment - 1U) : 0U;
+    return padding + layout->headroom + capacity + layout->tailroom;
+}
+
+/// Returns the offset of the payload within the memory fragment that begins at the origin, which may be NULL.
+CANARD_PRIVATE size_t rxPayloadLayoutGetOffset(const CanardRxPayloadLayout* const layout, const uint8_t* const origin)
+{
+    CANARD_ASSERT(layout != NULL);
+    size_t out = 0U;
+    if (origin != NULL)
+    {
+        out = layout->headroom;
+        if (layout->alignment > 1U)
+        {
+            // Intentional violation of MISRA: the address is inspected to compute the alignment padding. Unavoidable.
+            const uintptr_t address = ((uintptr_t) (const void*) origin) + out;  // NOSONAR
+            out += (size_t) ((0U - address) & (layout->alignment - 1U));
+        }
+    }
+    return out;
+}
+
+/// Allocates a buffer with the specified layout, copies the payload into it, and hands it over to the transfer.
+CANARD_PRIVATE int8_t rxCopyPayload(CanardInstance* const              ins,
+                                    const CanardRxPayloadLayout* const layout,
+                                    const size_t                       payload_size,
+                                    const void* const                  payload,
+                                    CanardRxTransfer* const            out_transfer)
+{
+    CANARD_ASSERT((ins != NULL) && (out_transfer != NULL));
+    CANARD_ASSERT((payload != NULL) || (payload_size == 0U));
+    int8_t         out    = 0;
+    uint8_t* const origin = (uint8_t*) ins->memory_allocate(ins, rxPayloadLayoutGetFragmentSize(layout, payload_size));
+    if (origin != NULL)
+    {
+        out_transfer->payload        = origin;
+        out_transfer->payload_offset = rxPayloadLayoutGetOffset(layout, origin);
+        out_transfer->payload_size   = payload_size;
+        // Intentional violation of MISRA: indexing on a pointer. This is done to avoid pointer arithmetics.
+        // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+        // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+        (void) memcpy(&origin[out_transfer->payload_offset], payload, payload_size);  // NOLINT NOSONAR
+    }
+    else
+    {
+        out = -CANARD_ERROR_OUT_OF_MEMORY;
+    }
+    return out;
+}
+
+/// The compact session layout stores only the lower 32 bits of the timestamp; the full value is reconstructed assuming
+/// that it is less than 2**31 microseconds away from the reference, which shall be the timestamp of the frame that is
+/// currently being processed.
+CANARD_PRIVATE CanardMicrosecond rxSessionExpandTimestamp(const RxSessionTimestamp stored_usec,
+                                                          const CanardMicrosecond  reference_usec)
+{
+#if CANARD_RX_COMPACT_SESSION
+    const uint32_t    behind = (uint32_t) reference_usec - stored_usec;  // Wraps around modulo 2**32.
+    CanardMicrosecond out    = reference_usec + (uint32_t) (0U - behind);
+    if ((behind < (UINT32_C(1) << 31U)) && (behind <= reference_usec))
+    {
+        out = reference_usec - behind;
+    }
+    return out;
+#else
+    (void) reference_usec;
+    return stored_usec;
+#endif
+}
+
+/// Returns the timestamp of the last start-of-transfer frame received by the session.
+/// See rxSessionExpandTimestamp() regarding the reference.
+CANARD_PRIVATE CanardMicrosecond rxSessionGetTimestamp(const CanardInternalRxSession* const rxs,
+                                                       const CanardMicrosecond              reference_usec)
+{
+    CANARD_ASSERT(rxs != NULL);
+    return rxSessionExpandTimestamp(rxs->transfer_timestamp_usec, reference_usec);
+}
+
+/// The capacity of an adaptive payload buffer is the payload size rounded up to the next power of two, limited by the
+/// extent; it is a function of the payload size, so it need not be stored in the session state.
+CANARD_PRIVATE size_t rxSessionGetAdaptiveCapacity(const size_t payload_size, const size_t extent)
+{
+    CANARD_ASSERT((payload_size > 0U) && (payload_size <= extent));
+    size_t x = payload_size - 1U;
+    for (size_t shift = 1U; shift < (sizeof(size_t) * 8U); shift <<= 1U)  // The number of iterations is constant.
+    {
+        x |= x >> shift;
+    }
+    x++;  // Becomes zero if the result is not representable.
+    return ((x >= payload_size) && (x < extent)) ? x : extent;
+}
+
+/// Adaptive payload buffers are used instead of buffers of the full extent if the session was created with the
+/// extent above the rx_adaptive_extent_threshold. If the required amount of data exceeds the capacity of the current
+/// buffer, the data received so far is moved into a new, larger buffer. No buffer is allocated for empty payloads.
+/// On failure, the current buffer is retained; it is released when the session is restarted.
+CANARD_PRIVATE int8_t rxSessionGrowPayload(CanardInstance* const          ins,
+                                           CanardInternalRxSession* const rxs,
+                                           const size_t                   extent,
+                                           const size_t                   required)
+{
+    CANARD_ASSERT((ins != NULL) && (rxs != NULL));
+    CANARD_ASSERT(rxs->adaptive_payload);
+    CANARD_ASSERT((rxs->payload_size <= required) && (required <= extent));
+    CANARD_ASSERT((rxs->payload != NULL) || (rxs->payload_size == 0U));
+    // If the session was restarted without releasing the buffer, the capacity is unknown, so the buffer is replaced.
+    int8_t       out      = 0;
+    const size_t capacity = (rxs->payload_size > 0U) ? rxSessionGetAdaptiveCapacity(rxs->payload_size, extent) : 0U;
+    if (required > capacity)
+    {
+        uint8_t* const buffer = (uint8_t*) ins->memory_allocate(ins, rxSessionGetAdaptiveCapacity(required, extent));
+        if (buffer != NULL)
+        {
+            if (rxs->payload_size > 0U)
+            {
+                (void) memcpy(buffer, rxs->payload, rxs->payload_size);  // NOLINT
+            }
+            ins->memory_free(ins, rxs->payload);  // May be NULL, which is OK.
+            rxs->payload = buffer;
+        }
+        else
+        {
+            out = -CANARD_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    return out;
+}
+
+/// The session payload pointer always points to the beginning of the memory fragment; the location of the data within
+/// the fragment is derived from the layout, which does not change while the session exists.
+CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const              ins,
+                                            CanardInternalRxSession* const     rxs,
+                                            const CanardRxPayloadLayout* const layout,
+                                            const size_t                       subscription_extent,
+                                            const size_t                       payload_size,
+                                            const void* const                  payload)
 {
     CANARD_ASSERT(ins != NULL);
     CANARD_ASSERT(rxs != NULL);
+    CANARD_ASSERT((!rxs->adaptive_payload) || rxPayloadLayoutIsDefault(layout));
     CANARD_ASSERT((payload != NULL) || (payload_size == 0U));
+    // The sizes are limited by the session layout; this is only relevant with CANARD_RX_COMPACT_SESSION.
+    const size_t extent = (subscription_extent < RX_SESSION_SIZE_MAX) ? subscription_extent : RX_SESSION_SIZE_MAX;
     CANARD_ASSERT(rxs->payload_size <= extent);  // This invariant is enforced by the subscription logic.
     CANARD_ASSERT(rxs->payload_size <= rxs->total_payload_size);
 
-    rxs->total_payload_size += payload_size;
+    rxs->total_payload_size = (payload_size < (RX_SESSION_SIZE_MAX - rxs->total_payload_size))
+                                  ? (RxSessionSize) (rxs->total_payload_size + payload_size)
+                                  : RX_SESSION_SIZE_MAX;
 
     // Allocate the payload lazily, as late as possible.
-    if ((NULL == rxs->payload) && (extent > 0U))
+    int8_t out = 0;
+    if (rxs->adaptive_payload)
+    {
+        const size_t available = extent - rxs->payload_size;  // The implicit truncation rule applies here as well.
+        const size_t required  = rxs->payload_size + ((payload_size < available) ? payload_size : available);
+        out                    = rxSessionGrowPayload(ins, rxs, extent, required);
+    }
+    if ((NULL == rxs->payload) && (extent > 0U) && (!rxs->adaptive_payload))
     {
         CANARD_ASSERT(rxs->payload_size == 0);
-        rxs->payload = ins->memory_allocate(ins, extent);
+        rxs->payload = ins->memory_allocate(ins, rxPayloadLayoutGetFragmentSize(layout, extent));
+        out          = (rxs->payload != NULL) ? 0 : -CANARD_ERROR_OUT_OF_MEMORY;
     }
 
-    int8_t out = 0;
-    if (rxs->payload != NULL)
+    if ((out == 0) && (rxs->payload != NULL))
     {
         // Copy the payload into the contiguous buffer. Apply the implicit truncation rule if necessary.
         size_t bytes_to_copy = payload_size;
@@ -710,15 +1406,12 @@ CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const          ins,
         // Intentional violation of MISRA: indexing on a pointer. This is done to avoid pointer arithmetics.
         // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
         // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-        (void) memcpy(&rxs->payload[rxs->payload_size], payload, bytes_to_copy);  // NOLINT NOSONAR
-        rxs->payload_size += bytes_to_copy;
+        uint8_t* const data = &rxs->payload[rxPayloadLayoutGetOffset(layout, rxs->payload)];
+        (void) memcpy(&data[rxs->payload_size], payload, bytes_to_copy);  // NOLINT NOSONAR
+        rxs->payload_size = (RxSessionSize) (rxs->payload_size + bytes_to_copy);
         CANARD_ASSERT(rxs->payload_size <= extent);
     }
-    else
-    {
-        CANARD_ASSERT(rxs->payload_size == 0);
-        out = (extent > 0U) ? -CANARD_ERROR_OUT_OF_MEMORY : 0;
-    }
+    CANARD_ASSERT((out < 0) || (rxs->payload != NULL) || (rxs->payload_size == 0));
     CANARD_ASSERT(out <= 0);
     return out;
 }
@@ -737,11 +1430,12 @@ CANARD_PRIVATE void rxSessionRestart(CanardInstance* const ins, CanardInternalRx
     rxs->toggle = INITIAL_TOGGLE_STATE;
 }
 
-CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
-                                           CanardInternalRxSession* const rxs,
-                                           const RxFrameModel* const      frame,
-                                           const size_t                   extent,
-                                           CanardRxTransfer* const        out_transfer)
+CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const              ins,
+                                           CanardInternalRxSession* const     rxs,
+                                           const RxFrameModel* const          frame,
+                                           const CanardRxPayloadLayout* const layout,
+                                           const size_t                       extent,
+                                           CanardRxTransfer* const            out_transfer)
 {
     CANARD_ASSERT(ins != NULL);
     CANARD_ASSERT(rxs != NULL);
@@ -752,7 +1446,7 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
 
     if (frame->start_of_transfer)  // The transfer timestamp is the timestamp of its first frame.
     {
-        rxs->transfer_timestamp_usec = frame->timestamp_usec;
+        rxs->transfer_timestamp_usec = (RxSessionTimestamp) frame->timestamp_usec;
     }
 
     const bool single_frame = frame->start_of_transfer && frame->end_of_transfer;
@@ -763,7 +1457,7 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
         rxs->calculated_crc = crcAdd(rxs->calculated_crc, frame->payload_size, frame->payload);
     }
 
-    int8_t out = rxSessionWritePayload(ins, rxs, extent, frame->payload_size, frame->payload);
+    int8_t out = rxSessionWritePayload(ins, rxs, layout, extent, frame->payload_size, frame->payload);
     if (out < 0)
     {
         CANARD_ASSERT(-CANARD_ERROR_OUT_OF_MEMORY == out);
@@ -776,9 +1470,10 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
         {
             out = 1;  // One transfer received, notify the application.
             rxInitTransferMetadataFromFrame(frame, &out_transfer->metadata);
-            out_transfer->timestamp_usec = rxs->transfer_timestamp_usec;
+            out_transfer->timestamp_usec = rxSessionGetTimestamp(rxs, frame->timestamp_usec);
             out_transfer->payload_size   = rxs->payload_size;
             out_transfer->payload        = rxs->payload;
+            out_transfer->payload_offset = rxPayloadLayoutGetOffset(layout, rxs->payload);
 
             // Cut off the CRC from the payload if it's there -- we don't want to expose it to the user.
             CANARD_ASSERT(rxs->total_payload_size >= rxs->payload_size);
@@ -800,6 +1495,80 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
     return out;
 }
 
+/// A session fails over to another redundant transport as soon as the latter delivers the first frame of a transfer
+/// that is newer than the last one received, provided that the current transport has not started a transfer for
+/// longer than the fail-over timeout. The transfer-ID check prevents the stale duplicates that arrive late via the
+/// other transport from being accepted again after the switch; a transfer that is still in progress on the current
+/// transport is not restarted, the session fails over with the next one.
+CANARD_PRIVATE bool rxSessionNeedsFailOver(const CanardMicrosecond   transfer_timestamp_usec,
+                                           const CanardTransferID    next_transfer_id,
+                                           const bool                in_progress,
+                                           const uint8_t             current_transport_index,
+                                           const RxFrameModel* const frame,
+                                           const uint8_t             redundant_transport_index,
+                                           const CanardMicrosecond   failover_timeout_usec)
+{
+    CANARD_ASSERT(frame != NULL);
+    const bool silent = (frame->timestamp_usec > transfer_timestamp_usec) &&
+                        ((frame->timestamp_usec - transfer_timestamp_usec) > failover_timeout_usec);
+
+    const uint8_t diff  = rxComputeTransferIDDifference(frame->transfer_id, next_transfer_id);
+    const bool    newer = (diff < RX_TRANSFER_ID_HALF_RANGE) && ((!in_progress) || (diff > 0U));
+
+    return frame->start_of_transfer && (current_transport_index != redundant_transport_index) && silent && newer;
+}
+
+/// In the first-arrival-wins mode, the first frame of a transfer that arrives via another redundant transport takes
+/// over the session if the transfer is newer than the one that is being received or, if none, was received last.
+/// The session transfer-ID is that of the transfer being received, or the next expected one if there is none.
+CANARD_PRIVATE bool rxSessionIsFirstArrival(const CanardTransferID    session_transfer_id,
+                                            const bool                in_progress,
+                                            const uint8_t             current_transport_index,
+                                            const RxFrameModel* const frame,
+                                            const uint8_t             redundant_transport_index)
+{
+    CANARD_ASSERT(frame != NULL);
+    const uint8_t diff = rxComputeTransferIDDifference(frame->transfer_id, session_transfer_id);
+    return frame->start_of_transfer && (current_transport_index != redundant_transport_index) &&
+           (diff < RX_TRANSFER_ID_HALF_RANGE) && ((!in_progress) || (diff > 0U));
+}
+
+CANARD_PRIVATE CanardRxTransportStats* rxGetTransportStats(const CanardRxSubscription* const subscription,
+                                                           const uint8_t                     redundant_transport_index)
+{
+    CANARD_ASSERT(subscription != NULL);
+    const bool known = (subscription->transport_stats != NULL) &&
+                       (redundant_transport_index < subscription->transport_stats_count);
+    return known ? &subscription->transport_stats[redundant_transport_index] : NULL;
+}
+
+/// The first frame that arrives via another redundant transport after the same transfer has been started via
+/// the current one is a loss of the former transport; the delay is measured from the first frame of the winner.
+CANARD_PRIVATE void rxTransportStatsCountLoss(CanardRxTransportStats* const stats,
+                                              const CanardMicrosecond       transfer_timestamp_usec,
+                                              const CanardTransferID        session_transfer_id,
+                                              const bool                    in_progress,
+                                              const uint8_t                 current_transport_index,
+                                              const RxFrameModel* const     frame,
+                                              const uint8_t                 redundant_transport_index)
+{
+    CANARD_ASSERT(frame != NULL);
+    // The session transfer-ID is one ahead of the last started transfer unless the latter is still in progress.
+    const uint8_t distance = (uint8_t) (in_progress ? 0U : 1U);
+    if ((stats != NULL) && frame->start_of_transfer && (current_transport_index != redundant_transport_index) &&
+        (rxComputeTransferIDDifference(session_transfer_id, frame->transfer_id) == distance))
+    {
+        const CanardMicrosecond delay_usec =
+            (frame->timestamp_usec > transfer_timestamp_usec) ? (frame->timestamp_usec - transfer_timestamp_usec) : 0U;
+        stats->losses++;
+        stats->loss_delay_usec_total += delay_usec;
+        if (delay_usec > stats->loss_delay_usec_max)
+        {
+            stats->loss_delay_usec_max = delay_usec;
+        }
+    }
+}
+
 /// RX session state machine update is the most intricate part of any Cyphal transport implementation.
 /// The state model used here is derived from the reference pseudocode given in the original UAVCAN v0 specification.
 /// The Cyphal/CAN v1 specification, which this library is an implementation of, does not provide any reference
@@ -807,40 +1576,77 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
 /// are given and the particular algorithms are left to be implementation-defined. Such abstract approach is much
 /// advantageous because it allows implementers to choose whatever solution works best for the specific application at
 /// hand, while the wire compatibility is still guaranteed by the high-level requirements given in the specification.
-CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const          ins,
-                                      CanardInternalRxSession* const rxs,
-                                      const RxFrameModel* const      frame,
-                                      const uint8_t                  redundant_transport_index,
-                                      const CanardMicrosecond        transfer_id_timeout_usec,
-                                      const size_t                   extent,
-                                      CanardRxTransfer* const        out_transfer)
+CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const             ins,
+                                      CanardInternalRxSession* const    rxs,
+                                      const CanardRxSubscription* const subscription,
+                                      const RxFrameModel* const         frame,
+                                      const uint8_t                     redundant_transport_index,
+                                      CanardRxTransfer* const           out_transfer,
+                                      bool* const                       out_accepted)
 {
     CANARD_ASSERT(ins != NULL);
     CANARD_ASSERT(rxs != NULL);
+    CANARD_ASSERT(subscription != NULL);
     CANARD_ASSERT(frame != NULL);
     CANARD_ASSERT(out_transfer != NULL);
+    CANARD_ASSERT(out_accepted != NULL);
     CANARD_ASSERT(rxs->transfer_id <= CANARD_TRANSFER_ID_MAX);
     CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
 
-    const bool tid_timed_out = (frame->timestamp_usec > rxs->transfer_timestamp_usec) &&
-                               ((frame->timestamp_usec - rxs->transfer_timestamp_usec) > transfer_id_timeout_usec);
+    CanardRxTransportStats* const stats = rxGetTransportStats(subscription, redundant_transport_index);
+
+    const CanardMicrosecond transfer_timestamp_usec = rxSessionGetTimestamp(rxs, frame->timestamp_usec);
+
+    const bool tid_timed_out =
+        (frame->timestamp_usec > transfer_timestamp_usec) &&
+        ((frame->timestamp_usec - transfer_timestamp_usec) > subscription->transfer_id_timeout_usec);
 
     const bool not_previous_tid = rxComputeTransferIDDifference(rxs->transfer_id, frame->transfer_id) > 1;
 
-    const bool need_restart = tid_timed_out || ((rxs->redundant_transport_index == redundant_transport_index) &&
-                                                frame->start_of_transfer && not_previous_tid);
+    // The non-last frames are never empty, so the first frame of a multi-frame transfer always adds some payload.
+    const bool in_progress = (rxs->total_payload_size > 0U);
+
+    const bool failover = rxSessionNeedsFailOver(transfer_timestamp_usec,
+                                                 rxs->transfer_id,
+                                                 in_progress,
+                                                 rxs->redundant_transport_index,
+                                                 frame,
+                                                 redundant_transport_index,
+                                                 subscription->failover_timeout_usec);
+
+    const bool first_arrival = subscription->first_arrival_wins &&
+                               rxSessionIsFirstArrival(rxs->transfer_id,
+                                                       in_progress,
+                                                       rxs->redundant_transport_index,
+                                                       frame,
+                                                       redundant_transport_index);
+
+    const bool need_restart = tid_timed_out || failover || first_arrival ||
+                              ((rxs->redundant_transport_index == redundant_transport_index) &&
+                               frame->start_of_transfer && not_previous_tid);
 
     if (need_restart)
     {
         rxs->total_payload_size        = 0U;
         rxs->payload_size              = 0U;
         rxs->calculated_crc            = CRC_INITIAL;
-        rxs->transfer_id               = frame->transfer_id;
+        rxs->transfer_id               = (CanardTransferID) (frame->transfer_id & CANARD_TRANSFER_ID_MAX);
         rxs->toggle                    = INITIAL_TOGGLE_STATE;
         rxs->redundant_transport_index = redundant_transport_index;
     }
+    else
+    {
+        rxTransportStatsCountLoss(stats,
+                                  transfer_timestamp_usec,
+                                  rxs->transfer_id,
+                                  in_progress,
+                                  rxs->redundant_transport_index,
+                                  frame,
+                                  redundant_transport_index);
+    }
 
-    int8_t out = 0;
+    int8_t out    = 0;
+    *out_accepted = false;
     if (need_restart && (!frame->start_of_transfer))
     {
         rxSessionRestart(ins, rxs);  // SOT-miss, no point going further.
@@ -852,17 +1658,371 @@ CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const          ins,
         const bool correct_tid       = (frame->transfer_id == rxs->transfer_id);
         if (correct_transport && correct_toggle && correct_tid)
         {
-            out = rxSessionAcceptFrame(ins, rxs, frame, extent, out_transfer);
+            *out_accepted = true;
+            if ((stats != NULL) && frame->start_of_transfer)
+            {
+                stats->wins++;
+            }
+            out = rxSessionAcceptFrame(ins,
+                                       rxs,
+                                       frame,
+                                       &subscription->payload_layout,
+                                       subscription->extent,
+                                       out_transfer);
+        }
+    }
+    return out;
+}
+
+/// The tick is the first one that begins strictly after the deadline, which matches the transfer-ID timeout check in
+/// rxSessionUpdate(): a session whose deadline equals the current time is not yet timed out.
+/// The current time is needed to reconstruct the transfer timestamp; see rxSessionGetTimestamp().
+CANARD_PRIVATE uint64_t rxTimerGetDeadlineTick(const CanardRxTimerWheel* const wheel,
+                                               const RxTimedSession* const     rxs,
+                                               const CanardMicrosecond         now_usec)
+{
+    CANARD_ASSERT((wheel != NULL) && (wheel->tick_usec > 0U) && (rxs != NULL) && (rxs->subscription != NULL));
+    const CanardMicrosecond timeout       = rxs->subscription->transfer_id_timeout_usec;
+    const CanardMicrosecond start         = rxSessionGetTimestamp(&rxs->base, now_usec);
+    const CanardMicrosecond deadline_usec = (start > (UINT64_MAX - timeout)) ? UINT64_MAX : (start + timeout);
+    const uint64_t          out           = deadline_usec / wheel->tick_usec;
+    return (out < UINT64_MAX) ? (out + 1U) : out;
+}
+
+CANARD_PRIVATE void rxTimerLink(CanardRxTimerWheel* const wheel,
+                                RxTimedSession* const     rxs,
+                                const uint8_t             level,
+                                const uint8_t             slot)
+{
+    CANARD_ASSERT((wheel != NULL) && (rxs != NULL) && (rxs->link == NULL));
+    CANARD_ASSERT((level <= RX_TIMER_LEVEL_OVERFLOW) && (slot < CANARD_RX_TIMER_WHEEL_SLOTS));
+    void** const head = (level < RX_TIMER_LEVEL_OVERFLOW) ? &wheel->slots[level][slot] : &wheel->overflow;
+    rxs->level        = level;
+    rxs->slot         = slot;
+    rxs->next         = *head;
+    rxs->link         = head;
+    if (rxs->next != NULL)
+    {
+        ((RxTimedSession*) rxs->next)->link = &rxs->next;
+    }
+    *head = rxs;
+    if (level < RX_TIMER_LEVEL_OVERFLOW)
+    {
+        wheel->occupancy[level] |= UINT32_C(1) << slot;
+    }
+}
+
+CANARD_PRIVATE void rxTimerUnlink(CanardRxTimerWheel* const wheel, RxTimedSession* const rxs)
+{
+    CANARD_ASSERT((wheel != NULL) && (rxs != NULL));
+    if (rxs->link != NULL)
+    {
+        *rxs->link = rxs->next;
+        if (rxs->next != NULL)
+        {
+            ((RxTimedSession*) rxs->next)->link = rxs->link;
+        }
+        if ((rxs->level < RX_TIMER_LEVEL_OVERFLOW) && (NULL == wheel->slots[rxs->level][rxs->slot]))
+        {
+            wheel->occupancy[rxs->level] &= (uint32_t) ~(UINT32_C(1) << rxs->slot);
+        }
+        rxs->next = NULL;
+        rxs->link = NULL;
+    }
+}
+
+/// The session is placed on the level that corresponds to the most significant group of bits where its deadline differs
+/// from the current time, into the slot indexed by the deadline bits of that group. Hence, every occupied slot on a
+/// level lies after the slot of the current time on that level, and the session is moved to a lower level (or expires)
+/// exactly when the current time reaches the beginning of its slot.
+/// Returns false if the deadline is not in the future, in which case the session is not placed.
+CANARD_PRIVATE bool rxTimerPlace(CanardRxTimerWheel* const wheel, RxTimedSession* const rxs)
+{
+    CANARD_ASSERT((wheel != NULL) && (rxs != NULL) && (rxs->link == NULL));
+    const bool out = rxs->deadline_tick > wheel->current_tick;
+    if (out)
+    {
+        const uint64_t diff  = rxs->deadline_tick ^ wheel->current_tick;
+        uint8_t        level = 0U;
+        while ((level < RX_TIMER_LEVEL_OVERFLOW) && ((diff >> (RX_TIMER_BITS_PER_LEVEL * (level + 1U))) != 0U))
+        {
+            level++;
+        }
+        uint8_t slot = 0U;
+        if (level < RX_TIMER_LEVEL_OVERFLOW)
+        {
+            slot = (uint8_t) ((rxs->deadline_tick >> (RX_TIMER_BITS_PER_LEVEL * level)) & RX_TIMER_SLOT_MASK);
+        }
+        else if ((NULL == wheel->overflow) || (rxs->deadline_tick < wheel->overflow_tick))
+        {
+            wheel->overflow_tick = rxs->deadline_tick;  // Not updated on removal, so it may become too early; harmless.
+        }
+        else
+        {
+            // The earliest deadline in the overflow list is unchanged.
+        }
+        rxTimerLink(wheel, rxs, level, slot);
+    }
+    return out;
+}
+
+/// Invoked after every update of the session; it is only moved in the wheel if its deadline has changed.
+/// A session whose deadline has already passed is placed at the next tick, so the next canardRxExpire() destroys it.
+CANARD_PRIVATE void rxTimerSchedule(CanardRxTimerWheel* const wheel,
+                                    RxTimedSession* const     rxs,
+                                    const CanardMicrosecond   now_usec)
+{
+    CANARD_ASSERT((wheel != NULL) && (rxs != NULL));
+    const uint64_t deadline_tick = rxTimerGetDeadlineTick(wheel, rxs, now_usec);
+    if ((deadline_tick != rxs->deadline_tick) || (NULL == rxs->link))
+    {
+        rxTimerUnlink(wheel, rxs);
+        rxs->deadline_tick = deadline_tick;
+        if (!rxTimerPlace(wheel, rxs))
+        {
+            rxs->deadline_tick = wheel->current_tick + 1U;
+            (void) rxTimerPlace(wheel, rxs);  // Not placed only if the time counter is exhausted, which is harmless.
+        }
+    }
+}
+
+CANARD_PRIVATE void rxTimerDestroySession(CanardInstance* const ins, RxTimedSession* const rxs)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->rx_timer_wheel != NULL) && (rxs != NULL) && (rxs->link == NULL));
+    CANARD_ASSERT(rxs->subscription->sessions[rxs->source_node_id] == &rxs->base);
+    CANARD_ASSERT(ins->rx_timer_wheel->session_count > 0U);
+    rxs->subscription->sessions[rxs->source_node_id] = NULL;
+    ins->rx_timer_wheel->session_count--;
+    ins->memory_free(ins, rxs->base.payload);  // May be NULL, which is OK.
+    ins->memory_free(ins, rxs);
+}
+
+/// Places the sessions from the detached list anew relative to the current time; those that have expired are destroyed.
+/// Returns the number of destroyed sessions.
+CANARD_PRIVATE int32_t rxTimerReplace(CanardInstance* const ins, void* const list)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->rx_timer_wheel != NULL));
+    int32_t out  = 0;
+    void*   item = list;
+    while (item != NULL)
+    {
+        RxTimedSession* const rxs = (RxTimedSession*) item;
+        item                      = rxs->next;
+        rxs->next                 = NULL;
+        rxs->link                 = NULL;
+        if (!rxTimerPlace(ins->rx_timer_wheel, rxs))
+        {
+            rxTimerDestroySession(ins, rxs);
+            out++;
+        }
+    }
+    return out;
+}
+
+/// Returns the earliest tick not later than the limit at which some slot of the wheel needs to be processed.
+/// The overflow list is not considered here because its handling differs between the callers.
+CANARD_PRIVATE uint64_t rxTimerFindNextTick(const CanardRxTimerWheel* const wheel, const uint64_t limit)
+{
+    CANARD_ASSERT(wheel != NULL);
+    const uint64_t now = wheel->current_tick;
+    uint64_t       out = limit;
+    for (uint_fast8_t level = 0U; level < CANARD_RX_TIMER_WHEEL_LEVELS; level++)
+    {
+        const uint_fast8_t shift   = (uint_fast8_t) (level * RX_TIMER_BITS_PER_LEVEL);
+        const uint32_t     current = (uint32_t) ((now >> shift) & RX_TIMER_SLOT_MASK);
+        const uint32_t     pending = wheel->occupancy[level] & (uint32_t) ~((UINT32_C(2) << current) - 1U);
+        if (pending != 0U)
+        {
+            const uint_fast8_t upper = (uint_fast8_t) (shift + RX_TIMER_BITS_PER_LEVEL);
+            const uint64_t     first = countTrailingZeros32(pending);
+            const uint64_t     tick  = ((now >> upper) << upper) | (first << shift);
+            out                      = (tick < out) ? tick : out;
+        }
+    }
+    return out;
+}
+
+/// Processes the slots that begin at the current tick, from the top level downwards, so that the sessions cascade
+/// into the lower levels. The sessions in the level 0 slot have reached their deadline by construction.
+/// Returns the number of destroyed sessions.
+CANARD_PRIVATE int32_t rxTimerProcessTick(CanardInstance* const ins)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->rx_timer_wheel != NULL));
+    CanardRxTimerWheel* const wheel = ins->rx_timer_wheel;
+    const uint64_t            now   = wheel->current_tick;
+    int32_t                   out   = 0;
+    const uint_fast8_t        top   = (uint_fast8_t) (CANARD_RX_TIMER_WHEEL_LEVELS * RX_TIMER_BITS_PER_LEVEL);
+    if ((now & ((UINT64_C(1) << top) - 1U)) == 0U)
+    {
+        void* const list = wheel->overflow;
+        wheel->overflow  = NULL;
+        out += rxTimerReplace(ins, list);
+    }
+    for (uint_fast8_t level = CANARD_RX_TIMER_WHEEL_LEVELS; level > 0U; level--)
+    {
+        const uint_fast8_t shift = (uint_fast8_t) ((level - 1U) * RX_TIMER_BITS_PER_LEVEL);
+        if ((now & ((UINT64_C(1) << shift) - 1U)) == 0U)
+        {
+            const uint_fast8_t slot        = (uint_fast8_t) ((now >> shift) & RX_TIMER_SLOT_MASK);
+            void* const        list        = wheel->slots[level - 1U][slot];
+            wheel->slots[level - 1U][slot] = NULL;
+            wheel->occupancy[level - 1U] &= (uint32_t) ~(UINT32_C(1) << slot);
+            out += rxTimerReplace(ins, list);
+        }
+    }
+    return out;
+}
+
+/// This is rxSessionUpdate() specialized for single-frame transfers, which operates on the reduced state.
+/// A single-frame transfer always starts a new transfer, so the restart logic is simplified accordingly;
+/// the payload is copied out and the transfer is delivered immediately.
+CANARD_PRIVATE int8_t rxSingleFrameSessionUpdate(CanardInstance* const             ins,
+                                                 RxSingleFrameSession* const       rxs,
+                                                 const CanardRxSubscription* const subscription,
+                                                 const RxFrameModel* const         frame,
+                                                 const uint8_t                     redundant_transport_index,
+                                                 CanardRxTransfer* const           out_transfer,
+                                                 bool* const                       out_accepted)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(rxs != NULL);
+    CANARD_ASSERT(subscription != NULL);
+    CANARD_ASSERT(frame != NULL);
+    CANARD_ASSERT(frame->start_of_transfer && frame->end_of_transfer);
+    CANARD_ASSERT((out_transfer != NULL) && (out_accepted != NULL));
+    CANARD_ASSERT(rxs->transfer_id <= CANARD_TRANSFER_ID_MAX);
+
+    CanardRxTransportStats* const stats = rxGetTransportStats(subscription, redundant_transport_index);
+
+    const CanardMicrosecond transfer_timestamp_usec =
+        rxSessionExpandTimestamp(rxs->transfer_timestamp_usec, frame->timestamp_usec);
+
+    const bool tid_timed_out =
+        (frame->timestamp_usec > transfer_timestamp_usec) &&
+        ((frame->timestamp_usec - transfer_timestamp_usec) > subscription->transfer_id_timeout_usec);
+
+    const bool not_previous_tid = rxComputeTransferIDDifference(rxs->transfer_id, frame->transfer_id) > 1;
+
+    const bool failover = rxSessionNeedsFailOver(transfer_timestamp_usec,
+                                                 rxs->transfer_id,
+                                                 false,
+                                                 rxs->redundant_transport_index,
+                                                 frame,
+                                                 redundant_transport_index,
+                                                 subscription->failover_timeout_usec);
+
+    const bool first_arrival = subscription->first_arrival_wins &&
+                               rxSessionIsFirstArrival(rxs->transfer_id,
+                                                       false,
+                                                       rxs->redundant_transport_index,
+                                                       frame,
+                                                       redundant_transport_index);
+
+    if (tid_timed_out || failover || first_arrival ||
+        ((rxs->redundant_transport_index == redundant_transport_index) && not_previous_tid))
+    {
+        rxs->transfer_id               = frame->transfer_id;
+        rxs->redundant_transport_index = redundant_transport_index;
+    }
+    else
+    {
+        rxTransportStatsCountLoss(stats,
+                                  transfer_timestamp_usec,
+                                  rxs->transfer_id,
+                                  false,
+                                  rxs->redundant_transport_index,
+                                  frame,
+                                  redundant_transport_index);
+    }
+
+    int8_t out    = 0;
+    *out_accepted = (rxs->redundant_transport_index == redundant_transport_index) &&
+                    (frame->transfer_id == rxs->transfer_id);
+    if (*out_accepted)
+    {
+        if (stats != NULL)
+        {
+            stats->wins++;
+        }
+        rxs->transfer_timestamp_usec = (RxSessionTimestamp) frame->timestamp_usec;
+        rxs->transfer_id             = (CanardTransferID) ((rxs->transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+        const size_t extent          = subscription->extent;
+        const size_t payload_size    = (extent < frame->payload_size) ? extent : frame->payload_size;
+        if (payload_size > 0U)
+        {
+            out = rxCopyPayload(ins, &subscription->payload_layout, payload_size, frame->payload, out_transfer);
+        }
+        else
+        {
+            out_transfer->payload_size   = 0U;
+            out_transfer->payload        = NULL;
+            out_transfer->payload_offset = 0U;
+        }
+        if (out == 0)  // Otherwise, the transfer is lost, same as with the full session state.
+        {
+            rxInitTransferMetadataFromFrame(frame, &out_transfer->metadata);
+            out_transfer->timestamp_usec = frame->timestamp_usec;
+            out                          = 1;
+        }
+    }
+    return out;
+}
+
+/// The reduced state is created ad-hoc like the full session state. The frames of multi-frame transfers are dropped.
+CANARD_PRIVATE int8_t rxAcceptSingleFrame(CanardInstance* const       ins,
+                                          CanardRxSubscription* const subscription,
+                                          const RxFrameModel* const   frame,
+                                          const uint8_t               redundant_transport_index,
+                                          CanardRxTransfer* const     out_transfer,
+                                          bool* const                 out_accepted)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(subscription != NULL);
+    CANARD_ASSERT(subscription->single_frame);
+    CANARD_ASSERT(frame != NULL);
+    CANARD_ASSERT(frame->source_node_id <= CANARD_NODE_ID_MAX);
+
+    int8_t out = 0;
+    if (frame->start_of_transfer && frame->end_of_transfer)
+    {
+        // The entries of single-frame subscriptions are never accessed as full session states.
+        RxSingleFrameSession* rxs = (RxSingleFrameSession*) (void*) subscription->sessions[frame->source_node_id];
+        if (NULL == rxs)
+        {
+            rxs = (RxSingleFrameSession*) ins->memory_allocate(ins, sizeof(RxSingleFrameSession));
+            subscription->sessions[frame->source_node_id] = (CanardInternalRxSession*) (void*) rxs;
+            if (rxs != NULL)
+            {
+                rxs->transfer_timestamp_usec   = (RxSessionTimestamp) frame->timestamp_usec;
+                rxs->transfer_id               = frame->transfer_id;
+                rxs->redundant_transport_index = redundant_transport_index;
+            }
+            else
+            {
+                out = -CANARD_ERROR_OUT_OF_MEMORY;
+            }
+        }
+        if (rxs != NULL)
+        {
+            out = rxSingleFrameSessionUpdate(ins,
+                                             rxs,
+                                             subscription,
+                                             frame,
+                                             redundant_transport_index,
+                                             out_transfer,
+                                             out_accepted);
         }
     }
     return out;
 }
 
+/// The frame is accepted if it has been consumed by an RX session; anonymous frames are never accepted in this sense.
 CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
                                     CanardRxSubscription* const subscription,
                                     const RxFrameModel* const   frame,
                                     const uint8_t               redundant_transport_index,
-                                    CanardRxTransfer* const     out_transfer)
+                                    CanardRxTransfer* const     out_transfer,
+                                    bool* const                 out_accepted)
 {
     CANARD_ASSERT(ins != NULL);
     CANARD_ASSERT(subscription != NULL);
@@ -871,28 +2031,51 @@ CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
     CANARD_ASSERT(frame->payload != NULL);
     CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
     CANARD_ASSERT((CANARD_NODE_ID_UNSET == frame->destination_node_id) || (ins->node_id == frame->destination_node_id));
-    CANARD_ASSERT(out_transfer != NULL);
+    CANARD_ASSERT((out_transfer != NULL) && (out_accepted != NULL));
 
-    int8_t out = 0;
-    if (frame->source_node_id <= CANARD_NODE_ID_MAX)
+    int8_t out    = 0;
+    *out_accepted = false;
+    if ((frame->source_node_id <= CANARD_NODE_ID_MAX) && subscription->single_frame)
+    {
+        out = rxAcceptSingleFrame(ins, subscription, frame, redundant_transport_index, out_transfer, out_accepted);
+    }
+    else if (frame->source_node_id <= CANARD_NODE_ID_MAX)
     {
         // If such session does not exist, create it. This only makes sense if this is the first frame of a
         // transfer, otherwise, we won't be able to receive the transfer anyway so we don't bother.
         if ((NULL == subscription->sessions[frame->source_node_id]) && frame->start_of_transfer)
         {
+            const bool adaptive_payload = rxPayloadLayoutIsDefault(&subscription->payload_layout) &&
+                                          (subscription->extent > ins->rx_adaptive_extent_threshold);
+            // The sessions are larger if they need to be tracked by the timer wheel.
+            const size_t session_size =
+                (ins->rx_timer_wheel != NULL) ? sizeof(RxTimedSession) : sizeof(CanardInternalRxSession);
             CanardInternalRxSession* const rxs =
-                (CanardInternalRxSession*) ins->memory_allocate(ins, sizeof(CanardInternalRxSession));
+                (CanardInternalRxSession*) ins->memory_allocate(ins, session_size);
             subscription->sessions[frame->source_node_id] = rxs;
             if (rxs != NULL)
             {
-                rxs->transfer_timestamp_usec   = frame->timestamp_usec;
+                if (ins->rx_timer_wheel != NULL)
+                {
+                    RxTimedSession* const trxs = (RxTimedSession*) (void*) rxs;
+                    trxs->next                 = NULL;
+                    trxs->link                 = NULL;
+                    trxs->subscription         = subscription;
+                    trxs->deadline_tick        = 0U;
+                    trxs->source_node_id       = frame->source_node_id;
+                    trxs->level                = 0U;
+                    trxs->slot                 = 0U;
+                    ins->rx_timer_wheel->session_count++;
+                }
+                rxs->transfer_timestamp_usec   = (RxSessionTimestamp) frame->timestamp_usec;
                 rxs->total_payload_size        = 0U;
                 rxs->payload_size              = 0U;
                 rxs->payload                   = NULL;
                 rxs->calculated_crc            = CRC_INITIAL;
-                rxs->transfer_id               = frame->transfer_id;
+                rxs->transfer_id               = (CanardTransferID) (frame->transfer_id & CANARD_TRANSFER_ID_MAX);
                 rxs->redundant_transport_index = redundant_transport_index;
                 rxs->toggle                    = INITIAL_TOGGLE_STATE;
+                rxs->adaptive_payload          = adaptive_payload;
             }
             else
             {
@@ -905,11 +2088,17 @@ CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
             CANARD_ASSERT(out == 0);
             out = rxSessionUpdate(ins,
                                   subscription->sessions[frame->source_node_id],
+                                  subscription,
                                   frame,
                                   redundant_transport_index,
-                                  subscription->transfer_id_timeout_usec,
-                                  subscription->extent,
-                                  out_transfer);
+                                  out_transfer,
+                                  out_accepted);
+            if (ins->rx_timer_wheel != NULL)
+            {
+                rxTimerSchedule(ins->rx_timer_wheel,
+                                (RxTimedSession*) (void*) subscription->sessions[frame->source_node_id],
+                                frame->timestamp_usec);
+            }
         }
     }
     else
@@ -920,26 +2109,89 @@ CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
         // independent of the input data and the memory shall be free-able.
         const size_t payload_size =
             (subscription->extent < frame->payload_size) ? subscription->extent : frame->payload_size;
-        void* const payload = ins->memory_allocate(ins, payload_size);
-        if (payload != NULL)
+        out = rxCopyPayload(ins, &subscription->payload_layout, payload_size, frame->payload, out_transfer);
+        if (out == 0)
         {
             rxInitTransferMetadataFromFrame(frame, &out_transfer->metadata);
             out_transfer->timestamp_usec = frame->timestamp_usec;
-            out_transfer->payload_size   = payload_size;
-            out_transfer->payload        = payload;
-            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
-            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-            (void) memcpy(payload, frame->payload, payload_size);  // NOLINT
-            out = 1;
+            out                          = 1;
         }
-        else
+    }
+    return out;
+}
+
+/// The slot is selected by a hash of the CAN ID and the tail byte; the frames that hash into the same slot evict
+/// each other, which only reduces the efficiency of the cache but never affects the correctness.
+CANARD_PRIVATE size_t rxDuplicateCacheGetSlot(const uint32_t extended_can_id, const uint8_t tail)
+{
+    uint32_t hash = extended_can_id ^ (((uint32_t) tail) << 21U);
+    hash ^= hash >> 15U;
+    hash *= 0x2C1B3C6DU;
+    hash ^= hash >> 12U;
+    return (size_t) (hash & (CANARD_RX_DUPLICATE_CACHE_SLOTS - 1U));
+}
+
+/// The clocks of the transports may be slightly skewed, so the entries are matched in both directions of time.
+CANARD_PRIVATE bool rxDuplicateCacheIsWithinWindow(const CanardRxDuplicateCache* const cache,
+                                                   const size_t                        slot,
+                                                   const CanardMicrosecond             timestamp_usec)
+{
+    CANARD_ASSERT((cache != NULL) && (slot < CANARD_RX_DUPLICATE_CACHE_SLOTS));
+    const CanardMicrosecond other = cache->timestamps[slot];
+    const CanardMicrosecond age   = (timestamp_usec > other) ? (timestamp_usec - other) : (other - timestamp_usec);
+    return (cache->can_ids[slot] != RX_DUPLICATE_CACHE_EMPTY) && (age <= cache->window_usec);
+}
+
+CANARD_PRIVATE bool rxDuplicateCacheSuppress(CanardRxDuplicateCache* const cache,
+                                             const CanardMicrosecond       timestamp_usec,
+                                             const CanardFrame* const      frame,
+                                             const uint8_t                 redundant_transport_index)
+{
+    CANARD_ASSERT(frame != NULL);
+    bool out = false;
+    if ((cache != NULL) && (frame->payload_size > 0U))
+    {
+        const uint8_t tail = ((const uint8_t*) frame->payload)[frame->payload_size - 1U];
+        const size_t  slot = rxDuplicateCacheGetSlot(frame->extended_can_id, tail);
+        out = (cache->can_ids[slot] == frame->extended_can_id) && (cache->tails[slot] == tail) &&
+              (cache->transports[slot] != redundant_transport_index) &&
+              rxDuplicateCacheIsWithinWindow(cache, slot, timestamp_usec);
+        if (out)
         {
-            out = -CANARD_ERROR_OUT_OF_MEMORY;
+            cache->suppressed_count++;
         }
     }
     return out;
 }
 
+CANARD_PRIVATE void rxDuplicateCacheRemember(CanardRxDuplicateCache* const cache,
+                                             const CanardMicrosecond       timestamp_usec,
+                                             const CanardFrame* const      frame,
+                                             const uint8_t                 redundant_transport_index)
+{
+    CANARD_ASSERT((cache != NULL) && (frame != NULL) && (frame->payload_size > 0U));
+    const uint8_t tail = ((const uint8_t*) frame->payload)[frame->payload_size - 1U];
+    const size_t  slot = rxDuplicateCacheGetSlot(frame->extended_can_id, tail);
+    const bool    same = (cache->can_ids[slot] == frame->extended_can_id) && (cache->tails[slot] == tail);
+    if ((!same) && rxDuplicateCacheIsWithinWindow(cache, slot, timestamp_usec))
+    {
+        cache->evicted_count++;
+    }
+    cache->timestamps[slot] = timestamp_usec;
+    cache->can_ids[slot]    = frame->extended_can_id;
+    cache->tails[slot]      = tail;
+    cache->transports[slot] = redundant_transport_index;
+}
+
+/// The shards are assigned round-robin over the consecutive port-IDs, which are typically allocated in groups,
+/// so that the load is spread evenly; the services are numbered after the subjects.
+CANARD_PRIVATE int8_t rxGetShard(const bool service, const CanardPortID port_id, const uint8_t shard_count)
+{
+    CANARD_ASSERT((shard_count > 0U) && (shard_count <= CANARD_RX_SHARD_COUNT_MAX));
+    const uint32_t key = service ? ((uint32_t) CANARD_SUBJECT_ID_MAX + 1U + port_id) : port_id;
+    return (int8_t) (key % shard_count);
+}
+
 CANARD_PRIVATE int8_t
 rxSubscriptionPredicateOnPortID(void* const user_reference,  // NOSONAR Cavl API requires pointer to non-const.
                                 const CanardTreeNode* const node)
@@ -958,64 +2210,579 @@ rxSubscriptionPredicateOnStruct(void* const user_reference,  // NOSONAR Cavl API
     return rxSubscriptionPredicateOnPortID(&((CanardRxSubscription*) user_reference)->port_id, node);
 }
 
-// --------------------------------------------- PUBLIC API ---------------------------------------------
-
-const uint8_t CanardCANDLCToLength[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
-const uint8_t CanardCANLengthToDLC[65] = {
-    0,  1,  2,  3,  4,  5,  6,  7,  8,                               // 0-8
-    9,  9,  9,  9,                                                   // 9-12
-    10, 10, 10, 10,                                                  // 13-16
-    11, 11, 11, 11,                                                  // 17-20
-    12, 12, 12, 12,                                                  // 21-24
-    13, 13, 13, 13, 13, 13, 13, 13,                                  // 25-32
-    14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,  // 33-48
-    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  // 49-64
-};
-
-CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const CanardMemoryFree memory_free)
+/// Releases the sessions of a subscription that is no longer reachable by canardRxAccept().
+CANARD_PRIVATE void rxSubscriptionReleaseSessions(CanardInstance* const ins, CanardRxSubscription* const sub)
 {
-    CANARD_ASSERT(memory_allocate != NULL);
-    CANARD_ASSERT(memory_free != NULL);
-    const CanardInstance out = {
-        .user_reference   = NULL,
-        .node_id          = CANARD_NODE_ID_UNSET,
-        .memory_allocate  = memory_allocate,
-        .memory_free      = memory_free,
-        .rx_subscriptions = {NULL, NULL, NULL},
-    };
-    return out;
+    CANARD_ASSERT((ins != NULL) && (sub != NULL));
+    for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+    {
+        // The reduced states of single-frame subscriptions are neither tracked by the wheel nor own payloads.
+        const bool full_session = (sub->sessions[i] != NULL) && (!sub->single_frame);
+        if ((ins->rx_timer_wheel != NULL) && full_session)
+        {
+            rxTimerUnlink(ins->rx_timer_wheel, (RxTimedSession*) (void*) sub->sessions[i]);
+            CANARD_ASSERT(ins->rx_timer_wheel->session_count > 0U);
+            ins->rx_timer_wheel->session_count--;
+        }
+        if (full_session)
+        {
+            ins->memory_free(ins, sub->sessions[i]->payload);  // May be NULL, which is OK.
+        }
+        ins->memory_free(ins, sub->sessions[i]);
+        sub->sessions[i] = NULL;
+    }
 }
 
-CanardTxQueue canardTxInit(const size_t capacity, const size_t mtu_bytes)
+CANARD_PRIVATE bool rxIsIdle(const CanardInstance* const ins)
 {
-    CanardTxQueue out = {
-        .capacity       = capacity,
-        .mtu_bytes      = mtu_bytes,
-        .size           = 0,
-        .root           = NULL,
-        .user_reference = NULL,
-    };
-    return out;
+    CANARD_ASSERT(ins != NULL);
+    bool idle = true;
+    for (size_t i = 0; i < CANARD_NUM_TRANSFER_KINDS; i++)
+    {
+        idle = idle && (NULL == ins->rx_subscriptions[i]);
+    }
+    return idle;
 }
 
-int32_t canardTxPush(CanardTxQueue* const                que,
-                     CanardInstance* const               ins,
-                     const CanardMicrosecond             tx_deadline_usec,
-                     const CanardTransferMetadata* const metadata,
-                     const size_t                        payload_size,
-                     const void* const                   payload)
+/// An immutable snapshot of the subscriptions published via CanardRxSubscriptionTable. The subscriptions of each
+/// transfer kind occupy a contiguous range of the array ordered by port-ID, so they are found by bisection.
+/// Once replaced, the snapshot is linked into the retired list together with the subscription that was removed.
+typedef struct
 {
-    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
-    if ((ins != NULL) && (que != NULL) && (metadata != NULL) && ((payload != NULL) || (0U == payload_size)))
+    void*                 next_retired;
+    CanardRxSubscription* removed;
+    size_t                offsets[CANARD_NUM_TRANSFER_KINDS + 1U];
+    CanardRxSubscription* items[];
+} RxSubscriptionSnapshot;
+
+CANARD_PRIVATE CanardRxSubscription* rxSnapshotSearch(const RxSubscriptionSnapshot* const snap,
+                                                      const size_t                        tk,
+                                                      const CanardPortID                  port_id)
+{
+    CANARD_ASSERT((snap != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS));
+    CanardRxSubscription* out = NULL;
+    size_t                lo  = snap->offsets[tk];
+    size_t                hi  = snap->offsets[tk + 1U];
+    while ((NULL == out) && (lo < hi))
     {
-        const size_t  pl_mtu       = adjustPresentationLayerMTU(que->mtu_bytes);
-        const int32_t maybe_can_id = txMakeCANID(metadata, payload_size, payload, ins->node_id, pl_mtu);
-        if (maybe_can_id >= 0)
+        const size_t                mid  = lo + ((hi - lo) / 2U);
+        CanardRxSubscription* const item = snap->items[mid];
+        if (item->port_id == port_id)
         {
-            if (payload_size <= pl_mtu)
-            {
-                out = txPushSingleFrame(que,
-                                        ins,
+            out = item;
+        }
+        else if (item->port_id < port_id)
+        {
+            lo = mid + 1U;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return out;
+}
+
+/// Allocates a copy of the snapshot where the specified subscription of the specified kind is added, removed,
+/// or both if one replaces the other, keeping the order. Returns NULL if there is not enough memory.
+CANARD_PRIVATE RxSubscriptionSnapshot* rxSnapshotDerive(CanardInstance* const               ins,
+                                                        const RxSubscriptionSnapshot* const base,
+                                                        const size_t                        tk,
+                                                        CanardRxSubscription* const         added,
+                                                        const CanardRxSubscription* const   removed)
+{
+    CANARD_ASSERT((ins != NULL) && (base != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS));
+    CANARD_ASSERT((added != NULL) || (removed != NULL));
+    const size_t count = (base->offsets[CANARD_NUM_TRANSFER_KINDS] + ((added != NULL) ? 1U : 0U)) -
+                         ((removed != NULL) ? 1U : 0U);
+    RxSubscriptionSnapshot* const out = (RxSubscriptionSnapshot*) ins->memory_allocate(
+        ins,
+        sizeof(RxSubscriptionSnapshot) + (count * sizeof(CanardRxSubscription*)));
+    if (out != NULL)
+    {
+        out->next_retired             = NULL;
+        out->removed                  = NULL;
+        out->offsets[0]               = 0U;
+        CanardRxSubscription* pending = added;
+        size_t                k       = 0U;
+        for (size_t kind = 0U; kind < CANARD_NUM_TRANSFER_KINDS; kind++)
+        {
+            for (size_t i = base->offsets[kind]; i < base->offsets[kind + 1U]; i++)
+            {
+                CanardRxSubscription* const item = base->items[i];
+                if ((kind == tk) && (pending != NULL) && (pending->port_id < item->port_id))
+                {
+                    out->items[k++] = pending;
+                    pending         = NULL;
+                }
+                if (item != removed)
+                {
+                    out->items[k++] = item;
+                }
+            }
+            if ((kind == tk) && (pending != NULL))
+            {
+                out->items[k++] = pending;
+                pending         = NULL;
+            }
+            out->offsets[kind + 1U] = k;
+        }
+        CANARD_ASSERT(k == count);
+    }
+    return out;
+}
+
+/// Replaces the published snapshot with one where the subscription is added, removed, or replaced, and retires
+/// the old snapshot along with the removed subscription. Returns false if there is not enough memory, in which case
+/// nothing is changed. Invoked by the writer only.
+CANARD_PRIVATE bool rxTablePublish(CanardInstance* const       ins,
+                                   const size_t                tk,
+                                   CanardRxSubscription* const added,
+                                   CanardRxSubscription* const removed)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->rx_subscription_table != NULL));
+    CanardRxSubscriptionTable* const table = ins->rx_subscription_table;
+    RxSubscriptionSnapshot* const    old   = (RxSubscriptionSnapshot*) table->version;  // Only the writer modifies it.
+    RxSubscriptionSnapshot* const    snap  = rxSnapshotDerive(ins, old, tk, added, removed);
+    if (snap != NULL)
+    {
+        CANARD_ATOMIC_STORE(&table->version, (void*) snap);
+        // The reader may still be searching the old snapshot, but it does not access these fields.
+        old->removed = removed;
+        void* head   = CANARD_ATOMIC_LOAD(&table->retired);
+        bool  pushed = false;
+        while (!pushed)
+        {
+            old->next_retired = head;
+            pushed            = CANARD_ATOMIC_COMPARE_EXCHANGE(&table->retired, &head, (void*) old);
+        }
+        if (removed != NULL)
+        {
+            CANARD_ATOMIC_STORE(&table->retired_count, table->retired_count + 1U);
+        }
+    }
+    return snap != NULL;
+}
+
+/// Releases the retired snapshots and the sessions of the removed subscriptions. Invoked by the reader only,
+/// when it holds no references to the snapshots or subscriptions obtained earlier.
+/// Returns the number of removed subscriptions whose sessions have been released.
+CANARD_PRIVATE int32_t rxTableReclaim(CanardInstance* const ins)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->rx_subscription_table != NULL));
+    CanardRxSubscriptionTable* const table = ins->rx_subscription_table;
+    int32_t                          out   = 0;
+    // The list is detached as a whole; the writer may keep pushing new items onto it concurrently.
+    void* head     = CANARD_ATOMIC_LOAD(&table->retired);
+    bool  detached = (NULL == head);
+    while (!detached)
+    {
+        detached = CANARD_ATOMIC_COMPARE_EXCHANGE(&table->retired, &head, NULL);
+    }
+    while (head != NULL)
+    {
+        RxSubscriptionSnapshot* const snap = (RxSubscriptionSnapshot*) head;
+        head                               = snap->next_retired;
+        if (snap->removed != NULL)
+        {
+            rxSubscriptionReleaseSessions(ins, snap->removed);
+            out++;
+        }
+        ins->memory_free(ins, snap);
+    }
+    if (out > 0)
+    {
+        CANARD_ATOMIC_STORE(&table->reclaimed_count, table->reclaimed_count + (size_t) out);
+    }
+    return out;
+}
+
+CANARD_PRIVATE int8_t rxSubscribe(CanardInstance* const       ins,
+                                  const CanardTransferKind    transfer_kind,
+                                  const CanardPortID          port_id,
+                                  const size_t                extent,
+                                  const CanardMicrosecond     transfer_id_timeout_usec,
+                                  const bool                  single_frame,
+                                  CanardRxSubscription* const out_subscription)
+{
+    int8_t       out = -CANARD_ERROR_INVALID_ARGUMENT;
+    const size_t tk  = (size_t) transfer_kind;
+    if ((ins != NULL) && (out_subscription != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS))
+    {
+        CanardRxSubscription* existing = NULL;
+        if (NULL == ins->rx_subscription_table)
+        {
+            // Reset to the initial state. This is absolutely critical because the new payload size limit may be
+            // larger than the old value; if there are any payload buffers allocated, we may overrun them because they
+            // are shorter than the new payload limit. So we clear the subscription and thus ensure that no overrun
+            // may occur.
+            out = canardRxUnsubscribe(ins, transfer_kind, port_id);
+        }
+        else
+        {
+            // The existing subscription is replaced in the same snapshot, so that the port is never left without one;
+            // it is retired only once the new snapshot is published. Its object cannot be reused at once because its
+            // sessions are released by the reader later.
+            CanardPortID port_id_mutable = port_id;
+            existing                     = (CanardRxSubscription*) (void*)
+                cavlSearch(&ins->rx_subscriptions[tk], &port_id_mutable, &rxSubscriptionPredicateOnPortID, NULL);
+            if (existing == out_subscription)
+            {
+                out = -CANARD_ERROR_INVALID_ARGUMENT;
+            }
+            else
+            {
+                out = (existing != NULL) ? 1 : 0;
+            }
+        }
+        if (out >= 0)
+        {
+            out_subscription->transfer_id_timeout_usec = transfer_id_timeout_usec;
+            out_subscription->failover_timeout_usec    = transfer_id_timeout_usec;
+            out_subscription->first_arrival_wins       = false;
+            out_subscription->transport_stats          = NULL;
+            out_subscription->transport_stats_count    = 0U;
+            out_subscription->extent                   = extent;
+            out_subscription->port_id                  = port_id;
+            out_subscription->single_frame             = single_frame;
+            out_subscription->payload_layout.alignment = 0U;
+            out_subscription->payload_layout.headroom  = 0U;
+            out_subscription->payload_layout.tailroom  = 0U;
+            for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+            {
+                // The sessions will be created ad-hoc. Normally, for a low-jitter deterministic system,
+                // we could have pre-allocated sessions here, but that requires too much memory to be feasible.
+                // We could accept an extra argument that would instruct us to pre-allocate sessions here?
+                out_subscription->sessions[i] = NULL;
+            }
+            // The tree is only used by the writer if there is a subscription table, so the order does not matter.
+            if ((ins->rx_subscription_table != NULL) && (!rxTablePublish(ins, tk, out_subscription, existing)))
+            {
+                out = -CANARD_ERROR_OUT_OF_MEMORY;
+            }
+            else
+            {
+                if ((ins->rx_subscription_table != NULL) && (existing != NULL))
+                {
+                    cavlRemove(&ins->rx_subscriptions[tk], &existing->base);  // The sessions go with the snapshot.
+                }
+                const CanardTreeNode* const res = cavlSearch(&ins->rx_subscriptions[tk],
+                                                             out_subscription,
+                                                             &rxSubscriptionPredicateOnStruct,
+                                                             &avlTrivialFactory);
+                (void) res;
+                CANARD_ASSERT(res == &out_subscription->base);
+                out = (out > 0) ? 0 : 1;
+            }
+        }
+    }
+    return out;
+}
+
+/// Returns the highest non-empty priority level of the backlog (numerically the lowest),
+/// or CANARD_PRIORITY_MAX + 1 if the backlog is empty.
+CANARD_PRIVATE size_t rxBacklogGetTopLevel(const CanardRxBacklog* const backlog)
+{
+    size_t out = 0U;
+    while ((out <= CANARD_PRIORITY_MAX) && (backlog->heads[out] == NULL))
+    {
+        out++;
+    }
+    return out;
+}
+
+/// Detaches the oldest frame of the specified priority level, which shall not be empty.
+CANARD_PRIVATE CanardRxBacklogItem* rxBacklogTake(CanardRxBacklog* const backlog, const size_t level)
+{
+    CanardRxBacklogItem* const out = backlog->heads[level];
+    CANARD_ASSERT((out != NULL) && (backlog->size > 0U));
+    backlog->heads[level] = out->next;
+    if (backlog->heads[level] == NULL)
+    {
+        backlog->tails[level] = NULL;
+    }
+    backlog->size--;
+    out->next = NULL;
+    return out;
+}
+
+// --------------------------------------------- BUS TIMING ---------------------------------------------
+
+#define BUS_STUFF_RUN_LENGTH 5U
+#define BUS_CRC15_POLYNOMIAL 0x4599U
+#define BUS_CRC15_WIDTH 15U
+#define BUS_FD_STUFF_COUNT_WIDTH 4U
+#define BUS_FD_CRC17_WIDTH 17U
+#define BUS_FD_CRC21_WIDTH 21U
+#define BUS_FD_CRC17_LENGTH_MAX 16U
+#define BUS_FD_FIXED_STUFF_PERIOD 4U
+/// The CRC delimiter, the ACK slot and delimiter, the end of frame, and the interframe space are not stuffed.
+#define BUS_TRAILER_BITS 13U
+#define NANOSECONDS_PER_SECOND UINT64_C(1000000000)
+#define NANOSECONDS_PER_MICROSECOND 1000U
+#define PARTS_PER_MILLION 1000000U
+
+/// Counts the bits of a frame as they appear on the wire: after five consecutive bits of the same level, a stuff bit
+/// of the opposite level is inserted, which itself counts towards the next run. The CRC-15 of Classic CAN is computed
+/// over the same bits before the stuffing.
+typedef struct
+{
+    uint8_t  state;  ///< See BusStuffNibbleTable; BUS_STATE_INITIAL before the start of frame.
+    uint32_t count;
+    uint32_t stuff;
+    uint32_t crc;
+} BusBitStream;
+
+/// The state of the stuffing is the level of the last bit (bit 2) and the length of its run less one (bits 0-1);
+/// a run of five is never carried over because it is terminated by a stuff bit.
+#define BUS_STATE_LEVEL 4U
+#define BUS_STATE_RUN_MASK 3U
+#define BUS_STATE_STUFF 8U
+#define BUS_STATE_INITIAL 0xFFU
+
+/// The dynamic bit stuffing of four bits at once, which speeds up the data field severalfold. The index is the state
+/// shifted left by four bits combined with the four bits to be pushed, most significant first. The entry is the new
+/// state and BUS_STATE_STUFF if a stuff bit has been inserted; there can be at most one.
+static const uint8_t BusStuffNibbleTable[128] = {
+    12U, 4U, 0U, 5U, 1U, 4U, 0U, 6U, 2U, 4U, 0U, 5U, 1U, 4U, 0U, 7U, 8U, 13U, 0U, 5U, 1U, 4U, 0U, 6U, 2U, 4U, 0U, 5U,
+    1U, 4U, 0U, 7U, 9U, 12U, 8U, 14U, 1U, 4U, 0U, 6U, 2U, 4U, 0U, 5U, 1U, 4U, 0U, 7U, 10U, 12U, 8U, 13U, 9U, 12U, 8U,
+    15U, 2U, 4U, 0U, 5U, 1U, 4U, 0U, 7U, 3U, 4U, 0U, 5U, 1U, 4U, 0U, 6U, 2U, 4U, 0U, 5U, 1U, 4U, 0U, 8U, 3U, 4U, 0U, 5U,
+    1U, 4U, 0U, 6U, 2U, 4U, 0U, 5U, 1U, 4U, 9U, 12U, 3U, 4U, 0U, 5U, 1U, 4U, 0U, 6U, 2U, 4U, 0U, 5U, 10U, 12U, 8U, 13U,
+    3U, 4U, 0U, 5U, 1U, 4U, 0U, 6U, 11U, 12U, 8U, 13U, 9U, 12U, 8U, 14U,
+};
+
+/// Pushes the specified number of the least significant bits of the value, most significant first.
+/// The CRC, if requested, is updated bit by bit; the bits are stuffed four at a time where possible.
+CANARD_PRIVATE void busPush(BusBitStream* const self, const uint32_t value, const uint8_t width, const bool crc)
+{
+    CANARD_ASSERT(self != NULL);
+    CANARD_ASSERT(width <= 32U);
+    for (uint8_t i = width; crc && (i > 0U); i--)
+    {
+        const bool bit      = ((value >> (i - 1U)) & 1U) != 0U;
+        const bool feedback = bit != (((self->crc >> (BUS_CRC15_WIDTH - 1U)) & 1U) != 0U);
+        self->crc           = (self->crc << 1U) & ((1UL << BUS_CRC15_WIDTH) - 1U);
+        self->crc ^= feedback ? BUS_CRC15_POLYNOMIAL : 0U;
+    }
+    uint8_t i = width;
+    while (i > 0U)
+    {
+        if ((i >= 4U) && (self->state != BUS_STATE_INITIAL))
+        {
+            const uint8_t next  = BusStuffNibbleTable[((uint32_t) self->state << 4U) | ((value >> (i - 4U)) & 0xFU)];
+            const uint8_t stuff = (uint8_t) (next >> 3U);
+            self->state         = (uint8_t) (next & (BUS_STATE_LEVEL | BUS_STATE_RUN_MASK));
+            self->count += 4U + stuff;
+            self->stuff += stuff;
+            i = (uint8_t) (i - 4U);
+        }
+        else
+        {
+            const bool     bit   = ((value >> (i - 1U)) & 1U) != 0U;
+            const bool     level = (self->state & BUS_STATE_LEVEL) != 0U;
+            const uint32_t run   = ((self->state != BUS_STATE_INITIAL) && (level == bit))
+                                       ? ((self->state & BUS_STATE_RUN_MASK) + 2U)
+                                       : 1U;
+            self->count++;
+            if (run == BUS_STUFF_RUN_LENGTH)
+            {
+                self->state = bit ? 0U : BUS_STATE_LEVEL;  // The stuff bit starts a new run of the opposite level.
+                self->count++;
+                self->stuff++;
+            }
+            else
+            {
+                self->state = (uint8_t) ((bit ? BUS_STATE_LEVEL : 0U) | (run - 1U));
+            }
+            i--;
+        }
+    }
+}
+
+/// The frame shall be valid, which is checked by the caller.
+CANARD_PRIVATE CanardFrameBits busGetFrameBits(const CanardFrame* const frame, const bool fd, const bool brs)
+{
+    CANARD_ASSERT(frame != NULL);
+    CANARD_ASSERT(frame->payload_size <= CANARD_MTU_MAX);
+    const uint8_t* const payload = (const uint8_t*) frame->payload;
+    const uint8_t        dlc     = CanardCANLengthToDLC[frame->payload_size];
+    const size_t         length  = fd ? CanardCANDLCToLength[dlc] : frame->payload_size;
+    const bool           crc     = !fd;  // The CRC of CAN FD is not needed because its length is fixed.
+    BusBitStream         bs      = {BUS_STATE_INITIAL, 0U, 0U, 0U};
+    busPush(&bs, 0U, 1U, crc);                                          // SOF
+    busPush(&bs, (frame->extended_can_id >> 18U) & 0x7FFU, 11U, crc);  // Base ID
+    busPush(&bs, 3U, 2U, crc);                                          // SRR, IDE
+    busPush(&bs, frame->extended_can_id & 0x3FFFFU, 18U, crc);          // Extended ID
+    CanardFrameBits out = {0U, 0U, 0U};
+    if (fd)
+    {
+        busPush(&bs, brs ? 0x5U : 0x4U, 4U, false);  // RRS, FDF, res, BRS
+        const uint32_t arbitration = bs.count;
+        busPush(&bs, dlc, 5U, false);  // ESI, DLC
+        for (size_t i = 0; i < length; i++)
+        {
+            busPush(&bs, (i < frame->payload_size) ? payload[i] : PADDING_BYTE_VALUE, BITS_PER_BYTE, false);
+        }
+        // The stuff bit count and the CRC are not stuffed dynamically; instead, a fixed stuff bit precedes
+        // the stuff bit count and follows every fourth bit thereafter.
+        const uint32_t crc_width = (length > BUS_FD_CRC17_LENGTH_MAX) ? BUS_FD_CRC21_WIDTH : BUS_FD_CRC17_WIDTH;
+        const uint32_t fixed     = 1U + ((BUS_FD_STUFF_COUNT_WIDTH + crc_width - 1U) / BUS_FD_FIXED_STUFF_PERIOD);
+        const uint32_t data      = (bs.count - arbitration) + BUS_FD_STUFF_COUNT_WIDTH + crc_width + fixed;
+        out.nominal              = (uint16_t) (arbitration + BUS_TRAILER_BITS + (brs ? 0U : data));
+        out.data                 = (uint16_t) (brs ? data : 0U);
+        out.stuff                = (uint16_t) (bs.stuff + fixed);
+    }
+    else
+    {
+        busPush(&bs, 0U, 3U, crc);  // RTR, r1, r0
+        busPush(&bs, dlc, 4U, crc);
+        for (size_t i = 0; i < length; i++)
+        {
+            busPush(&bs, payload[i], BITS_PER_BYTE, crc);
+        }
+        busPush(&bs, bs.crc, BUS_CRC15_WIDTH, false);  // The CRC sequence of Classic CAN is stuffed dynamically.
+        out.nominal = (uint16_t) (bs.count + BUS_TRAILER_BITS);
+        out.stuff   = (uint16_t) bs.stuff;
+    }
+    return out;
+}
+
+/// Returns zero if the timing or the frame is invalid. The caller shall ensure that the timing is not NULL.
+CANARD_PRIVATE uint32_t busGetFrameDuration(const CanardBusTiming* const timing,
+                                            const CanardFrame* const     frame,
+                                            CanardFrameBits* const       out_bits)
+{
+    CANARD_ASSERT(timing != NULL);
+    CANARD_ASSERT(out_bits != NULL);
+    const bool brs = timing->fd && (timing->data_bit_rate > 0U);
+    uint32_t   out = 0U;
+    if ((frame != NULL) && ((frame->payload != NULL) || (frame->payload_size == 0U)) &&
+        (frame->payload_size <= (timing->fd ? CANARD_MTU_CAN_FD : CANARD_MTU_CAN_CLASSIC)) &&
+        (timing->nominal_bit_rate > 0U))
+    {
+        *out_bits           = busGetFrameBits(frame, timing->fd, brs);
+        const uint64_t nsec = ((out_bits->nominal * NANOSECONDS_PER_SECOND) / timing->nominal_bit_rate) +
+                              (brs ? ((out_bits->data * NANOSECONDS_PER_SECOND) / timing->data_bit_rate) : 0U);
+        out                 = (nsec < UINT32_MAX) ? (uint32_t) nsec : UINT32_MAX;
+    }
+    return out;
+}
+
+// --------------------------------------------- PUBLIC API ---------------------------------------------
+
+const uint8_t CanardCANDLCToLength[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+const uint8_t CanardCANLengthToDLC[65] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,                               // 0-8
+    9,  9,  9,  9,                                                   // 9-12
+    10, 10, 10, 10,                                                  // 13-16
+    11, 11, 11, 11,                                                  // 17-20
+    12, 12, 12, 12,                                                  // 21-24
+    13, 13, 13, 13, 13, 13, 13, 13,                                  // 25-32
+    14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,  // 33-48
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  // 49-64
+};
+
+CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const CanardMemoryFree memory_free)
+{
+    CANARD_ASSERT(memory_allocate != NULL);
+    CANARD_ASSERT(memory_free != NULL);
+    const CanardInstance out = {
+        .user_reference               = NULL,
+        .node_id                      = CANARD_NODE_ID_UNSET,
+        .memory_allocate              = memory_allocate,
+        .memory_free                  = memory_free,
+        .rx_adaptive_extent_threshold = SIZE_MAX,
+        .rx_subscriptions             = {NULL, NULL, NULL},
+        .rx_timer_wheel               = NULL,
+        .rx_duplicate_cache           = NULL,
+        .rx_subscription_table        = NULL,
+    };
+    return out;
+}
+
+CanardTxQueue canardTxInit(const size_t capacity, const size_t mtu_bytes)
+{
+    CanardTxQueue out = {
+        .capacity          = capacity,
+        .mtu_bytes         = mtu_bytes,
+        .size              = 0,
+        .root              = NULL,
+        .deadline_root     = NULL,
+        .deadline_index    = false,
+        .kind              = CanardTxQueueKindTree,
+        .heap              = NULL,
+        .heap_length       = 0,
+        .sequence          = 0,
+        .bitmap_root       = NULL,
+        .bitmap_free       = NULL,
+        .bitmap_free_count = 0,
+        .user_reference    = NULL,
+    };
+    return out;
+}
+
+CanardTxQueue canardTxInitHeap(const size_t              capacity,
+                               const size_t              mtu_bytes,
+                               CanardTxQueueItem** const heap,
+                               const size_t              heap_length)
+{
+    CanardTxQueue out = canardTxInit(capacity, mtu_bytes);
+    out.kind          = CanardTxQueueKindHeap;
+    out.heap          = heap;
+    out.heap_length   = (heap != NULL) ? heap_length : 0U;
+    return out;
+}
+
+CanardTxQueue canardTxInitBitmap(const size_t              capacity,
+                                 const size_t              mtu_bytes,
+                                 CanardTxBitmapNode* const nodes,
+                                 const size_t              node_count)
+{
+    CanardTxQueue out = canardTxInit(capacity, mtu_bytes);
+    out.kind          = CanardTxQueueKindBitmap;
+    if (nodes != NULL)
+    {
+        for (size_t i = 0U; i < node_count; i++)
+        {
+            nodes[i].mask        = 0U;
+            nodes[i].children[0] = out.bitmap_free;
+            out.bitmap_free      = &nodes[i];
+        }
+        out.bitmap_free_count = node_count;
+    }
+    return out;
+}
+
+int8_t canardTxSetDeadlineIndex(CanardTxQueue* const que, const bool enabled)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((que != NULL) && (0U == que->size))
+    {
+        CANARD_ASSERT(NULL == que->deadline_root);
+        que->deadline_index = enabled;
+        out                 = 0;
+    }
+    return out;
+}
+
+int32_t canardTxPush(CanardTxQueue* const                que,
+                     CanardInstance* const               ins,
+                     const CanardMicrosecond             tx_deadline_usec,
+                     const CanardTransferMetadata* const metadata,
+                     const size_t                        payload_size,
+                     const void* const                   payload)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (que != NULL) && (metadata != NULL) && ((payload != NULL) || (0U == payload_size)))
+    {
+        const size_t  pl_mtu       = adjustPresentationLayerMTU(que->mtu_bytes);
+        const int32_t maybe_can_id = txMakeCANID(metadata, payload_size, payload, ins->node_id, pl_mtu);
+        if (maybe_can_id >= 0)
+        {
+            if (payload_size <= pl_mtu)
+            {
+                out = txPushSingleFrame(que,
+                                        ins,
                                         tx_deadline_usec,
                                         (uint32_t) maybe_can_id,
                                         metadata->transfer_id,
@@ -1025,174 +2792,994 @@ int32_t canardTxPush(CanardTxQueue* const                que,
             }
             else
             {
-                out = txPushMultiFrame(que,
-                                       ins,
-                                       pl_mtu,
-                                       tx_deadline_usec,
-                                       (uint32_t) maybe_can_id,
-                                       metadata->transfer_id,
-                                       payload_size,
-                                       payload);
-                CANARD_ASSERT((out < 0) || (out >= 2));
+                out = txPushMultiFrame(que,
+                                       ins,
+                                       pl_mtu,
+                                       tx_deadline_usec,
+                                       (uint32_t) maybe_can_id,
+                                       metadata->transfer_id,
+                                       payload_size,
+                                       payload);
+                CANARD_ASSERT((out < 0) || (out >= 2));
+            }
+        }
+        else
+        {
+            out = maybe_can_id;
+        }
+    }
+    CANARD_ASSERT(out != 0);
+    return out;
+}
+
+const CanardTxQueueItem* canardTxPeek(const CanardTxQueue* const que)
+{
+    const CanardTxQueueItem* out = NULL;
+    if (que != NULL)
+    {
+        if (CanardTxQueueKindHeap == que->kind)
+        {
+            out = (que->size > 0U) ? que->heap[0] : NULL;
+        }
+        else if (CanardTxQueueKindBitmap == que->kind)
+        {
+            out = txBitmapPeek(que);
+        }
+        else
+        {
+            // Paragraph 6.7.2.1.15 of the C standard says:
+            //     A pointer to a structure object, suitably converted, points to its initial member, and vice versa.
+            out = (const CanardTxQueueItem*) (void*) cavlFindExtremum(que->root, false);
+        }
+    }
+    return out;
+}
+
+const CanardTxQueueItem* canardTxPeekEarliestDeadline(const CanardTxQueue* const que)
+{
+    const CanardTxQueueItem* out = NULL;
+    if ((que != NULL) && (que->deadline_root != NULL))
+    {
+        CANARD_ASSERT(que->deadline_index);
+        out = ((const TxDeadlineNode*) (const void*) cavlFindExtremum(que->deadline_root, false))->item;
+    }
+    return out;
+}
+
+CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem* const item)
+{
+    CanardTxQueueItem* out = NULL;
+    if ((que != NULL) && (item != NULL))
+    {
+        // Intentional violation of MISRA: casting away const qualifier. This is considered safe because the API
+        // contract dictates that the pointer shall point to a mutable entity in RAM previously allocated by the
+        // memory manager. It is difficult to avoid this cast in this context.
+        out = (CanardTxQueueItem*) item;  // NOSONAR casting away const qualifier.
+        txQueueRemove(que, item);
+    }
+    return out;
+}
+
+int8_t canardTxSlotPoolInit(CanardTxSlotPool* const pool,
+                            CanardTxSlot* const     slots,
+                            const size_t            capacity,
+                            const size_t            mtu_bytes)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((pool != NULL) && (slots != NULL) && (capacity > 0U) && ((capacity & (capacity - 1U)) == 0U))
+    {
+        (void) memset(pool, 0, sizeof(CanardTxSlotPool));
+        pool->slots            = slots;
+        pool->capacity         = capacity;
+        pool->payload_capacity = adjustPresentationLayerMTU(mtu_bytes);
+        CANARD_ASSERT(pool->payload_capacity <= sizeof(slots->payload));
+        // The sequence number of a slot equals the position at which it can be claimed next; it is one greater when
+        // the slot is committed. The consumer then advances it by the capacity, making it claimable in the next lap.
+        for (size_t i = 0; i < capacity; i++)
+        {
+            slots[i].sequence = i;
+        }
+        out = 0;
+    }
+    return out;
+}
+
+CanardTxSlot* canardTxSlotClaim(CanardTxSlotPool* const pool, const size_t payload_size)
+{
+    CanardTxSlot* out = NULL;
+    if ((pool != NULL) && (payload_size <= pool->payload_capacity))
+    {
+        size_t pos  = CANARD_ATOMIC_LOAD(&pool->tail);
+        bool   done = false;
+        while (!done)
+        {
+            CanardTxSlot* const slot = &pool->slots[pos & (pool->capacity - 1U)];
+            const size_t        seq  = CANARD_ATOMIC_LOAD(&slot->sequence);
+            if (seq == pos)
+            {
+                // On failure, pos is updated with the current tail, so the next attempt targets the next free slot.
+                if (CANARD_ATOMIC_COMPARE_EXCHANGE(&pool->tail, &pos, pos + 1U))
+                {
+                    out               = slot;
+                    out->payload_size = payload_size;
+                    done              = true;
+                }
+            }
+            else if ((pos - seq) <= pool->capacity)
+            {
+                // The slot is still occupied by the transfer claimed one lap earlier.
+                (void) CANARD_ATOMIC_INCREMENT(&pool->overrun_count);
+                done = true;
+            }
+            else
+            {
+                pos = CANARD_ATOMIC_LOAD(&pool->tail);  // Another producer has claimed this slot; pos is stale.
+            }
+        }
+    }
+    return out;
+}
+
+int8_t canardTxSlotCommit(CanardTxSlot* const slot)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if (slot != NULL)
+    {
+        CANARD_ATOMIC_STORE(&slot->sequence, slot->sequence + 1U);  // Publishes the contents of the slot.
+        out = 0;
+    }
+    return out;
+}
+
+int32_t canardTxPushSlots(CanardTxQueue* const que, CanardInstance* const ins, CanardTxSlotPool* const pool)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((que != NULL) && (ins != NULL) && (pool != NULL))
+    {
+        // The payload may have been altered by the producer after claiming; a multi-frame transfer is not accepted.
+        const size_t pl_mtu = adjustPresentationLayerMTU(que->mtu_bytes);
+        size_t       i      = 0;
+        bool         more   = true;
+        out                 = 0;
+        while (more && (i < pool->capacity))
+        {
+            const size_t        pos  = pool->head;
+            CanardTxSlot* const slot = &pool->slots[pos & (pool->capacity - 1U)];
+            if (CANARD_ATOMIC_LOAD(&slot->sequence) == (pos + 1U))
+            {
+                int32_t result = -CANARD_ERROR_INVALID_ARGUMENT;
+                if (slot->payload_size <= pl_mtu)
+                {
+                    result = canardTxPush(que,
+                                          ins,
+                                          slot->tx_deadline_usec,
+                                          &slot->metadata,
+                                          slot->payload_size,
+                                          &slot->payload[0]);
+                    CANARD_ASSERT(result <= 1);
+                }
+                if (result == -CANARD_ERROR_OUT_OF_MEMORY)
+                {
+                    more = false;  // The transfer is kept in its slot to be retried later.
+                }
+                else
+                {
+                    if (result > 0)
+                    {
+                        out += result;
+                    }
+                    else
+                    {
+                        pool->drop_count++;
+                    }
+                    CANARD_ATOMIC_STORE(&slot->sequence, pos + pool->capacity);  // Hands the slot back to producers.
+                    pool->head = pos + 1U;
+                }
+            }
+            else
+            {
+                more = false;  // Not committed yet.
+            }
+            i++;
+        }
+    }
+    return out;
+}
+
+int8_t canardRxAccept(CanardInstance* const        ins,
+                      const CanardMicrosecond      timestamp_usec,
+                      const CanardFrame* const     frame,
+                      const uint8_t                redundant_transport_index,
+                      CanardRxTransfer* const      out_transfer,
+                      CanardRxSubscription** const out_subscription)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (out_transfer != NULL) && (frame != NULL) && (frame->extended_can_id <= CAN_EXT_ID_MASK) &&
+        ((frame->payload != NULL) || (0 == frame->payload_size)))
+    {
+        if (ins->rx_subscription_table != NULL)
+        {
+            (void) rxTableReclaim(ins);  // This is a quiescent point of the reader.
+        }
+        RxFrameModel model = {0};
+        if (rxDuplicateCacheSuppress(ins->rx_duplicate_cache, timestamp_usec, frame, redundant_transport_index))
+        {
+            out = 0;  // A redundant duplicate of a frame that has already been processed.
+        }
+        else if (rxTryParseFrame(timestamp_usec, frame, &model))
+        {
+            if ((CANARD_NODE_ID_UNSET == model.destination_node_id) || (ins->node_id == model.destination_node_id))
+            {
+                // This is the reason the function has a logarithmic time complexity of the number of subscriptions.
+                // Note also that this one of the two variable-complexity operations in the RX pipeline; the other one
+                // is memcpy(). Excepting these two cases, the entire RX pipeline contains neither loops nor recursion.
+                const size_t                tk  = (size_t) model.transfer_kind;
+                CanardRxSubscription* const sub =
+                    (ins->rx_subscription_table != NULL)
+                        ? rxSnapshotSearch((const RxSubscriptionSnapshot*) CANARD_ATOMIC_LOAD(
+                                               &ins->rx_subscription_table->version),
+                                           tk,
+                                           model.port_id)
+                        : (CanardRxSubscription*) (void*) cavlSearch(&ins->rx_subscriptions[tk],
+                                                                     &model.port_id,
+                                                                     &rxSubscriptionPredicateOnPortID,
+                                                                     NULL);
+                if (out_subscription != NULL)
+                {
+                    *out_subscription = sub;  // Expose selected instance to the caller.
+                }
+                if (sub != NULL)
+                {
+                    CANARD_ASSERT(sub->port_id == model.port_id);
+                    bool accepted = false;
+                    out = rxAcceptFrame(ins, sub, &model, redundant_transport_index, out_transfer, &accepted);
+                    CanardRxDuplicateCache* const cache = ins->rx_duplicate_cache;
+                    if ((cache != NULL) && accepted)
+                    {
+                        rxDuplicateCacheRemember(cache, timestamp_usec, frame, redundant_transport_index);
+                    }
+                }
+                else
+                {
+                    out = 0;  // No matching subscription.
+                }
+            }
+            else
+            {
+                out = 0;  // Mis-addressed frame (normally it should be filtered out by the hardware).
+            }
+        }
+        else
+        {
+            out = 0;  // A non-Cyphal/CAN input frame.
+        }
+    }
+    CANARD_ASSERT(out <= 1);
+    return out;
+}
+
+int8_t canardRxFrameRingInit(CanardRxFrameRing* const ring, CanardRxFrameSlot* const slots, const size_t capacity)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ring != NULL) && (slots != NULL) && (capacity > 0U) && ((capacity & (capacity - 1U)) == 0U))
+    {
+        (void) memset(ring, 0, sizeof(CanardRxFrameRing));
+        ring->slots    = slots;
+        ring->capacity = capacity;
+        out            = 0;
+    }
+    return out;
+}
+
+CanardRxFrameSlot* canardRxFrameRingReserve(CanardRxFrameRing* const ring)
+{
+    CanardRxFrameSlot* out = NULL;
+    if (ring != NULL)
+    {
+        // The tail is only written by the producer, so it can be read without synchronization here.
+        // The head is only loaded from the consumer's cache line when the cached copy indicates that the ring is full.
+        if ((ring->tail - ring->head_cache) >= ring->capacity)
+        {
+            ring->head_cache = CANARD_ATOMIC_LOAD(&ring->head);
+        }
+        if ((ring->tail - ring->head_cache) < ring->capacity)
+        {
+            out = &ring->slots[ring->tail & (ring->capacity - 1U)];
+        }
+        else
+        {
+            ring->overrun_count++;
+        }
+    }
+    return out;
+}
+
+int8_t canardRxFrameRingCommit(CanardRxFrameRing* const ring)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if (ring != NULL)
+    {
+        if ((ring->tail - ring->head_cache) >= ring->capacity)
+        {
+            ring->head_cache = CANARD_ATOMIC_LOAD(&ring->head);
+        }
+        if ((ring->tail - ring->head_cache) < ring->capacity)
+        {
+            CANARD_ATOMIC_STORE(&ring->tail, ring->tail + 1U);  // Publishes the contents of the slot.
+            out = 0;
+        }
+    }
+    return out;
+}
+
+const CanardRxFrameSlot* canardRxFrameRingPeek(CanardRxFrameRing* const ring)
+{
+    const CanardRxFrameSlot* out = NULL;
+    if (ring != NULL)
+    {
+        if (ring->head == ring->tail_cache)
+        {
+            ring->tail_cache = CANARD_ATOMIC_LOAD(&ring->tail);
+        }
+        if (ring->head != ring->tail_cache)
+        {
+            out = &ring->slots[ring->head & (ring->capacity - 1U)];
+        }
+    }
+    return out;
+}
+
+int8_t canardRxFrameRingPop(CanardRxFrameRing* const ring)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if (canardRxFrameRingPeek(ring) != NULL)
+    {
+        CANARD_ATOMIC_STORE(&ring->head, ring->head + 1U);  // Hands the slot back to the producer.
+        out = 0;
+    }
+    return out;
+}
+
+int32_t canardRxAcceptRing(CanardInstance* const    ins,
+                           CanardRxFrameRing* const ring,
+                           CanardRxTransfer* const  out_transfers,
+                           const size_t             capacity)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (ring != NULL) && (out_transfers != NULL) && (capacity > 0U))
+    {
+        size_t                   count = 0U;
+        const CanardRxFrameSlot* slot  = canardRxFrameRingPeek(ring);
+        while ((slot != NULL) && (count < capacity) && (count < (size_t) INT32_MAX))
+        {
+            // The frame refers to the payload in the slot, which stays intact until the slot is popped.
+            CanardFrame frame     = {0};
+            frame.extended_can_id = slot->extended_can_id;
+            frame.payload_size    = (slot->payload_size <= CANARD_MTU_MAX) ? slot->payload_size : 0U;
+            frame.payload         = &slot->payload[0];
+            const int8_t result   = canardRxAccept(ins,
+                                                 slot->timestamp_usec,
+                                                 &frame,
+                                                 slot->redundant_transport_index,
+                                                 &out_transfers[count],
+                                                 NULL);
+            if (result > 0)
+            {
+                count++;
+            }
+            else if (result == -CANARD_ERROR_OUT_OF_MEMORY)
+            {
+                ring->oom_count++;
+            }
+            else
+            {
+                // Nothing to do; the malformed frames are dropped silently like the invalid Cyphal/CAN frames are.
+            }
+            (void) canardRxFrameRingPop(ring);
+            slot = canardRxFrameRingPeek(ring);
+        }
+        out = (int32_t) count;
+    }
+    return out;
+}
+
+int8_t canardRxBacklogInit(CanardRxBacklog* const backlog, CanardRxBacklogItem* const items, const size_t capacity)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((backlog != NULL) && (items != NULL) && (capacity > 0U))
+    {
+        (void) memset(backlog, 0, sizeof(CanardRxBacklog));
+        for (size_t i = 0U; i < capacity; i++)
+        {
+            items[i].next = ((i + 1U) < capacity) ? &items[i + 1U] : NULL;
+        }
+        backlog->idle = &items[0];
+        out           = 0;
+    }
+    return out;
+}
+
+int8_t canardRxBacklogPush(CanardRxBacklog* const   backlog,
+                           const CanardMicrosecond  timestamp_usec,
+                           const CanardFrame* const frame,
+                           const uint8_t            redundant_transport_index)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((backlog != NULL) && (frame != NULL) && ((frame->payload != NULL) || (frame->payload_size == 0U)) &&
+        (frame->payload_size <= CANARD_MTU_MAX))
+    {
+        const size_t         level = (size_t) ((frame->extended_can_id >> OFFSET_PRIORITY) & CANARD_PRIORITY_MAX);
+        CanardRxBacklogItem* item  = backlog->idle;
+        if (item != NULL)
+        {
+            backlog->idle = item->next;
+            item->next    = NULL;
+        }
+        else
+        {
+            // The backlog is full; make room by dropping the oldest frame of the lowest priority below this one.
+            size_t victim = CANARD_PRIORITY_MAX;
+            while ((victim > level) && (backlog->heads[victim] == NULL))
+            {
+                victim--;
+            }
+            if (victim > level)
+            {
+                item = rxBacklogTake(backlog, victim);
+                backlog->eviction_count++;
+            }
+        }
+        if (item != NULL)
+        {
+            item->frame.timestamp_usec            = timestamp_usec;
+            item->frame.extended_can_id           = frame->extended_can_id;
+            item->frame.redundant_transport_index = redundant_transport_index;
+            item->frame.payload_size              = (uint8_t) frame->payload_size;
+            if (frame->payload_size > 0U)
+            {
+                (void) memcpy(&item->frame.payload[0], frame->payload, frame->payload_size);  // NOLINT
+            }
+            if (backlog->tails[level] != NULL)
+            {
+                backlog->tails[level]->next = item;
+            }
+            else
+            {
+                backlog->heads[level] = item;
+            }
+            backlog->tails[level] = item;
+            backlog->size++;
+            out = 1;
+        }
+        else
+        {
+            backlog->drop_count++;
+            out = 0;
+        }
+    }
+    return out;
+}
+
+int32_t canardRxAcceptBacklog(CanardInstance* const   ins,
+                              CanardRxBacklog* const  backlog,
+                              CanardRxTransfer* const out_transfers,
+                              const size_t            capacity)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (backlog != NULL) && (out_transfers != NULL) && (capacity > 0U))
+    {
+        size_t count = 0U;
+        size_t level = rxBacklogGetTopLevel(backlog);
+        while ((level <= CANARD_PRIORITY_MAX) && (count < capacity) && (count < (size_t) INT32_MAX))
+        {
+            CanardRxBacklogItem* const item = rxBacklogTake(backlog, level);
+            CanardFrame                frame = {0};
+            frame.extended_can_id            = item->frame.extended_can_id;
+            frame.payload_size               = item->frame.payload_size;
+            frame.payload                    = &item->frame.payload[0];
+            const int8_t result              = canardRxAccept(ins,
+                                                              item->frame.timestamp_usec,
+                                                              &frame,
+                                                              item->frame.redundant_transport_index,
+                                                              &out_transfers[count],
+                                                              NULL);
+            if (result > 0)
+            {
+                count++;
+            }
+            else if (result == -CANARD_ERROR_OUT_OF_MEMORY)
+            {
+                backlog->oom_count++;
+            }
+            else
+            {
+                // Nothing to do; the malformed frames are dropped silently like the invalid Cyphal/CAN frames are.
+            }
+            item->next    = backlog->idle;  // The payload has been consumed by now, so the item can be reused.
+            backlog->idle = item;
+            level         = rxBacklogGetTopLevel(backlog);
+        }
+        out = (int32_t) count;
+    }
+    return out;
+}
+
+int8_t canardRxSubscribe(CanardInstance* const       ins,
+                         const CanardTransferKind    transfer_kind,
+                         const CanardPortID          port_id,
+                         const size_t                extent,
+                         const CanardMicrosecond     transfer_id_timeout_usec,
+                         CanardRxSubscription* const out_subscription)
+{
+    return rxSubscribe(ins, transfer_kind, port_id, extent, transfer_id_timeout_usec, false, out_subscription);
+}
+
+int8_t canardRxSubscribeSingleFrame(CanardInstance* const       ins,
+                                    const CanardTransferKind    transfer_kind,
+                                    const CanardPortID          port_id,
+                                    const size_t                extent,
+                                    const CanardMicrosecond     transfer_id_timeout_usec,
+                                    CanardRxSubscription* const out_subscription)
+{
+    return rxSubscribe(ins, transfer_kind, port_id, extent, transfer_id_timeout_usec, true, out_subscription);
+}
+
+int8_t canardRxSetPayloadLayout(CanardRxSubscription* const subscription, const CanardRxPayloadLayout* const layout)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((subscription != NULL) && (layout != NULL) && ((layout->alignment & (layout->alignment - 1U)) == 0U))
+    {
+        bool has_sessions = false;
+        for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+        {
+            has_sessions = has_sessions || (subscription->sessions[i] != NULL);
+        }
+        // The largest buffer is that of the extent; the smaller ones cannot overflow if this one does not.
+        const size_t padding = (layout->alignment > 1U) ? (layout->alignment - 1U) : 0U;
+        size_t       budget  = SIZE_MAX - subscription->extent;
+        bool         fits    = padding <= budget;
+        budget -= fits ? padding : 0U;
+        fits = fits && (layout->headroom <= budget);
+        budget -= fits ? layout->headroom : 0U;
+        fits = fits && (layout->tailroom <= budget);
+        if ((!has_sessions) && fits)
+        {
+            subscription->payload_layout = *layout;
+            out                          = 0;
+        }
+    }
+    return out;
+}
+
+CanardRxSharedPayload* canardRxSharePayload(CanardInstance* const ins, const CanardRxTransfer* const transfer)
+{
+    CanardRxSharedPayload* out = NULL;
+    if ((ins != NULL) && (transfer != NULL))
+    {
+        out = (CanardRxSharedPayload*) ins->memory_allocate(ins, sizeof(CanardRxSharedPayload));
+        if (out != NULL)
+        {
+            out->instance        = ins;
+            out->payload_size    = transfer->payload_size;
+            out->payload         = transfer->payload;
+            out->payload_offset  = transfer->payload_offset;
+            out->reference_count = 1U;
+        }
+    }
+    return out;
+}
+
+int8_t canardRxSharedPayloadAcquire(CanardRxSharedPayload* const shared)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if (shared != NULL)
+    {
+        const size_t count = CANARD_ATOMIC_INCREMENT(&shared->reference_count);
+        CANARD_ASSERT(count > 1U);  // The caller shall hold a reference already.
+        (void) count;
+        out = 0;
+    }
+    return out;
+}
+
+int8_t canardRxSharedPayloadRelease(CanardRxSharedPayload* const shared)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if (shared != NULL)
+    {
+        // Released more times than acquired? Checked before the decrement, which would wrap the counter around.
+        CANARD_ASSERT(CANARD_ATOMIC_LOAD(&shared->reference_count) > 0U);
+        const size_t count = CANARD_ATOMIC_DECREMENT(&shared->reference_count);
+        out = 0;
+        if (0U == count)
+        {
+            CanardInstance* const ins = shared->instance;
+            ins->memory_free(ins, shared->payload);
+            ins->memory_free(ins, shared);
+            out = 1;
+        }
+    }
+    return out;
+}
+
+int8_t canardRxUnsubscribe(CanardInstance* const    ins,
+                           const CanardTransferKind transfer_kind,
+                           const CanardPortID       port_id)
+{
+    int8_t       out = -CANARD_ERROR_INVALID_ARGUMENT;
+    const size_t tk  = (size_t) transfer_kind;
+    if ((ins != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS))
+    {
+        CanardPortID                port_id_mutable = port_id;
+        CanardRxSubscription* const sub             = (CanardRxSubscription*) (void*)
+            cavlSearch(&ins->rx_subscriptions[tk], &port_id_mutable, &rxSubscriptionPredicateOnPortID, NULL);
+        if (sub != NULL)
+        {
+            CANARD_ASSERT(sub->port_id == port_id);
+            if (NULL == ins->rx_subscription_table)
+            {
+                cavlRemove(&ins->rx_subscriptions[tk], &sub->base);
+                rxSubscriptionReleaseSessions(ins, sub);
+                out = 1;
+            }
+            else if (rxTablePublish(ins, tk, NULL, sub))
+            {
+                cavlRemove(&ins->rx_subscriptions[tk], &sub->base);
+                out = 1;  // The sessions will be released by the reader.
+            }
+            else
+            {
+                out = -CANARD_ERROR_OUT_OF_MEMORY;
             }
         }
         else
         {
-            out = maybe_can_id;
+            out = 0;
         }
     }
-    CANARD_ASSERT(out != 0);
     return out;
 }
 
-const CanardTxQueueItem* canardTxPeek(const CanardTxQueue* const que)
+int8_t canardRxSetDuplicateCache(CanardInstance* const         ins,
+                                 CanardRxDuplicateCache* const cache,
+                                 const CanardMicrosecond       window_usec)
 {
-    const CanardTxQueueItem* out = NULL;
-    if (que != NULL)
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if (ins != NULL)
     {
-        // Paragraph 6.7.2.1.15 of the C standard says:
-        //     A pointer to a structure object, suitably converted, points to its initial member, and vice versa.
-        out = (const CanardTxQueueItem*) (void*) cavlFindExtremum(que->root, false);
+        if (cache != NULL)
+        {
+            cache->window_usec      = window_usec;
+            cache->suppressed_count = 0U;
+            cache->evicted_count    = 0U;
+            for (size_t i = 0; i < CANARD_RX_DUPLICATE_CACHE_SLOTS; i++)
+            {
+                cache->timestamps[i] = 0U;
+                cache->can_ids[i]    = RX_DUPLICATE_CACHE_EMPTY;
+                cache->tails[i]      = 0U;
+                cache->transports[i] = 0U;
+            }
+        }
+        ins->rx_duplicate_cache = cache;
+        out                     = 0;
     }
     return out;
 }
 
-CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem* const item)
+int8_t canardRxSetTimerWheel(CanardInstance* const     ins,
+                             CanardRxTimerWheel* const wheel,
+                             const CanardMicrosecond   tick_usec)
 {
-    CanardTxQueueItem* out = NULL;
-    if ((que != NULL) && (item != NULL))
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && ((NULL == wheel) || (tick_usec > 0U)))
     {
-        // Intentional violation of MISRA: casting away const qualifier. This is considered safe because the API
-        // contract dictates that the pointer shall point to a mutable entity in RAM previously allocated by the
-        // memory manager. It is difficult to avoid this cast in this context.
-        out = (CanardTxQueueItem*) item;  // NOSONAR casting away const qualifier.
-        // Paragraph 6.7.2.1.15 of the C standard says:
-        //     A pointer to a structure object, suitably converted, points to its initial member, and vice versa.
-        // Note that the highest-priority frame is always a leaf node in the AVL tree, which means that it is very
-        // cheap to remove.
-        cavlRemove(&que->root, &item->base);
-        que->size--;
+        if (rxIsIdle(ins))
+        {
+            if (wheel != NULL)
+            {
+                wheel->tick_usec     = tick_usec;
+                wheel->current_tick  = 0U;
+                wheel->session_count = 0U;
+                for (size_t i = 0; i < CANARD_RX_TIMER_WHEEL_LEVELS; i++)
+                {
+                    wheel->occupancy[i] = 0U;
+                    for (size_t k = 0; k < CANARD_RX_TIMER_WHEEL_SLOTS; k++)
+                    {
+                        wheel->slots[i][k] = NULL;
+                    }
+                }
+                wheel->overflow      = NULL;
+                wheel->overflow_tick = 0U;
+            }
+            ins->rx_timer_wheel = wheel;
+            out                 = 0;
+        }
     }
     return out;
 }
 
-int8_t canardRxAccept(CanardInstance* const        ins,
-                      const CanardMicrosecond      timestamp_usec,
-                      const CanardFrame* const     frame,
-                      const uint8_t                redundant_transport_index,
-                      CanardRxTransfer* const      out_transfer,
-                      CanardRxSubscription** const out_subscription)
+int8_t canardRxSetSubscriptionTable(CanardInstance* const ins, CanardRxSubscriptionTable* const table)
 {
     int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
-    if ((ins != NULL) && (out_transfer != NULL) && (frame != NULL) && (frame->extended_can_id <= CAN_EXT_ID_MASK) &&
-        ((frame->payload != NULL) || (0 == frame->payload_size)))
+    if ((ins != NULL) && rxIsIdle(ins))
     {
-        RxFrameModel model = {0};
-        if (rxTryParseFrame(timestamp_usec, frame, &model))
+        if (ins->rx_subscription_table != NULL)
         {
-            if ((CANARD_NODE_ID_UNSET == model.destination_node_id) || (ins->node_id == model.destination_node_id))
+            (void) rxTableReclaim(ins);
+            ins->memory_free(ins, ins->rx_subscription_table->version);
+            ins->rx_subscription_table = NULL;
+        }
+        out = 0;
+        if (table != NULL)
+        {
+            RxSubscriptionSnapshot* const snap =
+                (RxSubscriptionSnapshot*) ins->memory_allocate(ins, sizeof(RxSubscriptionSnapshot));
+            if (snap != NULL)
             {
-                // This is the reason the function has a logarithmic time complexity of the number of subscriptions.
-                // Note also that this one of the two variable-complexity operations in the RX pipeline; the other one
-                // is memcpy(). Excepting these two cases, the entire RX pipeline contains neither loops nor recursion.
-                CanardRxSubscription* const sub =
-                    (CanardRxSubscription*) (void*) cavlSearch(&ins->rx_subscriptions[(size_t) model.transfer_kind],
-                                                               &model.port_id,
-                                                               &rxSubscriptionPredicateOnPortID,
-                                                               NULL);
-                if (out_subscription != NULL)
-                {
-                    *out_subscription = sub;  // Expose selected instance to the caller.
-                }
-                if (sub != NULL)
+                snap->next_retired = NULL;
+                snap->removed      = NULL;
+                for (size_t i = 0; i <= CANARD_NUM_TRANSFER_KINDS; i++)
                 {
-                    CANARD_ASSERT(sub->port_id == model.port_id);
-                    out = rxAcceptFrame(ins, sub, &model, redundant_transport_index, out_transfer);
-                }
-                else
-                {
-                    out = 0;  // No matching subscription.
+                    snap->offsets[i] = 0U;
                 }
+                table->version             = snap;
+                table->retired             = NULL;
+                table->retired_count       = 0U;
+                table->reclaimed_count     = 0U;
+                ins->rx_subscription_table = table;
             }
             else
             {
-                out = 0;  // Mis-addressed frame (normally it should be filtered out by the hardware).
+                out = -CANARD_ERROR_OUT_OF_MEMORY;
             }
         }
-        else
+    }
+    return out;
+}
+
+int32_t canardRxReclaim(CanardInstance* const ins)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (ins->rx_subscription_table != NULL))
+    {
+        out = rxTableReclaim(ins);
+    }
+    return out;
+}
+
+int8_t canardRxIsReclaimed(const CanardInstance* const ins)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (ins->rx_subscription_table != NULL))
+    {
+        const CanardRxSubscriptionTable* const table = ins->rx_subscription_table;
+        out = (CANARD_ATOMIC_LOAD(&table->reclaimed_count) == table->retired_count) ? 1 : 0;
+    }
+    return out;
+}
+
+int32_t canardRxExpire(CanardInstance* const ins, const CanardMicrosecond now_usec)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (ins->rx_timer_wheel != NULL))
+    {
+        if (ins->rx_subscription_table != NULL)
         {
-            out = 0;  // A non-Cyphal/CAN input frame.
+            (void) rxTableReclaim(ins);  // This is a quiescent point of the reader.
+        }
+        CanardRxTimerWheel* const wheel  = ins->rx_timer_wheel;
+        const uint64_t            target = now_usec / wheel->tick_usec;
+        out                              = 0;
+        // The ticks where there is nothing to do are skipped, so the number of iterations does not depend on the
+        // amount of time elapsed since the last invocation.
+        // The overflow list is processed at the last top-level wrap-around not later than the target: none of its
+        // deadlines precede the first wrap-around after the current time, and the passed-over deadlines are destroyed.
+        const uint_fast8_t top = (uint_fast8_t) (CANARD_RX_TIMER_WHEEL_LEVELS * RX_TIMER_BITS_PER_LEVEL);
+        while (wheel->current_tick < target)
+        {
+            uint64_t next = rxTimerFindNextTick(wheel, target);
+            if (wheel->overflow != NULL)
+            {
+                const uint64_t wrap = (target >> top) << top;
+                next                = ((wrap > wheel->current_tick) && (wrap < next)) ? wrap : next;
+            }
+            wheel->current_tick = next;
+            out += rxTimerProcessTick(ins);
         }
     }
-    CANARD_ASSERT(out <= 1);
     return out;
 }
 
-int8_t canardRxSubscribe(CanardInstance* const       ins,
-                         const CanardTransferKind    transfer_kind,
-                         const CanardPortID          port_id,
-                         const size_t                extent,
-                         const CanardMicrosecond     transfer_id_timeout_usec,
-                         CanardRxSubscription* const out_subscription)
+int8_t canardRxGetNextExpiration(const CanardInstance* const ins, CanardMicrosecond* const out_time_usec)
 {
-    int8_t       out = -CANARD_ERROR_INVALID_ARGUMENT;
-    const size_t tk  = (size_t) transfer_kind;
-    if ((ins != NULL) && (out_subscription != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS))
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (ins->rx_timer_wheel != NULL) && (out_time_usec != NULL))
     {
-        // Reset to the initial state. This is absolutely critical because the new payload size limit may be larger
-        // than the old value; if there are any payload buffers allocated, we may overrun them because they are shorter
-        // than the new payload limit. So we clear the subscription and thus ensure that no overrun may occur.
-        out = canardRxUnsubscribe(ins, transfer_kind, port_id);
-        if (out >= 0)
+        const CanardRxTimerWheel* const wheel = ins->rx_timer_wheel;
+        out                                   = 0;
+        if (wheel->session_count > 0U)
         {
-            out_subscription->transfer_id_timeout_usec = transfer_id_timeout_usec;
-            out_subscription->extent                   = extent;
-            out_subscription->port_id                  = port_id;
-            for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+            // The overflow list is due at the last top-level wrap-around not later than its earliest deadline,
+            // which is never before the first wrap-around after the current tick.
+            const uint_fast8_t top  = (uint_fast8_t) (CANARD_RX_TIMER_WHEEL_LEVELS * RX_TIMER_BITS_PER_LEVEL);
+            uint64_t           tick = rxTimerFindNextTick(wheel, UINT64_MAX);
+            if (wheel->overflow != NULL)
             {
-                // The sessions will be created ad-hoc. Normally, for a low-jitter deterministic system,
-                // we could have pre-allocated sessions here, but that requires too much memory to be feasible.
-                // We could accept an extra argument that would instruct us to pre-allocate sessions here?
-                out_subscription->sessions[i] = NULL;
+                const uint64_t first = ((wheel->current_tick >> top) + 1U) << top;
+                const uint64_t last  = (wheel->overflow_tick >> top) << top;
+                const uint64_t wrap  = (last > first) ? last : first;
+                tick                 = (wrap < tick) ? wrap : tick;
             }
-            const CanardTreeNode* const res = cavlSearch(&ins->rx_subscriptions[tk],
-                                                         out_subscription,
-                                                         &rxSubscriptionPredicateOnStruct,
-                                                         &avlTrivialFactory);
-            (void) res;
-            CANARD_ASSERT(res == &out_subscription->base);
-            out = (out > 0) ? 0 : 1;
+            *out_time_usec = (tick > (UINT64_MAX / wheel->tick_usec)) ? UINT64_MAX : (tick * wheel->tick_usec);
+            out            = 1;
         }
     }
     return out;
 }
 
-int8_t canardRxUnsubscribe(CanardInstance* const    ins,
-                           const CanardTransferKind transfer_kind,
-                           const CanardPortID       port_id)
+int8_t canardRxGetShard(const CanardTransferKind transfer_kind, const CanardPortID port_id, const uint8_t shard_count)
 {
-    int8_t       out = -CANARD_ERROR_INVALID_ARGUMENT;
-    const size_t tk  = (size_t) transfer_kind;
-    if ((ins != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS))
+    int8_t     out     = -CANARD_ERROR_INVALID_ARGUMENT;
+    const bool message = (CanardTransferKindMessage == transfer_kind);
+    const bool service = (CanardTransferKindRequest == transfer_kind) || (CanardTransferKindResponse == transfer_kind);
+    if ((shard_count > 0U) && (shard_count <= CANARD_RX_SHARD_COUNT_MAX) &&
+        ((message && (port_id <= CANARD_SUBJECT_ID_MAX)) || (service && (port_id <= CANARD_SERVICE_ID_MAX))))
     {
-        CanardPortID                port_id_mutable = port_id;
-        CanardRxSubscription* const sub             = (CanardRxSubscription*) (void*)
-            cavlSearch(&ins->rx_subscriptions[tk], &port_id_mutable, &rxSubscriptionPredicateOnPortID, NULL);
-        if (sub != NULL)
+        out = rxGetShard(service, port_id, shard_count);
+    }
+    return out;
+}
+
+int8_t canardRxGetFrameShard(const CanardFrame* const frame, const uint8_t shard_count)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((frame != NULL) && (frame->extended_can_id <= CAN_EXT_ID_MASK) && (shard_count > 0U) &&
+        (shard_count <= CANARD_RX_SHARD_COUNT_MAX))
+    {
+        const uint32_t can_id  = frame->extended_can_id;
+        const bool     service = (0 != (can_id & FLAG_SERVICE_NOT_MESSAGE));
+        const uint32_t port_id = service ? ((can_id >> OFFSET_SERVICE_ID) & CANARD_SERVICE_ID_MAX)
+                                         : ((can_id >> OFFSET_SUBJECT_ID) & CANARD_SUBJECT_ID_MAX);
+        out                    = rxGetShard(service, (CanardPortID) port_id, shard_count);
+    }
+    return out;
+}
+
+int8_t canardRxDispatcherInit(CanardRxDispatcher* const dispatcher,
+                              CanardRxFrameRing* const  rings,
+                              const uint8_t             shard_count)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((dispatcher != NULL) && (rings != NULL) && (shard_count > 0U) && (shard_count <= CANARD_RX_SHARD_COUNT_MAX))
+    {
+        dispatcher->rings       = rings;
+        dispatcher->shard_count = shard_count;
+        out                     = 0;
+    }
+    return out;
+}
+
+int8_t canardRxDispatch(CanardRxDispatcher* const dispatcher,
+                        const CanardMicrosecond   timestamp_usec,
+                        const CanardFrame* const  frame,
+                        const uint8_t             redundant_transport_index)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((dispatcher != NULL) && (frame != NULL) && ((frame->payload != NULL) || (frame->payload_size == 0U)) &&
+        (frame->payload_size <= CANARD_MTU_MAX))
+    {
+        const int8_t shard = canardRxGetFrameShard(frame, dispatcher->shard_count);
+        if (shard >= 0)
         {
-            cavlRemove(&ins->rx_subscriptions[tk], &sub->base);
-            CANARD_ASSERT(sub->port_id == port_id);
-            out = 1;
-            for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+            CanardRxFrameRing* const ring = &dispatcher->rings[shard];
+            CanardRxFrameSlot* const slot = canardRxFrameRingReserve(ring);
+            out                           = 0;
+            if (slot != NULL)
+            {
+                slot->timestamp_usec            = timestamp_usec;
+                slot->extended_can_id           = frame->extended_can_id;
+                slot->redundant_transport_index = redundant_transport_index;
+                slot->payload_size              = (uint8_t) frame->payload_size;
+                if (frame->payload_size > 0U)
+                {
+                    // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+                    // We ignore it because the safe functions are poorly supported; reliance on them may limit the
+                    // portability.
+                    (void) memcpy(&slot->payload[0], frame->payload, frame->payload_size);  // NOLINT
+                }
+                (void) canardRxFrameRingCommit(ring);
+                out = 1;
+            }
+        }
+    }
+    return out;
+}
+
+CanardFrameBits canardGetFrameBits(const CanardFrame* const frame, const bool fd, const bool bit_rate_switch)
+{
+    CanardFrameBits out = {0U, 0U, 0U};
+    if ((frame != NULL) && ((frame->payload != NULL) || (frame->payload_size == 0U)) &&
+        (frame->payload_size <= (fd ? CANARD_MTU_CAN_FD : CANARD_MTU_CAN_CLASSIC)))
+    {
+        out = busGetFrameBits(frame, fd, fd && bit_rate_switch);
+    }
+    return out;
+}
+
+uint32_t canardGetFrameDuration(const CanardBusTiming* const timing, const CanardFrame* const frame)
+{
+    uint32_t out = 0U;
+    if (timing != NULL)
+    {
+        CanardFrameBits bits = {0U, 0U, 0U};
+        out                  = busGetFrameDuration(timing, frame, &bits);
+    }
+    return out;
+}
+
+int8_t canardBusLoadMeterInit(CanardBusLoadMeter* const meter,
+                              const CanardBusTiming     timing,
+                              const CanardMicrosecond   window_usec)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((meter != NULL) && (timing.nominal_bit_rate > 0U) && (window_usec > 0U))
+    {
+        (void) memset(meter, 0, sizeof(CanardBusLoadMeter));
+        meter->timing      = timing;
+        meter->window_usec = window_usec;
+        out                = 0;
+    }
+    return out;
+}
+
+int8_t canardBusLoadMeterUpdate(CanardBusLoadMeter* const meter,
+                                const CanardMicrosecond   timestamp_usec,
+                                const CanardFrame* const  frame)
+{
+    int8_t          out      = -CANARD_ERROR_INVALID_ARGUMENT;
+    CanardFrameBits bits     = {0U, 0U, 0U};
+    uint32_t        duration = 0U;
+    if ((meter != NULL) && (meter->window_usec > 0U))
+    {
+        duration = busGetFrameDuration(&meter->timing, frame, &bits);
+    }
+    if ((meter != NULL) && (meter->window_usec > 0U) && ((frame == NULL) || (duration > 0U)))
+    {
+        out = 0;
+        if (!meter->window_started)
+        {
+            meter->window_start_usec = timestamp_usec;
+            meter->window_started    = true;
+        }
+        else if ((timestamp_usec >= meter->window_start_usec) &&
+                 ((timestamp_usec - meter->window_start_usec) >= meter->window_usec))
+        {
+            const CanardMicrosecond elapsed = timestamp_usec - meter->window_start_usec;
+            const uint64_t          scale   = PARTS_PER_MILLION / NANOSECONDS_PER_MICROSECOND;
+            const uint64_t          ppm     = (meter->window_busy_nsec * scale) / meter->window_usec;
+            meter->utilization_ppm          = (ppm < PARTS_PER_MILLION) ? (uint32_t) ppm : PARTS_PER_MILLION;
+            if (meter->utilization_ppm > meter->utilization_ppm_max)
+            {
+                meter->utilization_ppm_max = meter->utilization_ppm;  // Before it is superseded by an idle window.
+            }
+            if ((elapsed - meter->window_usec) >= meter->window_usec)
             {
-                ins->memory_free(ins, (sub->sessions[i] != NULL) ? sub->sessions[i]->payload : NULL);
-                ins->memory_free(ins, sub->sessions[i]);
-                sub->sessions[i] = NULL;
+                meter->utilization_ppm = 0U;  // The bus was idle during the last complete window.
             }
+            meter->window_start_usec = timestamp_usec - (elapsed % meter->window_usec);
+            meter->window_busy_nsec  = 0U;
+            out                      = 1;
         }
         else
         {
-            out = 0;
+            // The timestamp is within the current window or precedes it; the latter is accounted in the current one.
+        }
+        if (frame != NULL)
+        {
+            meter->window_busy_nsec += duration;
+            meter->busy_nsec += duration;
+            meter->frame_count++;
+            meter->stuff_bit_count += bits.stuff;
         }
     }
     return out;
@@ -72,6 +72,8 @@
 ///
 /// The library is purely reactive: it does not perform any background processing and does not require periodic
 /// servicing. Its internal state is only updated as a response to well-specified external events.
+/// Applications that prefer to release the memory held by stale RX sessions can do so by invoking canardRxExpire()
+/// whenever convenient; see canardRxSetTimerWheel().
 ///
 /// --------------------------------------------------------------------------------------------------------------------
 ///
@@ -131,6 +133,33 @@ extern "C" {
 /// different values per subscription (i.e., per data specifier) depending on its timing requirements.
 #define CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC 2000000UL
 
+/// The size of the cache line that separates the data written by the producers from the data written by the consumer
+/// in the lock-free queues (CanardTxSlotPool, CanardRxFrameRing) to avoid false sharing between them.
+/// It is also the alignment of the objects affected by CANARD_CACHE_LINE_ALIGNED.
+#ifndef CANARD_CACHE_LINE_SIZE
+#    define CANARD_CACHE_LINE_SIZE 64U
+#endif
+
+/// Define CANARD_CACHE_LINE_ALIGNED=1 to align CanardInstance, CanardTxQueue, and CanardRxSubscription at the cache
+/// line boundary and to round their size up to a multiple of the cache line, so that the objects serviced by different
+/// threads (e.g., one instance per CAN interface per core) never share a cache line, wherever they are placed.
+/// This costs up to one cache line of padding per object. The option shall be the same for the library and for all
+/// translation units that include this header, since it affects the layout of the public types.
+/// It requires C11, C++11, or a GCC-compatible compiler.
+#if defined(CANARD_CACHE_LINE_ALIGNED) && (CANARD_CACHE_LINE_ALIGNED != 0)
+#    if defined(__cplusplus)
+#        define CANARD_ALIGNED_TO_CACHE_LINE alignas(CANARD_CACHE_LINE_SIZE)
+#    elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#        define CANARD_ALIGNED_TO_CACHE_LINE _Alignas(CANARD_CACHE_LINE_SIZE)
+#    elif defined(__GNUC__)
+#        define CANARD_ALIGNED_TO_CACHE_LINE __attribute__((aligned(CANARD_CACHE_LINE_SIZE)))
+#    else
+#        error "CANARD_CACHE_LINE_ALIGNED is not supported by this compiler"
+#    endif
+#else
+#    define CANARD_ALIGNED_TO_CACHE_LINE
+#endif
+
 // Forward declarations.
 typedef struct CanardInstance    CanardInstance;
 typedef struct CanardTreeNode    CanardTreeNode;
@@ -234,17 +263,49 @@ typedef struct
     CanardTransferID transfer_id;
 } CanardTransferMetadata;
 
+/// The data structure that keeps the frames in a transmission queue ordered. The observable behavior of the queue does
+/// not depend on its kind: frames are always ordered by CAN ID, and frames with identical CAN ID are ordered FIFO.
+/// The kind is selected when the queue is constructed and cannot be changed afterwards.
+typedef enum
+{
+    /// An AVL tree. This is the default option that does not require any memory beyond the enqueued frames.
+    CanardTxQueueKindTree = 0,
+    /// A binary heap stored in a contiguous array provided by the application; see canardTxInitHeap().
+    /// The complexity is the same as that of the tree; the constant factor is lower for shallow queues because the heap
+    /// is maintained by moving pointers in contiguous memory rather than by rebalancing a linked structure.
+    CanardTxQueueKindHeap = 1,
+    /// A radix tree over the 29-bit CAN ID where every node carries a bitmap of its non-empty children;
+    /// see canardTxInitBitmap(). Frames with identical CAN ID are kept in a linked list in the leaf.
+    /// Every operation visits a fixed number of nodes regardless of the number of enqueued frames,
+    /// and the highest-priority frame is located with one count-trailing-zeros operation per tree level.
+    CanardTxQueueKindBitmap = 2,
+} CanardTxQueueKind;
+
+/// The number of children per node of the radix tree used by the queues of kind CanardTxQueueKindBitmap.
+#define CANARD_TX_BITMAP_FANOUT 32U
+
+/// A node of the radix tree used by the queues of kind CanardTxQueueKindBitmap. Nodes are never allocated by the
+/// library; instead, the application supplies an array of them to canardTxInitBitmap(). Do not access the fields.
+typedef struct CanardTxBitmapNode
+{
+    uint32_t mask;
+    void*    children[CANARD_TX_BITMAP_FANOUT];
+} CanardTxBitmapNode;
+
 /// Prioritized transmission queue that keeps CAN frames destined for transmission via one CAN interface.
 /// Applications with redundant interfaces are expected to have one instance of this type per interface.
 /// Applications that are not interested in transmission may have zero queues.
-/// All operations (push, peek, pop) are O(log n); there is exactly one heap allocation per element.
+/// All operations (push, peek, pop) are O(log n) for the tree and the heap, and O(1) for the bitmap queue;
+/// there is exactly one heap allocation per element. The optional deadline index (see canardTxSetDeadlineIndex())
+/// adds an O(log n) update to every push and pop regardless of the kind of the queue.
 /// API functions that work with this type are named "canardTx*()", find them below.
 typedef struct CanardTxQueue
 {
     /// The maximum number of frames this queue is allowed to contain. An attempt to push more will fail with an
     /// out-of-memory error even if the memory is not exhausted. This value can be changed by the user at any moment.
     /// The purpose of this limitation is to ensure that a blocked queue does not exhaust the heap memory.
-    size_t capacity;
+    /// Queues of the kind CanardTxQueueKindHeap are additionally limited by the length of their heap storage.
+    CANARD_ALIGNED_TO_CACHE_LINE size_t capacity;
 
     /// The transport-layer maximum transmission unit (MTU). The value can be changed arbitrarily at any time between
     /// pushes. It defines the maximum number of data bytes per CAN data frame in outgoing transfers via this queue.
@@ -261,8 +322,36 @@ typedef struct CanardTxQueue
     size_t size;
 
     /// The root of the priority queue is NULL if the queue is empty. Do not modify this field!
+    /// This field is only used if the kind of the queue is CanardTxQueueKindTree.
     CanardTreeNode* root;
 
+    /// The root of the tree that orders the enqueued frames by their transmission deadline regardless of the kind
+    /// of the queue; see canardTxPeekEarliestDeadline(). NULL if the queue is empty or the deadline index is disabled.
+    /// Do not modify this field!
+    CanardTreeNode* deadline_root;
+
+    /// True if the deadline index is maintained; see canardTxSetDeadlineIndex(). Do not modify this field!
+    bool deadline_index;
+
+    /// The kind of the ordering data structure used by this queue. Do not modify this field!
+    CanardTxQueueKind kind;
+
+    /// The storage of the binary heap and its length (in elements) as supplied to canardTxInitHeap().
+    /// The pointers are NULL/zero unless the kind of the queue is CanardTxQueueKindHeap. Do not modify these fields!
+    CanardTxQueueItem** heap;
+    size_t              heap_length;
+
+    /// Incremented with every frame enqueued into the heap; keeps frames with identical CAN ID in the FIFO order.
+    /// Do not modify this field!
+    uint32_t sequence;
+
+    /// The root of the radix tree, the list of unused nodes and its length. The nodes are supplied to
+    /// canardTxInitBitmap(). The fields are NULL/zero unless the kind of the queue is CanardTxQueueKindBitmap.
+    /// Do not modify these fields!
+    CanardTxBitmapNode* bitmap_root;
+    CanardTxBitmapNode* bitmap_free;
+    size_t              bitmap_free_count;
+
     /// This field can be arbitrarily mutated by the user. It is never accessed by the library.
     /// Its purpose is to simplify integration with OOP interfaces.
     void* user_reference;
@@ -271,8 +360,19 @@ typedef struct CanardTxQueue
 /// One frame stored in the transmission queue along with its metadata.
 struct CanardTxQueueItem
 {
-    /// Internal use only; do not access this field.
-    CanardTreeNode base;
+    /// Internal use only; do not access this field. Its use depends on the kind of the queue:
+    /// CanardTxQueueKindTree links the frame into the AVL tree;
+    /// CanardTxQueueKindBitmap uses the links of the node to keep frames with identical CAN ID in a list;
+    /// CanardTxQueueKindHeap keeps the position of the frame in the heap and its insertion sequence number.
+    union
+    {
+        CanardTreeNode node;
+        struct
+        {
+            size_t   index;
+            uint32_t sequence;
+        } heap;
+    } base;
 
     /// Points to the next frame in this transfer or NULL. This field is mostly intended for own needs of the library.
     /// Normally, the application would not use it because transfer frame ordering is orthogonal to global TX ordering.
@@ -289,6 +389,82 @@ struct CanardTxQueueItem
     CanardFrame frame;
 };
 
+/// A transfer stored in a CanardTxSlotPool by a producer that cannot invoke canardTxPush() itself, such as
+/// an interrupt handler; see canardTxSlotClaim(). The producer populates all fields except the first one
+/// and the payload size, which is set when the slot is claimed.
+/// The transfer always fits into a single frame of the MTU of the pool, so the payload array is sized for CAN FD,
+/// but only its first bytes are used with Classic CAN.
+typedef struct CanardTxSlot
+{
+    size_t                 sequence;  ///< Internal use only; do not access this field.
+    CanardMicrosecond      tx_deadline_usec;
+    CanardTransferMetadata metadata;
+    size_t                 payload_size;
+    uint8_t                payload[CANARD_MTU_MAX - 1U];  ///< One byte of the frame is taken by the tail byte.
+} CanardTxSlot;
+
+/// A lock-free bounded queue of transfers pending addition to a CanardTxQueue; see canardTxSlotPoolInit().
+/// Any number of producers (e.g., interrupt handlers of different priorities) may claim and commit slots concurrently;
+/// one consumer (the context that owns the TX queue) moves the committed transfers into the TX queue.
+/// The index claimed by the producers and the one advanced by the consumer are kept in separate cache lines.
+///
+/// The storage is supplied by the application. Do not access the fields except where stated otherwise.
+typedef struct CanardTxSlotPool
+{
+    CanardTxSlot* slots;
+    size_t        capacity;          ///< A power of two. Read-only.
+    size_t        payload_capacity;  ///< The largest single-frame payload at the MTU of the pool. Read-only.
+
+    uint8_t padding_0[CANARD_CACHE_LINE_SIZE];
+
+    size_t tail;  ///< Advanced by the producers.
+
+    /// The number of times a producer could not claim a slot because all of them were in use.
+    /// The application may read it at any time; it is incremented atomically by the producers.
+    size_t overrun_count;
+
+    uint8_t padding_1[CANARD_CACHE_LINE_SIZE];
+
+    size_t head;  ///< Advanced by the consumer.
+
+    /// The number of committed transfers that the consumer has discarded because canardTxPush() rejected them
+    /// for a reason other than running out of memory, or because their payload does not fit into a single frame.
+    /// Written by the consumer only.
+    size_t drop_count;
+
+    uint8_t padding_2[CANARD_CACHE_LINE_SIZE];
+} CanardTxSlotPool;
+
+/// The placement of the transfer payload within the buffers that are handed over to the application;
+/// see canardRxSetPayloadLayout(). The default layout is all zeros.
+typedef struct CanardRxPayloadLayout
+{
+    /// The payload is located at an address that is a multiple of this value, which shall be a power of two.
+    /// Zero or one means that the alignment is the same as that of the memory fragments returned by memory_allocate.
+    size_t alignment;
+
+    /// The number of bytes available for use by the application before the payload, e.g., to prepend a header.
+    size_t headroom;
+
+    /// The number of bytes available for use by the application after the extent, e.g., to append a trailer or to
+    /// allow wide vector loads to overrun the end of the payload.
+    size_t tailroom;
+} CanardRxPayloadLayout;
+
+/// The reception statistics of one redundant transport; see CanardRxSubscription::transport_stats.
+/// A transport wins a transfer if the first frame of the transfer is accepted from it; the first frames of the same
+/// transfer that arrive later via the other transports are the losses of those transports.
+typedef struct CanardRxTransportStats
+{
+    uint64_t wins;
+    uint64_t losses;
+
+    /// The total and the maximum delay of the lost first frames relative to the first frame of the winner.
+    /// The mean latency penalty of the transport is loss_delay_usec_total / losses.
+    CanardMicrosecond loss_delay_usec_total;
+    CanardMicrosecond loss_delay_usec_max;
+} CanardRxTransportStats;
+
 /// Transfer subscription state. The application can register its interest in a particular kind of data exchanged
 /// over the bus by creating such subscription objects. Frames that carry data for which there is no active
 /// subscription will be silently dropped by the library. The entire RX pipeline is invariant to the number of
@@ -296,16 +472,46 @@ struct CanardTxQueueItem
 ///
 /// SUBSCRIPTION INSTANCES SHALL NOT BE MOVED WHILE IN USE.
 ///
-/// The memory footprint of a subscription is large. On a 32-bit platform it slightly exceeds half a KiB.
+/// The memory footprint of a subscription is large. On a 32-bit platform it is about 0.6 KiB.
 /// This is an intentional time-memory trade-off: use a large look-up table to ensure predictable temporal properties.
 typedef struct CanardRxSubscription
 {
-    CanardTreeNode base;  ///< Read-only DO NOT MODIFY THIS
+    CANARD_ALIGNED_TO_CACHE_LINE CanardTreeNode base;  ///< Read-only DO NOT MODIFY THIS
 
     CanardMicrosecond transfer_id_timeout_usec;
+
+    /// The redundant transport fail-over timeout: if the current transport of a session has not started a transfer
+    /// for longer than this, the session switches to another transport as soon as the latter delivers the first frame
+    /// of a newer transfer. A transfer that is still being reassembled from the current transport is not restarted
+    /// when its own first frame arrives late via the other transport; the switch then happens with the next
+    /// transfer-ID. Set to the transfer-ID timeout on subscription, which disables the early fail-over.
+    /// It can be reduced at any time to speed up the recovery from a transport failure; it should be set somewhat
+    /// above the transfer period, otherwise the sessions alternate between the transports, which is harmless for
+    /// the duplicate suppression but may interrupt the multi-frame transfers that are being reassembled.
+    CanardMicrosecond failover_timeout_usec;
+
+    /// If true, each transfer is accepted from whichever redundant transport delivers its first frame first,
+    /// so that the reception latency is that of the fastest transport rather than that of the transport that
+    /// the session happened to lock onto. The duplicates are still suppressed by the transfer-ID: a first frame that
+    /// arrives via another transport takes over the session only if it belongs to a newer transfer than the one
+    /// that is being received or was received last. False on subscription; can be changed at any time.
+    bool first_arrival_wins;
+
+    /// Optional per-transport instrumentation indexed by redundant_transport_index, updated in all modes.
+    /// The transports whose index is not less than transport_stats_count are not accounted for.
+    /// NULL and zero on subscription; the application may set both at any time and read the statistics at any time.
+    CanardRxTransportStats* transport_stats;
+    size_t                  transport_stats_count;
+
     size_t            extent;   ///< Read-only DO NOT MODIFY THIS
     CanardPortID      port_id;  ///< Read-only DO NOT MODIFY THIS
 
+    /// True if the subscription was created by canardRxSubscribeSingleFrame(). Read-only DO NOT MODIFY THIS
+    bool single_frame;
+
+    /// See canardRxSetPayloadLayout(). Read-only DO NOT MODIFY THIS
+    CanardRxPayloadLayout payload_layout;
+
     /// This field can be arbitrarily mutated by the user. It is never accessed by the library.
     /// Its purpose is to simplify integration with OOP interfaces.
     void* user_reference;
@@ -317,9 +523,12 @@ typedef struct CanardRxSubscription
     /// allocation routines are assumed to be O(1) and we make at most one allocation per remote node.
     ///
     /// A more predictable and simpler approach is to pre-allocate states here statically instead of keeping
-    /// just pointers, but it would push the size of this instance from about 0.5 KiB to ~3 KiB for a typical 32-bit
+    /// just pointers, but it would push the size of this instance from about 0.6 KiB to ~3 KiB for a typical 32-bit
     /// system. Since this is a general-purpose library, we have to pick a middle ground so we use the more complex
     /// but more memory-efficient approach.
+    ///
+    /// The entries of single-frame subscriptions point to much smaller states that only hold the information needed
+    /// for duplicate suppression; see canardRxSubscribeSingleFrame().
     struct CanardInternalRxSession* sessions[CANARD_NODE_ID_MAX + 1U];  ///< Read-only DO NOT MODIFY THIS
 } CanardRxSubscription;
 
@@ -336,8 +545,171 @@ typedef struct CanardRxTransfer
     /// The application is required to deallocate the payload buffer after the transfer is processed.
     size_t payload_size;
     void*  payload;
+
+    /// The payload data begins this many bytes past the payload pointer, which always points to the beginning of
+    /// the buffer and is therefore the one to pass to memory_free. The offset is zero unless the subscription has
+    /// a non-default payload layout (see canardRxSetPayloadLayout()).
+    size_t payload_offset;
 } CanardRxTransfer;
 
+/// The payload buffer of a received transfer that is shared by multiple consumers; see canardRxSharePayload().
+/// The fields are read-only. The payload may be accessed by any holder of a reference until it is released.
+typedef struct CanardRxSharedPayload
+{
+    CanardInstance* instance;  ///< The memory_free of this instance is used to deallocate the buffer.
+    size_t          payload_size;
+    void*           payload;
+    size_t          payload_offset;   ///< Same as CanardRxTransfer::payload_offset.
+    size_t          reference_count;  ///< DO NOT MODIFY THIS
+} CanardRxSharedPayload;
+
+/// The number of levels and the number of slots per level of CanardRxTimerWheel.
+#define CANARD_RX_TIMER_WHEEL_LEVELS 3U
+#define CANARD_RX_TIMER_WHEEL_SLOTS 32U
+
+/// A hierarchical timer wheel that keeps the RX sessions ordered by their transfer-ID timeout deadline;
+/// see canardRxSetTimerWheel(). The slots of level 0 are one tick wide, and the slots of every next level are
+/// CANARD_RX_TIMER_WHEEL_SLOTS times wider than those of the level below. Deadlines that are too far in the future
+/// to be placed on the top level are kept in a separate overflow list until they come within reach.
+/// Every level has a bitmap of its non-empty slots, so the next occupied slot is located in constant time.
+///
+/// The storage is supplied by the application. Do not access the fields except where stated otherwise.
+typedef struct CanardRxTimerWheel
+{
+    CanardMicrosecond tick_usec;     ///< The width of a level 0 slot. Read-only.
+    uint64_t          current_tick;  ///< The time passed to the last canardRxExpire() in ticks. Read-only.
+    size_t            session_count;  ///< The number of RX sessions that currently exist. Read-only.
+
+    uint32_t occupancy[CANARD_RX_TIMER_WHEEL_LEVELS];
+    void*    slots[CANARD_RX_TIMER_WHEEL_LEVELS][CANARD_RX_TIMER_WHEEL_SLOTS];
+    void*    overflow;
+    uint64_t overflow_tick;  ///< Not later than the earliest deadline in the overflow list; valid if it is not empty.
+} CanardRxTimerWheel;
+
+/// The number of slots of CanardRxDuplicateCache; a power of two.
+#define CANARD_RX_DUPLICATE_CACHE_SLOTS 32U
+
+/// A small hash table of the recently received frames that suppresses the redundant duplicates of a frame before
+/// they are parsed and matched against the subscriptions; see canardRxSetDuplicateCache().
+/// Each slot holds the CAN ID and the tail byte of the last frame that hashed into it, along with the transport
+/// that delivered it and its timestamp; a newer frame simply overwrites the slot.
+///
+/// The storage is supplied by the application. Do not access the fields except where stated otherwise.
+typedef struct CanardRxDuplicateCache
+{
+    CanardMicrosecond window_usec;  ///< Read-only.
+
+    /// The number of frames dropped as duplicates. The application may reset it at any time.
+    uint64_t suppressed_count;
+
+    /// The number of entries that were overwritten within the window by frames with a different key. A large value
+    /// relative to suppressed_count means that the cache is too small for the traffic. May be reset at any time.
+    uint64_t evicted_count;
+
+    CanardMicrosecond timestamps[CANARD_RX_DUPLICATE_CACHE_SLOTS];
+    uint32_t          can_ids[CANARD_RX_DUPLICATE_CACHE_SLOTS];
+    uint8_t           tails[CANARD_RX_DUPLICATE_CACHE_SLOTS];
+    uint8_t           transports[CANARD_RX_DUPLICATE_CACHE_SLOTS];
+} CanardRxDuplicateCache;
+
+/// An index of the subscriptions that canardRxAccept() searches without locking while the subscriptions are being
+/// added and removed concurrently from another thread; see canardRxSetSubscriptionTable().
+/// Every change publishes a new immutable sorted snapshot of the subscriptions atomically; the replaced snapshots
+/// and the removed subscriptions are released later by the receiving thread when it is known not to use them.
+///
+/// The storage is supplied by the application. Do not access the fields.
+typedef struct CanardRxSubscriptionTable
+{
+    void*  version;          ///< The current snapshot.
+    void*  retired;          ///< The replaced snapshots that have not yet been reclaimed, newest first.
+    size_t retired_count;    ///< The number of subscriptions removed so far.
+    size_t reclaimed_count;  ///< The number of removed subscriptions whose sessions have been released.
+} CanardRxSubscriptionTable;
+
+/// A received CAN frame stored in place in a CanardRxFrameRing. The producer (e.g., the CAN interrupt handler or the
+/// driver thread) fills the fields directly, which avoids an intermediate copy of the payload.
+typedef struct CanardRxFrameSlot
+{
+    CanardMicrosecond timestamp_usec;
+    uint32_t          extended_can_id;
+    uint8_t           redundant_transport_index;
+    uint8_t           payload_size;
+    uint8_t           payload[CANARD_MTU_MAX];
+} CanardRxFrameSlot;
+
+/// A lock-free single-producer single-consumer queue of received CAN frames; see canardRxFrameRingInit().
+/// The producer runs in the interrupt or driver context and the consumer runs in the context that owns the instance.
+/// The indexes are free-running counters; the ones written by the producer and by the consumer are kept in separate
+/// cache lines together with a cached copy of the index of the other side, so that the sides only touch each other's
+/// cache line when the cached copy indicates that the ring is full or empty.
+///
+/// The storage is supplied by the application. Do not access the fields except where stated otherwise.
+typedef struct CanardRxFrameRing
+{
+    CanardRxFrameSlot* slots;
+    size_t             capacity;  ///< A power of two. Read-only.
+
+    uint8_t padding_0[CANARD_CACHE_LINE_SIZE];
+
+    size_t tail;        ///< Written by the producer.
+    size_t head_cache;  ///< The last known value of head; used by the producer.
+
+    /// The number of frames that the producer could not store because the ring was full.
+    /// The producer may read and reset it at any time.
+    uint64_t overrun_count;
+
+    uint8_t padding_1[CANARD_CACHE_LINE_SIZE];
+
+    size_t head;        ///< Written by the consumer.
+    size_t tail_cache;  ///< The last known value of tail; used by the consumer.
+
+    /// The number of frames that canardRxAcceptRing() dropped because canardRxAccept() ran out of memory.
+    /// The consumer may read and reset it at any time.
+    uint64_t oom_count;
+
+    uint8_t padding_2[CANARD_CACHE_LINE_SIZE];
+} CanardRxFrameRing;
+
+/// Routes the frames received by one producer to the shards through one frame ring per shard;
+/// see canardRxDispatcherInit(). Do not access the fields except where stated otherwise.
+typedef struct CanardRxDispatcher
+{
+    CanardRxFrameRing* rings;        ///< Indexed by the shard index. Read-only.
+    uint8_t            shard_count;  ///< Read-only.
+} CanardRxDispatcher;
+
+/// A received CAN frame held in a CanardRxBacklog.
+typedef struct CanardRxBacklogItem
+{
+    struct CanardRxBacklogItem* next;
+    CanardRxFrameSlot           frame;
+} CanardRxBacklogItem;
+
+/// A bounded buffer of received CAN frames that are passed to the instance in the order of their CAN priority;
+/// see canardRxBacklogInit(). There is one FIFO list per priority level and a list of the unused items.
+///
+/// The storage is supplied by the application. Do not access the fields except where stated otherwise.
+typedef struct CanardRxBacklog
+{
+    CanardRxBacklogItem* heads[CANARD_PRIORITY_MAX + 1U];
+    CanardRxBacklogItem* tails[CANARD_PRIORITY_MAX + 1U];
+    CanardRxBacklogItem* idle;
+
+    size_t size;  ///< The number of frames in the backlog. Read-only.
+
+    /// The number of frames that were not stored because the backlog was full of frames of the same or higher priority.
+    /// The application may read and reset it at any time.
+    uint64_t drop_count;
+
+    /// The number of lower-priority frames that were removed from the full backlog to make room for the new ones.
+    /// The application may read and reset it at any time.
+    uint64_t eviction_count;
+
+    /// The number of frames that canardRxAcceptBacklog() dropped because canardRxAccept() ran out of memory.
+    /// The application may read and reset it at any time.
+    uint64_t oom_count;
+} CanardRxBacklog;
+
 /// A pointer to the memory allocation function. The semantics are similar to malloc():
 ///     - The returned pointer shall point to an uninitialized block of memory that is at least "amount" bytes large.
 ///     - If there is not enough memory, the returned pointer shall be NULL.
@@ -361,7 +733,7 @@ struct CanardInstance
     /// User pointer that can link this instance with other objects.
     /// This field can be changed arbitrarily, the library does not access it after initialization.
     /// The default value is NULL.
-    void* user_reference;
+    CANARD_ALIGNED_TO_CACHE_LINE void* user_reference;
 
     /// The node-ID of the local node.
     /// Per the Cyphal Specification, the node-ID should not be assigned more than once.
@@ -374,15 +746,88 @@ struct CanardInstance
     /// functions have constant complexity O(1).
     ///
     /// The following API functions may allocate memory:   canardRxAccept(), canardTxPush().
-    /// The following API functions may deallocate memory: canardRxAccept(), canardRxSubscribe(), canardRxUnsubscribe().
+    /// The following API functions may deallocate memory: canardRxAccept(), canardRxSubscribe(), canardRxUnsubscribe(),
+    /// canardRxExpire().
+    /// If a subscription table is installed, see canardRxSetSubscriptionTable() for the differences.
     /// The exact memory requirement and usage model is specified for each function in its documentation.
     CanardMemoryAllocate memory_allocate;
     CanardMemoryFree     memory_free;
 
+    /// The RX sessions of the subscriptions whose extent exceeds this value do not allocate the payload buffer of the
+    /// full extent upfront. Instead, the buffer is sized to the amount of data received so far rounded up to the next
+    /// power of two (but not beyond the extent), and it is replaced with a larger one as more frames arrive,
+    /// moving the data received so far into it. The transfer is handed over to the application in the last such buffer,
+    /// which is at most twice the payload size; if the payload is empty, no buffer is allocated at all.
+    /// This is beneficial for subscriptions whose extent is much larger than the typical transfer, which is common
+    /// because the extent has to accommodate the worst case: the buffers no longer tie up the full extent per source
+    /// node. The cost is a logarithmic number of additional allocations and copies per multi-frame transfer.
+    /// The value can be changed at any time; it only affects the sessions that are created afterwards.
+    /// The default value is SIZE_MAX, meaning that the payload buffers are always allocated at the full extent.
+    size_t rx_adaptive_extent_threshold;
+
     /// Read-only DO NOT MODIFY THIS
     CanardTreeNode* rx_subscriptions[CANARD_NUM_TRANSFER_KINDS];
+
+    /// The timer wheel installed by canardRxSetTimerWheel(). The default value is NULL, meaning that RX sessions are
+    /// never destroyed until their subscription is removed.
+    /// Read-only DO NOT MODIFY THIS
+    CanardRxTimerWheel* rx_timer_wheel;
+
+    /// The duplicate frame cache installed by canardRxSetDuplicateCache(). The default value is NULL, meaning that
+    /// the redundant duplicates are rejected by the RX sessions as usual.
+    /// Read-only DO NOT MODIFY THIS
+    CanardRxDuplicateCache* rx_duplicate_cache;
+
+    /// The subscription table installed by canardRxSetSubscriptionTable(). The default value is NULL, meaning that
+    /// the subscriptions shall not be modified concurrently with the reception.
+    /// Read-only DO NOT MODIFY THIS
+    CanardRxSubscriptionTable* rx_subscription_table;
 };
 
+/// The bit timing of the bus used to compute the durations of the frames on the wire.
+typedef struct CanardBusTiming
+{
+    /// If true, all frames are CAN FD frames, otherwise they are Classic CAN frames.
+    bool fd;
+    /// The bit rate of the arbitration phase and of the Classic CAN frames, in bit/s; shall be positive.
+    uint32_t nominal_bit_rate;
+    /// The bit rate of the data phase of the CAN FD frames, in bit/s; zero if the bit rate switching is not used.
+    uint32_t data_bit_rate;
+} CanardBusTiming;
+
+/// The number of bits of a frame on the wire including the stuff bits, the ACK slot, and the interframe space.
+/// See canardGetFrameBits().
+typedef struct CanardFrameBits
+{
+    uint16_t nominal;  ///< Transmitted at the nominal bit rate.
+    uint16_t data;     ///< Transmitted at the data bit rate; nonzero only for CAN FD with the bit rate switching.
+    uint16_t stuff;    ///< The number of the stuff bits among the above, including the fixed stuff bits of CAN FD.
+} CanardFrameBits;
+
+/// Measures the bus utilization from the frames seen on the bus; see canardBusLoadMeterInit().
+/// The utilization is averaged over consecutive windows of the specified duration.
+typedef struct CanardBusLoadMeter
+{
+    /// These can be changed at any time; the changes take effect with the next frame and the next window.
+    /// The window shall be positive.
+    CanardBusTiming   timing;
+    CanardMicrosecond window_usec;
+
+    /// The fraction of the time the bus was busy during the last complete window, in parts per million,
+    /// and the maximum thereof. The application may reset the maximum at any time.
+    uint32_t utilization_ppm;
+    uint32_t utilization_ppm_max;
+
+    /// The totals since initialization. The application may read and reset them at any time.
+    uint64_t frame_count;
+    uint64_t busy_nsec;
+    uint64_t stuff_bit_count;
+
+    CanardMicrosecond window_start_usec;  ///< Read-only DO NOT MODIFY THIS
+    uint64_t          window_busy_nsec;   ///< Read-only DO NOT MODIFY THIS
+    bool              window_started;     ///< Read-only DO NOT MODIFY THIS
+} CanardBusLoadMeter;
+
 /// CAN acceptance filter configuration with an extended 29-bit ID utilizing an ID + mask filter scheme.
 /// Filter configuration can be programmed into a CAN controller to filter out irrelevant messages in hardware.
 /// This allows the software application to reduce CPU load spent on processing irrelevant messages.
@@ -417,6 +862,67 @@ CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const Cana
 /// The time complexity is constant. This function does not invoke the dynamic memory manager.
 CanardTxQueue canardTxInit(const size_t capacity, const size_t mtu_bytes);
 
+/// This is like canardTxInit() except that the constructed queue is of the kind CanardTxQueueKindHeap.
+/// The frames are ordered using a binary heap that is kept in the array supplied by the application; the array shall
+/// contain at least heap_length elements and it shall not be moved or destroyed while the queue is in use.
+/// The contents of the array need not be initialized. The effective capacity of the queue never exceeds heap_length,
+/// even if the capacity field is set to a greater value later.
+///
+/// The ordering of frames is identical to that of the tree-based queue, so the kinds are interchangeable.
+/// The heap is preferable in applications where the queue is usually shallow (up to ca. a few hundred frames).
+/// Deeper queues are served better by the tree or by the bitmap queue (see canardTxInitBitmap()) because every
+/// comparison performed by the heap dereferences a queue item, which is costly when the items do not fit in cache.
+/// The position of a frame in the heap is kept in the storage of the tree node that is not used by this kind of queue,
+/// so the frames are of the same size regardless of the kind of the queue.
+///
+/// If the heap pointer is NULL, the heap length is forced to zero, so that any attempt to push will fail.
+///
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+CanardTxQueue canardTxInitHeap(const size_t              capacity,
+                               const size_t              mtu_bytes,
+                               CanardTxQueueItem** const heap,
+                               const size_t              heap_length);
+
+/// This is like canardTxInit() except that the constructed queue is of the kind CanardTxQueueKindBitmap.
+/// The frames are ordered using a radix tree whose nodes are taken from the array supplied by the application;
+/// the array shall not be moved or destroyed while the queue is in use. The contents need not be initialized.
+/// Frames sharing the same CAN ID share the same tree path, so the number of nodes in use depends only on the
+/// number of distinct CAN IDs in the queue, not on the number of frames. A path takes at most 6 nodes, and the
+/// nodes closer to the root are shared between CAN IDs with common prefixes; hence, a queue containing N distinct
+/// CAN IDs needs at most (1 + 5*N) nodes. A push that would require more nodes than available fails with
+/// CANARD_ERROR_OUT_OF_MEMORY, like a push that would exceed the capacity of the queue.
+///
+/// The ordering of frames is identical to that of the tree-based queue, so the kinds are interchangeable.
+/// The bitmap queue is preferable when the queue can become deep, e.g., if the bus is saturated, because the
+/// worst-case cost of every operation is bounded and small. canardTxPeek() and canardTxPop() cost 6 node visits,
+/// canardTxPush() the same per frame. This does not hold if the deadline index is enabled
+/// (see canardTxSetDeadlineIndex()), which is ordered by a tree.
+///
+/// If the nodes pointer is NULL, the number of nodes is forced to zero, so that any attempt to push will fail.
+///
+/// The time complexity is linear of node_count. This function does not invoke the dynamic memory manager.
+CanardTxQueue canardTxInitBitmap(const size_t              capacity,
+                                 const size_t              mtu_bytes,
+                                 CanardTxBitmapNode* const nodes,
+                                 const size_t              node_count);
+
+/// This function enables or disables the deadline index of the queue, which orders the enqueued frames by their
+/// transmission deadline in addition to the transmission order; see canardTxPeekEarliestDeadline().
+/// The index is disabled by default because it adds an O(log n) tree update to every canardTxPush() and canardTxPop()
+/// regardless of the kind of the queue. Applications that do not need to know the earliest deadline should keep it
+/// disabled; those that do are expected to enable it right after the queue is constructed.
+///
+/// The setting can only be changed while the queue is empty, because the frames of a queue with the deadline index
+/// are larger than those of a queue without it: every frame carries a tree node after its payload, which takes
+/// 20 extra bytes plus alignment padding on a typical 32-bit platform; this shall be accounted for in the memory
+/// requirement model given in the documentation for canardTxPush().
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if the queue is NULL or
+/// it is not empty.
+///
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int8_t canardTxSetDeadlineIndex(CanardTxQueue* const que, const bool enabled);
+
 /// This function serializes a transfer into a sequence of transport frames and inserts them into the prioritized
 /// transmission queue at the appropriate position. Afterwards, the application is supposed to take the enqueued frames
 /// from the transmission queue using the function canardTxPeek() and transmit them. Each transmitted (or otherwise
@@ -461,7 +967,8 @@ CanardTxQueue canardTxInit(const size_t capacity, const size_t mtu_bytes);
 ///
 /// The memory allocation requirement is one allocation per transport frame. A single-frame transfer takes one
 /// allocation; a multi-frame transfer of N frames takes N allocations. The size of each allocation is
-/// (sizeof(CanardTxQueueItem) + MTU).
+/// (sizeof(CanardTxQueueItem) + MTU), plus the size of the deadline index node if the index is enabled
+/// (see canardTxSetDeadlineIndex()).
 int32_t canardTxPush(CanardTxQueue* const                que,
                      CanardInstance* const               ins,
                      const CanardMicrosecond             tx_deadline_usec,
@@ -493,6 +1000,21 @@ int32_t canardTxPush(CanardTxQueue* const                que,
 /// The time complexity is logarithmic of the queue size. This function does not invoke the dynamic memory manager.
 const CanardTxQueueItem* canardTxPeek(const CanardTxQueue* const que);
 
+/// This function accesses the element of the transmission queue that has the earliest transmission deadline
+/// (tx_deadline_usec), regardless of its priority. Frames with identical deadlines are returned in the order they were
+/// pushed. The queue itself is not modified; the ownership and lifetime rules are the same as for canardTxPeek().
+///
+/// This is intended for event-driven applications: the deadline of the returned frame is the moment when the
+/// application needs to wake up to discard timed-out frames (if it is not awakened earlier by other events),
+/// e.g., by arming a timerfd. All frames whose deadline has passed can be discarded by invoking this function followed
+/// by canardTxPop() until the returned frame is not yet timed out.
+///
+/// The deadline index shall be enabled using canardTxSetDeadlineIndex(); otherwise, the returned value is NULL.
+/// If the queue is empty or if the argument is NULL, the returned value is NULL.
+///
+/// The time complexity is logarithmic of the queue size. This function does not invoke the dynamic memory manager.
+const CanardTxQueueItem* canardTxPeekEarliestDeadline(const CanardTxQueue* const que);
+
 /// This function transfers the ownership of the specified element of the prioritized transmission queue from the queue
 /// to the application. The element does not necessarily need to be the top one -- it is safe to dequeue any element.
 /// The element is dequeued but not invalidated; it is the responsibility of the application to deallocate the
@@ -504,6 +1026,62 @@ const CanardTxQueueItem* canardTxPeek(const CanardTxQueue* const que);
 /// The time complexity is logarithmic of the queue size. This function does not invoke the dynamic memory manager.
 CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem* const item);
 
+/// This function initializes a pool of transfer slots over the array supplied by the application, whose number shall
+/// be a power of two. The pool shall not be moved or destroyed while it is in use; its contents need not be
+/// initialized. The pool does not depend on any instance or queue, but the MTU should equal that of the TX queue the
+/// pool is drained into: the pool only accepts the transfers that fit into a single frame of this MTU, so that every
+/// slot turns into exactly one queue item.
+///
+/// The pool allows publishing short transfers (see CanardTxSlot) from contexts where canardTxPush() cannot be used
+/// because it invokes the dynamic memory manager and reorganizes the queue, most notably from interrupt handlers.
+/// Such a producer claims a slot via canardTxSlotClaim(), populates it in place, and makes it available to the consumer
+/// via canardTxSlotCommit(). The consumer, which is the context that owns the TX queue, later invokes
+/// canardTxPushSlots() to push the committed transfers into the TX queue in the order in which they were claimed.
+///
+/// The producers never block and never invoke the dynamic memory manager. A claim takes a constant number of steps
+/// except that it is retried if another producer claimed the same slot at the same time; on a single-core system,
+/// the number of retries is thus bounded by the number of producers that can preempt it (the interrupt nesting depth).
+/// Committing a slot is a single store. The atomic operations are provided by the GCC/Clang built-ins by default;
+/// see CANARD_ATOMIC_LOAD et al. in canard.c for other compilers.
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if any of the pointers
+/// are NULL or the capacity is not a power of two.
+///
+/// The time complexity is linear of the capacity.
+int8_t canardTxSlotPoolInit(CanardTxSlotPool* const pool,
+                            CanardTxSlot* const     slots,
+                            const size_t            capacity,
+                            const size_t            mtu_bytes);
+
+/// Producer side. Claims the next slot of the pool for the producer to populate and commit. The slots are claimed in
+/// a circular order; a slot that is claimed but not committed holds up the consumer (but not the producers) until it
+/// is committed, so the producer shall always commit the claimed slot, and it shall do so promptly.
+/// The payload size of the claimed slot is set to the specified value.
+///
+/// Returns NULL if all slots are in use, in which case the overrun counter of the pool is incremented.
+/// Returns NULL without claiming a slot if the pool is NULL or the payload does not fit into a single frame
+/// of the MTU of the pool; such a transfer shall be published via canardTxPush() instead.
+CanardTxSlot* canardTxSlotClaim(CanardTxSlotPool* const pool, const size_t payload_size);
+
+/// Producer side. Makes the populated slot available to the consumer. The slot shall not be accessed afterwards.
+/// Returns zero on success or a negated invalid argument error if the argument is NULL.
+int8_t canardTxSlotCommit(CanardTxSlot* const slot);
+
+/// Consumer side. Pushes the committed transfers from the pool into the TX queue by invoking canardTxPush() for
+/// each of them in the order of claiming, and releases their slots back to the producers. The processing stops at
+/// the first slot that is not yet committed, or after the number of slots equal to the capacity of the pool has been
+/// processed, which bounds the execution time of the function if the producers keep committing new transfers.
+///
+/// Each transfer takes exactly one frame. If the TX queue runs out of memory, the processing stops and the transfer
+/// is kept in its slot to be retried on the next invocation. A transfer that is rejected for any other reason
+/// (for example, its metadata is invalid, or its payload size was changed after claiming and no longer fits into
+/// a single frame of the TX queue) is dropped and counted in the drop counter of the pool, and the processing goes on.
+///
+/// The return value is the number of frames pushed into the TX queue by this invocation, which may be zero;
+/// the failures described above do not affect it.
+/// The return value is a negated invalid argument error if any of the pointers are NULL.
+int32_t canardTxPushSlots(CanardTxQueue* const que, CanardInstance* const ins, CanardTxSlotPool* const pool);
+
 /// This function implements the transfer reassembly logic. It accepts a transport frame from any of the redundant
 /// interfaces, locates the appropriate subscription state, and, if found, updates it. If the frame completed a
 /// transfer, the return value is 1 (one) and the out_transfer pointer is populated with the parameters of the
@@ -532,6 +1110,9 @@ CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem
 ///        Real-time networks typically do not change their configuration at runtime, so it is possible to reduce
 ///        the time complexity by never deallocating sessions.
 ///        The size of a session instance is at most 48 bytes on any conventional platform (typically much smaller).
+///        It can be reduced further by building the library with CANARD_RX_COMPACT_SESSION=1 (see canard.c).
+///        If a timer wheel is installed (see canardRxSetTimerWheel()), sessions are also destroyed by
+///        canardRxExpire() once their transfer-ID timeout has expired.
 ///
 ///     2. New memory for the transfer payload buffer is allocated when a new transfer is initiated, unless the buffer
 ///        was already allocated at the time.
@@ -539,6 +1120,8 @@ CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem
 ///        new transfer (that is, the start-of-frame flag is set and it is not a duplicate).
 ///        The amount of the allocated memory equals the extent as configured via canardRxSubscribe(); please read
 ///        its documentation for further information about the extent and related edge cases.
+///        If the extent exceeds CanardInstance::rx_adaptive_extent_threshold, the buffer is smaller than the extent
+///        and it may be reallocated with every received frame; it never exceeds the extent.
 ///        The worst case occurs when every node on the bus initiates a multi-frame transfer for which there is a
 ///        matching subscription: in this case, the library will allocate number_of_nodes allocations, where each
 ///        allocation is the same size as the configured extent.
@@ -567,15 +1150,18 @@ CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem
 /// active subscriptions for a given transfer kind, and the MTU, both of which are easy to predict and account for.
 /// Excepting the subscription search and the payload data copying, the entire RX pipeline contains neither loops
 /// nor recursion.
-/// Misaddressed and malformed frames are discarded in constant time.
+/// Misaddressed and malformed frames are discarded in constant time, and so are the redundant duplicates that are
+/// suppressed by the duplicate frame cache (see canardRxSetDuplicateCache()); the subscription is not reported via
+/// out_subscription for such frames.
 ///
 /// The function returns 1 (one) if the new frame completed a transfer. In this case, the details of the transfer
 /// are stored into out_transfer, and the transfer payload buffer ownership is passed to that object. The lifetime
 /// of the resulting transfer object is not related to the lifetime of the input transport frame (that is, even if
 /// it is a single-frame transfer, its payload is copied out into a new dynamically allocated buffer storage).
 /// If the extent is zero, the payload pointer may be NULL, since there is no data to store and so a
-/// buffer is not needed. The application is responsible for deallocating the payload buffer when the processing
-/// is done by invoking memory_free on the transfer payload pointer.
+/// buffer is not needed; the same applies to empty payloads if the buffer is not allocated at the full extent
+/// (see rx_adaptive_extent_threshold in CanardInstance). The application is responsible for
+/// deallocating the payload buffer when the processing is done by invoking memory_free on the transfer payload pointer.
 ///
 /// The function returns a negated out-of-memory error if it was unable to allocate dynamic memory.
 ///
@@ -597,6 +1183,108 @@ int8_t canardRxAccept(CanardInstance* const        ins,
                       CanardRxTransfer* const      out_transfer,
                       CanardRxSubscription** const out_subscription);
 
+/// This function initializes a frame ring over the array of slots supplied by the application, whose number shall be
+/// a power of two. The ring shall not be moved or destroyed while it is in use; its contents need not be initialized.
+/// The ring can hold one frame per slot. It does not depend on any instance.
+///
+/// The frames are stored by the producer as follows: canardRxFrameRingReserve() returns the next free slot, which the
+/// producer fills in place, and canardRxFrameRingCommit() makes it visible to the consumer. The consumer either passes
+/// the frames to the instance in batches via canardRxAcceptRing(), or processes them one by one via
+/// canardRxFrameRingPeek() and canardRxFrameRingPop(). The payload of the slot is never copied by the ring itself;
+/// canardRxAccept() reads it directly from the slot, which remains owned by the consumer until it is popped.
+///
+/// The producer and the consumer may run concurrently, including in an interrupt handler and in the main context,
+/// as long as there is only one of each at a time. The atomic operations are provided by the GCC/Clang built-ins
+/// by default; see CANARD_ATOMIC_LOAD et al. in canard.c for other compilers. No function of the ring blocks or
+/// invokes the dynamic memory manager, except that canardRxAcceptRing() invokes canardRxAccept().
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if any of the pointers
+/// are NULL or the capacity is not a power of two.
+///
+/// The time complexity of all functions of the ring is constant, excepting canardRxAcceptRing().
+int8_t canardRxFrameRingInit(CanardRxFrameRing* const ring, CanardRxFrameSlot* const slots, const size_t capacity);
+
+/// Producer side. Returns the next free slot for the producer to fill, or NULL if the ring is full or the argument is
+/// NULL. The same slot is returned until it is committed. If the ring is full, the overrun counter is incremented,
+/// on the assumption that the frame is then dropped.
+CanardRxFrameSlot* canardRxFrameRingReserve(CanardRxFrameRing* const ring);
+
+/// Producer side. Makes the slot returned by canardRxFrameRingReserve() visible to the consumer.
+/// Returns zero on success or a negated invalid argument error if the argument is NULL or the ring is full.
+int8_t canardRxFrameRingCommit(CanardRxFrameRing* const ring);
+
+/// Consumer side. Returns the oldest committed slot, or NULL if the ring is empty or the argument is NULL.
+/// The slot is not reused by the producer until it is popped.
+const CanardRxFrameSlot* canardRxFrameRingPeek(CanardRxFrameRing* const ring);
+
+/// Consumer side. Releases the oldest committed slot back to the producer.
+/// Returns zero on success or a negated invalid argument error if the argument is NULL or the ring is empty.
+int8_t canardRxFrameRingPop(CanardRxFrameRing* const ring);
+
+/// Consumer side. This is a batch variant of canardRxAccept() that consumes the frames from the ring, passing each one
+/// to canardRxAccept() directly from its slot, until the ring is empty or the specified number of transfers has been
+/// received. The received transfers are stored into the array in the order of reception; their ownership is the same
+/// as with canardRxAccept(). The frames that canardRxAccept() fails to process due to running out of memory are dropped
+/// and counted in CanardRxFrameRing::oom_count, which is the same outcome as with canardRxAccept().
+///
+/// The return value is the number of transfers stored into the array. The return value is a negated invalid argument
+/// error if any of the pointers are NULL or the capacity of the array is zero.
+///
+/// The time complexity is that of canardRxAccept() times the number of consumed frames, which is bounded by the
+/// capacity of the ring if the producer is slower than the consumer.
+int32_t canardRxAcceptRing(CanardInstance* const    ins,
+                           CanardRxFrameRing* const ring,
+                           CanardRxTransfer* const  out_transfers,
+                           const size_t             capacity);
+
+/// This function initializes a backlog over the array of items supplied by the application; the backlog can hold
+/// one frame per item. Neither the backlog nor the items shall be moved or destroyed while in use.
+/// The backlog does not depend on any instance.
+///
+/// The backlog is an ingress stage for the cases where the receiving context may fall behind the bus: instead of
+/// passing every frame to canardRxAccept() in the order of arrival, the application stores the received frames into
+/// the backlog via canardRxBacklogPush() (e.g., by draining its driver buffers or a CanardRxFrameRing completely)
+/// and then lets canardRxAcceptBacklog() pass them to the instance highest priority first, so that the latency of
+/// high-priority transfers does not depend on the amount of low-priority traffic awaiting processing. If the backlog
+/// is full, the oldest frame of the lowest priority level below that of the new frame is dropped to make room for it.
+///
+/// The order of arrival is preserved among the frames of the same priority level. Since the CAN ID of a Cyphal frame
+/// contains its priority, all frames of a transfer, and all transfers of a session that keep the same priority, which
+/// is the norm, are processed in the order of arrival. Transfers of different priority levels overtake each other.
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if any of the pointers
+/// are NULL or the capacity is zero.
+///
+/// The time complexity of this function is linear of the capacity; that of the other functions of the backlog is
+/// constant, excepting canardRxAcceptBacklog(). The backlog is not thread-safe.
+int8_t canardRxBacklogInit(CanardRxBacklog* const backlog, CanardRxBacklogItem* const items, const size_t capacity);
+
+/// Copies the received frame into the backlog. The arguments are the same as those of canardRxAccept().
+///
+/// The return value is 1 if the frame is stored, which may have caused the eviction of a lower-priority frame,
+/// and 0 if it is dropped because the backlog is full of frames of the same or higher priority.
+/// The return value is a negated invalid argument error if any of the pointers are NULL (excepting the payload of
+/// an empty frame) or the payload exceeds CANARD_MTU_MAX.
+int8_t canardRxBacklogPush(CanardRxBacklog* const   backlog,
+                           const CanardMicrosecond  timestamp_usec,
+                           const CanardFrame* const frame,
+                           const uint8_t            redundant_transport_index);
+
+/// This is a batch variant of canardRxAccept() that consumes the frames from the backlog highest priority first
+/// until the backlog is empty or the specified number of transfers has been received. In other respects it behaves
+/// like canardRxAcceptRing(); the frames dropped due to running out of memory are counted in
+/// CanardRxBacklog::oom_count. Limiting the number of transfers per call allows the application to keep storing
+/// the newly received frames in between, so that they can overtake the remaining lower-priority frames.
+///
+/// The return value is the number of transfers stored into the array. The return value is a negated invalid argument
+/// error if any of the pointers are NULL or the capacity of the array is zero.
+///
+/// The time complexity is that of canardRxAccept() times the number of consumed frames.
+int32_t canardRxAcceptBacklog(CanardInstance* const   ins,
+                              CanardRxBacklog* const  backlog,
+                              CanardRxTransfer* const out_transfers,
+                              const size_t            capacity);
+
 /// This function creates a new subscription, allowing the application to register its interest in a particular
 /// category of transfers. The library will reject all transport frames for which there is no active subscription.
 /// The reference out_subscription shall retain validity until the subscription is terminated (the referred object
@@ -613,8 +1301,8 @@ int8_t canardRxAccept(CanardInstance* const        ins,
 /// whether its payload is truncated.
 ///
 /// The default transfer-ID timeout value is defined as CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC; use it if not sure.
-/// The redundant transport fail-over timeout (if redundant transports are used) is the same as the transfer-ID timeout.
-/// It may be reduced in a future release of the library, but it will not affect the backward compatibility.
+/// The redundant transport fail-over timeout (if redundant transports are used) is initialized to the transfer-ID
+/// timeout; it may be reduced afterwards via CanardRxSubscription::failover_timeout_usec.
 ///
 /// The return value is 1 if a new subscription has been created as requested.
 /// The return value is 0 if such subscription existed at the time the function was invoked. In this case,
@@ -624,6 +1312,7 @@ int8_t canardRxAccept(CanardInstance* const        ins,
 /// The time complexity is logarithmic from the number of current subscriptions under the specified transfer kind.
 /// This function does not allocate new memory. The function may deallocate memory if such subscription already
 /// existed; the deallocation behavior is specified in the documentation for canardRxUnsubscribe().
+/// If a subscription table is installed, see canardRxSetSubscriptionTable() for the differences.
 ///
 /// Subscription instances have large look-up tables to ensure that the temporal properties of the algorithms are
 /// invariant to the network configuration (i.e., a node that is validated on a network containing one other node
@@ -635,6 +1324,79 @@ int8_t canardRxSubscribe(CanardInstance* const       ins,
                          const CanardMicrosecond     transfer_id_timeout_usec,
                          CanardRxSubscription* const out_subscription);
 
+/// This function is like canardRxSubscribe() except that the new subscription accepts only single-frame transfers.
+/// It is intended for subjects and services whose payload is guaranteed to fit into one frame, such as heartbeats.
+/// The frames of multi-frame transfers are silently dropped without being processed.
+///
+/// A single-frame transfer is delivered as soon as its frame is accepted, so there is nothing to reassemble and the
+/// multi-frame reassembly state machine is bypassed entirely. Instead of a full session state, only the transfer-ID,
+/// the timestamp, and the redundant transport index of the last transfer from each source are kept for duplicate
+/// suppression; this state occupies 16 bytes or less on all conventional platforms (8 bytes with
+/// CANARD_RX_COMPACT_SESSION) instead of the size of a full session state.
+/// The payload is copied out into a new buffer of the size min(extent, payload size) for each accepted transfer;
+/// no buffer is allocated if this size is zero. The duplicate suppression and the redundant transport fail-over
+/// behave exactly like in regular subscriptions.
+///
+/// The single-frame states are not tracked by the timer wheel (see canardRxSetTimerWheel()) because they are too
+/// small to be worth reclaiming; they are kept until the subscription is removed.
+///
+/// The arguments, the return values, and the complexity are the same as those of canardRxSubscribe().
+int8_t canardRxSubscribeSingleFrame(CanardInstance* const       ins,
+                                    const CanardTransferKind    transfer_kind,
+                                    const CanardPortID          port_id,
+                                    const size_t                extent,
+                                    const CanardMicrosecond     transfer_id_timeout_usec,
+                                    CanardRxSubscription* const out_subscription);
+
+/// This function configures the placement of the payload within the buffers of the transfers that are received via
+/// the specified subscription, so that the application can process and forward the payload in place without copying:
+/// e.g., SIMD deserializers may require aligned data, and gateways may prepend a header before forwarding.
+/// The payload buffer is allocated larger than the extent to accommodate the headroom, the tailroom, and the padding
+/// required for the alignment, the latter being at most alignment-1 bytes. The payload pointer of the received
+/// transfers still refers to the beginning of the buffer, so that it is deallocated as usual; the payload data is
+/// located CanardRxTransfer::payload_offset bytes past it, which includes the headroom and the alignment padding.
+///
+/// The layout applies to all transfers received via the subscription, including the anonymous and the single-frame
+/// ones. Empty payloads of transfers that are delivered without a buffer of the full extent are still delivered
+/// without a buffer. The adaptive payload buffers (see CanardInstance::rx_adaptive_extent_threshold) are not used
+/// with a non-default layout because they would require copying the payload.
+///
+/// The layout can only be changed while the subscription has no sessions, that is, right after it is created by
+/// canardRxSubscribe() or canardRxSubscribeSingleFrame(), which reset the layout to the default.
+///
+/// The return value is a negated invalid argument error if any of the pointers are NULL, if the subscription has
+/// sessions, if the alignment is not a power of two, or if the buffer size would not be representable.
+/// Otherwise, the return value is zero. This function does not allocate or deallocate memory.
+int8_t canardRxSetPayloadLayout(CanardRxSubscription* const        subscription,
+                                const CanardRxPayloadLayout* const layout);
+
+/// This function moves the payload buffer of a received transfer into a new reference-counted handle, so that the
+/// same buffer can be shared by several consumers (possibly running in different threads) without copying it.
+/// The handle is allocated from the instance using memory_allocate; its reference count is initially one.
+/// Each additional consumer shall call canardRxSharedPayloadAcquire() before it receives the handle, and every
+/// consumer shall call canardRxSharedPayloadRelease() when it no longer needs the payload. The last release
+/// deallocates the payload buffer and the handle using memory_free of the instance, which must be safe to invoke
+/// from whichever thread happens to release the last reference.
+///
+/// On success, the handle owns the payload buffer: the application shall not deallocate it, and the payload pointers
+/// of the transfer should be considered borrowed (they remain valid while the handle is referenced).
+/// The reference counter is updated atomically using the GCC/Clang atomic built-ins or the CANARD_ATOMIC_INCREMENT and
+/// CANARD_ATOMIC_DECREMENT definitions supplied by the user; the build fails if neither is available, unless the
+/// library is built with CANARD_SINGLE_THREADED=1 (see canard.c).
+///
+/// The return value is NULL if any of the arguments are NULL or if the handle could not be allocated; in this case,
+/// the transfer retains the ownership of its payload buffer, which the application shall deallocate as usual.
+CanardRxSharedPayload* canardRxSharePayload(CanardInstance* const ins, const CanardRxTransfer* const transfer);
+
+/// Adds a reference to the shared payload. The caller shall already hold a reference.
+/// Returns zero on success or a negated invalid argument error if the argument is NULL.
+int8_t canardRxSharedPayloadAcquire(CanardRxSharedPayload* const shared);
+
+/// Removes a reference from the shared payload. The caller shall not access the handle afterward.
+/// The return value is 1 if this was the last reference and the payload was deallocated, 0 if references remain,
+/// or a negated invalid argument error if the argument is NULL.
+int8_t canardRxSharedPayloadRelease(CanardRxSharedPayload* const shared);
+
 /// This function reverses the effect of canardRxSubscribe().
 /// If the subscription is found, all its memory is de-allocated (session states and payload buffers); to determine
 /// the amount of memory freed, please refer to the memory allocation requirement model of canardRxAccept().
@@ -645,10 +1407,253 @@ int8_t canardRxSubscribe(CanardInstance* const       ins,
 ///
 /// The time complexity is logarithmic from the number of current subscriptions under the specified transfer kind.
 /// This function does not allocate new memory.
+/// If a subscription table is installed, see canardRxSetSubscriptionTable() for the differences.
 int8_t canardRxUnsubscribe(CanardInstance* const    ins,
                            const CanardTransferKind transfer_kind,
                            const CanardPortID       port_id);
 
+/// This function installs a timer wheel that tracks the transfer-ID timeout deadline of every RX session, which
+/// allows canardRxExpire() to destroy the sessions that have timed out without scanning the subscriptions.
+/// The deadline of a session is the timestamp of its last start-of-transfer frame plus the transfer-ID timeout of its
+/// subscription. The wheel shall not be moved or destroyed while it is installed; its contents need not be initialized.
+/// Passing NULL removes the wheel, which restores the default behavior where the sessions are never destroyed.
+///
+/// The tick defines the resolution of the wheel: a session may be destroyed up to one tick later than its deadline
+/// but never earlier. The wheel covers CANARD_RX_TIMER_WHEEL_SLOTS**CANARD_RX_TIMER_WHEEL_LEVELS ticks ahead
+/// (e.g., ca. 33 seconds with a 1 ms tick); longer deadlines are supported at a slightly higher cost.
+///
+/// The wheel can only be installed or removed while the instance has no subscriptions, because the sessions that are
+/// tracked by the wheel are larger than those that are not; in other words, call this right after canardInit().
+/// The sessions occupy 32 extra bytes on a typical 32-bit platform when the wheel is in use; this shall be accounted
+/// for in the memory requirement model given in the documentation for canardRxAccept().
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if the instance is NULL,
+/// the tick is zero while the wheel is not NULL, or the instance has subscriptions.
+///
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int8_t canardRxSetTimerWheel(CanardInstance* const     ins,
+                             CanardRxTimerWheel* const wheel,
+                             const CanardMicrosecond   tick_usec);
+
+/// This function installs a cache that drops the redundant duplicates of the received frames early, before they are
+/// parsed and matched against the subscriptions, which saves most of the processing time that the redundant
+/// transports incur: with dual-redundant transports, every other frame is a duplicate that would otherwise be
+/// rejected only by the RX session. The cache shall not be moved or destroyed while it is installed; its contents
+/// need not be initialized. Passing NULL removes the cache. The cache can be installed or removed at any time.
+///
+/// A frame is remembered by the cache if it has been accepted by an RX session. A frame is suppressed if its CAN ID
+/// and tail byte are equal to those of a remembered frame that was delivered via a different transport no more than
+/// the window earlier or later; such a frame would have been rejected by the session anyway because the transfer
+/// it belongs to is being or has been received via the other transport. The frames that arrive via the same
+/// transport are never suppressed, and neither are the anonymous frames and the frames whose originals were rejected.
+/// The window should exceed the maximum difference in latency between the transports, and it shall be shorter than
+/// the transfer-ID timeouts and the fail-over timeouts of the subscriptions, and also shorter than the time it takes
+/// the transfer-ID to wrap around at the highest transfer rate of any subject or service from any source node,
+/// otherwise a new transfer may be mistaken for a duplicate of an old one; a few milliseconds is typical.
+/// The duplicates suppressed by the cache are not accounted for in CanardRxSubscription::transport_stats.
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if the instance is NULL.
+///
+/// The time complexity is linear of CANARD_RX_DUPLICATE_CACHE_SLOTS. This function does not invoke the dynamic
+/// memory manager. The time complexity of canardRxAccept() is not affected by the cache.
+int8_t canardRxSetDuplicateCache(CanardInstance* const         ins,
+                                 CanardRxDuplicateCache* const cache,
+                                 const CanardMicrosecond       window_usec);
+
+/// This function destroys the RX sessions whose transfer-ID timeout has expired by the specified time, releasing
+/// their state and payload buffers. A destroyed session is re-created when the next transfer from the same remote
+/// node arrives, which is indistinguishable from the behavior of a session that has timed out but was kept alive.
+/// The time shall be taken from the same clock that is used to timestamp the received frames, and it shall not be
+/// ahead of the timestamps of the frames that are yet to be passed to canardRxAccept().
+///
+/// If the transfer-ID timeout of a subscription is changed, the sessions are rescheduled when they receive the next
+/// start-of-transfer frame.
+///
+/// The return value is the number of destroyed sessions. The return value is a negated invalid argument error if
+/// the instance is NULL or there is no timer wheel installed.
+///
+/// The time complexity is linear of the number of destroyed sessions plus a constant cost per every occupied slot of
+/// the wheel that is passed; idle ticks cost nothing. The function may deallocate memory; it does not allocate memory.
+int32_t canardRxExpire(CanardInstance* const ins, const CanardMicrosecond now_usec);
+
+/// This function reports the time when canardRxExpire() should be invoked next, which allows an event-driven
+/// application to sleep until then (e.g., by arming a timerfd) instead of polling periodically.
+/// The reported time is never later than the moment when the earliest RX session times out; it may be earlier than
+/// that if the session is on an upper level of the timer wheel, in which case invoking canardRxExpire() at the reported
+/// time moves the session down the wheel and the next query returns a more accurate result. The number of such
+/// extra wake-ups per session is bounded by the number of levels of the wheel.
+///
+/// The return value is 1 if there is at least one RX session, in which case the time is stored into out_time_usec.
+/// The return value is 0 if there are no RX sessions, so there is no need to invoke canardRxExpire() until
+/// a transfer is received; out_time_usec is not modified in this case.
+/// The return value is a negated invalid argument error if any of the pointers are NULL or there is no timer wheel
+/// installed (see canardRxSetTimerWheel()).
+///
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int8_t canardRxGetNextExpiration(const CanardInstance* const ins, CanardMicrosecond* const out_time_usec);
+
+/// This function installs a subscription table that allows one thread (the writer) to invoke canardRxSubscribe(),
+/// canardRxSubscribeSingleFrame(), and canardRxUnsubscribe() while another thread (the reader) is invoking
+/// canardRxAccept(), canardRxExpire(), and canardRxReclaim() on the same instance, without any locking.
+/// The reader then looks up the subscriptions in an immutable snapshot that the writer replaces atomically with every
+/// change. The writers shall be serialized among themselves, and the memory allocator shall be thread-safe, because
+/// the snapshots are allocated by the writer and deallocated by the reader. The atomic operations are provided by the
+/// GCC/Clang built-ins by default; see CANARD_ATOMIC_LOAD et al. in canard.c for other compilers.
+///
+/// The sessions of a removed subscription are not released by canardRxUnsubscribe() because the reader may be using
+/// them at the moment; they are released by the reader at its next quiescent point, that is, at the beginning of
+/// the next canardRxAccept(), canardRxExpire(), or canardRxReclaim(). An idle reader should invoke canardRxReclaim()
+/// periodically. Until then, the object of the removed subscription shall not be reused or destroyed; that includes
+/// re-subscribing with the same object, which is rejected with the invalid argument error if the object is still
+/// the subscription of the port. canardRxIsReclaimed() tells the writer when the objects can be reused.
+/// A subscription to a port that already has one replaces it in a single snapshot, so the reader never observes
+/// the port without a subscription, and the replaced one is removed as if by canardRxUnsubscribe().
+/// Likewise, the pointer to the subscription reported by canardRxAccept() is valid until the next quiescent point.
+/// The fields of a subscription that are adjusted after it is created (such as failover_timeout_usec, or via
+/// canardRxSetPayloadLayout()) are not synchronized with the reader, so they shall only be adjusted while the reader
+/// is not running.
+///
+/// The table shall not be moved or destroyed while it is installed; its contents need not be initialized.
+/// Passing NULL removes the table. The table can be installed or removed only while the instance has no subscriptions
+/// and the reader is not running.
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if the instance is NULL
+/// or has subscriptions. The return value is a negated out-of-memory error if the initial snapshot could not be
+/// allocated, in which case no table is installed.
+///
+/// Once the table is installed, canardRxSubscribe(), canardRxSubscribeSingleFrame(), and canardRxUnsubscribe() have
+/// a linear time complexity of the number of subscriptions, allocate one snapshot per change, and may fail with
+/// the out-of-memory error, leaving the published subscriptions unchanged. The complexity of canardRxAccept() remains
+/// logarithmic. This function has a constant complexity unless it removes a table, in which case it is linear of
+/// the number of snapshots awaiting reclamation.
+int8_t canardRxSetSubscriptionTable(CanardInstance* const ins, CanardRxSubscriptionTable* const table);
+
+/// This function shall be invoked by the reader thread only. It releases the snapshots and the sessions of
+/// the subscriptions that have been removed since the last quiescent point (see canardRxSetSubscriptionTable()).
+/// This is done automatically at the beginning of canardRxAccept() and canardRxExpire(), so it only needs to be
+/// invoked explicitly when there is no traffic for a long time.
+///
+/// The return value is the number of subscriptions whose sessions have been released. The return value is a negated
+/// invalid argument error if the instance is NULL or there is no subscription table installed.
+///
+/// The time complexity is linear of the number of released snapshots and sessions. The function may deallocate
+/// memory; it does not allocate memory.
+int32_t canardRxReclaim(CanardInstance* const ins);
+
+/// This function shall be invoked by the writer thread only. It reports whether the reader has released all
+/// subscriptions removed so far, so that their objects can be reused or destroyed.
+///
+/// The return value is 1 if all removed subscriptions have been released, and 0 otherwise. The return value is
+/// a negated invalid argument error if the instance is NULL or there is no subscription table installed.
+///
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int8_t canardRxIsReclaimed(const CanardInstance* const ins);
+
+/// The maximum number of shards accepted by canardRxGetShard() and canardRxGetFrameShard().
+#define CANARD_RX_SHARD_COUNT_MAX 64U
+
+/// These functions allow the application to spread the reception workload across several independent instances,
+/// each serviced by its own thread, without any synchronization inside the library. The subscriptions are partitioned
+/// between the instances (shards) by port-ID: a subscription shall be created on the instance whose index is returned
+/// by canardRxGetShard(), and every received frame shall be passed to the instance whose index is returned by
+/// canardRxGetFrameShard() for the same number of shards. Both functions compute the same deterministic mapping,
+/// so all frames of a session end up in the same shard; if every interface delivers the frames to each shard through
+/// a first-in-first-out queue, the per-session frame ordering is preserved as well. The requests and responses of the
+/// same service share a shard. All shards shall have the same node-ID.
+///
+/// Only the CAN ID of the frame is examined; malformed frames are routed like any other and then rejected by
+/// canardRxAccept() in the shard.
+///
+/// The return value is the index of the shard in [0, shard_count). The return value is a negated invalid argument
+/// error if the shard count is zero or exceeds CANARD_RX_SHARD_COUNT_MAX, the transfer kind or the port-ID is invalid,
+/// the frame pointer is NULL, or the CAN ID of the frame exceeds 29 bits.
+///
+/// The time complexity is constant. These functions do not access any state and do not invoke the dynamic memory
+/// manager, so they can be invoked concurrently from any thread.
+int8_t canardRxGetShard(const CanardTransferKind transfer_kind, const CanardPortID port_id, const uint8_t shard_count);
+int8_t canardRxGetFrameShard(const CanardFrame* const frame, const uint8_t shard_count);
+
+/// This function initializes a dispatcher that implements the frame routing described above for one producer,
+/// such as the thread or the interrupt handler of one CAN interface. The array of rings is supplied by the
+/// application, one ring per shard, each initialized beforehand by canardRxFrameRingInit(); the dispatcher is the
+/// only producer of these rings, and the thread of each shard is their consumer. With several producers, each one
+/// has its own dispatcher and its own rings, and the thread of shard N drains ring N of every dispatcher, e.g., via
+/// canardRxAcceptRing() into the instance of the shard. Because every ring is first-in-first-out and all frames of a
+/// session that arrive via the same producer go to the same ring, the frames of each session are delivered to the
+/// instance in the order in which the producer received them.
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if any of the pointers
+/// are NULL or the shard count is zero or exceeds CANARD_RX_SHARD_COUNT_MAX.
+int8_t canardRxDispatcherInit(CanardRxDispatcher* const dispatcher,
+                              CanardRxFrameRing* const  rings,
+                              const uint8_t             shard_count);
+
+/// Producer side. Copies the frame into the ring of the shard returned by canardRxGetFrameShard() and commits it.
+/// The frame itself is not retained, so it can be reused by the producer immediately.
+///
+/// The return value is 1 if the frame is stored, and 0 if it is dropped because the ring of the shard is full;
+/// the latter is counted in CanardRxFrameRing::overrun_count of that ring. The return value is a negated invalid
+/// argument error if any of the pointers are NULL, the payload pointer of the frame is NULL while its size is
+/// non-zero, the payload exceeds CANARD_MTU_MAX, or the CAN ID of the frame exceeds 29 bits.
+///
+/// The time complexity is constant. This function does not block or invoke the dynamic memory manager.
+int8_t canardRxDispatch(CanardRxDispatcher* const dispatcher,
+                        const CanardMicrosecond   timestamp_usec,
+                        const CanardFrame* const  frame,
+                        const uint8_t             redundant_transport_index);
+
+/// Computes the exact number of bits that the frame occupies on the wire, which is how the bus time consumed by
+/// the publishers of an application can be estimated. The frame is an extended data frame; the stuff bits are
+/// computed from its actual CAN ID and payload, and so is the CRC-15 of Classic CAN, which is stuffed as well.
+/// A CAN FD frame has a CRC of 17 or 21 bits depending on the length of the data field, which is preceded by
+/// the stuff bit count and followed by the fixed stuff bits. The data phase of CAN FD, which is transmitted at the data
+/// bit rate if the bit rate switching is enabled, extends from the ESI bit to the end of the CRC sequence.
+/// A CAN FD payload whose size cannot be represented by the DLC is counted as if padded to the next valid size.
+///
+/// The result is zero if the frame pointer is NULL, the payload pointer is NULL while its size is nonzero,
+/// or the payload does not fit into one frame (8 bytes for Classic CAN, 64 bytes for CAN FD).
+/// The CAN ID is truncated to 29 bits.
+///
+/// The time complexity is linear of the payload size. This function does not invoke the dynamic memory manager.
+CanardFrameBits canardGetFrameBits(const CanardFrame* const frame, const bool fd, const bool bit_rate_switch);
+
+/// Computes the exact duration of the frame on the wire in nanoseconds using canardGetFrameBits(), from the start
+/// of frame to the end of the following interframe space; hence, the frames transmitted back to back take the sum of
+/// their durations. The result is zero if the arguments are invalid (see canardGetFrameBits()), or if the timing is
+/// NULL or its nominal bit rate is zero.
+///
+/// The time complexity is linear of the payload size. This function does not invoke the dynamic memory manager.
+uint32_t canardGetFrameDuration(const CanardBusTiming* const timing, const CanardFrame* const frame);
+
+/// This function initializes a bus load meter, which accumulates the durations of the frames seen on the bus,
+/// as reported by canardBusLoadMeterUpdate(), to compute the bus utilization over consecutive windows.
+/// Every frame shall be reported exactly once, which is achieved by reporting the frames received by the local node
+/// together with the frames it has transmitted, since the latter are not received back.
+///
+/// The return value is zero on success. The return value is a negated invalid argument error if the meter is NULL,
+/// the nominal bit rate is zero, or the window is zero.
+///
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int8_t canardBusLoadMeterInit(CanardBusLoadMeter* const meter,
+                              const CanardBusTiming     timing,
+                              const CanardMicrosecond   window_usec);
+
+/// Accounts a frame seen on the bus at the specified time, which is the RX timestamp of a received frame or
+/// the time when a transmitted frame was popped from the TX queue after it was handed over to the CAN driver.
+/// The frame pointer may be NULL to only advance the time, which should be done periodically so that the utilization
+/// drops to zero when the bus is idle. The first invocation starts the first window. The frames are accounted
+/// in the current window even if their timestamps precede it, which is possible if the RX and TX paths
+/// are reported out of order.
+///
+/// The return value is 1 if one or more windows have completed and the utilization has been updated, zero otherwise.
+/// The return value is a negated invalid argument error if the meter is NULL, its window or nominal bit rate is zero,
+/// or the frame is invalid (see canardGetFrameBits()); the meter is not modified then.
+///
+/// The time complexity is linear of the payload size. This function does not invoke the dynamic memory manager.
+int8_t canardBusLoadMeterUpdate(CanardBusLoadMeter* const meter,
+                                const CanardMicrosecond   timestamp_usec,
+                                const CanardFrame* const  frame);
+
 /// Utilities for generating CAN controller hardware acceptance filter configurations
 /// to accept specific subjects, services, or nodes.
 ///
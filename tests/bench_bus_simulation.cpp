@@ -0,0 +1,145 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// Simulates a bus populated by a varying number of nodes in virtual time (see simulator.hpp) and reports how the
+// bus load, the TX queue depth, the latency, and the memory footprint scale with the number of nodes, for Classic CAN
+// and for CAN FD. Every node publishes a heartbeat once a second and a 32-byte sensor message ten times a second with
+// a deadline of 100 ms, and subscribes to the heartbeats of all nodes and to the sensor messages of a few neighbors.
+// The peak load is the maximum over one-second windows as measured by CanardBusLoadMeter. Since the bus time is
+// virtual, the results are exactly reproducible; the wall time is reported only to show how fast the simulation runs.
+// Usage: bench_bus_simulation [simulated seconds]
+
+#include "simulator.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+
+namespace
+{
+constexpr CanardPortID           HeartbeatSubjectID = 7509;
+constexpr CanardPortID           SensorSubjectBase  = 1000;
+constexpr std::size_t            SensorSize         = 32U;
+constexpr std::size_t            Neighbors          = 4U;
+constexpr simulator::Nanoseconds Second             = 1'000'000'000U;
+constexpr simulator::Nanoseconds SensorPeriod       = Second / 10U;
+
+/// Executes the action periodically, starting at the specified time.
+void schedulePeriodic(simulator::Bus&              bus,
+                      const simulator::Nanoseconds at,
+                      const simulator::Nanoseconds period,
+                      const std::function<void()>& action)
+{
+    bus.schedule(at, [&bus, at, period, action]() {
+        action();
+        schedulePeriodic(bus, at + period, period, action);
+    });
+}
+
+auto makeMessage(const CanardPortID port_id, const CanardPriority priority, const CanardTransferID transfer_id)
+    -> CanardTransferMetadata
+{
+    CanardTransferMetadata out{};
+    out.priority       = priority;
+    out.transfer_kind  = CanardTransferKindMessage;
+    out.port_id        = port_id;
+    out.remote_node_id = CANARD_NODE_ID_UNSET;
+    out.transfer_id    = transfer_id;
+    return out;
+}
+
+void run(const std::size_t node_count, const bool fd, const simulator::Nanoseconds duration)
+{
+    simulator::BusConfig config;
+    config.fd = fd;
+    simulator::Bus bus(config);
+    for (std::size_t i = 0; i < node_count; i++)
+    {
+        auto& node = bus.addNode(static_cast<CanardNodeID>(i + 1U));
+        node.subscribe(CanardTransferKindMessage, HeartbeatSubjectID, 7U);
+        for (std::size_t k = 1; k <= Neighbors; k++)
+        {
+            const auto neighbor = static_cast<CanardPortID>(((i + k) % node_count) + 1U);
+            node.subscribe(CanardTransferKindMessage, static_cast<CanardPortID>(SensorSubjectBase + neighbor), 64U);
+        }
+        // The publications of different nodes are staggered as their clocks are not synchronized.
+        const simulator::Nanoseconds phase = (i * 7'919'000U) % SensorPeriod;
+        auto                         tids  = std::make_shared<std::array<CanardTransferID, 2>>();
+        schedulePeriodic(bus, phase, Second, [&node, tids]() {
+            const std::array<std::uint8_t, 7> heartbeat{};
+            const auto meta = makeMessage(HeartbeatSubjectID, CanardPriorityNominal, tids->at(0)++);
+            (void) node.publish(meta, heartbeat.size(), heartbeat.data());
+        });
+        schedulePeriodic(bus, phase, SensorPeriod, [&node, tids]() {
+            const std::array<std::uint8_t, SensorSize> sensor{};
+            const auto port = static_cast<CanardPortID>(SensorSubjectBase + node.getInstance().node_id);
+            const auto meta = makeMessage(port, CanardPriorityHigh, tids->at(1)++);
+            (void) node.publish(meta, sensor.size(), sensor.data(), SensorPeriod);
+        });
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    bus.runUntil(duration);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    simulator::NodeStats total;
+    for (const auto& node : bus.getNodes())
+    {
+        const auto& stats = node->getStats();
+        total.tx_transfers += stats.tx_transfers;
+        total.tx_push_failures += stats.tx_push_failures;
+        total.tx_deadline_drops += stats.tx_deadline_drops;
+        total.tx_queue_depth_max = std::max(total.tx_queue_depth_max, stats.tx_queue_depth_max);
+        total.latency_max        = std::max(total.latency_max, stats.latency_max);
+        total.latency_total += stats.latency_total;
+        total.rx_transfers += stats.rx_transfers;
+        total.memory_bytes_max = std::max(total.memory_bytes_max, stats.memory_bytes_max);
+    }
+    const double latency_mean =
+        (total.tx_transfers > 0U)
+            ? (static_cast<double>(total.latency_total) / static_cast<double>(total.tx_transfers) * 1e-3)
+            : 0.0;
+    std::printf("%6zu %8s %8.1f %8.1f %10llu %10llu %8zu %10.1f %10.1f %8llu %10zu %10.0f\n",
+                node_count,
+                fd ? "FD" : "classic",
+                bus.getUtilization() * 100.0,
+                static_cast<double>(bus.getBusLoadMeter().utilization_ppm_max) * 1e-4,
+                static_cast<unsigned long long>(bus.getStats().frames),
+                static_cast<unsigned long long>(total.rx_transfers),
+                total.tx_queue_depth_max,
+                latency_mean,
+                static_cast<double>(total.latency_max) * 1e-3,
+                static_cast<unsigned long long>(total.tx_deadline_drops + total.tx_push_failures),
+                total.memory_bytes_max,
+                static_cast<double>(bus.getStats().frames) / wall);
+}
+}  // namespace
+
+int main(const int argc, const char* const argv[])
+{
+    const simulator::Nanoseconds duration = ((argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10U) * Second;
+    std::printf("%6s %8s %8s %8s %10s %10s %8s %10s %10s %8s %10s %10s\n",
+                "nodes",
+                "bus",
+                "load, %",
+                "peak, %",
+                "frames",
+                "rx xfers",
+                "max que",
+                "mean, us",
+                "max, us",
+                "dropped",
+                "max mem",
+                "frames/s");
+    for (const bool fd : {false, true})
+    {
+        for (const std::size_t node_count : {8U, 32U, 64U, 127U})
+        {
+            run(node_count, fd, duration);
+        }
+    }
+    return 0;
+}
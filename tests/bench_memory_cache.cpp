@@ -0,0 +1,201 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// Measures the contention on a shared heap when several instances run on different threads, with and without
+// the per-thread memory cache (MemCache). The shared heap is malloc() behind a mutex, which is how a single-threaded
+// deterministic allocator (such as O1Heap) is shared between threads. Every thread publishes
+// a transfer (allocating and freeing its TX frames) and receives one per iteration; the received payloads are handed
+// over to the next thread, which frees them, so the payload blocks are freed by a thread other than the allocating one.
+
+#include "canard.h"
+#include "memcache.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t Iterations    = 200'000U;  // Per thread.
+constexpr std::size_t QueueCapacity = 1024U;     // A power of two.
+constexpr std::size_t CacheLineSize = 64U;
+constexpr std::size_t BlockLimit    = 64U;
+
+std::mutex g_heap_lock;  // NOLINT
+
+void* lockedAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    const std::lock_guard<std::mutex> locker(g_heap_lock);
+    return std::malloc(amount);  // NOLINT
+}
+
+void lockedFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    const std::lock_guard<std::mutex> locker(g_heap_lock);
+    std::free(pointer);  // NOLINT
+}
+
+thread_local MemCache* g_thread_cache = nullptr;  // NOLINT
+
+void* cachedAllocate(CanardInstance* const ins, const size_t amount)
+{
+    return memcacheAllocate(g_thread_cache, ins, amount);
+}
+
+void cachedFree(CanardInstance* const ins, void* const pointer)
+{
+    memcacheFree(g_thread_cache, ins, pointer);
+}
+
+// Carries the received payloads to the thread that frees them.
+struct alignas(CacheLineSize) Queue
+{
+    alignas(CacheLineSize) std::atomic<std::size_t> head{0};
+    alignas(CacheLineSize) std::atomic<std::size_t> tail{0};
+    alignas(CacheLineSize) std::array<void*, QueueCapacity> slots{};
+
+    auto push(void* const item) -> bool
+    {
+        const std::size_t tl = tail.load(std::memory_order_relaxed);
+        const bool        ok = (tl - head.load(std::memory_order_acquire)) < QueueCapacity;
+        if (ok)
+        {
+            slots.at(tl % QueueCapacity) = item;
+            tail.store(tl + 1U, std::memory_order_release);
+        }
+        return ok;
+    }
+
+    auto pop() -> void*
+    {
+        const std::size_t hd  = head.load(std::memory_order_relaxed);
+        void*             out = nullptr;
+        if (hd != tail.load(std::memory_order_acquire))
+        {
+            out = slots.at(hd % QueueCapacity);
+            head.store(hd + 1U, std::memory_order_release);
+        }
+        return out;
+    }
+};
+
+void run(const std::size_t               index,
+         const bool                      cached,
+         Queue&                          inbox,
+         Queue&                          outbox,
+         std::atomic<std::size_t>&       threads_running,
+         std::vector<MemCache>&          caches)
+{
+    MemCache* const cache = &caches.at(index);
+    g_thread_cache        = cache;
+    CanardInstance ins = cached ? canardInit(&cachedAllocate, &cachedFree) : canardInit(&lockedAllocate, &lockedFree);
+    ins.node_id        = static_cast<CanardNodeID>(1U + index);
+    CanardTxQueue        que = canardTxInit(16, CANARD_MTU_CAN_CLASSIC);
+    CanardRxSubscription sub{};
+    if (canardRxSubscribe(&ins, CanardTransferKindMessage, 1000, 64, 2'000'000, &sub) != 1)
+    {
+        std::abort();
+    }
+    std::array<std::uint8_t, 20> payload{};
+    CanardTransferMetadata       meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 1000;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+
+    const auto drain = [&] {
+        while (void* const item = inbox.pop())
+        {
+            ins.memory_free(&ins, item);
+        }
+    };
+    for (std::size_t i = 0; i < Iterations; i++)
+    {
+        // Publish a multi-frame transfer and receive it back as if it came from the bus.
+        meta.transfer_id = static_cast<CanardTransferID>(i & CANARD_TRANSFER_ID_MAX);
+        if (canardTxPush(&que, &ins, 0, &meta, payload.size(), payload.data()) <= 0)
+        {
+            std::abort();
+        }
+        CanardRxTransfer transfer{};
+        std::int8_t      result = 0;
+        while (const CanardTxQueueItem* const ti = canardTxPeek(&que))
+        {
+            result = canardRxAccept(&ins, 1'000'000U + i, &ti->frame, 0, &transfer, nullptr);
+            ins.memory_free(&ins, canardTxPop(&que, ti));
+        }
+        if (result != 1)
+        {
+            std::abort();
+        }
+        while (!outbox.push(transfer.payload))
+        {
+            drain();
+            std::this_thread::yield();
+        }
+        drain();
+    }
+    threads_running.fetch_sub(1U, std::memory_order_acq_rel);
+    while (threads_running.load(std::memory_order_acquire) > 0U)  // The neighbor may still be sending.
+    {
+        drain();
+        std::this_thread::yield();
+    }
+    drain();
+    (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, 1000);
+}
+
+auto benchmark(const std::size_t thread_count, const bool cached) -> double
+{
+    const std::unique_ptr<Queue[]> queues(new Queue[thread_count]);  // NOLINT
+    std::vector<MemCache> caches(thread_count);
+    for (auto& cache : caches)
+    {
+        (void) memcacheInit(&cache, &lockedAllocate, &lockedFree, BlockLimit);
+    }
+    std::atomic<std::size_t> threads_running{thread_count};
+    std::vector<std::thread> threads;
+    const auto               started = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&, t] {
+            run(t, cached, queues[t], queues[(t + 1U) % thread_count], threads_running, caches);
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    for (auto& cache : caches)
+    {
+        (void) memcacheTrim(&cache, nullptr);  // The owners are gone, so this is safe.
+    }
+    return static_cast<double>(thread_count * Iterations) /
+           std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+}
+}  // namespace
+
+int main(const int argc, const char* const argv[])
+{
+    const unsigned    cores       = std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t max_threads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : cores;
+    std::printf("%10s %20s %20s %16s\n", "threads", "shared, Mtransfer/s", "cached, Mtransfer/s", "speedup");
+    for (std::size_t thread_count = 1; thread_count <= max_threads; thread_count++)
+    {
+        const double shared = benchmark(thread_count, false);
+        const double cached = benchmark(thread_count, true);
+        std::printf("%10zu %20.3f %20.3f %16.2f\n", thread_count, shared * 1e-6, cached * 1e-6, cached / shared);
+    }
+    return 0;
+}
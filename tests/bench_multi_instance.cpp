@@ -0,0 +1,351 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// Measures how the throughput of independent instances scales with the number of threads, one instance per thread,
+// as in an application that runs one instance per CAN interface on separate cores. Every thread receives a realistic
+// mix of single-frame and multi-frame transfers from several nodes and publishes its own transfers through its TX
+// queue. Since the instances share no state, the per-thread throughput should not degrade with the number of threads
+// unless the objects serviced by different threads share cache lines (false sharing) or the memory bus saturates.
+//
+// The instances, the TX queues, and the subscriptions of all threads are deliberately kept in contiguous arrays,
+// which is how an application would typically declare them; the report shows how many of the neighboring objects
+// that belong to different threads share a cache line. Build with CANARD_CACHE_LINE_ALIGNED=1 to compare
+// (see bench_multi_instance_aligned). The hardware counter deltas are reported per transfer where perf_event_open()
+// is permitted (see /proc/sys/kernel/perf_event_paranoid).
+
+#include "canard.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#    include <linux/perf_event.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace
+{
+constexpr std::size_t NumSubjects       = 8U;
+constexpr std::size_t NumRemoteNodes    = 8U;
+constexpr std::size_t TransfersPerRound = 256U;
+constexpr std::size_t Rounds            = 200U;
+constexpr std::size_t CacheLineSize     = CANARD_CACHE_LINE_SIZE;
+
+void* benchAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    return std::malloc(amount);  // NOLINT
+}
+
+void benchFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    std::free(pointer);  // NOLINT
+}
+
+struct Frame
+{
+    std::uint32_t                            extended_can_id;
+    std::uint8_t                             payload_size;
+    std::array<std::uint8_t, CANARD_MTU_MAX> payload;
+};
+
+// The frames of one round of reception: heartbeat-sized and larger transfers from several nodes, interleaved.
+auto generate() -> std::vector<Frame>
+{
+    CanardInstance   ins = canardInit(&benchAllocate, &benchFree);
+    CanardTxQueue    que = canardTxInit(SIZE_MAX, CANARD_MTU_CAN_CLASSIC);
+    std::minstd_rand rng(1234);  // NOLINT fixed seed for reproducibility
+
+    std::vector<Frame>                                      out;
+    std::array<std::uint8_t, 40>                            payload{};
+    std::array<std::array<CanardTransferID, NumSubjects>, NumRemoteNodes> tids{};
+    for (std::size_t i = 0; i < TransfersPerRound; i++)
+    {
+        const std::size_t node    = rng() % NumRemoteNodes;
+        const std::size_t subject = rng() % NumSubjects;
+        ins.node_id               = static_cast<CanardNodeID>(100U + node);
+        CanardTransferMetadata meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = static_cast<CanardPortID>(subject);
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = tids.at(node).at(subject)++;
+        const std::size_t size = ((subject % 2U) == 0U) ? 7U : (rng() % payload.size());
+        if (canardTxPush(&que, &ins, 0, &meta, size, payload.data()) <= 0)
+        {
+            std::abort();
+        }
+        while (const CanardTxQueueItem* const ti = canardTxPeek(&que))
+        {
+            Frame frame{};
+            frame.extended_can_id = ti->frame.extended_can_id;
+            frame.payload_size    = static_cast<std::uint8_t>(ti->frame.payload_size);
+            std::memcpy(frame.payload.data(), ti->frame.payload, ti->frame.payload_size);
+            out.push_back(frame);
+            ins.memory_free(&ins, canardTxPop(&que, ti));
+        }
+    }
+    return out;
+}
+
+// Counts the events of the calling thread in the user space; inactive if the kernel does not permit it.
+class Counter
+{
+public:
+    Counter(const std::uint32_t type, const std::uint64_t config)
+    {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void) type;
+        (void) config;
+#endif
+    }
+    ~Counter()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0)
+        {
+            (void) close(fd_);
+        }
+#endif
+    }
+    Counter(const Counter&)                    = delete;
+    Counter(Counter&&)                         = delete;
+    auto operator=(const Counter&) -> Counter& = delete;
+    auto operator=(Counter&&) -> Counter&      = delete;
+
+    [[nodiscard]] auto read() const -> std::int64_t
+    {
+        std::int64_t out = -1;
+#if defined(__linux__)
+        std::uint64_t value = 0;
+        if ((fd_ >= 0) && (::read(fd_, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))))
+        {
+            out = static_cast<std::int64_t>(value);
+        }
+#endif
+        return out;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+struct Result
+{
+    double       seconds   = 0;
+    std::int64_t cycles    = -1;
+    std::int64_t misses    = -1;
+    std::int64_t l1d_miss  = -1;
+    std::size_t  transfers = 0;
+};
+
+struct Workers
+{
+    std::vector<CanardInstance>       instances;
+    std::vector<CanardTxQueue>        queues;
+    std::vector<CanardRxSubscription> subscriptions;  // NumSubjects per thread.
+};
+
+void run(const std::size_t                index,
+         Workers&                         workers,
+         const std::vector<Frame>&        frames,
+         std::atomic<std::size_t>&        ready,
+         const std::size_t                thread_count,
+         Result&                          result)
+{
+    CanardInstance& ins = workers.instances.at(index);
+    CanardTxQueue&  que = workers.queues.at(index);
+    ins                 = canardInit(&benchAllocate, &benchFree);
+    ins.node_id         = static_cast<CanardNodeID>(1U + index);
+    que                 = canardTxInit(TransfersPerRound * 8U, CANARD_MTU_CAN_CLASSIC);
+    for (std::size_t i = 0; i < NumSubjects; i++)
+    {
+        if (canardRxSubscribe(&ins,
+                              CanardTransferKindMessage,
+                              static_cast<CanardPortID>(i),
+                              64,
+                              2'000'000,
+                              &workers.subscriptions.at((index * NumSubjects) + i)) != 1)
+        {
+            std::abort();
+        }
+    }
+    std::array<std::uint8_t, 20> payload{};
+    CanardTransferMetadata       meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+
+    const Counter cycles(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    const Counter misses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    const Counter l1d(PERF_TYPE_HW_CACHE,
+                      PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U));
+    ready.fetch_add(1U);
+    while (ready.load() < thread_count)  // Start all threads at once.
+    {
+        std::this_thread::yield();
+    }
+    const std::int64_t cycles_before = cycles.read();
+    const std::int64_t misses_before = misses.read();
+    const std::int64_t l1d_before    = l1d.read();
+    const auto         started       = std::chrono::steady_clock::now();
+    CanardMicrosecond  now           = 1'000'000;
+    for (std::size_t round = 0; round < Rounds; round++)
+    {
+        // The transfer-IDs of the remote nodes repeat in every round, so the timestamps are spaced beyond the timeout.
+        now += 10'000'000U;
+        for (const Frame& frame : frames)
+        {
+            CanardFrame cf{};
+            cf.extended_can_id = frame.extended_can_id;
+            cf.payload_size    = frame.payload_size;
+            cf.payload         = frame.payload.data();
+            CanardRxTransfer transfer{};
+            if (canardRxAccept(&ins, now, &cf, 0, &transfer, nullptr) > 0)
+            {
+                result.transfers++;
+                ins.memory_free(&ins, transfer.payload);
+            }
+        }
+        for (std::size_t i = 0; i < (TransfersPerRound / 4U); i++)
+        {
+            meta.port_id     = static_cast<CanardPortID>(1000U + (i % 4U));
+            meta.transfer_id = static_cast<CanardTransferID>(i);
+            if (canardTxPush(&que, &ins, now, &meta, ((i % 2U) == 0U) ? 7U : payload.size(), payload.data()) <= 0)
+            {
+                std::abort();
+            }
+            result.transfers++;
+        }
+        while (const CanardTxQueueItem* const ti = canardTxPeek(&que))
+        {
+            ins.memory_free(&ins, canardTxPop(&que, ti));
+        }
+    }
+    result.seconds  = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    const auto diff = [](const std::int64_t after, const std::int64_t before) {
+        return ((after >= 0) && (before >= 0)) ? (after - before) : -1;
+    };
+    result.cycles   = diff(cycles.read(), cycles_before);
+    result.misses   = diff(misses.read(), misses_before);
+    result.l1d_miss = diff(l1d.read(), l1d_before);
+    for (std::size_t i = 0; i < NumSubjects; i++)
+    {
+        (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, static_cast<CanardPortID>(i));
+    }
+}
+
+// The number of pairs of consecutive objects owned by different threads that share a cache line.
+template <typename T>
+auto countSharedLines(const std::vector<T>& objects, const std::size_t objects_per_thread) -> std::size_t
+{
+    std::size_t out = 0;
+    for (std::size_t i = objects_per_thread; i < objects.size(); i += objects_per_thread)
+    {
+        const auto last_of_previous = reinterpret_cast<std::uintptr_t>(&objects.at(i)) - 1U;
+        const auto first_of_next    = reinterpret_cast<std::uintptr_t>(&objects.at(i));
+        out += ((last_of_previous / CacheLineSize) == (first_of_next / CacheLineSize)) ? 1U : 0U;
+    }
+    return out;
+}
+
+auto format(const std::int64_t value, const std::size_t transfers) -> std::array<char, 16>
+{
+    std::array<char, 16> out{};
+    if (value >= 0)
+    {
+        const double per_transfer = static_cast<double>(value) / static_cast<double>(transfers);
+        (void) std::snprintf(out.data(), out.size(), "%.2f", per_transfer);
+    }
+    else
+    {
+        (void) std::snprintf(out.data(), out.size(), "n/a");
+    }
+    return out;
+}
+}  // namespace
+
+int main(const int argc, const char* const argv[])
+{
+    const unsigned           cores       = std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t        max_threads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : cores;
+    const std::vector<Frame> frames      = generate();
+    std::printf("cache line alignment of the public types: %s\n",
+                (alignof(CanardInstance) >= CacheLineSize) ? "enabled" : "disabled");
+    std::printf("%8s %14s %14s %11s %8s %11s %11s %11s %28s\n",
+                "threads",
+                "total, Mt/s",
+                "per thr, Mt/s",
+                "efficiency",
+                "shared",
+                "cyc/t",
+                "miss/t",
+                "l1d miss/t",
+                "shared lines: ins/que/sub");
+    double baseline = 0;
+    for (std::size_t thread_count = 1; thread_count <= max_threads; thread_count++)
+    {
+        Workers workers;
+        workers.instances.resize(thread_count);
+        workers.queues.resize(thread_count);
+        workers.subscriptions.resize(thread_count * NumSubjects);
+        std::vector<Result>      results(thread_count);
+        std::atomic<std::size_t> ready{0};
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < thread_count; t++)
+        {
+            threads.emplace_back([&, t] { run(t, workers, frames, ready, thread_count, results.at(t)); });
+        }
+        for (auto& th : threads)
+        {
+            th.join();
+        }
+        Result total{0, 0, 0, 0, 0};
+        double per_thread = 0;
+        for (const auto& r : results)
+        {
+            per_thread += static_cast<double>(r.transfers) / r.seconds;
+            total.transfers += r.transfers;
+            total.cycles   = ((total.cycles >= 0) && (r.cycles >= 0)) ? (total.cycles + r.cycles) : -1;
+            total.misses   = ((total.misses >= 0) && (r.misses >= 0)) ? (total.misses + r.misses) : -1;
+            total.l1d_miss = ((total.l1d_miss >= 0) && (r.l1d_miss >= 0)) ? (total.l1d_miss + r.l1d_miss) : -1;
+        }
+        per_thread /= static_cast<double>(thread_count);
+        baseline = (thread_count == 1U) ? per_thread : baseline;
+        const std::size_t shared_ins = countSharedLines(workers.instances, 1U);
+        const std::size_t shared_que = countSharedLines(workers.queues, 1U);
+        const std::size_t shared_sub = countSharedLines(workers.subscriptions, NumSubjects);
+        std::array<char, 32> shared{};
+        (void) std::snprintf(shared.data(), shared.size(), "%zu/%zu/%zu", shared_ins, shared_que, shared_sub);
+        std::printf("%8zu %14.3f %14.3f %11.2f %8s %11s %11s %11s %28s\n",
+                    thread_count,
+                    per_thread * static_cast<double>(thread_count) * 1e-6,
+                    per_thread * 1e-6,
+                    per_thread / baseline,
+                    ((shared_ins + shared_que + shared_sub) > 0U) ? "yes" : "no",
+                    format(total.cycles, total.transfers).data(),
+                    format(total.misses, total.transfers).data(),
+                    format(total.l1d_miss, total.transfers).data(),
+                    shared.data());
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// Measures the memory footprint of the RX session state and the frame processing throughput with thousands of
+// concurrent sessions, where the session states are visited in a random order so that they do not stay in the cache.
+// Build this twice, with and without CANARD_RX_COMPACT_SESSION, to compare the session layouts.
+
+#include "canard.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NumNodes = CANARD_NODE_ID_MAX + 1U;
+
+std::size_t g_allocated_bytes = 0;
+
+// The size of each fragment is stored in front of it to keep track of the amount of memory in use.
+void* benchAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    auto* const out = static_cast<std::max_align_t*>(std::malloc(sizeof(std::max_align_t) + amount));  // NOLINT
+    if (out == nullptr)
+    {
+        std::abort();
+    }
+    *reinterpret_cast<std::size_t*>(out) = amount;
+    g_allocated_bytes += amount;
+    return out + 1;
+}
+
+void benchFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    if (pointer != nullptr)
+    {
+        auto* const base = static_cast<std::max_align_t*>(pointer) - 1;
+        g_allocated_bytes -= *reinterpret_cast<std::size_t*>(base);
+        std::free(base);  // NOLINT
+    }
+}
+
+struct Result
+{
+    double bytes_per_session;
+    double ns_per_frame;
+};
+
+auto benchmark(const std::size_t num_subjects, const std::size_t iterations) -> Result
+{
+    CanardInstance                    ins = canardInit(&benchAllocate, &benchFree);
+    std::vector<CanardRxSubscription> subs(num_subjects);
+    for (std::size_t i = 0; i < num_subjects; i++)
+    {
+        if (canardRxSubscribe(&ins,
+                              CanardTransferKindMessage,
+                              static_cast<CanardPortID>(i),
+                              64,
+                              CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
+                              &subs.at(i)) != 1)
+        {
+            std::abort();
+        }
+    }
+
+    std::vector<CanardTransferID> transfer_ids(num_subjects * NumNodes);
+    CanardMicrosecond             now = 1'000'000'000;
+    const auto                    accept = [&](const std::size_t session_index) {
+        const std::size_t  subject_id = session_index / NumNodes;
+        const std::size_t  node_id    = session_index % NumNodes;
+        CanardTransferID&  tid        = transfer_ids.at(session_index);
+        const std::uint8_t tail       = static_cast<std::uint8_t>(0b111'00000U | tid);
+        CanardFrame        frame{};
+        frame.extended_can_id = 0b001'00'0'11'0000000000000'0'0000000U |
+                                static_cast<std::uint32_t>((subject_id << 8U) | node_id);
+        frame.payload_size    = 1;
+        frame.payload         = &tail;
+        CanardRxTransfer transfer{};
+        if (canardRxAccept(&ins, now++, &frame, 0, &transfer, nullptr) != 1)
+        {
+            std::abort();
+        }
+        ins.memory_free(&ins, transfer.payload);
+        tid = static_cast<CanardTransferID>((tid + 1U) & CANARD_TRANSFER_ID_MAX);
+    };
+
+    // Create all sessions first; once the transfers are delivered, only the session states remain allocated.
+    for (std::size_t i = 0; i < transfer_ids.size(); i++)
+    {
+        accept(i);
+    }
+    const double bytes_per_session =
+        static_cast<double>(g_allocated_bytes) / static_cast<double>(transfer_ids.size());
+
+    std::minstd_rand rng(1234);  // NOLINT fixed seed for reproducibility
+    std::vector<std::size_t> order(iterations);
+    for (auto& x : order)
+    {
+        x = rng() % transfer_ids.size();
+    }
+    const auto started = std::chrono::steady_clock::now();
+    for (const auto x : order)
+    {
+        accept(x);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    for (std::size_t i = 0; i < num_subjects; i++)
+    {
+        (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, static_cast<CanardPortID>(i));
+    }
+    if (g_allocated_bytes != 0)
+    {
+        std::abort();
+    }
+    return {bytes_per_session,
+            static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                static_cast<double>(iterations)};
+}
+}  // namespace
+
+int main()
+{
+    static const std::array<std::size_t, 5> Subjects{{1U, 8U, 64U, 256U, 1024U}};
+    constexpr std::size_t                   Iterations = 2'000'000U;
+    std::printf("%10s %16s %16s\n", "sessions", "bytes/session", "ns/frame");
+    for (const auto num_subjects : Subjects)
+    {
+        const Result res = benchmark(num_subjects, Iterations);
+        std::printf("%10zu %16.1f %16.1f\n", num_subjects * NumNodes, res.bytes_per_session, res.ns_per_frame);
+    }
+    return 0;
+}
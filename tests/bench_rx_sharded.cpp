@@ -0,0 +1,259 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// Measures the RX throughput of a gateway that spreads the reception across several instances (shards) partitioned
+// by port-ID, each serviced by its own worker thread. Every interface thread routes its frames to the shards using
+// its own CanardRxDispatcher, which keeps one frame ring per shard, so that the frames of every session are processed
+// in the order of arrival. The number of shards is varied from one to the number of
+// available cores (or the number given on the command line) to see how the throughput scales.
+
+#include "canard.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NumInterfaces       = 4U;
+constexpr std::size_t NumSubjects         = 256U;
+constexpr std::size_t NodesPerInterface   = 16U;
+constexpr std::size_t TransfersPerSession = 64U;
+constexpr std::size_t RingCapacity        = 1024U;  // A power of two.
+constexpr std::size_t MaxTransfersPerPoll = 64U;
+
+struct Frame
+{
+    CanardMicrosecond                        timestamp_usec;
+    std::uint32_t                            extended_can_id;
+    std::uint8_t                             payload_size;
+    std::array<std::uint8_t, CANARD_MTU_MAX> payload;
+};
+
+void* benchAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    return std::malloc(amount);  // NOLINT
+}
+
+void benchFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    std::free(pointer);  // NOLINT
+}
+
+// Every interface carries the traffic of its own group of nodes; the transfers are split into frames by the library.
+auto generate(const std::size_t iface, std::size_t& out_transfer_count) -> std::vector<Frame>
+{
+    CanardInstance   ins = canardInit(&benchAllocate, &benchFree);
+    CanardTxQueue    que = canardTxInit(SIZE_MAX, CANARD_MTU_CAN_CLASSIC);
+    std::minstd_rand rng(static_cast<std::minstd_rand::result_type>(1234U + iface));  // NOLINT fixed seed
+
+    std::vector<Frame>            out;
+    std::array<std::uint8_t, 20>  payload{};
+    std::vector<CanardTransferID> tids(NodesPerInterface * NumSubjects);
+    CanardMicrosecond             now = 1'000'000;
+    for (std::size_t i = 0; i < (tids.size() * TransfersPerSession); i++)
+    {
+        const std::size_t session = rng() % tids.size();
+
+        ins.node_id = static_cast<CanardNodeID>((iface * NodesPerInterface) + (session / NumSubjects));
+        CanardTransferMetadata meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = static_cast<CanardPortID>(session % NumSubjects);
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = tids.at(session);
+        tids.at(session)    = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+        if (canardTxPush(&que, &ins, 0, &meta, rng() % (payload.size() + 1U), payload.data()) <= 0)
+        {
+            std::abort();
+        }
+        while (const CanardTxQueueItem* const ti = canardTxPeek(&que))
+        {
+            Frame frame{};
+            frame.timestamp_usec  = now;
+            frame.extended_can_id = ti->frame.extended_can_id;
+            frame.payload_size    = static_cast<std::uint8_t>(ti->frame.payload_size);
+            std::memcpy(frame.payload.data(), ti->frame.payload, ti->frame.payload_size);
+            out.push_back(frame);
+            now += 10U;
+            ins.memory_free(&ins, canardTxPop(&que, ti));
+        }
+    }
+    out_transfer_count = tids.size() * TransfersPerSession;
+    return out;
+}
+
+void runInterface(const std::vector<Frame>& frames, CanardRxDispatcher* const dispatcher)
+{
+    for (const Frame& frame : frames)
+    {
+        CanardFrame cf{};
+        cf.extended_can_id = frame.extended_can_id;
+        cf.payload_size    = frame.payload_size;
+        cf.payload         = frame.payload.data();
+        std::int8_t out    = 0;
+        while ((out = canardRxDispatch(dispatcher, frame.timestamp_usec, &cf, 0)) == 0)  // The ring is full.
+        {
+            std::this_thread::yield();
+        }
+        if (out < 0)
+        {
+            std::abort();
+        }
+    }
+}
+
+auto runShard(const std::uint8_t              shard,
+              const std::uint8_t              shard_count,
+              CanardRxDispatcher* const       dispatchers,  // One per interface.
+              const std::atomic<std::size_t>& interfaces_running) -> std::size_t
+{
+    CanardInstance                    ins = canardInit(&benchAllocate, &benchFree);
+    std::vector<CanardRxSubscription> subs(NumSubjects);
+    for (std::size_t i = 0; i < NumSubjects; i++)
+    {
+        const auto port_id = static_cast<CanardPortID>(i);
+        if ((canardRxGetShard(CanardTransferKindMessage, port_id, shard_count) == shard) &&
+            (canardRxSubscribe(&ins, CanardTransferKindMessage, port_id, 64, 2'000'000, &subs.at(i)) != 1))
+        {
+            std::abort();
+        }
+    }
+    std::array<CanardRxTransfer, MaxTransfersPerPoll> transfers{};
+    std::size_t                                       transfer_count = 0;
+    bool                                              more           = true;
+    while (more)
+    {
+        const bool last = (interfaces_running.load(std::memory_order_acquire) == 0U);
+        bool       idle = true;
+        for (std::size_t iface = 0; iface < NumInterfaces; iface++)
+        {
+            CanardRxFrameRing* const ring = &dispatchers[iface].rings[shard];  // NOLINT pointer arithmetic
+            while (canardRxFrameRingPeek(ring) != nullptr)
+            {
+                idle           = false;
+                const auto out = canardRxAcceptRing(&ins, ring, transfers.data(), transfers.size());
+                if (out < 0)
+                {
+                    std::abort();
+                }
+                for (std::size_t i = 0; i < static_cast<std::size_t>(out); i++)
+                {
+                    ins.memory_free(&ins, transfers.at(i).payload);
+                }
+                transfer_count += static_cast<std::size_t>(out);
+            }
+        }
+        more = !(last && idle);  // The rings are known to be drained only if they were empty after the producers quit.
+        if (idle && more)
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (std::size_t i = 0; i < NumSubjects; i++)
+    {
+        (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, static_cast<CanardPortID>(i));
+    }
+    return transfer_count;
+}
+
+auto benchmark(const std::array<std::vector<Frame>, NumInterfaces>& frames,
+               const std::size_t                                     expected_transfer_count,
+               const std::uint8_t                                    shard_count) -> double
+{
+    const std::size_t                             ring_count = NumInterfaces * shard_count;
+    std::vector<CanardRxFrameSlot>                slots(ring_count * RingCapacity);
+    const std::unique_ptr<CanardRxFrameRing[]>    rings(new CanardRxFrameRing[ring_count]);  // NOLINT
+    std::array<CanardRxDispatcher, NumInterfaces> dispatchers{};
+    for (std::size_t i = 0; i < ring_count; i++)
+    {
+        if (canardRxFrameRingInit(&rings[i], &slots.at(i * RingCapacity), RingCapacity) != 0)
+        {
+            std::abort();
+        }
+    }
+    for (std::size_t iface = 0; iface < NumInterfaces; iface++)
+    {
+        if (canardRxDispatcherInit(&dispatchers.at(iface), &rings[iface * shard_count], shard_count) != 0)
+        {
+            std::abort();
+        }
+    }
+    std::atomic<std::size_t> interfaces_running{NumInterfaces};
+    std::vector<std::size_t> transfer_counts(shard_count);
+    std::vector<std::thread> threads;
+
+    const auto started = std::chrono::steady_clock::now();
+    for (std::uint8_t shard = 0; shard < shard_count; shard++)
+    {
+        threads.emplace_back([&, shard] {
+            transfer_counts.at(shard) = runShard(shard, shard_count, dispatchers.data(), interfaces_running);
+        });
+    }
+    for (std::size_t iface = 0; iface < NumInterfaces; iface++)
+    {
+        threads.emplace_back([&, iface] {
+            runInterface(frames.at(iface), &dispatchers.at(iface));
+            interfaces_running.fetch_sub(1U, std::memory_order_release);
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    std::size_t total_frames = 0;
+    for (const auto& x : frames)
+    {
+        total_frames += x.size();
+    }
+    std::size_t total_transfers = 0;
+    for (const auto x : transfer_counts)
+    {
+        total_transfers += x;
+    }
+    if (total_transfers != expected_transfer_count)  // A reordering within a session would lose transfers.
+    {
+        std::abort();
+    }
+    return static_cast<double>(total_frames) /
+           std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+}
+}  // namespace
+
+int main(const int argc, const char* const argv[])
+{
+    const unsigned    cores      = std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t max_shards = std::min<std::size_t>(CANARD_RX_SHARD_COUNT_MAX,
+                                                         (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : cores);
+    std::array<std::vector<Frame>, NumInterfaces> frames;
+    std::size_t                                   expected_transfer_count = 0;
+    for (std::size_t iface = 0; iface < NumInterfaces; iface++)
+    {
+        std::size_t count = 0;
+        frames.at(iface)  = generate(iface, count);
+        expected_transfer_count += count;
+    }
+
+    std::printf("%10s %16s %16s\n", "shards", "Mframe/s", "speedup");
+    double baseline = 0.0;
+    for (std::size_t shard_count = 1; shard_count <= max_shards; shard_count++)
+    {
+        const double rate = benchmark(frames, expected_transfer_count, static_cast<std::uint8_t>(shard_count));
+        baseline          = (shard_count == 1U) ? rate : baseline;
+        std::printf("%10zu %16.2f %16.2f\n", shard_count, rate * 1e-6, rate / baseline);
+    }
+    return 0;
+}
@@ -0,0 +1,305 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// Compares the throughput and the system call count of the two ways to service the SocketCAN interfaces:
+// the conventional event loop built on epoll_wait() plus socketcanTransmit()/socketcanReceive(), which makes
+// several system calls per batch of frames per interface, and the io_uring engine, which services all interfaces
+// with at most one system call per iteration (see socketcan_uring.h). Every interface carries the same transfers
+// as in a redundant setup; the received frames are passed to canardRxAccept() in both cases.
+//
+// By default, the interfaces are emulated with socketpair(AF_UNIX, SOCK_SEQPACKET); to use a virtual CAN interface
+// instead, pass its name (e.g., ./bench_socketcan_uring vcan0), in which case a single interface is benchmarked.
+// The absolute numbers of the stand-in are not representative of a real bus; the system call counts are.
+
+#include "canard.h"
+#include "socketcan.h"
+#include "socketcan_uring.h"
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+constexpr CanardPortID SubjectID    = 1234U;
+constexpr std::size_t  NumTransfers = 20'000U;
+constexpr std::size_t  MaxBuses     = SOCKETCAN_URING_INTERFACE_MAX / 2U;  // Each bus has a TX and an RX socket.
+
+void* benchAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    return std::malloc(amount);  // NOLINT
+}
+
+void benchFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    std::free(pointer);  // NOLINT
+}
+
+struct Result
+{
+    double frames_per_second;
+    double syscalls_per_frame;
+};
+
+/// The sockets of the benchmarked buses, the TX queues, and the receiving instance.
+struct Setup
+{
+    Setup(const char* const iface, const std::size_t buses, const bool can_fd) :
+        num_buses(buses), sender(canardInit(&benchAllocate, &benchFree)),
+        receiver(canardInit(&benchAllocate, &benchFree))
+    {
+        sender.node_id = 42;
+        (void) canardRxSubscribe(&receiver, CanardTransferKindMessage, SubjectID, 1000U, 1'000'000U, &sub);
+        for (std::size_t i = 0; i < num_buses; i++)
+        {
+            std::array<int, 2> fds{};
+            bool               ok = false;
+            if (iface != nullptr)
+            {
+                ok = (0 == socketcanOpen(&tx.at(i), iface, can_fd)) && (0 == socketcanOpen(&rx.at(i), iface, can_fd));
+            }
+            else
+            {
+                ok = (0 == socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0, fds.data())) &&
+                     (0 == socketcanAttach(&tx.at(i), fds.at(0), can_fd)) &&
+                     (0 == socketcanAttach(&rx.at(i), fds.at(1), can_fd));
+            }
+            if (!ok)
+            {
+                std::fprintf(stderr, "cannot open the interface: %s\n", std::strerror(errno));
+                std::exit(1);
+            }
+            rx.at(i).redundant_transport_index = static_cast<std::uint8_t>(i);
+            que.at(i) = canardTxInit(NumTransfers * 10U, can_fd ? CANARD_MTU_CAN_FD : CANARD_MTU_CAN_CLASSIC);
+        }
+    }
+    ~Setup()
+    {
+        for (std::size_t i = 0; i < num_buses; i++)
+        {
+            while (que.at(i).size > 0U)
+            {
+                sender.memory_free(&sender, canardTxPop(&que.at(i), canardTxPeek(&que.at(i))));
+            }
+            socketcanClose(&tx.at(i), &sender);
+            socketcanClose(&rx.at(i), nullptr);
+        }
+        (void) canardRxUnsubscribe(&receiver, CanardTransferKindMessage, SubjectID);
+    }
+    Setup(const Setup&)                    = delete;
+    Setup(Setup&&)                         = delete;
+    auto operator=(const Setup&) -> Setup& = delete;
+    auto operator=(Setup&&) -> Setup&      = delete;
+
+    /// Publishes the same transfers via every bus and returns the total number of frames to be received.
+    auto publish(const std::size_t size) -> std::size_t
+    {
+        std::size_t                     out = 0;
+        const std::vector<std::uint8_t> payload(size, 0xAAU);
+        CanardTransferMetadata          meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = SubjectID;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        for (std::size_t i = 0; i < num_buses; i++)
+        {
+            for (std::size_t k = 0; k < NumTransfers; k++)
+            {
+                meta.transfer_id = static_cast<CanardTransferID>(k % (CANARD_TRANSFER_ID_MAX + 1U));
+                if (canardTxPush(&que.at(i), &sender, 0, &meta, payload.size(), payload.data()) < 1)
+                {
+                    std::abort();
+                }
+            }
+            out += que.at(i).size;
+        }
+        return out;
+    }
+
+    void accept(const CanardRxFrameSlot* const frames, const std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            CanardFrame frame{};
+            frame.extended_can_id = frames[i].extended_can_id;
+            frame.payload_size    = frames[i].payload_size;
+            frame.payload         = &frames[i].payload[0];
+            CanardRxTransfer transfer{};
+            if (1 == canardRxAccept(&receiver,
+                                    frames[i].timestamp_usec,
+                                    &frame,
+                                    frames[i].redundant_transport_index,
+                                    &transfer,
+                                    nullptr))
+            {
+                receiver.memory_free(&receiver, transfer.payload);
+            }
+        }
+    }
+
+    std::size_t                         num_buses;
+    CanardInstance                      sender;
+    CanardInstance                      receiver;
+    CanardRxSubscription                sub{};
+    std::array<SocketCAN, MaxBuses>     tx{};
+    std::array<SocketCAN, MaxBuses>     rx{};
+    std::array<CanardTxQueue, MaxBuses> que{};
+};
+
+auto getResult(const std::chrono::steady_clock::duration elapsed, const std::size_t frames, const std::size_t syscalls)
+    -> Result
+{
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    return Result{static_cast<double>(frames) / seconds, static_cast<double>(syscalls) / static_cast<double>(frames)};
+}
+
+/// Waits for the readiness of the sockets and moves the frames in batches, one system call per batch.
+auto benchmarkEpoll(Setup& setup, const std::size_t size) -> Result
+{
+    const std::size_t total = setup.publish(size);
+    const int         ep    = epoll_create1(EPOLL_CLOEXEC);
+    for (std::size_t i = 0; i < setup.num_buses; i++)
+    {
+        epoll_event ev{};
+        ev.events   = EPOLLIN;
+        ev.data.u64 = i;
+        (void) epoll_ctl(ep, EPOLL_CTL_ADD, setup.rx.at(i).fd, &ev);
+    }
+    std::array<CanardRxFrameSlot, SOCKETCAN_BATCH_SIZE> frames{};
+    std::array<epoll_event, MaxBuses>                   events{};
+    std::size_t                                         received = 0;
+    std::size_t                                         syscalls = 0;
+    const auto                                          started  = std::chrono::steady_clock::now();
+    while (received < total)
+    {
+        bool sending = false;
+        for (std::size_t i = 0; i < setup.num_buses; i++)
+        {
+            SocketCAN& tx = setup.tx.at(i);
+            if ((setup.que.at(i).size > 0U) || (tx.pending_count > 0U))
+            {
+                (void) socketcanTransmit(&tx, &setup.que.at(i), &setup.sender, 0);
+                syscalls++;
+                sending = true;
+            }
+        }
+        // While there is more to send, the readiness is polled without blocking so that the TX path is not stalled.
+        const int ready = epoll_wait(ep, events.data(), static_cast<int>(setup.num_buses), sending ? 0 : 10);
+        syscalls++;
+        for (int k = 0; k < ready; k++)
+        {
+            SocketCAN&   rx    = setup.rx.at(events.at(static_cast<std::size_t>(k)).data.u64);
+            std::int32_t count = static_cast<std::int32_t>(SOCKETCAN_BATCH_SIZE);
+            while (count == static_cast<std::int32_t>(SOCKETCAN_BATCH_SIZE))
+            {
+                count = socketcanReceive(&rx, frames.data(), frames.size());
+                syscalls++;
+                if (count > 0)
+                {
+                    setup.accept(frames.data(), static_cast<std::size_t>(count));
+                    received += static_cast<std::size_t>(count);
+                }
+            }
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    (void) close(ep);
+    return getResult(elapsed, total, syscalls);
+}
+
+/// Services all sockets of all buses with one io_uring_enter() per iteration.
+auto benchmarkUring(Setup& setup, const std::size_t size) -> Result
+{
+    SocketCANUring engine{};
+    if (0 != socketcanUringInit(&engine))
+    {
+        return Result{0.0, 0.0};
+    }
+    for (std::size_t i = 0; i < setup.num_buses; i++)
+    {
+        (void) socketcanUringAdd(&engine, &setup.tx.at(i), &setup.que.at(i));
+        (void) socketcanUringAdd(&engine, &setup.rx.at(i), nullptr);
+    }
+    const std::size_t                                         total = setup.publish(size);
+    std::array<CanardRxFrameSlot, SOCKETCAN_URING_RX_BUFFERS> frames{};
+    std::size_t                                               received = 0;
+    engine.syscall_count                                               = 0;
+    const auto                                                started  = std::chrono::steady_clock::now();
+    while (received < total)
+    {
+        const std::int32_t count =
+            socketcanUringPoll(&engine, &setup.sender, 0, 10'000U, frames.data(), frames.size());
+        if (count < 0)
+        {
+            std::abort();
+        }
+        setup.accept(frames.data(), static_cast<std::size_t>(count));
+        received += static_cast<std::size_t>(count);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    const auto out     = getResult(elapsed, total, static_cast<std::size_t>(engine.syscall_count));
+    socketcanUringClose(&engine, &setup.sender);
+    return out;
+}
+}  // namespace
+
+int main(const int argc, const char* const argv[])
+{
+    const char* const iface = (argc > 1) ? argv[1] : nullptr;
+    {
+        SocketCANUring probe{};
+        const auto     result = socketcanUringInit(&probe);
+        if (result != 0)
+        {
+            std::printf("io_uring is not available: %s\n", std::strerror(-result));
+            return 0;
+        }
+        socketcanUringClose(&probe, nullptr);
+    }
+    std::printf("interface: %s\n", (iface != nullptr) ? iface : "socketpair stand-in");
+    std::printf("%6s %9s %6s %16s %16s %16s %16s\n",
+                "buses",
+                "payload",
+                "CAN FD",
+                "epoll, frame/s",
+                "epoll, sc/frame",
+                "uring, frame/s",
+                "uring, sc/frame");
+    static const std::array<std::size_t, 2> Sizes{{7U, 313U}};
+    const std::size_t                       max_buses = (iface != nullptr) ? 1U : MaxBuses;
+    for (std::size_t buses = 1U; buses <= max_buses; buses++)
+    {
+        for (const auto size : Sizes)
+        {
+            const bool can_fd = size > 7U;
+            Result     epoll{};
+            Result     uring{};
+            {
+                Setup setup(iface, buses, can_fd);
+                epoll = benchmarkEpoll(setup, size);
+            }
+            {
+                Setup setup(iface, buses, can_fd);
+                uring = benchmarkUring(setup, size);
+            }
+            std::printf("%6zu %9zu %6s %16.0f %16.3f %16.0f %16.3f\n",
+                        buses,
+                        size,
+                        can_fd ? "yes" : "no",
+                        epoll.frames_per_second,
+                        epoll.syscalls_per_frame,
+                        uring.frames_per_second,
+                        uring.syscalls_per_frame);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// Compares the push/pop latency of the available TX queue kinds at various queue depths.
+// The queue is first filled up to the target depth, then a steady-state mix of push+pop pairs is measured,
+// which is representative of a queue that is being drained by the CAN driver while the application keeps publishing.
+// Every pair is timed individually to report the tail latency in addition to the mean.
+
+#include "canard.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t NumPorts       = 64U;
+constexpr std::size_t NumDistinctIDs = NumPorts * (CANARD_PRIORITY_MAX + 1U);
+
+void* benchAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    return std::malloc(amount);  // NOLINT
+}
+
+void benchFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    std::free(pointer);  // NOLINT
+}
+
+struct Result
+{
+    double mean_ns;
+    double p999_ns;  ///< 99.9-th percentile.
+};
+
+auto benchmark(const CanardTxQueueKind kind, const std::size_t depth, const std::size_t iterations) -> Result
+{
+    CanardInstance                  ins = canardInit(&benchAllocate, &benchFree);
+    std::vector<CanardTxQueueItem*> heap(depth + 1U);
+    std::vector<CanardTxBitmapNode> bitmap(1U + (5U * NumDistinctIDs));
+    CanardTxQueue                   que = canardTxInit(depth + 1U, CANARD_MTU_CAN_CLASSIC);
+    if (kind == CanardTxQueueKindHeap)
+    {
+        que = canardTxInitHeap(depth + 1U, CANARD_MTU_CAN_CLASSIC, heap.data(), heap.size());
+    }
+    if (kind == CanardTxQueueKindBitmap)
+    {
+        que = canardTxInitBitmap(depth + 1U, CANARD_MTU_CAN_CLASSIC, bitmap.data(), bitmap.size());
+    }
+    ins.node_id = 42;
+
+    std::minstd_rand                  rng(1234);  // NOLINT fixed seed for reproducibility
+    const std::array<std::uint8_t, 7> payload{};
+    CanardTransferMetadata            meta{};
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    const auto push     = [&]() {
+        meta.priority    = static_cast<CanardPriority>(rng() % (CANARD_PRIORITY_MAX + 1U));
+        meta.port_id     = static_cast<CanardPortID>(rng() % NumPorts);
+        meta.transfer_id = static_cast<CanardTransferID>((meta.transfer_id + 1U) % 32U);
+        if (canardTxPush(&que, &ins, 0, &meta, payload.size(), payload.data()) != 1)
+        {
+            std::abort();
+        }
+    };
+    const auto pop = [&]() { ins.memory_free(&ins, canardTxPop(&que, canardTxPeek(&que))); };
+
+    while (que.size < depth)
+    {
+        push();
+    }
+    using Clock = std::chrono::steady_clock;
+    std::vector<std::int64_t> samples(iterations);
+    for (auto& sample : samples)
+    {
+        const auto started = Clock::now();
+        push();
+        pop();
+        sample = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count();
+    }
+    while (que.size > 0)
+    {
+        pop();
+    }
+    double sum = 0;
+    for (const auto sample : samples)
+    {
+        sum += static_cast<double>(sample);
+    }
+    const auto p999 = samples.begin() + static_cast<std::ptrdiff_t>((iterations * 999U) / 1000U);
+    std::nth_element(samples.begin(), p999, samples.end());
+    return {sum / static_cast<double>(iterations), static_cast<double>(*p999)};
+}
+}  // namespace
+
+int main()
+{
+    static const std::array<std::size_t, 5> Depths{{10U, 100U, 1'000U, 10'000U, 100'000U}};
+    constexpr std::size_t                   Iterations = 1'000'000U;
+    std::printf("Nanoseconds per push+pop pair, mean / 99.9-th percentile\n");
+    std::printf("%10s %16s %16s %16s\n", "depth", "tree", "heap", "bitmap");
+    for (const auto depth : Depths)
+    {
+        const Result tree   = benchmark(CanardTxQueueKindTree, depth, Iterations);
+        const Result heap   = benchmark(CanardTxQueueKindHeap, depth, Iterations);
+        const Result bitmap = benchmark(CanardTxQueueKindBitmap, depth, Iterations);
+        std::printf("%10zu %9.1f/%6.0f %9.1f/%6.0f %9.1f/%6.0f\n",
+                    depth,
+                    tree.mean_ns,
+                    tree.p999_ns,
+                    heap.mean_ns,
+                    heap.p999_ns,
+                    bitmap.mean_ns,
+                    bitmap.p999_ns);
+    }
+    return 0;
+}
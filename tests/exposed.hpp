@@ -43,6 +43,26 @@ struct TxItem final : CanardTxQueueItem
     auto operator=(const TxItem&&) -> TxItem& = delete;
 };
 
+struct TxDeadlineNode
+{
+    CanardTreeNode           base;
+    const CanardTxQueueItem* item;
+};
+
+#if defined(CANARD_RX_COMPACT_SESSION) && CANARD_RX_COMPACT_SESSION
+struct RxSession
+{
+    std::uint8_t* payload                   = nullptr;
+    std::uint32_t transfer_timestamp_usec   = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t total_payload_size        = 0U;
+    std::uint32_t payload_size              = 0U;
+    TransferCRC   calculated_crc            = 0U;
+    std::uint8_t  redundant_transport_index = std::numeric_limits<std::uint8_t>::max();
+    unsigned int  transfer_id : CANARD_TRANSFER_ID_BIT_LENGTH;  // Bit-fields cannot have default initializers.
+    bool          toggle : 1;
+    bool          adaptive_payload : 1;
+};
+#else
 struct RxSession
 {
     CanardMicrosecond transfer_timestamp_usec   = std::numeric_limits<std::uint64_t>::max();
@@ -53,7 +73,9 @@ struct RxSession
     CanardTransferID  transfer_id               = std::numeric_limits<std::uint8_t>::max();
     std::uint8_t      redundant_transport_index = std::numeric_limits<std::uint8_t>::max();
     bool              toggle                    = false;
+    bool              adaptive_payload          = false;
 };
+#endif
 
 struct RxFrameModel
 {
@@ -101,20 +123,21 @@ auto rxTryParseFrame(const CanardMicrosecond  timestamp_usec,
                      const CanardFrame* const frame,
                      RxFrameModel* const      out_result) -> bool;
 
-auto rxSessionWritePayload(CanardInstance* const ins,
-                           RxSession* const      rxs,
-                           const std::size_t     extent,
-                           const std::size_t     payload_size,
-                           const void* const     payload) -> std::int8_t;
+auto rxSessionWritePayload(CanardInstance* const              ins,
+                           RxSession* const                   rxs,
+                           const CanardRxPayloadLayout* const layout,
+                           const std::size_t                  extent,
+                           const std::size_t                  payload_size,
+                           const void* const                  payload) -> std::int8_t;
 
 void rxSessionRestart(CanardInstance* const ins, RxSession* const rxs);
 
-auto rxSessionUpdate(CanardInstance* const     ins,
-                     RxSession* const          rxs,
-                     const RxFrameModel* const frame,
-                     const std::uint8_t        redundant_transport_index,
-                     const CanardMicrosecond   transfer_id_timeout_usec,
-                     const std::size_t         extent,
-                     CanardRxTransfer* const   out_transfer) -> std::int8_t;
+auto rxSessionUpdate(CanardInstance* const             ins,
+                     RxSession* const                  rxs,
+                     const CanardRxSubscription* const subscription,
+                     const RxFrameModel* const         frame,
+                     const std::uint8_t                redundant_transport_index,
+                     CanardRxTransfer* const           out_transfer,
+                     bool* const                       out_accepted) -> std::int8_t;
 }
 }  // namespace exposed
@@ -199,11 +199,27 @@ public:
         return canardRxSubscribe(&canard_, transfer_kind, port_id, extent, transfer_id_timeout_usec, &out_subscription);
     }
 
+    [[nodiscard]] auto rxSubscribeSingleFrame(const CanardTransferKind transfer_kind,
+                                              const CanardPortID       port_id,
+                                              const std::size_t        extent,
+                                              const CanardMicrosecond  transfer_id_timeout_usec,
+                                              CanardRxSubscription&    out_subscription)
+    {
+        return canardRxSubscribeSingleFrame(&canard_,
+                                            transfer_kind,
+                                            port_id,
+                                            extent,
+                                            transfer_id_timeout_usec,
+                                            &out_subscription);
+    }
+
     [[nodiscard]] auto rxUnsubscribe(const CanardTransferKind transfer_kind, const CanardPortID port_id)
     {
         return canardRxUnsubscribe(&canard_, transfer_kind, port_id);
     }
 
+    [[nodiscard]] auto rxExpire(const CanardMicrosecond now_usec) { return canardRxExpire(&canard_, now_usec); }
+
     /// The items are sorted by port-ID.
     [[nodiscard]] auto getSubs(const CanardTransferKind tk) const -> std::vector<const CanardRxSubscription*>
     {
@@ -245,10 +261,19 @@ private:
 class TxQueue
 {
 public:
-    explicit TxQueue(const std::size_t capacity, const std::size_t mtu_bytes) : que_(canardTxInit(capacity, mtu_bytes))
+    explicit TxQueue(const std::size_t       capacity,
+                     const std::size_t       mtu_bytes,
+                     const CanardTxQueueKind kind           = CanardTxQueueKindTree,
+                     const bool              deadline_index = false) :
+        heap_((kind == CanardTxQueueKindHeap) ? capacity : 0U),
+        bitmap_((kind == CanardTxQueueKindBitmap) ? (1U + (5U * capacity)) : 0U),  // Worst case: all IDs distinct.
+        que_(makeQueue(capacity, mtu_bytes, kind, heap_, bitmap_))
     {
         enforce(que_.user_reference == nullptr, "Incorrect initialization of the user reference in TxQueue");
         enforce(que_.mtu_bytes == mtu_bytes, "Incorrect MTU");
+        enforce(que_.kind == kind, "Incorrect kind");
+        enforce(!que_.deadline_index, "The deadline index shall be disabled by default");
+        enforce(0 == canardTxSetDeadlineIndex(&que_, deadline_index), "Could not configure the deadline index");
         que_.user_reference = this;  // This is simply to ensure it is not overwritten unexpectedly.
         checkInvariants();
     }
@@ -309,20 +334,79 @@ public:
     [[nodiscard]] auto getSize() const
     {
         std::size_t out = 0;
-        traverse(que_.root, [&](auto* _) {
-            (void) _;
-            out++;
-        });
+        if (que_.kind == CanardTxQueueKindHeap)
+        {
+            enforce(que_.root == nullptr, "Heap queue uses the tree");
+            for (out = 0; out < que_.size; out++)
+            {
+                const auto* const item = que_.heap[out];
+                enforce(item->base.heap.index == out, "Heap index mismatch");
+                enforce((out == 0) || !isBefore(item, que_.heap[(out - 1U) / 2U]), "Heap property violation");
+            }
+        }
+        else if (que_.kind == CanardTxQueueKindBitmap)
+        {
+            enforce(que_.root == nullptr, "Bitmap queue uses the tree");
+            std::size_t nodes = 0;
+            traverseBitmap(que_.bitmap_root, 0, nodes, [&](auto* _) {
+                (void) _;
+                out++;
+            });
+            enforce((nodes + que_.bitmap_free_count) == bitmap_.size(), "Bitmap node leak");
+        }
+        else
+        {
+            traverse(que_.root, [&](auto* _) {
+                (void) _;
+                out++;
+            });
+        }
         enforce(que_.size == out, "Size miscalculation");
+        std::size_t              deadline_count = 0;
+        const CanardTxQueueItem* prev           = nullptr;
+        traverse(que_.deadline_root, [&](const CanardTreeNode* const node) {
+            const auto* const item = reinterpret_cast<const exposed::TxDeadlineNode*>(node)->item;
+            enforce((prev == nullptr) || (prev->tx_deadline_usec <= item->tx_deadline_usec), "Deadline order");
+            prev = item;
+            deadline_count++;
+        });
+        enforce(deadline_count == (que_.deadline_index ? out : 0U), "Deadline tree size mismatch");
         return out;
     }
 
+    [[nodiscard]] auto peekEarliestDeadline() const -> const exposed::TxItem*
+    {
+        checkInvariants();
+        const auto* const ret = canardTxPeekEarliestDeadline(&que_);
+        enforce((ret == nullptr) == ((que_.size == 0) || !que_.deadline_index), "Bad earliest deadline peek");
+        return static_cast<const exposed::TxItem*>(ret);  // NOLINT static downcast
+    }
+
     [[nodiscard]] auto linearize() const -> std::vector<const exposed::TxItem*>
     {
         std::vector<const exposed::TxItem*> out;
-        traverse(que_.root, [&](const CanardTreeNode* const item) {
-            out.push_back(reinterpret_cast<const exposed::TxItem*>(item));
-        });
+        if (que_.kind == CanardTxQueueKindHeap)
+        {
+            std::vector<const CanardTxQueueItem*> items(que_.heap, que_.heap + que_.size);
+            std::sort(items.begin(), items.end(), &TxQueue::isBefore);
+            for (const auto* const item : items)
+            {
+                out.push_back(static_cast<const exposed::TxItem*>(item));  // NOLINT static downcast
+            }
+        }
+        else if (que_.kind == CanardTxQueueKindBitmap)
+        {
+            std::size_t nodes = 0;
+            traverseBitmap(que_.bitmap_root, 0, nodes, [&](const CanardTxQueueItem* const item) {
+                out.push_back(static_cast<const exposed::TxItem*>(item));  // NOLINT static downcast
+            });
+        }
+        else
+        {
+            traverse(que_.root, [&](const CanardTreeNode* const item) {
+                out.push_back(reinterpret_cast<const exposed::TxItem*>(item));
+            });
+        }
         enforce(out.size() == getSize(), "Internal error");
         return out;
     }
@@ -345,7 +429,81 @@ private:
         enforce(que_.size == getSize(), "Size miscalculation");
     }
 
-    CanardTxQueue que_;
+    static auto makeQueue(const std::size_t                capacity,
+                          const std::size_t                mtu_bytes,
+                          const CanardTxQueueKind          kind,
+                          std::vector<CanardTxQueueItem*>& heap,
+                          std::vector<CanardTxBitmapNode>& bitmap) -> CanardTxQueue
+    {
+        switch (kind)
+        {
+        case CanardTxQueueKindHeap:
+            return canardTxInitHeap(capacity, mtu_bytes, heap.data(), heap.size());
+        case CanardTxQueueKindBitmap:
+            return canardTxInitBitmap(capacity, mtu_bytes, bitmap.data(), bitmap.size());
+        case CanardTxQueueKindTree:
+            break;
+        }
+        return canardTxInit(capacity, mtu_bytes);
+    }
+
+    /// Visits the items in the transmission order and validates the structure of the radix tree along the way.
+    template <typename F>
+    static void traverseBitmap(const CanardTxBitmapNode* const node,
+                               const std::uint32_t             level,
+                               std::size_t&                    node_count,
+                               const F&                        fn)
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+        enforce(node->mask != 0, "Empty bitmap node is not pruned");
+        enforce((level > 0) || (node->mask <= 0xFFFFU), "Root node index out of range");
+        node_count++;
+        for (std::uint32_t i = 0; i < CANARD_TX_BITMAP_FANOUT; i++)
+        {
+            if ((node->mask & (1UL << i)) == 0)
+            {
+                continue;
+            }
+            if (level < 5U)
+            {
+                traverseBitmap(static_cast<const CanardTxBitmapNode*>(node->children[i]), level + 1U, node_count, fn);
+            }
+            else
+            {
+                const auto* const head = static_cast<const CanardTxQueueItem*>(node->children[i]);
+                const auto*       item = head;
+                const auto*       prev =
+                    static_cast<const CanardTxQueueItem*>(static_cast<void*>(head->base.node.lr[0]));
+                enforce(prev->base.node.lr[1] == nullptr, "The previous item of the head shall be the tail");
+                while (item != nullptr)
+                {
+                    enforce(item->frame.extended_can_id == head->frame.extended_can_id, "CAN ID mismatch");
+                    enforce((item == head) || (item->base.node.lr[0] == &prev->base.node), "Broken list");
+                    fn(item);
+                    prev = item;
+                    item = static_cast<const CanardTxQueueItem*>(static_cast<void*>(item->base.node.lr[1]));
+                }
+                enforce(head->base.node.lr[0] == &prev->base.node, "The tail is not linked from the head");
+            }
+        }
+    }
+
+    /// The same ordering as the one implemented by the library: by CAN ID, then FIFO.
+    static auto isBefore(const CanardTxQueueItem* const a, const CanardTxQueueItem* const b) -> bool
+    {
+        if (a->frame.extended_can_id != b->frame.extended_can_id)
+        {
+            return a->frame.extended_can_id < b->frame.extended_can_id;
+        }
+        return static_cast<std::int32_t>(a->base.heap.sequence - b->base.heap.sequence) < 0;
+    }
+
+    std::vector<CanardTxQueueItem*> heap_;
+    std::vector<CanardTxBitmapNode> bitmap_;
+    CanardTxQueue                   que_;
 };
 
 }  // namespace helpers
@@ -0,0 +1,409 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// A deterministic in-process simulator of a CAN bus that hosts many nodes, each with its own instance and TX queue,
+// for the tests and the benchmarks that need to see how the library behaves at scale. The time is virtual and
+// advances only as the frames are transmitted and the scheduled actions are executed, so a simulation of many
+// seconds of bus activity completes in a fraction of that and is exactly reproducible.
+//
+// The bus is modeled at the bit level: the duration of every frame is computed by canardGetFrameDuration() from its
+// actual bits, including the stuff bits, the CRC field of the proper length, and the data phase of CAN FD at its own
+// bit rate.
+// The frames at the heads of the TX queues of all nodes compete for the bus by their CAN IDs as in the lossless
+// bitwise arbitration, and the winner is delivered to every other node at the end of its transmission.
+
+#pragma once
+
+#include "canard.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <queue>
+#include <vector>
+
+namespace simulator
+{
+using Nanoseconds = std::uint64_t;
+
+using FrameBits = CanardFrameBits;
+
+inline auto getFrameBits(const CanardFrame& frame, const bool fd, const bool bit_rate_switch) -> FrameBits
+{
+    return canardGetFrameBits(&frame, fd, bit_rate_switch);
+}
+
+/// The configuration of the bus. The data bit rate is used only for CAN FD with bit rate switching.
+struct BusConfig
+{
+    bool          fd               = false;
+    bool          bit_rate_switch  = true;
+    std::uint32_t nominal_bit_rate = 1'000'000U;
+    std::uint32_t data_bit_rate    = 4'000'000U;
+
+    [[nodiscard]] auto getTiming() const -> CanardBusTiming
+    {
+        return CanardBusTiming{fd, nominal_bit_rate, (fd && bit_rate_switch) ? data_bit_rate : 0U};
+    }
+};
+
+inline auto getFrameDuration(const BusConfig& config, const CanardFrame& frame) -> Nanoseconds
+{
+    const CanardBusTiming timing = config.getTiming();
+    return canardGetFrameDuration(&timing, &frame);
+}
+
+/// The statistics of one node.
+struct NodeStats
+{
+    std::uint64_t tx_transfers       = 0;  ///< Transfers whose last frame has been transmitted.
+    std::uint64_t tx_frames          = 0;
+    std::uint64_t tx_push_failures   = 0;  ///< The queue was full or the memory ran out.
+    std::uint64_t tx_deadline_drops  = 0;  ///< Frames dropped at the head of the queue because they have expired.
+    std::size_t   tx_queue_depth_max = 0;  ///< In frames.
+    Nanoseconds   latency_max        = 0;  ///< From the publication to the end of the last frame of a transfer.
+    Nanoseconds   latency_total      = 0;
+    std::uint64_t rx_transfers       = 0;
+    std::size_t   memory_bytes       = 0;  ///< The memory allocated by the instance at the moment.
+    std::size_t   memory_bytes_max   = 0;
+    std::size_t   memory_fragments   = 0;
+};
+
+class Bus;
+
+/// A node on the simulated bus: an instance, its TX queue, its subscriptions, and its memory accounting.
+class Node
+{
+public:
+    Node(Bus& bus, const CanardNodeID node_id, const std::size_t tx_capacity, const BusConfig& config) :
+        bus_(bus),
+        ins_(canardInit(&allocate, &deallocate)),
+        que_(canardTxInit(tx_capacity, config.fd ? CANARD_MTU_CAN_FD : CANARD_MTU_CAN_CLASSIC))
+    {
+        ins_.node_id        = node_id;
+        ins_.user_reference = this;
+    }
+    ~Node()
+    {
+        while (que_.size > 0U)
+        {
+            ins_.memory_free(&ins_, canardTxPop(&que_, canardTxPeek(&que_)));
+        }
+        for (auto& sub : subscriptions_)
+        {
+            (void) canardRxUnsubscribe(&ins_, sub.first, sub.second->port_id);
+        }
+    }
+    Node(const Node&)                    = delete;
+    Node(Node&&)                         = delete;
+    auto operator=(const Node&) -> Node& = delete;
+    auto operator=(Node&&) -> Node&      = delete;
+
+    void subscribe(const CanardTransferKind kind, const CanardPortID port_id, const std::size_t extent)
+    {
+        subscriptions_.emplace_back(kind, std::make_unique<CanardRxSubscription>());
+        (void) canardRxSubscribe(&ins_, kind, port_id, extent, 2'000'000U, subscriptions_.back().second.get());
+    }
+
+    /// Pushes the transfer into the TX queue at the current virtual time. The deadline is relative to the current
+    /// time; zero means no deadline. Returns the result of canardTxPush().
+    auto publish(const CanardTransferMetadata& metadata,
+                 const std::size_t             payload_size,
+                 const void* const             payload,
+                 const Nanoseconds             timeout = 0) -> std::int32_t;
+
+    /// Invoked for every transfer received by this node at the virtual time of the reception.
+    std::function<void(const CanardRxTransfer&)> on_transfer;
+
+    [[nodiscard]] auto getInstance() -> CanardInstance& { return ins_; }
+    [[nodiscard]] auto getTxQueue() -> CanardTxQueue& { return que_; }
+    [[nodiscard]] auto getStats() const -> const NodeStats& { return stats_; }
+
+private:
+    friend class Bus;
+
+    /// The size of each allocation is stored in front of it for the memory accounting.
+    static constexpr std::size_t Header = alignof(std::max_align_t);
+
+    static auto allocate(CanardInstance* const ins, const std::size_t amount) -> void*
+    {
+        auto* const self = static_cast<Node*>(ins->user_reference);
+        auto* const p    = static_cast<std::uint8_t*>(std::malloc(amount + Header));  // NOLINT
+        if (p != nullptr)
+        {
+            *reinterpret_cast<std::size_t*>(p) = amount;  // NOLINT
+            self->stats_.memory_bytes += amount;
+            self->stats_.memory_fragments++;
+            self->stats_.memory_bytes_max = std::max(self->stats_.memory_bytes_max, self->stats_.memory_bytes);
+        }
+        return (p != nullptr) ? (p + Header) : nullptr;
+    }
+
+    static void deallocate(CanardInstance* const ins, void* const pointer)
+    {
+        if (pointer != nullptr)
+        {
+            auto* const self = static_cast<Node*>(ins->user_reference);
+            auto* const p    = static_cast<std::uint8_t*>(pointer) - Header;
+            self->stats_.memory_bytes -= *reinterpret_cast<std::size_t*>(p);  // NOLINT
+            self->stats_.memory_fragments--;
+            std::free(p);  // NOLINT
+        }
+    }
+
+    /// Identifies an outgoing transfer by its kind, port, destination, and transfer-ID, which are recoverable from
+    /// the CAN ID and the tail byte of its frames.
+    static auto getTransferKey(const CanardTransferKind kind,
+                               const CanardPortID       port_id,
+                               const CanardNodeID       remote_node_id,
+                               const CanardTransferID   transfer_id) -> std::uint64_t
+    {
+        return (static_cast<std::uint64_t>(kind) << 32U) | (static_cast<std::uint64_t>(port_id) << 16U) |
+               (static_cast<std::uint64_t>(remote_node_id) << 8U) | transfer_id;
+    }
+
+    static auto getTransferKey(const CanardFrame& frame) -> std::uint64_t
+    {
+        const std::uint32_t id   = frame.extended_can_id;
+        const auto          tail = static_cast<const std::uint8_t*>(frame.payload)[frame.payload_size - 1U];
+        const auto          tid  = static_cast<CanardTransferID>(tail & CANARD_TRANSFER_ID_MAX);
+        std::uint64_t       out  = 0;
+        if ((id & (1UL << 25U)) == 0U)
+        {
+            const auto port = static_cast<CanardPortID>((id >> 8U) & CANARD_SUBJECT_ID_MAX);
+            out             = getTransferKey(CanardTransferKindMessage, port, CANARD_NODE_ID_UNSET, tid);
+        }
+        else
+        {
+            const auto kind = ((id & (1UL << 24U)) != 0U) ? CanardTransferKindRequest : CanardTransferKindResponse;
+            const auto port = static_cast<CanardPortID>((id >> 14U) & CANARD_SERVICE_ID_MAX);
+            out = getTransferKey(kind, port, static_cast<CanardNodeID>((id >> 7U) & CANARD_NODE_ID_MAX), tid);
+        }
+        return out;
+    }
+
+    using Subscription = std::pair<CanardTransferKind, std::unique_ptr<CanardRxSubscription>>;
+
+    Bus&                                 bus_;
+    CanardInstance                       ins_;
+    CanardTxQueue                        que_;
+    std::list<Subscription>              subscriptions_;
+    std::map<std::uint64_t, Nanoseconds> published_;  ///< The publication time of pending transfers.
+    NodeStats                            stats_;
+};
+
+/// The statistics of the bus.
+struct BusStats
+{
+    std::uint64_t frames                 = 0;
+    Nanoseconds   busy_time              = 0;
+    std::uint64_t stuff_bits             = 0;
+    std::uint64_t arbitrations_contended = 0;  ///< Arbitrations won against at least one other pending frame.
+};
+
+class Bus
+{
+public:
+    explicit Bus(const BusConfig& config) : config_(config)
+    {
+        (void) canardBusLoadMeterInit(&meter_, config_.getTiming(), 1'000'000U);
+    }
+
+    /// The node is owned by the bus; the reference remains valid for the lifetime of the bus.
+    auto addNode(const CanardNodeID node_id, const std::size_t tx_capacity = 1'000U) -> Node&
+    {
+        nodes_.push_back(std::make_unique<Node>(*this, node_id, tx_capacity, config_));
+        return *nodes_.back();
+    }
+
+    /// Executes the action at the specified virtual time; the actions scheduled for the same time are executed
+    /// in the order of scheduling. An action may schedule further actions.
+    void schedule(const Nanoseconds at, std::function<void()> action)
+    {
+        events_.push(Event{std::max(at, now_), sequence_++, std::move(action)});
+    }
+
+    /// Runs the simulation until the specified virtual time. A transmission that begins before that time is completed
+    /// even if it ends later.
+    void runUntil(const Nanoseconds until)
+    {
+        bool more = true;
+        while (more)
+        {
+            // The actions due now are executed first so that the frames they enqueue take part in the arbitration.
+            const bool  due    = !events_.empty() && (events_.top().at <= now_);
+            std::size_t pending = 0;
+            Node* const winner  = due ? nullptr : arbitrate(pending);
+            if (due)
+            {
+                runEvent();
+            }
+            else if ((winner != nullptr) && (now_ <= until))
+            {
+                stats_.arbitrations_contended += (pending > 1U) ? 1U : 0U;
+                transmit(*winner);
+            }
+            else if (!events_.empty() && (events_.top().at <= until))
+            {
+                runEvent();
+            }
+            else
+            {
+                now_ = std::max(now_, until);
+                more = false;
+            }
+        }
+    }
+
+    [[nodiscard]] auto now() const { return now_; }
+    [[nodiscard]] auto nowMicroseconds() const -> CanardMicrosecond { return now_ / 1'000U; }
+    [[nodiscard]] auto getConfig() const -> const BusConfig& { return config_; }
+    [[nodiscard]] auto getStats() const -> const BusStats& { return stats_; }
+    [[nodiscard]] auto getNodes() const -> const std::vector<std::unique_ptr<Node>>& { return nodes_; }
+
+    /// The bus load as measured by a node that receives every frame, averaged over one-second windows.
+    [[nodiscard]] auto getBusLoadMeter() const -> const CanardBusLoadMeter& { return meter_; }
+
+    /// The fraction of the time the bus has been busy since the beginning of the simulation.
+    [[nodiscard]] auto getUtilization() const -> double
+    {
+        return (now_ > 0U) ? (static_cast<double>(stats_.busy_time) / static_cast<double>(now_)) : 0.0;
+    }
+
+private:
+    struct Event
+    {
+        Nanoseconds           at;
+        std::uint64_t         sequence;
+        std::function<void()> action;
+    };
+    struct EventOrder
+    {
+        auto operator()(const Event& a, const Event& b) const -> bool
+        {
+            return (a.at != b.at) ? (a.at > b.at) : (a.sequence > b.sequence);
+        }
+    };
+
+    void runEvent()
+    {
+        Event event = events_.top();
+        events_.pop();
+        now_ = event.at;
+        event.action();
+    }
+
+    /// Drops the expired frames and returns the node whose head frame has the lowest CAN ID, if any, along with
+    /// the number of nodes that have a frame pending. The ties, which are only possible with anonymous frames,
+    /// are resolved in favor of the node added first.
+    auto arbitrate(std::size_t& pending) -> Node*
+    {
+        Node* out = nullptr;
+        for (auto& node : nodes_)
+        {
+            const CanardTxQueueItem* ti = canardTxPeek(&node->que_);
+            while ((ti != nullptr) && (ti->tx_deadline_usec != 0U) && (ti->tx_deadline_usec <= nowMicroseconds()))
+            {
+                node->ins_.memory_free(&node->ins_, canardTxPop(&node->que_, ti));
+                node->stats_.tx_deadline_drops++;
+                ti = canardTxPeek(&node->que_);
+            }
+            if (ti != nullptr)
+            {
+                pending++;
+                if ((out == nullptr) ||
+                    (ti->frame.extended_can_id < canardTxPeek(&out->que_)->frame.extended_can_id))
+                {
+                    out = node.get();
+                }
+            }
+        }
+        return out;
+    }
+
+    /// Transmits the head frame of the node. The actions scheduled for the time of the transmission are executed
+    /// before the frame is delivered; the frames they enqueue compete in the next arbitration.
+    void transmit(Node& sender)
+    {
+        CanardTxQueueItem* const item     = canardTxPop(&sender.que_, canardTxPeek(&sender.que_));
+        const FrameBits          bits     = getFrameBits(item->frame, config_.fd, config_.bit_rate_switch);
+        const Nanoseconds        duration = getFrameDuration(config_, item->frame);
+        const Nanoseconds        end      = now_ + duration;
+        stats_.frames++;
+        stats_.busy_time += duration;
+        stats_.stuff_bits += bits.stuff;
+        while (!events_.empty() && (events_.top().at < end))
+        {
+            runEvent();
+        }
+        now_ = end;
+        (void) canardBusLoadMeterUpdate(&meter_, nowMicroseconds(), &item->frame);
+        sender.stats_.tx_frames++;
+        const auto tail = static_cast<const std::uint8_t*>(item->frame.payload)[item->frame.payload_size - 1U];
+        if ((tail & 0x40U) != 0U)  // End of transfer.
+        {
+            sender.stats_.tx_transfers++;
+            const auto it = sender.published_.find(Node::getTransferKey(item->frame));
+            if (it != sender.published_.end())
+            {
+                const Nanoseconds latency   = now_ - it->second;
+                sender.stats_.latency_max   = std::max(sender.stats_.latency_max, latency);
+                sender.stats_.latency_total += latency;
+                sender.published_.erase(it);
+            }
+        }
+        for (auto& node : nodes_)
+        {
+            if (node.get() != &sender)
+            {
+                CanardRxTransfer transfer{};
+                if (1 == canardRxAccept(&node->ins_, nowMicroseconds(), &item->frame, 0, &transfer, nullptr))
+                {
+                    node->stats_.rx_transfers++;
+                    if (node->on_transfer)
+                    {
+                        node->on_transfer(transfer);
+                    }
+                    node->ins_.memory_free(&node->ins_, transfer.payload);
+                }
+            }
+        }
+        sender.ins_.memory_free(&sender.ins_, item);
+    }
+
+    const BusConfig                                            config_;
+    Nanoseconds                                                now_      = 0;
+    std::uint64_t                                              sequence_ = 0;
+    std::priority_queue<Event, std::vector<Event>, EventOrder> events_;
+    std::vector<std::unique_ptr<Node>>                         nodes_;
+    BusStats                                                   stats_;
+    CanardBusLoadMeter                                         meter_{};
+};
+
+inline auto Node::publish(const CanardTransferMetadata& metadata,
+                          const std::size_t             payload_size,
+                          const void* const             payload,
+                          const Nanoseconds             timeout) -> std::int32_t
+{
+    const CanardMicrosecond deadline = (timeout > 0U) ? ((bus_.now() + timeout) / 1'000U) : 0U;
+    const std::int32_t      out      = canardTxPush(&que_, &ins_, deadline, &metadata, payload_size, payload);
+    if (out > 0)
+    {
+        const bool message = metadata.transfer_kind == CanardTransferKindMessage;
+        published_[getTransferKey(metadata.transfer_kind,
+                                  metadata.port_id,
+                                  message ? CANARD_NODE_ID_UNSET : metadata.remote_node_id,
+                                  metadata.transfer_id)] = bus_.now();
+        stats_.tx_queue_depth_max = std::max(stats_.tx_queue_depth_max, que_.size);
+    }
+    else
+    {
+        stats_.tx_push_failures++;
+    }
+    return out;
+}
+}  // namespace simulator
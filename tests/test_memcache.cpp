@@ -0,0 +1,239 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+
+#include "helpers.hpp"
+#include "memcache.h"
+#include "catch.hpp"
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+thread_local MemCache* g_thread_cache = nullptr;  // NOLINT the cache of the current thread
+
+// The memory management callbacks of the instances forward the calls to the cache of the calling thread,
+// which draws the blocks from the heap of the instance referenced by the user reference.
+auto cachedAllocate(CanardInstance* const ins, const std::size_t amount) -> void*
+{
+    return memcacheAllocate(g_thread_cache, static_cast<CanardInstance*>(ins->user_reference), amount);
+}
+
+void cachedFree(CanardInstance* const ins, void* const pointer)
+{
+    memcacheFree(g_thread_cache, static_cast<CanardInstance*>(ins->user_reference), pointer);
+}
+}  // namespace
+
+TEST_CASE("MemoryCache")
+{
+    helpers::Instance heap;
+    auto&             alloc    = heap.getAllocator();
+    CanardInstance*   upstream = &heap.getInstance();
+    MemCache          cache{};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == memcacheInit(nullptr, upstream->memory_allocate, nullptr, 2));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == memcacheInit(&cache, nullptr, upstream->memory_free, 2));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == memcacheInit(&cache, upstream->memory_allocate, nullptr, 2));
+    REQUIRE(0 == memcacheInit(&cache, upstream->memory_allocate, upstream->memory_free, 2));
+    REQUIRE(nullptr == memcacheAllocate(nullptr, upstream, 1));
+    memcacheFree(nullptr, upstream, &cache);  // No effect.
+    memcacheFree(&cache, upstream, nullptr);  // No effect.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == memcacheTrim(nullptr, upstream));
+
+    // The blocks are drawn from the shared heap in the power-of-two size classes including the header.
+    auto* const a = static_cast<std::uint8_t*>(memcacheAllocate(&cache, upstream, 1));
+    REQUIRE(a != nullptr);
+    REQUIRE(0 == (reinterpret_cast<std::uintptr_t>(a) % MEMCACHE_HEADER_SIZE));
+    std::memset(a, 0xAA, MEMCACHE_BLOCK_SIZE_MIN - MEMCACHE_HEADER_SIZE);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    REQUIRE(MEMCACHE_BLOCK_SIZE_MIN == alloc.getTotalAllocatedAmount());
+    void* const b = memcacheAllocate(&cache, upstream, 0);
+    REQUIRE(b != nullptr);
+    REQUIRE(2 * MEMCACHE_BLOCK_SIZE_MIN == alloc.getTotalAllocatedAmount());
+    void* const c = memcacheAllocate(&cache, upstream, 49);
+    REQUIRE(c != nullptr);
+    REQUIRE(4 * MEMCACHE_BLOCK_SIZE_MIN == alloc.getTotalAllocatedAmount());
+    REQUIRE(3 == cache.upstream_allocation_count);
+
+    // The freed blocks are reused without invoking the shared heap.
+    memcacheFree(&cache, upstream, a);
+    memcacheFree(&cache, upstream, b);
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    REQUIRE(2 == cache.block_count[0]);
+    void* const d = memcacheAllocate(&cache, upstream, 20);
+    REQUIRE(((d == a) || (d == b)));
+    REQUIRE(3 == cache.upstream_allocation_count);
+    REQUIRE(1 == cache.block_count[0]);
+
+    // The blocks beyond the limit are returned to the shared heap.
+    void* const e = memcacheAllocate(&cache, upstream, 30);
+    void* const f = memcacheAllocate(&cache, upstream, 40);
+    REQUIRE(4 == cache.upstream_allocation_count);
+    memcacheFree(&cache, upstream, d);
+    memcacheFree(&cache, upstream, e);
+    memcacheFree(&cache, upstream, f);
+    REQUIRE(2 == cache.block_count[0]);
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+
+    // The allocations that do not fit into the largest size class bypass the cache.
+    const std::size_t largest = (MEMCACHE_BLOCK_SIZE_MIN << (MEMCACHE_CLASS_COUNT - 1U));
+    void* const       huge    = memcacheAllocate(&cache, upstream, largest);
+    REQUIRE(huge != nullptr);
+    REQUIRE(4 == alloc.getNumAllocatedFragments());
+    memcacheFree(&cache, upstream, huge);
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    REQUIRE(nullptr == memcacheAllocate(&cache, upstream, SIZE_MAX));
+
+    // The shared heap is exhausted.
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount());
+    REQUIRE(nullptr == memcacheAllocate(&cache, upstream, 100));
+    void* const g = memcacheAllocate(&cache, upstream, 10);  // Served from the cache.
+    REQUIRE(g != nullptr);
+    memcacheFree(&cache, upstream, g);
+    REQUIRE(6 == cache.upstream_allocation_count);  // Including the failed request.
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+
+    // A block freed via another cache is handed back to its owner, which takes it when it runs out of blocks.
+    MemCache other{};
+    REQUIRE(0 == memcacheInit(&other, upstream->memory_allocate, upstream->memory_free, 2));
+    memcacheFree(&other, upstream, c);
+    REQUIRE(0 == other.block_count[1]);
+    REQUIRE(0 == cache.block_count[1]);
+    REQUIRE(cache.remote != nullptr);
+    REQUIRE(c == memcacheAllocate(&cache, upstream, 64));
+    REQUIRE(cache.remote == nullptr);
+    REQUIRE(6 == cache.upstream_allocation_count);
+    memcacheFree(&other, upstream, c);
+
+    // Trimming returns the kept and the handed-back blocks to the shared heap.
+    REQUIRE(3 == memcacheTrim(&cache, upstream));
+    REQUIRE(0 == memcacheTrim(&other, upstream));
+    REQUIRE(0 == memcacheTrim(&cache, upstream));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("MemoryCacheInstance")
+{
+    // The library is used with the cache as its memory manager; the TX frames are recycled within the cache.
+    helpers::Instance heap;
+    MemCache          cache{};
+    REQUIRE(0 == memcacheInit(&cache, heap.getInstance().memory_allocate, heap.getInstance().memory_free, SIZE_MAX));
+    g_thread_cache = &cache;
+
+    CanardInstance ins = canardInit(&cachedAllocate, &cachedFree);
+    ins.user_reference = &heap.getInstance();
+    ins.node_id        = 42;
+    CanardTxQueue          q = canardTxInit(100, CANARD_MTU_CAN_FD);
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 1234;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    std::array<std::uint8_t, 200> payload{};
+    for (std::size_t i = 0; i < 100; i++)
+    {
+        meta.transfer_id = static_cast<CanardTransferID>(i);
+        REQUIRE(4 == canardTxPush(&q, &ins, 0, &meta, payload.size(), payload.data()));
+        while (const CanardTxQueueItem* const ti = canardTxPeek(&q))
+        {
+            ins.memory_free(&ins, canardTxPop(&q, ti));
+        }
+    }
+    REQUIRE(4 == cache.upstream_allocation_count);
+    REQUIRE(4 == heap.getAllocator().getNumAllocatedFragments());
+    REQUIRE(4 == memcacheTrim(&cache, &heap.getInstance()));
+    REQUIRE(0 == heap.getAllocator().getNumAllocatedFragments());
+    g_thread_cache = nullptr;
+}
+
+TEST_CASE("MemoryCacheConcurrent")
+{
+    // Every thread allocates blocks from its own cache; some of them are freed locally, and the others are freed
+    // by the next thread, as is the case with RX payloads handed over for processing. The contents shall be intact.
+    constexpr std::size_t                              NumThreads = 4;
+    constexpr std::size_t                              NumBlocks  = 20'000;  // Per thread.
+    helpers::Instance                                  heap;
+    CanardInstance* const                              upstream = &heap.getInstance();
+    std::array<MemCache, NumThreads>                   caches{};
+    std::array<std::mutex, NumThreads>                 mailbox_locks;
+    std::array<std::vector<std::uint8_t*>, NumThreads> mailboxes;
+    std::atomic<std::size_t>                           errors{0};  // Catch assertions are not thread-safe.
+    for (auto& cache : caches)
+    {
+        REQUIRE(0 == memcacheInit(&cache, upstream->memory_allocate, upstream->memory_free, 16));
+    }
+    const auto check = [&](const std::uint8_t* const block) {
+        const std::size_t size = block[0];
+        for (std::size_t i = 1; i < size; i++)
+        {
+            errors += (block[i] == static_cast<std::uint8_t>(size + i)) ? 0U : 1U;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < NumThreads; t++)
+    {
+        threads.emplace_back([&, t] {
+            std::minstd_rand   rng(static_cast<std::minstd_rand::result_type>(t + 1U));  // NOLINT std::rand is unsafe
+            MemCache* cache = &caches.at(t);
+            for (std::size_t i = 0; i < NumBlocks; i++)
+            {
+                const auto size  = static_cast<std::uint8_t>(1U + (rng() % 255U));
+                auto*      block = static_cast<std::uint8_t*>(memcacheAllocate(cache, upstream, size));
+                errors += (block == nullptr) ? 1U : 0U;
+                block[0] = size;
+                for (std::size_t k = 1; k < size; k++)
+                {
+                    block[k] = static_cast<std::uint8_t>(size + k);
+                }
+                if ((rng() % 2U) == 0U)
+                {
+                    check(block);
+                    memcacheFree(cache, upstream, block);
+                }
+                else
+                {
+                    const std::lock_guard<std::mutex> locker(mailbox_locks.at((t + 1U) % NumThreads));
+                    mailboxes.at((t + 1U) % NumThreads).push_back(block);
+                }
+                if ((i % 16U) == 0U)
+                {
+                    std::vector<std::uint8_t*> received;
+                    {
+                        const std::lock_guard<std::mutex> locker(mailbox_locks.at(t));
+                        received.swap(mailboxes.at(t));
+                    }
+                    for (auto* const x : received)
+                    {
+                        check(x);
+                        memcacheFree(cache, upstream, x);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    REQUIRE(0 == errors);
+
+    // The owners are gone, so the remaining blocks are freed and the caches are trimmed from this thread.
+    for (std::size_t t = 0; t < NumThreads; t++)
+    {
+        for (auto* const x : mailboxes.at(t))
+        {
+            check(x);
+            memcacheFree(&caches.at(t), upstream, x);
+        }
+    }
+    REQUIRE(0 == errors);
+    for (auto& cache : caches)
+    {
+        REQUIRE(0 <= memcacheTrim(&cache, upstream));
+        REQUIRE(cache.upstream_allocation_count < NumBlocks);
+    }
+    REQUIRE(0 == heap.getAllocator().getNumAllocatedFragments());
+}
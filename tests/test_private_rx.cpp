@@ -159,15 +159,16 @@ TEST_CASE("rxSessionWritePayload")
     using exposed::rxSessionWritePayload;
     using exposed::rxSessionRestart;
 
-    Instance  ins;
-    RxSession rxs;
+    Instance                    ins;
+    RxSession                   rxs;
+    const CanardRxPayloadLayout layout{};
     rxs.transfer_id = 0U;
 
     REQUIRE(ins.getAllocator().getNumAllocatedFragments() == 0);
     REQUIRE(ins.getAllocator().getTotalAllocatedAmount() == 0);
 
     // Regular write, the RX state is uninitialized so a new allocation will take place.
-    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, 10, 5, "\x00\x01\x02\x03\x04"));
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 10, 5, "\x00\x01\x02\x03\x04"));
     REQUIRE(ins.getAllocator().getNumAllocatedFragments() == 1);
     REQUIRE(ins.getAllocator().getTotalAllocatedAmount() == 10);
     REQUIRE(rxs.payload_size == 5);
@@ -179,7 +180,7 @@ TEST_CASE("rxSessionWritePayload")
     REQUIRE(rxs.payload[4] == 4);
 
     // Appending the pre-allocated storage.
-    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, 10, 4, "\x05\x06\x07\x08"));
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 10, 4, "\x05\x06\x07\x08"));
     REQUIRE(ins.getAllocator().getNumAllocatedFragments() == 1);
     REQUIRE(ins.getAllocator().getTotalAllocatedAmount() == 10);
     REQUIRE(rxs.payload_size == 9);
@@ -195,7 +196,7 @@ TEST_CASE("rxSessionWritePayload")
     REQUIRE(rxs.payload[8] == 8);
 
     // Implicit truncation -- too much payload, excess ignored.
-    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, 10, 3, "\x09\x0A\x0B"));
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 10, 3, "\x09\x0A\x0B"));
     REQUIRE(ins.getAllocator().getNumAllocatedFragments() == 1);
     REQUIRE(ins.getAllocator().getTotalAllocatedAmount() == 10);
     REQUIRE(rxs.payload_size == 10);
@@ -212,7 +213,7 @@ TEST_CASE("rxSessionWritePayload")
     REQUIRE(rxs.payload[9] == 9);
 
     // Storage is already full, write ignored.
-    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, 10, 3, "\x0C\x0D\x0E"));
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 10, 3, "\x0C\x0D\x0E"));
     REQUIRE(ins.getAllocator().getNumAllocatedFragments() == 1);
     REQUIRE(ins.getAllocator().getTotalAllocatedAmount() == 10);
     REQUIRE(rxs.payload_size == 10);
@@ -265,7 +266,7 @@ TEST_CASE("rxSessionWritePayload")
     REQUIRE(rxs.toggle);
 
     // Write into a zero-capacity storage. NULL at the output.
-    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, 0, 3, "\x00\x01\x02"));
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 0, 3, "\x00\x01\x02"));
     REQUIRE(ins.getAllocator().getNumAllocatedFragments() == 0);
     REQUIRE(ins.getAllocator().getTotalAllocatedAmount() == 0);
     REQUIRE(rxs.payload_size == 0);
@@ -273,13 +274,85 @@ TEST_CASE("rxSessionWritePayload")
 
     // Write with OOM.
     ins.getAllocator().setAllocationCeiling(5);
-    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == rxSessionWritePayload(&ins.getInstance(), &rxs, 10, 3, "\x00\x01\x02"));
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY ==
+            rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 10, 3, "\x00\x01\x02"));
     REQUIRE(ins.getAllocator().getNumAllocatedFragments() == 0);
     REQUIRE(ins.getAllocator().getTotalAllocatedAmount() == 0);
     REQUIRE(rxs.payload_size == 0);
     REQUIRE(rxs.payload == nullptr);
 }
 
+TEST_CASE("rxSessionWritePayloadAdaptive")
+{
+    using helpers::Instance;
+    using exposed::RxSession;
+    using exposed::rxSessionWritePayload;
+    using exposed::rxSessionRestart;
+
+    Instance                    ins;
+    auto&                       alloc = ins.getAllocator();
+    RxSession                   rxs;
+    const CanardRxPayloadLayout layout{};
+    rxs.transfer_id      = 0U;
+    rxs.adaptive_payload = true;
+
+    // Empty payloads do not require a buffer.
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 20, 0, ""));
+    REQUIRE(alloc.getNumAllocatedFragments() == 0);
+    REQUIRE(rxs.payload == nullptr);
+
+    // The buffer is sized to the next power of two.
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 20, 3, "\x00\x01\x02"));
+    REQUIRE(alloc.getNumAllocatedFragments() == 1);
+    REQUIRE(alloc.getTotalAllocatedAmount() == 4);
+    REQUIRE(rxs.payload_size == 3);
+    REQUIRE(rxs.total_payload_size == 3);
+    const auto* const first = rxs.payload;
+
+    // Fits into the current buffer, no reallocation.
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 20, 1, "\x03"));
+    REQUIRE(alloc.getTotalAllocatedAmount() == 4);
+    REQUIRE(rxs.payload == first);
+
+    // Grows; the data received so far is moved into the new buffer.
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 20, 7, "\x04\x05\x06\x07\x08\x09\x0A"));
+    REQUIRE(alloc.getNumAllocatedFragments() == 1);
+    REQUIRE(alloc.getTotalAllocatedAmount() == 16);
+    REQUIRE(rxs.payload_size == 11);
+    REQUIRE(0 == std::memcmp(rxs.payload, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A", 11));
+
+    // The capacity is limited by the extent; the implicit truncation applies.
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(),
+                                       &rxs,
+                                       &layout,
+                                       20,
+                                       14,
+                                       "\x0B\x0C\x0D\x0E\x0F\x10\x11\x12\x13\x14\x15\x16\x17\x18"));
+    REQUIRE(alloc.getNumAllocatedFragments() == 1);
+    REQUIRE(alloc.getTotalAllocatedAmount() == 20);
+    REQUIRE(rxs.payload_size == 20);
+    REQUIRE(rxs.total_payload_size == 25);
+    REQUIRE(rxs.payload[19] == 0x13);
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 20, 3, "\x19\x1A\x1B"));
+    REQUIRE(alloc.getTotalAllocatedAmount() == 20);
+    REQUIRE(rxs.payload_size == 20);
+    rxSessionRestart(&ins.getInstance(), &rxs);
+    REQUIRE(alloc.getNumAllocatedFragments() == 0);
+    REQUIRE(rxs.adaptive_payload);
+
+    // If the buffer cannot be grown, the data received so far is retained until the restart.
+    REQUIRE(0 == rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 20, 7, "\x00\x01\x02\x03\x04\x05\x06"));
+    REQUIRE(alloc.getTotalAllocatedAmount() == 8);
+    alloc.setAllocationCeiling(20);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY ==
+            rxSessionWritePayload(&ins.getInstance(), &rxs, &layout, 20, 7, "\x07\x08\x09\x0A\x0B\x0C\x0D"));
+    REQUIRE(alloc.getNumAllocatedFragments() == 1);
+    REQUIRE(rxs.payload_size == 7);
+    rxSessionRestart(&ins.getInstance(), &rxs);
+    REQUIRE(alloc.getNumAllocatedFragments() == 0);
+    REQUIRE(rxs.payload == nullptr);
+}
+
 TEST_CASE("rxSessionUpdate")
 {
     using helpers::Instance;
@@ -309,24 +382,24 @@ TEST_CASE("rxSessionUpdate")
     rxs.transfer_id               = 31;
     rxs.redundant_transport_index = 1;
 
-    CanardRxTransfer transfer{};
+    CanardRxSubscription sub{};
+    CanardRxTransfer     transfer{};
+    bool                 accepted = false;
 
     const auto update = [&](const std::uint8_t  redundant_transport_index,
                             const std::uint64_t tid_timeout_usec,
                             const std::size_t   extent) {
-        return rxSessionUpdate(&ins.getInstance(),
-                               &rxs,
-                               &frame,
-                               redundant_transport_index,
-                               tid_timeout_usec,
-                               extent,
-                               &transfer);
+        sub.transfer_id_timeout_usec = tid_timeout_usec;
+        sub.failover_timeout_usec    = tid_timeout_usec;
+        sub.extent                   = extent;
+        return rxSessionUpdate(&ins.getInstance(), &rxs, &sub, &frame, redundant_transport_index, &transfer, &accepted);
     };
 
     const auto crc = [](const char* const string) { return crcAdd(0xFFFF, std::strlen(string), string); };
 
     // Accept one transfer.
     REQUIRE(1 == update(1, 1'000'000, 16));
+    REQUIRE(accepted);
     REQUIRE(rxs.transfer_timestamp_usec == 10'000'000);
     REQUIRE(rxs.payload_size == 0);   // Handed over to the output transfer.
     REQUIRE(rxs.payload == nullptr);  // Handed over to the output transfer.
@@ -351,6 +424,7 @@ TEST_CASE("rxSessionUpdate")
     frame.transfer_id    = 12;
     frame.payload        = reinterpret_cast<const uint8_t*>("\x02\x02\x02");
     REQUIRE(0 == update(2, 1'000'000, 16));
+    REQUIRE(!accepted);
     REQUIRE(rxs.transfer_timestamp_usec == 10'000'000);
     REQUIRE(rxs.payload_size == 0);   // Handed over to the output transfer.
     REQUIRE(rxs.payload == nullptr);  // Handed over to the output transfer.
@@ -387,6 +461,7 @@ TEST_CASE("rxSessionUpdate")
     frame.transfer_id    = 12;
     frame.payload        = reinterpret_cast<const uint8_t*>("\x04\x04\x04");
     REQUIRE(0 == update(1, 1'000'200, 16));
+    REQUIRE(!accepted);
     REQUIRE(rxs.transfer_timestamp_usec == 10'000'050);
     REQUIRE(rxs.payload_size == 0);
     REQUIRE(rxs.payload == nullptr);
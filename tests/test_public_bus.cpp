@@ -0,0 +1,206 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+
+#include "catch.hpp"
+#include "canard.h"
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+auto makeFrame(const std::uint32_t can_id, const std::vector<std::uint8_t>& payload) -> CanardFrame
+{
+    CanardFrame out{};
+    out.extended_can_id = can_id;
+    out.payload_size    = payload.size();
+    out.payload         = payload.data();
+    return out;
+}
+}  // namespace
+
+TEST_CASE("FrameBits")
+{
+    // The reference values have been obtained by constructing the frames bit by bit, including the CRC,
+    // and stuffing them independently of the library.
+    const std::vector<std::uint8_t> empty;
+    const std::vector<std::uint8_t> tail{0xE0};
+    const std::vector<std::uint8_t> mixed{1, 2, 3, 4, 5, 6, 0xE3};
+    std::vector<std::uint8_t>       counter(64);
+    std::iota(counter.begin(), counter.end(), 0);
+    counter.back() = 0xE0;
+
+    auto frame = makeFrame(0x107D552AU, empty);
+    auto bits  = canardGetFrameBits(&frame, false, false);
+    REQUIRE(bits.nominal == 70);
+    REQUIRE(bits.data == 0);
+    REQUIRE(bits.stuff == 3);
+    frame = makeFrame(0x107D552AU, tail);
+    bits  = canardGetFrameBits(&frame, false, true);  // The bit rate switching is ignored for Classic CAN.
+    REQUIRE(bits.nominal == 79);
+    REQUIRE(bits.data == 0);
+    REQUIRE(bits.stuff == 4);
+    const std::vector<std::uint8_t> zeros8(8, 0x00);
+    frame = makeFrame(0, zeros8);
+    bits  = canardGetFrameBits(&frame, false, false);
+    REQUIRE(bits.nominal == 150);
+    REQUIRE(bits.stuff == 19);
+    const std::vector<std::uint8_t> ones8(8, 0xFF);
+    frame = makeFrame(0x1FFFFFFFU, ones8);
+    bits  = canardGetFrameBits(&frame, false, false);
+    REQUIRE(bits.nominal == 149);
+    REQUIRE(bits.stuff == 18);
+    frame = makeFrame(0xFFFFFFFFU, ones8);  // The CAN ID is truncated to 29 bits.
+    bits  = canardGetFrameBits(&frame, false, false);
+    REQUIRE(bits.nominal == 149);
+    frame = makeFrame(0x1C00002AU, mixed);
+    bits  = canardGetFrameBits(&frame, false, false);
+    REQUIRE(bits.nominal == 134);
+    REQUIRE(bits.stuff == 11);
+
+    // CAN FD: the CRC is 17 bits long up to 16 bytes of data and 21 bits otherwise, with fixed stuff bits.
+    frame = makeFrame(0x107D552AU, tail);
+    bits  = canardGetFrameBits(&frame, true, true);
+    REQUIRE(bits.nominal == 51);
+    REQUIRE(bits.data == 41);
+    REQUIRE(bits.stuff == 9);
+    frame = makeFrame(0x107D552AU, counter);
+    bits  = canardGetFrameBits(&frame, true, true);
+    REQUIRE(bits.nominal == 51);
+    REQUIRE(bits.data == 574);
+    REQUIRE(bits.stuff == 34);
+    const std::vector<std::uint8_t> zeros13(13, 0x00);
+    const std::vector<std::uint8_t> zeros16(16, 0x00);
+    frame             = makeFrame(0, zeros13);
+    bits              = canardGetFrameBits(&frame, true, true);
+    frame             = makeFrame(0, zeros16);
+    const auto padded = canardGetFrameBits(&frame, true, true);
+    REQUIRE(bits.nominal == padded.nominal);
+    REQUIRE(bits.data == padded.data);
+    const std::vector<std::uint8_t> zeros20(20, 0x00);
+    frame = makeFrame(0, zeros20);
+    bits  = canardGetFrameBits(&frame, true, true);
+    REQUIRE(bits.nominal == 54);
+    REQUIRE(bits.data == 229);
+    REQUIRE(bits.stuff == 44);
+    const std::vector<std::uint8_t> ones64(64, 0xFF);
+    frame = makeFrame(0x1FFFFFFFU, ones64);
+    bits  = canardGetFrameBits(&frame, true, false);  // Without the bit rate switching, all bits are nominal.
+    REQUIRE(bits.nominal == 55 + 652);
+    REQUIRE(bits.data == 0);
+    REQUIRE(bits.stuff == 116);
+
+    // Invalid arguments.
+    frame = makeFrame(0, zeros16);
+    bits  = canardGetFrameBits(&frame, false, false);  // Too large for Classic CAN.
+    REQUIRE(bits.nominal == 0);
+    REQUIRE(bits.data == 0);
+    REQUIRE(bits.stuff == 0);
+    frame.payload = nullptr;
+    REQUIRE(canardGetFrameBits(&frame, true, true).nominal == 0);
+    frame.payload_size = 0;
+    REQUIRE(canardGetFrameBits(&frame, true, true).nominal > 0);
+    frame.payload_size = 65;
+    REQUIRE(canardGetFrameBits(&frame, true, true).nominal == 0);
+    REQUIRE(canardGetFrameBits(nullptr, true, true).nominal == 0);
+}
+
+TEST_CASE("FrameDuration")
+{
+    const std::vector<std::uint8_t> tail{0xE0};
+    const auto                      frame = makeFrame(0x107D552AU, tail);
+    CanardBusTiming                 timing{true, 1'000'000U, 5'000'000U};
+    REQUIRE(canardGetFrameDuration(&timing, &frame) == ((51U * 1000U) + (41U * 200U)));
+    timing.data_bit_rate = 0;  // No bit rate switching; the BRS bit is recessive, which affects the stuffing.
+    REQUIRE(canardGetFrameBits(&frame, true, false).nominal == 93);
+    REQUIRE(canardGetFrameDuration(&timing, &frame) == (93U * 1000U));
+    timing.fd = false;
+    REQUIRE(canardGetFrameDuration(&timing, &frame) == (79U * 1000U));
+    timing.nominal_bit_rate = 125'000U;
+    REQUIRE(canardGetFrameDuration(&timing, &frame) == (79U * 8000U));
+    timing.nominal_bit_rate = 0;
+    REQUIRE(canardGetFrameDuration(&timing, &frame) == 0);
+    REQUIRE(canardGetFrameDuration(nullptr, &frame) == 0);
+    timing.nominal_bit_rate = 1'000'000U;
+    REQUIRE(canardGetFrameDuration(&timing, nullptr) == 0);
+}
+
+TEST_CASE("BusLoadMeter")
+{
+    const std::vector<std::uint8_t> tail{0xE0};
+    const auto                      frame = makeFrame(0x107D552AU, tail);  // 79 us at 1 Mbit/s.
+    const CanardBusTiming           classic{false, 1'000'000U, 0};
+    CanardBusLoadMeter              meter{};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardBusLoadMeterInit(nullptr, classic, 1'000U));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardBusLoadMeterInit(&meter, CanardBusTiming{false, 0, 0}, 1'000U));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardBusLoadMeterInit(&meter, classic, 0));
+    REQUIRE(0 == canardBusLoadMeterInit(&meter, classic, 10'000U));
+    REQUIRE(meter.utilization_ppm == 0);
+    REQUIRE(meter.window_usec == 10'000U);
+
+    // The first frame starts the first window; ten frames in 10 ms make 790 us of busy time.
+    for (std::uint32_t i = 0; i < 10; i++)
+    {
+        REQUIRE(0 == canardBusLoadMeterUpdate(&meter, 5'000'000U + (i * 1'000U), &frame));
+    }
+    REQUIRE(meter.frame_count == 10);
+    REQUIRE(meter.busy_nsec == 790'000U);
+    REQUIRE(meter.stuff_bit_count == 40);
+    REQUIRE(meter.utilization_ppm == 0);
+    // The window completes with the first frame of the next one, which is accounted in the new window.
+    REQUIRE(1 == canardBusLoadMeterUpdate(&meter, 5'010'500U, &frame));
+    REQUIRE(meter.utilization_ppm == 79'000U);
+    REQUIRE(meter.utilization_ppm_max == 79'000U);
+    REQUIRE(meter.window_start_usec == 5'010'000U);
+    REQUIRE(meter.window_busy_nsec == 79'000U);
+    // A frame with an earlier timestamp, e.g., from another transport, is accounted in the current window.
+    REQUIRE(0 == canardBusLoadMeterUpdate(&meter, 5'009'000U, &frame));
+    REQUIRE(meter.window_busy_nsec == 158'000U);
+    // Advancing the time without a frame completes the window.
+    REQUIRE(0 == canardBusLoadMeterUpdate(&meter, 5'019'999U, nullptr));
+    REQUIRE(1 == canardBusLoadMeterUpdate(&meter, 5'020'000U, nullptr));
+    REQUIRE(meter.utilization_ppm == 15'800U);
+    REQUIRE(meter.utilization_ppm_max == 79'000U);
+    REQUIRE(meter.frame_count == 12);
+    // When the bus has been idle for more than a window, the utilization drops to zero.
+    REQUIRE(1 == canardBusLoadMeterUpdate(&meter, 5'045'000U, &frame));
+    REQUIRE(meter.utilization_ppm == 0);
+    REQUIRE(meter.window_start_usec == 5'040'000U);
+    REQUIRE(meter.window_busy_nsec == 79'000U);
+    // The utilization is saturated at 100% if the frames overlap in time, which may happen with timestamp jitter.
+    for (std::uint32_t i = 0; i < 200; i++)
+    {
+        REQUIRE(0 == canardBusLoadMeterUpdate(&meter, 5'045'000U, &frame));
+    }
+    REQUIRE(1 == canardBusLoadMeterUpdate(&meter, 5'050'000U, nullptr));
+    REQUIRE(meter.utilization_ppm == 1'000'000U);
+    REQUIRE(meter.utilization_ppm_max == 1'000'000U);
+    REQUIRE(meter.frame_count == 213);
+    REQUIRE(meter.busy_nsec == 213U * 79'000U);
+
+    // Invalid arguments do not modify the meter.
+    std::vector<std::uint8_t> large(9, 0x00);
+    const auto                too_large = makeFrame(0, large);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardBusLoadMeterUpdate(&meter, 6'000'000U, &too_large));
+    REQUIRE(meter.frame_count == 213);
+    REQUIRE(meter.window_start_usec == 5'050'000U);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardBusLoadMeterUpdate(nullptr, 6'000'000U, &frame));
+    meter.window_usec = 0;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardBusLoadMeterUpdate(&meter, 6'000'000U, nullptr));
+
+    // CAN FD frames are accepted once the timing is changed.
+    meter.window_usec = 1'000U;
+    meter.timing      = CanardBusTiming{true, 1'000'000U, 4'000'000U};
+    REQUIRE(1 == canardBusLoadMeterUpdate(&meter, 6'000'000U, &too_large));
+    REQUIRE(meter.frame_count == 214);
+
+    // A busy window followed by an idle gap of several windows still counts towards the maximum.
+    REQUIRE(0 == canardBusLoadMeterInit(&meter, classic, 1'000U));
+    for (std::uint32_t i = 0; i < 6; i++)
+    {
+        REQUIRE(0 == canardBusLoadMeterUpdate(&meter, 7'000'000U + (i * 100U), &frame));
+    }
+    REQUIRE(1 == canardBusLoadMeterUpdate(&meter, 7'003'000U, nullptr));
+    REQUIRE(meter.utilization_ppm == 0);
+    REQUIRE(meter.utilization_ppm_max == 474'000U);
+}
@@ -4,7 +4,13 @@
 #include "exposed.hpp"
 #include "helpers.hpp"
 #include "catch.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <limits>
+#include <optional>
+#include <random>
+#include <thread>
 
 // clang-tidy mistakenly suggests to avoid C arrays here, which is clearly an error
 template <typename P, std::size_t N>
@@ -318,6 +324,12 @@ TEST_CASE("RxSubscriptionErrors")
     REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSubscribe(&ins.getInstance(), kind.value, 0, 0, 0, &sub));
     REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
             canardRxSubscribe(&ins.getInstance(), CanardTransferKindMessage, 0, 0, 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardRxSubscribeSingleFrame(nullptr, CanardTransferKindMessage, 0, 0, 0, &sub));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardRxSubscribeSingleFrame(&ins.getInstance(), kind.value, 0, 0, 0, &sub));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardRxSubscribeSingleFrame(&ins.getInstance(), CanardTransferKindMessage, 0, 0, 0, nullptr));
 
     REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxUnsubscribe(nullptr, CanardTransferKindMessage, 0));
     REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxUnsubscribe(&ins.getInstance(), kind.value, 0));
@@ -331,3 +343,2168 @@ TEST_CASE("RxSubscriptionErrors")
     REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAccept(&ins.getInstance(), 0, &frame, 0, nullptr, nullptr));
     REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAccept(nullptr, 0, nullptr, 0, nullptr, nullptr));
 }
+
+TEST_CASE("RxSessionTimestampWrap")
+{
+    // The compact session layout stores only the lower 32 bits of the transfer timestamp (CANARD_RX_COMPACT_SESSION).
+    // The behavior shall be identical to the regular layout as long as the timestamps are not too far apart.
+    helpers::Instance    ins;
+    helpers::Instance    tx_ins;
+    helpers::TxQueue     que(10, CANARD_MTU_CAN_CLASSIC);
+    CanardRxSubscription sub{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1234, 16, 1'000'000, sub));
+    tx_ins.setNodeID(42);
+
+    CanardMicrosecond received_timestamp = 0;
+
+    const auto transmit = [&](const CanardTransferID transfer_id, const std::array<CanardMicrosecond, 2> timestamps) {
+        const std::array<std::uint8_t, 10> payload{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}};
+        CanardTransferMetadata             meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = 1234;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = transfer_id;
+        REQUIRE(2 == que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+        std::int8_t out = 0;
+        for (const auto ts : timestamps)
+        {
+            const auto*      ti = que.peek();
+            CanardRxTransfer transfer{};
+            out = ins.rxAccept(ts, ti->frame, 0, transfer, nullptr);
+            if (out == 1)
+            {
+                REQUIRE(transfer.payload_size == payload.size());
+                REQUIRE(0 == std::memcmp(transfer.payload, payload.data(), payload.size()));
+                received_timestamp = transfer.timestamp_usec;
+                ins.getAllocator().deallocate(transfer.payload);
+            }
+            tx_ins.getAllocator().deallocate(que.pop(ti));
+        }
+        return out;
+    };
+
+    // The transfer begins before the lower 32 bits of the time wrap around and ends after that.
+    constexpr CanardMicrosecond Wrap = 1ULL << 32U;
+    REQUIRE(1 == transmit(0, {{Wrap - 10, Wrap + 10}}));
+    REQUIRE(Wrap - 10 == received_timestamp);
+    // A duplicate is rejected within the transfer-ID timeout.
+    REQUIRE(0 == transmit(0, {{Wrap + 999'990, Wrap + 999'995}}));
+    // And accepted after the timeout.
+    REQUIRE(1 == transmit(0, {{Wrap + 999'991, Wrap + 999'995}}));
+    REQUIRE(Wrap + 999'991 == received_timestamp);
+    // Long pauses up to the next wraparound of the lower 32 bits; each one is shorter than 2**31 microseconds.
+    REQUIRE(1 == transmit(0, {{Wrap + 1'500'000'000, Wrap + 1'500'000'001}}));
+    REQUIRE(1 == transmit(0, {{Wrap + 2'900'000'000, Wrap + 2'900'000'001}}));
+    REQUIRE(1 == transmit(0, {{(2 * Wrap) - 10, (2 * Wrap) + 10}}));
+    REQUIRE((2 * Wrap) - 10 == received_timestamp);
+    REQUIRE(0 == transmit(0, {{(2 * Wrap) + 500'000, (2 * Wrap) + 500'001}}));
+    REQUIRE(1 == transmit(1, {{(2 * Wrap) + 500'000, (2 * Wrap) + 500'001}}));
+    REQUIRE((2 * Wrap) + 500'000 == received_timestamp);
+    // A frame that is timestamped earlier than the start of the last transfer does not time out the session.
+    REQUIRE(0 == transmit(1, {{(2 * Wrap) - 1'500'000, (2 * Wrap) - 1'499'999}}));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1234));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+    REQUIRE(0 == tx_ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxAdaptivePayload")
+{
+    using exposed::RxSession;
+
+    helpers::Instance ins;
+    helpers::Instance tx_ins;
+    helpers::TxQueue  que(10, CANARD_MTU_CAN_CLASSIC);
+    auto&             alloc = ins.getAllocator();
+    tx_ins.setNodeID(42);
+    REQUIRE(std::numeric_limits<std::size_t>::max() == ins.getInstance().rx_adaptive_extent_threshold);  // Disabled.
+    ins.getInstance().rx_adaptive_extent_threshold = 100;
+
+    CanardRxSubscription sub_large{};
+    CanardRxSubscription sub_small{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 1000, 1'000'000, sub_large));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 200, 50, 1'000'000, sub_small));
+
+    CanardRxTransfer transfer{};
+    std::size_t      peak = 0;  // The maximum amount of memory held between the frames of the transfer.
+
+    const auto transmit = [&](const CanardPortID               port_id,
+                              const CanardTransferID           transfer_id,
+                              const std::vector<std::uint8_t>& payload,
+                              const std::size_t                frames_to_deliver) {
+        CanardTransferMetadata meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = port_id;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = transfer_id;
+        REQUIRE(0 < que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+        std::int8_t out = 0;
+        std::size_t i   = 0;
+        peak            = 0;
+        while (const auto* const ti = que.peek())
+        {
+            if (i++ < frames_to_deliver)
+            {
+                out  = ins.rxAccept(1'000'000, ti->frame, 0, transfer, nullptr);
+                peak = std::max(peak, alloc.getTotalAllocatedAmount());
+            }
+            tx_ins.getAllocator().deallocate(que.pop(ti));
+        }
+        return out;
+    };
+
+    // A small single-frame transfer does not tie up the full extent.
+    REQUIRE(1 == transmit(100, 0, {1, 2, 3}, 1));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE((sizeof(RxSession) + 4) == alloc.getTotalAllocatedAmount());
+    REQUIRE(3 == transfer.payload_size);
+    REQUIRE(0 == std::memcmp(transfer.payload, "\x01\x02\x03", 3));
+    alloc.deallocate(transfer.payload);
+
+    // An empty payload does not require a buffer at all.
+    REQUIRE(1 == transmit(100, 1, {}, 1));
+    REQUIRE(0 == transfer.payload_size);
+    REQUIRE(nullptr == transfer.payload);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // A multi-frame transfer: the buffer grows as the frames arrive; the CRC is included in the buffer.
+    std::vector<std::uint8_t> payload(30);
+    for (std::size_t i = 0; i < payload.size(); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>(i);
+    }
+    REQUIRE(0 == transmit(100, 2, payload, 2));  // Incomplete; the buffer holds 14 bytes.
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE((sizeof(RxSession) + 16) == alloc.getTotalAllocatedAmount());
+    REQUIRE(1 == transmit(100, 3, payload, 5));  // The old buffer is released.
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE((sizeof(RxSession) + 32) == alloc.getTotalAllocatedAmount());
+    REQUIRE((sizeof(RxSession) + 32) == peak);  // The old buffers are released as soon as the data is moved.
+    REQUIRE(30 == transfer.payload_size);
+    REQUIRE(0 == std::memcmp(transfer.payload, payload.data(), payload.size()));
+    alloc.deallocate(transfer.payload);
+
+    // The subscriptions whose extent is below the threshold are not affected.
+    REQUIRE(1 == transmit(200, 0, payload, 5));
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    REQUIRE((sizeof(RxSession) + sizeof(RxSession) + 50) == alloc.getTotalAllocatedAmount());
+    alloc.deallocate(transfer.payload);
+
+    // The sessions that exist already are not affected by the change of the setting.
+    ins.getInstance().rx_adaptive_extent_threshold = std::numeric_limits<std::size_t>::max();
+    REQUIRE(0 == transmit(100, 4, payload, 1));
+    REQUIRE((sizeof(RxSession) + 8 + sizeof(RxSession)) == alloc.getTotalAllocatedAmount());
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 1000, 1'000'000, sub_large));
+    REQUIRE(0 == transmit(100, 0, payload, 1));
+    REQUIRE((sizeof(RxSession) + 1000 + sizeof(RxSession)) == alloc.getTotalAllocatedAmount());
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 200));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == tx_ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxPayloadLayout")
+{
+    using exposed::RxSession;
+
+    helpers::Instance ins;
+    helpers::Instance tx_ins;
+    helpers::TxQueue  que(10, CANARD_MTU_CAN_CLASSIC);
+    auto&             alloc = ins.getAllocator();
+    tx_ins.setNodeID(42);
+    ins.getInstance().rx_adaptive_extent_threshold = 0;  // Not used with a custom layout.
+
+    CanardRxSubscription        sub{};
+    const CanardRxPayloadLayout layout{64, 16, 8};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetPayloadLayout(nullptr, &layout));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetPayloadLayout(&sub, nullptr));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, std::numeric_limits<std::size_t>::max() - 80, 0, sub));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetPayloadLayout(&sub, &layout));  // Not representable.
+    REQUIRE(0 == ins.rxSubscribe(CanardTransferKindMessage, 100, 20, 1'000'000, sub));
+    const CanardRxPayloadLayout misaligned{48, 0, 0};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetPayloadLayout(&sub, &misaligned));
+    REQUIRE(0 == canardRxSetPayloadLayout(&sub, &layout));
+    REQUIRE(64 == sub.payload_layout.alignment);
+    REQUIRE(16 == sub.payload_layout.headroom);
+    REQUIRE(8 == sub.payload_layout.tailroom);
+
+    CanardRxTransfer transfer{};
+    const auto       transmit = [&](const CanardTransferID transfer_id, const std::vector<std::uint8_t>& payload) {
+        CanardTransferMetadata meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = 100;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = transfer_id;
+        REQUIRE(0 < que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+        std::int8_t out = 0;
+        while (const auto* const ti = que.peek())
+        {
+            out = ins.rxAccept(1'000'000, ti->frame, 0, transfer, nullptr);
+            tx_ins.getAllocator().deallocate(que.pop(ti));
+        }
+        return out;
+    };
+    // The payload pointer refers to the beginning of the buffer; the data is located at the offset.
+    const auto payload_data = [&]() {
+        return static_cast<const std::uint8_t*>(transfer.payload) + transfer.payload_offset;
+    };
+    // The headroom and the tailroom shall be usable; the sanitizers will catch an overrun.
+    const auto check = [&](const std::size_t state_size, const std::size_t fragment_size) {
+        auto* const origin  = static_cast<std::uint8_t*>(transfer.payload);
+        auto* const payload = origin + transfer.payload_offset;
+        REQUIRE(0 == (reinterpret_cast<std::uintptr_t>(payload) % 64U));
+        REQUIRE(transfer.payload_offset >= 16);
+        REQUIRE(transfer.payload_offset <= (16 + 63));
+        REQUIRE((state_size + fragment_size) == alloc.getTotalAllocatedAmount());
+        const auto tail = fragment_size - static_cast<std::size_t>(payload - origin) - transfer.payload_size;
+        REQUIRE(tail >= 8);
+        std::fill_n(payload - 16, 16, std::uint8_t{0xAA});
+        std::fill_n(payload + transfer.payload_size, tail, std::uint8_t{0xBB});
+        alloc.deallocate(transfer.payload);
+    };
+
+    // A multi-frame transfer is reassembled in place in a buffer of the full extent.
+    const std::vector<std::uint8_t> payload{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    REQUIRE(1 == transmit(0, payload));
+    REQUIRE(15 == transfer.payload_size);
+    REQUIRE(0 == std::memcmp(payload_data(), payload.data(), payload.size()));
+    check(sizeof(RxSession), 63 + 16 + 20 + 8);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetPayloadLayout(&sub, &layout));  // Has sessions now.
+
+    // Anonymous transfers are copied into a buffer of the exact size with the same layout.
+    {
+        const std::array<std::uint8_t, 4> data{{1, 2, 3, 0b111'00000U | 0U}};
+        CanardFrame                       frame{};
+        frame.extended_can_id = 0b001'01'0'11'0000000000000'0'0000000U | (100U << 8U) | 0x55U;
+        frame.payload_size    = data.size();
+        frame.payload         = data.data();
+        REQUIRE(1 == ins.rxAccept(2'000'000, frame, 0, transfer, nullptr));
+        REQUIRE(3 == transfer.payload_size);
+        REQUIRE(0 == std::memcmp(payload_data(), "\x01\x02\x03", 3));
+        check(sizeof(RxSession), 63 + 16 + 3 + 8);
+    }
+
+    // The layout of the single-frame subscriptions is honored as well; empty payloads are delivered without a buffer.
+    REQUIRE(0 == ins.rxSubscribeSingleFrame(CanardTransferKindMessage, 100, 20, 1'000'000, sub));
+    REQUIRE(0 == sub.payload_layout.headroom);  // Reset to the default.
+    REQUIRE(0 == canardRxSetPayloadLayout(&sub, &layout));
+    REQUIRE(1 == transmit(1, {1, 2, 3, 4, 5}));
+    REQUIRE(5 == transfer.payload_size);
+    REQUIRE(0 == std::memcmp(payload_data(), "\x01\x02\x03\x04\x05", 5));
+    const std::size_t state_size = alloc.getTotalAllocatedAmount() - (63 + 16 + 5 + 8);
+    check(state_size, 63 + 16 + 5 + 8);
+    REQUIRE(1 == transmit(2, {}));
+    REQUIRE(nullptr == transfer.payload);
+    REQUIRE(0 == transfer.payload_offset);
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == tx_ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxSharedPayload")
+{
+    helpers::Instance    ins;
+    auto&                alloc = ins.getAllocator();
+    CanardRxSubscription sub{};
+    CanardRxTransfer     transfer{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 8, 1'000'000, sub));
+
+    const auto accept = [&](const CanardTransferID transfer_id) {
+        const std::array<std::uint8_t, 4> data{{1, 2, 3, static_cast<std::uint8_t>(0b111'00000U | transfer_id)}};
+        CanardFrame                       frame{};
+        frame.extended_can_id = 0b001'00'0'11'0000000000000'0'0000000U | (100U << 8U) | 42U;
+        frame.payload_size    = data.size();
+        frame.payload         = data.data();
+        return ins.rxAccept(1'000'000 + transfer_id, frame, 0, transfer, nullptr);
+    };
+
+    REQUIRE(nullptr == canardRxSharePayload(nullptr, &transfer));
+    REQUIRE(nullptr == canardRxSharePayload(&ins.getInstance(), nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSharedPayloadAcquire(nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSharedPayloadRelease(nullptr));
+
+    // The buffer is shared by three consumers and deallocated when the last one releases it.
+    REQUIRE(1 == accept(0));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    CanardRxSharedPayload* const shared = canardRxSharePayload(&ins.getInstance(), &transfer);
+    REQUIRE(shared != nullptr);
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    REQUIRE(&ins.getInstance() == shared->instance);
+    REQUIRE(transfer.payload == shared->payload);
+    REQUIRE(0 == shared->payload_offset);
+    REQUIRE(3 == shared->payload_size);
+    REQUIRE(1 == shared->reference_count);
+    REQUIRE(0 == canardRxSharedPayloadAcquire(shared));
+    REQUIRE(0 == canardRxSharedPayloadAcquire(shared));
+    REQUIRE(3 == shared->reference_count);
+    REQUIRE(0 == canardRxSharedPayloadRelease(shared));
+    REQUIRE(0 == canardRxSharedPayloadRelease(shared));
+    REQUIRE(0 == std::memcmp(shared->payload, "\x01\x02\x03", 3));
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == canardRxSharedPayloadRelease(shared));
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // If the handle cannot be allocated, the application retains the ownership of the buffer.
+    REQUIRE(1 == accept(1));
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount());
+    REQUIRE(nullptr == canardRxSharePayload(&ins.getInstance(), &transfer));
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    alloc.deallocate(transfer.payload);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // The references are released concurrently; exactly one consumer observes the last release.
+    REQUIRE(1 == accept(2));
+    constexpr std::size_t        NumConsumers = 8;
+    CanardRxSharedPayload* const fanout       = canardRxSharePayload(&ins.getInstance(), &transfer);
+    REQUIRE(fanout != nullptr);
+    std::atomic<std::size_t> last{0};
+    std::atomic<std::size_t> sum{0};
+    {
+        std::vector<std::thread> consumers;
+        for (std::size_t i = 1; i < NumConsumers; i++)
+        {
+            REQUIRE(0 == canardRxSharedPayloadAcquire(fanout));
+        }
+        for (std::size_t i = 0; i < NumConsumers; i++)
+        {
+            consumers.emplace_back([&]() {
+                for (std::size_t k = 0; k < 1000; k++)  // Stress the counter while the payload is in use.
+                {
+                    (void) canardRxSharedPayloadAcquire(fanout);
+                    sum += static_cast<const std::uint8_t*>(fanout->payload)[k % 3U];
+                    (void) canardRxSharedPayloadRelease(fanout);
+                }
+                last += static_cast<std::size_t>(canardRxSharedPayloadRelease(fanout));
+            });
+        }
+        for (auto& c : consumers)
+        {
+            c.join();
+        }
+    }
+    REQUIRE(1 == last);
+    REQUIRE((NumConsumers * (334U * 1U + 333U * 2U + 333U * 3U)) == sum);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxSingleFrame")
+{
+    using exposed::RxSession;
+    using helpers::Instance;
+
+    Instance             ins;
+    auto&                alloc = ins.getAllocator();
+    CanardRxTransfer     transfer{};
+    CanardRxSubscription sub{};
+
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 8, 1'000'000, sub));
+    REQUIRE(!sub.single_frame);
+    REQUIRE(0 == ins.rxSubscribeSingleFrame(CanardTransferKindMessage, 100, 8, 1'000'000, sub));  // Replaced.
+    REQUIRE(sub.single_frame);
+    REQUIRE(ensureAllNullptr(sub.sessions));
+
+    const auto accept = [&](const CanardNodeID               source_node_id,
+                            const CanardMicrosecond          timestamp_usec,
+                            const std::uint8_t               redundant_transport_index,
+                            const std::vector<std::uint8_t>& payload) {
+        CanardFrame frame{};
+        frame.extended_can_id = 0b001'00'0'11'0000000000000'0'0000000U |
+                                static_cast<std::uint32_t>((100U << 8U) | source_node_id);
+        frame.payload_size    = std::size(payload);
+        frame.payload         = payload.data();
+        return ins.rxAccept(timestamp_usec, frame, redundant_transport_index, transfer, nullptr);
+    };
+
+    // The reduced state is much smaller than the full session state; the payload is copied out as usual.
+    REQUIRE(1 == accept(42, 1'000'000, 0, {1, 2, 3, 0b111'00000U | 5U}));
+    REQUIRE(sub.sessions[42] != nullptr);
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    const std::size_t state_size = alloc.getTotalAllocatedAmount() - 3U;
+    REQUIRE(state_size <= 16U);
+    REQUIRE(state_size < sizeof(RxSession));
+    REQUIRE(1'000'000 == transfer.timestamp_usec);
+    REQUIRE(CanardPriorityImmediate == transfer.metadata.priority);
+    REQUIRE(42 == transfer.metadata.remote_node_id);
+    REQUIRE(5 == transfer.metadata.transfer_id);
+    REQUIRE(3 == transfer.payload_size);
+    REQUIRE(0 == std::memcmp(transfer.payload, "\x01\x02\x03", 3));
+    alloc.deallocate(transfer.payload);
+
+    // Duplicates are suppressed; the transfer-ID may jump arbitrarily and wrap around.
+    REQUIRE(0 == accept(42, 1'000'001, 0, {1, 2, 3, 0b111'00000U | 5U}));
+    REQUIRE(1 == accept(42, 1'000'002, 0, {0b111'00000U | 31U}));  // An empty payload does not require a buffer.
+    REQUIRE(0 == transfer.payload_size);
+    REQUIRE(nullptr == transfer.payload);
+    REQUIRE(1 == accept(42, 1'000'003, 0, {1, 2, 3, 4, 5, 6, 7, 8, 9, 0b111'00000U | 0U}));  // Truncated to the extent.
+    REQUIRE(8 == transfer.payload_size);
+    REQUIRE(0 == std::memcmp(transfer.payload, "\x01\x02\x03\x04\x05\x06\x07\x08", 8));
+    alloc.deallocate(transfer.payload);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // The frames of multi-frame transfers are dropped without creating the state.
+    REQUIRE(0 == accept(43, 1'000'004, 0, {1, 2, 3, 4, 5, 6, 7, 0b101'00000U | 1U}));
+    REQUIRE(0 == accept(42, 1'000'004, 0, {1, 2, 3, 4, 5, 6, 7, 0b101'00000U | 1U}));
+    REQUIRE(0 == accept(42, 1'000'004, 0, {1, 0b010'00000U | 1U}));
+    REQUIRE(sub.sessions[43] == nullptr);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // The redundant transport fail-over occurs after the transfer-ID timeout like with the full session state.
+    REQUIRE(0 == accept(42, 1'500'000, 1, {0b111'00000U | 1U}));
+    REQUIRE(1 == accept(42, 1'500'001, 0, {0b111'00000U | 1U}));
+    REQUIRE(0 == accept(42, 1'500'002, 1, {0b111'00000U | 1U}));  // Duplicate from the other interface.
+    REQUIRE(0 == accept(42, 1'500'003, 1, {0b111'00000U | 3U}));
+    REQUIRE(1 == accept(42, 3'000'000, 1, {0b111'00000U | 3U}));
+    REQUIRE(0 == accept(42, 3'000'001, 0, {0b111'00000U | 4U}));
+    REQUIRE(1 == accept(42, 3'000'002, 1, {0b111'00000U | 4U}));
+
+    // Out-of-memory errors: the state cannot be created; the payload cannot be copied, losing the transfer.
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount() + 2U);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == accept(44, 4'000'000, 0, {0b111'00000U | 0U}));
+    REQUIRE(sub.sessions[44] == nullptr);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == accept(42, 4'000'000, 1, {1, 2, 3, 0b111'00000U | 5U}));
+    REQUIRE(0 == accept(42, 4'000'001, 1, {1, 2, 0b111'00000U | 5U}));  // The lost transfer is not accepted again.
+    REQUIRE(1 == accept(42, 4'000'002, 1, {1, 2, 0b111'00000U | 6U}));
+    alloc.deallocate(transfer.payload);
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+
+    // Anonymous transfers are accepted as usual.
+    {
+        const std::array<std::uint8_t, 2> payload{{1, 0b111'00000U | 0U}};
+        CanardFrame                       frame{};
+        frame.extended_can_id = 0b001'01'0'11'0000000000000'0'0000000U | (100U << 8U) | 0x55U;
+        frame.payload_size    = payload.size();
+        frame.payload         = payload.data();
+        REQUIRE(1 == ins.rxAccept(5'000'000, frame, 0, transfer, nullptr));
+        REQUIRE(CANARD_NODE_ID_UNSET == transfer.metadata.remote_node_id);
+    }
+    alloc.deallocate(transfer.payload);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // The reduced states are not tracked by the timer wheel.
+    CanardRxTimerWheel wheel{};
+    REQUIRE(0 == canardRxSetTimerWheel(&ins.getInstance(), &wheel, 1'000));
+    REQUIRE(1 == ins.rxSubscribeSingleFrame(CanardTransferKindMessage, 100, 8, 1'000'000, sub));
+    REQUIRE(1 == accept(42, 1'000'000, 0, {0b111'00000U | 0U}));
+    REQUIRE(1 == accept(43, 1'000'000, 0, {0b111'00000U | 0U}));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE(2 * state_size == alloc.getTotalAllocatedAmount());
+    REQUIRE(0 == wheel.session_count);
+    CanardMicrosecond next = 0;
+    REQUIRE(0 == canardRxGetNextExpiration(&ins.getInstance(), &next));
+    REQUIRE(0 == ins.rxExpire(10'000'000));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == accept(42, 10'000'000, 0, {0b101'00000U | 1U}));
+    REQUIRE(1 == accept(42, 10'000'000, 0, {0b111'00000U | 0U}));  // Timed out, so the same transfer-ID is accepted.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == wheel.session_count);
+}
+
+TEST_CASE("RxSingleFrameRandomized")
+{
+    using helpers::Instance;
+    using helpers::getRandomNatural;
+
+    // The single-frame subscription shall behave exactly like the regular one when fed with single-frame transfers.
+    Instance             ins;
+    CanardRxSubscription sub_regular{};
+    CanardRxSubscription sub_single{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 4, 100'000, sub_regular));
+    REQUIRE(1 == ins.rxSubscribeSingleFrame(CanardTransferKindMessage, 200, 4, 100'000, sub_single));
+
+    CanardMicrosecond now = 1'000'000;
+    for (std::uint32_t iteration = 0U; iteration < 20'000U; iteration++)
+    {
+        now += getRandomNatural<CanardMicrosecond>(60'000U);
+        const auto         node_id = getRandomNatural<std::uint8_t>(4U);
+        const auto         iface   = getRandomNatural<std::uint8_t>(2U);
+        const std::uint8_t tail    = static_cast<std::uint8_t>(0b111'00000U | getRandomNatural(4U));
+        const std::array<std::uint8_t, 7> payload{{1, 2, 3, 4, 5, 6, tail}};
+        const std::size_t                 size = 1U + getRandomNatural<std::size_t>(payload.size());
+        CanardFrame                       frame{};
+        frame.payload_size = size;
+        frame.payload      = &payload.at(payload.size() - size);
+
+        std::array<CanardRxTransfer, 2> transfers{};
+        frame.extended_can_id = 0b001'00'0'11'0000000000000'0'0000000U | (100U << 8U) | node_id;
+        const auto out_regular = ins.rxAccept(now, frame, iface, transfers.at(0), nullptr);
+        frame.extended_can_id  = 0b001'00'0'11'0000000000000'0'0000000U | (200U << 8U) | node_id;
+        const auto out_single  = ins.rxAccept(now, frame, iface, transfers.at(1), nullptr);
+        REQUIRE(out_regular == out_single);
+        if (out_regular > 0)
+        {
+            REQUIRE(transfers.at(0).metadata.transfer_id == transfers.at(1).metadata.transfer_id);
+            REQUIRE(transfers.at(0).timestamp_usec == transfers.at(1).timestamp_usec);
+            REQUIRE(transfers.at(0).payload_size == transfers.at(1).payload_size);
+            const std::size_t copied = transfers.at(0).payload_size;
+            REQUIRE(((copied == 0U) || (0 == std::memcmp(transfers.at(0).payload, transfers.at(1).payload, copied))));
+            ins.getAllocator().deallocate(transfers.at(0).payload);
+            ins.getAllocator().deallocate(transfers.at(1).payload);
+        }
+    }
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 200));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxRedundantFailover")
+{
+    using helpers::Instance;
+    using helpers::getRandomNatural;
+
+    // Two redundant transports deliver the same transfers with a random jitter, so their streams are interleaved.
+    // The first two subscriptions use the early fail-over; the last one keeps the default policy for comparison.
+    Instance                            ins;
+    std::array<CanardRxSubscription, 3> subs{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 8, 2'000'000, subs.at(0)));
+    REQUIRE(1 == ins.rxSubscribeSingleFrame(CanardTransferKindMessage, 200, 8, 2'000'000, subs.at(1)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 300, 8, 2'000'000, subs.at(2)));
+    REQUIRE(2'000'000 == subs.at(2).failover_timeout_usec);  // Disabled by default.
+    subs.at(0).failover_timeout_usec = 50'000;
+    subs.at(1).failover_timeout_usec = 50'000;
+
+    constexpr CanardMicrosecond                   Period    = 10'000;
+    constexpr CanardMicrosecond                   JitterMax = 3'000;
+    std::array<std::vector<CanardMicrosecond>, 3> timestamps{};  // Of the accepted transfers per subscription.
+    std::array<std::vector<CanardTransferID>, 3>  tids{};
+    const auto accept = [&](const std::uint8_t iface, const CanardMicrosecond timestamp_usec, const std::uint8_t tid) {
+        const std::array<std::uint8_t, 2> payload{{tid, static_cast<std::uint8_t>(0b111'00000U | tid)}};
+        for (std::size_t i = 0; i < subs.size(); i++)
+        {
+            CanardFrame frame{};
+            frame.extended_can_id = 0b001'00'0'11'0000000000000'0'0000000U |
+                                    (static_cast<std::uint32_t>(subs.at(i).port_id) << 8U) | 42U;
+            frame.payload_size    = payload.size();
+            frame.payload         = payload.data();
+            CanardRxTransfer transfer{};
+            const auto       out = ins.rxAccept(timestamp_usec, frame, iface, transfer, nullptr);
+            REQUIRE(out >= 0);
+            if (out > 0)
+            {
+                REQUIRE(transfer.payload_size == 1);
+                REQUIRE(static_cast<const std::uint8_t*>(transfer.payload)[0] == tid);
+                timestamps.at(i).push_back(transfer.timestamp_usec);
+                tids.at(i).push_back(transfer.metadata.transfer_id);
+                ins.getAllocator().deallocate(transfer.payload);
+            }
+        }
+    };
+    // Each transfer is published via the enabled transports in a random order.
+    std::uint8_t      tid = 0;
+    CanardMicrosecond now = 1'000'000;
+    const auto        publish = [&](const std::size_t count, const bool iface0, const bool iface1) {
+        for (std::size_t k = 0; k < count; k++)
+        {
+            const std::array<bool, 2> enabled{{iface0, iface1}};
+            const auto                first = getRandomNatural<std::uint8_t>(2U);
+            const auto                other = static_cast<std::uint8_t>(first ^ 1U);
+            if (enabled.at(first))
+            {
+                accept(first, now, tid);
+            }
+            if (enabled.at(other))
+            {
+                accept(other, now + getRandomNatural<CanardMicrosecond>(JitterMax), tid);
+            }
+            tid = static_cast<std::uint8_t>((tid + 1U) & CANARD_TRANSFER_ID_MAX);
+            now += Period;
+        }
+    };
+    // The transfers accepted since the specified index are consecutive, meaning that none are duplicated.
+    const auto check_consecutive = [&](const std::size_t sub_index, const std::size_t since) {
+        for (std::size_t k = since + 1U; k < tids.at(sub_index).size(); k++)
+        {
+            REQUIRE(tids.at(sub_index).at(k) == ((tids.at(sub_index).at(k - 1U) + 1U) & CANARD_TRANSFER_ID_MAX));
+        }
+    };
+
+    // Both transports are healthy: every transfer is delivered exactly once regardless of the arrival order.
+    // The sessions are locked to the first transport because it delivered the first transfer first.
+    accept(0, now, tid);
+    accept(1, now + JitterMax, tid);
+    tid = 1;
+    now += Period;
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        REQUIRE(tids.at(i).size() == 1);
+    }
+    publish(199, true, true);
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        REQUIRE(tids.at(i).size() == 200);
+        check_consecutive(i, 0);
+    }
+
+    // The first transport fails. With the early fail-over, the reception resumes within the fail-over timeout plus
+    // one period, while the default policy blocks the reception for the entire transfer-ID timeout.
+    CanardMicrosecond failed_at = now;
+    publish(100, false, true);
+    for (std::size_t i = 0; i < 2; i++)
+    {
+        REQUIRE(tids.at(i).size() >= 300 - ((50'000 + JitterMax) / Period) - 1U);
+        REQUIRE(tids.at(i).size() < 300);
+        REQUIRE(timestamps.at(i).at(200) > (failed_at + 50'000 - Period));
+        REQUIRE(timestamps.at(i).at(200) <= (failed_at + 50'000 + Period + JitterMax));
+        check_consecutive(i, 200);
+    }
+    REQUIRE(tids.at(2).size() == 200);
+
+    // The first transport is restored; it is now the backup, so it does not take over while the second one is alive.
+    const std::array<std::size_t, 2> before_restore{{tids.at(0).size(), tids.at(1).size()}};
+    publish(100, true, true);
+    for (std::size_t i = 0; i < 2; i++)
+    {
+        REQUIRE(tids.at(i).size() == (before_restore.at(i) + 100));
+        check_consecutive(i, 200);
+    }
+    // The regular subscription remained locked to the first transport, so it resumes immediately.
+    REQUIRE(tids.at(2).size() == 300);
+    check_consecutive(2, 200);
+
+    // Now the second transport fails; the sessions fail back over to the first one.
+    failed_at = now;
+    publish(100, true, false);
+    for (std::size_t i = 0; i < 2; i++)
+    {
+        const std::size_t since = before_restore.at(i) + 100;
+        REQUIRE(tids.at(i).size() >= (since + 100) - ((50'000 + JitterMax) / Period) - 1U);
+        REQUIRE(timestamps.at(i).at(since) <= (failed_at + 50'000 + Period + JitterMax));
+        check_consecutive(i, since);
+    }
+    REQUIRE(tids.at(2).size() == 400);
+    check_consecutive(2, 200);
+
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, subs.at(i).port_id));
+    }
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxRedundantFailoverInProgress")
+{
+    helpers::Instance ins;
+    helpers::Instance tx_ins;
+    helpers::TxQueue  que(10, CANARD_MTU_CAN_CLASSIC);
+    tx_ins.setNodeID(42);
+    CanardRxSubscription sub{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 100, 2'000'000, sub));
+    sub.failover_timeout_usec = 50'000;
+
+    // The frames of a multi-frame transfer are kept so that they can be delivered via either transport.
+    const std::vector<std::uint8_t> payload{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+    const auto                      generate = [&](const CanardTransferID transfer_id) {
+        CanardTransferMetadata meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = 100;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = transfer_id;
+        REQUIRE(0 < que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+        std::vector<std::pair<std::uint32_t, std::vector<std::uint8_t>>> out;
+        while (const auto* const ti = que.peek())
+        {
+            const auto* const data = static_cast<const std::uint8_t*>(ti->frame.payload);
+            out.emplace_back(ti->frame.extended_can_id,
+                             std::vector<std::uint8_t>(data, data + ti->frame.payload_size));
+            tx_ins.getAllocator().deallocate(que.pop(ti));
+        }
+        return out;
+    };
+    CanardRxTransfer transfer{};
+    const auto       accept = [&](const std::pair<std::uint32_t, std::vector<std::uint8_t>>& item,
+                            const std::uint8_t                                         iface,
+                            const CanardMicrosecond                                    timestamp_usec) {
+        CanardFrame frame{};
+        frame.extended_can_id = item.first;
+        frame.payload_size    = item.second.size();
+        frame.payload         = item.second.data();
+        return ins.rxAccept(timestamp_usec, frame, iface, transfer, nullptr);
+    };
+
+    // The transfer is reassembled from the first transport slower than the fail-over timeout. Its first frame then
+    // arrives via the second transport after the fail-over timeout, but the transfer is not restarted.
+    const auto first = generate(0);
+    REQUIRE(first.size() == 4);
+    REQUIRE(0 == accept(first.at(0), 0, 1'000'000));
+    REQUIRE(0 == accept(first.at(1), 0, 1'100'000));
+    REQUIRE(0 == accept(first.at(0), 1, 1'100'001));
+    REQUIRE(0 == accept(first.at(1), 1, 1'100'002));
+    REQUIRE(0 == accept(first.at(2), 0, 1'100'003));
+    REQUIRE(1 == accept(first.at(3), 0, 1'100'004));
+    REQUIRE(transfer.timestamp_usec == 1'000'000);
+    REQUIRE(transfer.payload_size == payload.size());
+    REQUIRE(0 == std::memcmp(transfer.payload, payload.data(), payload.size()));
+    ins.getAllocator().deallocate(transfer.payload);
+    REQUIRE(0 == accept(first.at(2), 1, 1'100'005));  // The rest of the duplicate is ignored.
+    REQUIRE(0 == accept(first.at(3), 1, 1'100'006));
+
+    // The first transport has failed; the second one takes over with the next transfer.
+    const auto second = generate(1);
+    REQUIRE(0 == accept(second.at(0), 1, 1'200'000));
+    REQUIRE(0 == accept(second.at(1), 1, 1'200'001));
+    REQUIRE(0 == accept(second.at(2), 1, 1'200'002));
+    REQUIRE(1 == accept(second.at(3), 1, 1'200'003));
+    REQUIRE(transfer.metadata.transfer_id == 1);
+    REQUIRE(transfer.timestamp_usec == 1'200'000);
+    ins.getAllocator().deallocate(transfer.payload);
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+    REQUIRE(0 == tx_ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxFirstArrivalWins")
+{
+    using helpers::getRandomNatural;
+
+    helpers::Instance ins;
+    helpers::Instance tx_ins;
+    helpers::TxQueue  que(100, CANARD_MTU_CAN_CLASSIC);
+    tx_ins.setNodeID(42);
+
+    // The first three subscriptions accept each transfer from the transport that delivers it first; the last one
+    // keeps the default policy for comparison. The third one receives multi-frame transfers.
+    std::array<CanardRxSubscription, 4>                  subs{};
+    std::array<std::array<CanardRxTransportStats, 2>, 4> stats{};
+    std::array<std::array<CanardRxTransportStats, 2>, 4> expected_stats{};
+    std::array<std::vector<CanardRxTransfer>, 4>         received{};
+    const std::array<std::size_t, 4>                     payload_sizes{{3, 3, 20, 3}};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 8, 2'000'000, subs.at(0)));
+    REQUIRE(1 == ins.rxSubscribeSingleFrame(CanardTransferKindMessage, 200, 8, 2'000'000, subs.at(1)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 300, 32, 2'000'000, subs.at(2)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 400, 8, 2'000'000, subs.at(3)));
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        REQUIRE(!subs.at(i).first_arrival_wins);
+        REQUIRE(nullptr == subs.at(i).transport_stats);
+        REQUIRE(0 == subs.at(i).transport_stats_count);
+        subs.at(i).first_arrival_wins    = (i < 3);
+        subs.at(i).transport_stats       = stats.at(i).data();
+        subs.at(i).transport_stats_count = stats.at(i).size();
+    }
+
+    struct Event
+    {
+        CanardMicrosecond         timestamp_usec;
+        std::uint8_t              iface;
+        std::size_t               sub_index;
+        std::uint32_t             can_id;
+        std::vector<std::uint8_t> payload;
+    };
+    const auto record_loss = [](CanardRxTransportStats& st, const CanardMicrosecond delay_usec) {
+        st.losses++;
+        st.loss_delay_usec_total += delay_usec;
+        st.loss_delay_usec_max = std::max(st.loss_delay_usec_max, delay_usec);
+    };
+
+    // The transports have different and jittery latencies, so either one may deliver a transfer first.
+    // The frames of both transports are interleaved in the order of arrival.
+    constexpr std::size_t          NumTransfers = 300;
+    std::optional<std::uint8_t>    locked;  // The transport of the sessions of the last subscription.
+    std::vector<CanardMicrosecond> first_arrivals;
+    std::vector<CanardMicrosecond> locked_arrivals;
+    for (std::size_t k = 0; k < NumTransfers; k++)
+    {
+        const CanardMicrosecond                published = 1'000'000 + (k * 10'000U);
+        const auto                             tid       = static_cast<CanardTransferID>(k % 32U);
+        const std::array<CanardMicrosecond, 2> latency{{1'000U + getRandomNatural<CanardMicrosecond>(1'000U),
+                                                        1'300U + getRandomNatural<CanardMicrosecond>(1'000U)}};
+        std::vector<Event>                     events;
+        for (std::size_t i = 0; i < subs.size(); i++)
+        {
+            std::vector<std::uint8_t> payload(payload_sizes.at(i), static_cast<std::uint8_t>(k));
+            CanardTransferMetadata    meta{};
+            meta.priority       = CanardPriorityNominal;
+            meta.transfer_kind  = CanardTransferKindMessage;
+            meta.port_id        = subs.at(i).port_id;
+            meta.remote_node_id = CANARD_NODE_ID_UNSET;
+            meta.transfer_id    = tid;
+            REQUIRE(0 < que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+            CanardMicrosecond offset = 0;
+            while (const auto* const ti = que.peek())
+            {
+                const auto* const bytes = static_cast<const std::uint8_t*>(ti->frame.payload);
+                for (std::uint8_t iface = 0; iface < 2; iface++)
+                {
+                    events.push_back({published + latency.at(iface) + offset,
+                                      iface,
+                                      i,
+                                      ti->frame.extended_can_id,
+                                      std::vector<std::uint8_t>(bytes, bytes + ti->frame.payload_size)});
+                }
+                offset += 100U;
+                tx_ins.getAllocator().deallocate(que.pop(ti));
+            }
+        }
+        std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+            return std::make_pair(a.timestamp_usec, a.iface) < std::make_pair(b.timestamp_usec, b.iface);
+        });
+        for (const auto& ev : events)
+        {
+            CanardFrame frame{};
+            frame.extended_can_id = ev.can_id;
+            frame.payload_size    = ev.payload.size();
+            frame.payload         = ev.payload.data();
+            CanardRxTransfer transfer{};
+            const auto       out = ins.rxAccept(ev.timestamp_usec, frame, ev.iface, transfer, nullptr);
+            REQUIRE(out >= 0);
+            if (out > 0)
+            {
+                REQUIRE(transfer.metadata.port_id == subs.at(ev.sub_index).port_id);
+                REQUIRE(transfer.payload_size == payload_sizes.at(ev.sub_index));
+                REQUIRE(static_cast<const std::uint8_t*>(transfer.payload)[0] == static_cast<std::uint8_t>(k));
+                ins.getAllocator().deallocate(transfer.payload);
+                received.at(ev.sub_index).push_back(transfer);
+            }
+        }
+
+        // Ties are resolved in favor of the first transport because its frames are fed first.
+        const auto winner = static_cast<std::uint8_t>((latency.at(1) < latency.at(0)) ? 1U : 0U);
+        const auto loser  = static_cast<std::uint8_t>(winner ^ 1U);
+        const auto delay  = latency.at(loser) - latency.at(winner);
+        first_arrivals.push_back(published + latency.at(winner));
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            expected_stats.at(i).at(winner).wins++;
+            record_loss(expected_stats.at(i).at(loser), delay);
+        }
+        // Without the first-arrival-wins policy, the session stays with the transport that won the first transfer.
+        // The other transport loses only when it is behind; otherwise, its frames are dropped as unexpected.
+        if (!locked)
+        {
+            locked = winner;
+        }
+        locked_arrivals.push_back(published + latency.at(*locked));
+        expected_stats.at(3).at(*locked).wins++;
+        if (winner == *locked)
+        {
+            record_loss(expected_stats.at(3).at(loser), delay);
+        }
+    }
+
+    // Every transfer is delivered exactly once; the first-arrival-wins policy minimizes the latency.
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        REQUIRE(received.at(i).size() == NumTransfers);
+        for (std::size_t k = 0; k < NumTransfers; k++)
+        {
+            REQUIRE(received.at(i).at(k).metadata.transfer_id == (k % 32U));
+            REQUIRE(received.at(i).at(k).timestamp_usec == ((i < 3) ? first_arrivals.at(k) : locked_arrivals.at(k)));
+        }
+        for (std::size_t iface = 0; iface < 2; iface++)
+        {
+            const auto& st  = stats.at(i).at(iface);
+            const auto& ref = expected_stats.at(i).at(iface);
+            REQUIRE(st.wins == ref.wins);
+            REQUIRE(st.losses == ref.losses);
+            REQUIRE(st.loss_delay_usec_total == ref.loss_delay_usec_total);
+            REQUIRE(st.loss_delay_usec_max == ref.loss_delay_usec_max);
+        }
+        REQUIRE((stats.at(i).at(0).wins + stats.at(i).at(1).wins) == NumTransfers);
+    }
+    REQUIRE(stats.at(0).at(0).wins > 0);  // Both transports win sometimes.
+    REQUIRE(stats.at(0).at(1).wins > 0);
+
+    // The transports beyond the statistics array are not accounted for.
+    subs.at(0).transport_stats_count = 1;
+    const std::array<std::uint8_t, 2> payload{{0, 0b111'00000U}};
+    CanardFrame                       frame{};
+    frame.extended_can_id = 0b001'00'0'11'0000000000000'0'0000000U | (100U << 8U) | 42U;
+    frame.payload_size    = payload.size();
+    frame.payload         = payload.data();
+    CanardRxTransfer transfer{};
+    const auto       wins_before = stats.at(0).at(1).wins;
+    REQUIRE(1 == ins.rxAccept(100'000'000, frame, 1, transfer, nullptr));
+    REQUIRE(wins_before == stats.at(0).at(1).wins);
+    ins.getAllocator().deallocate(transfer.payload);
+
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, subs.at(i).port_id));
+    }
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+    REQUIRE(0 == tx_ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxDuplicateCache")
+{
+    helpers::Instance      ins;
+    CanardRxDuplicateCache cache{};
+    CanardRxTransfer       transfer{};
+    REQUIRE(nullptr == ins.getInstance().rx_duplicate_cache);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetDuplicateCache(nullptr, &cache, 1'000));
+    REQUIRE(0 == canardRxSetDuplicateCache(&ins.getInstance(), &cache, 1'000));
+    REQUIRE(&cache == ins.getInstance().rx_duplicate_cache);
+    REQUIRE(1'000 == cache.window_usec);
+
+    CanardRxSubscription sub{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 8, 2'000'000, sub));
+
+    const auto accept = [&](const CanardMicrosecond          timestamp_usec,
+                            const std::uint8_t               iface,
+                            const std::uint32_t              can_id,
+                            const std::vector<std::uint8_t>& payload) {
+        CanardFrame frame{};
+        frame.extended_can_id = can_id;
+        frame.payload_size    = std::size(payload);
+        frame.payload         = payload.data();
+        const auto out        = ins.rxAccept(timestamp_usec, frame, iface, transfer, nullptr);
+        if (out > 0)
+        {
+            ins.getAllocator().deallocate(transfer.payload);
+        }
+        return out;
+    };
+    constexpr std::uint32_t CanID     = 0b001'00'0'11'0000000000000'0'0000000U | (100U << 8U) | 42U;
+    constexpr std::uint32_t Anonymous = 0b001'01'0'11'0000000000000'0'0000000U | (100U << 8U) | 42U;
+
+    // The duplicate from the other transport is dropped early; the duplicate from the same transport is not.
+    REQUIRE(1 == accept(10'000'000, 0, CanID, {1, 0b111'00000}));
+    REQUIRE(0 == accept(10'000'100, 1, CanID, {1, 0b111'00000}));
+    REQUIRE(1 == cache.suppressed_count);
+    REQUIRE(0 == accept(10'000'200, 0, CanID, {1, 0b111'00000}));
+    REQUIRE(1 == cache.suppressed_count);
+    // The clocks of the transports may be skewed, so the duplicate may appear to be older.
+    REQUIRE(0 == accept(9'999'500, 1, CanID, {1, 0b111'00000}));
+    REQUIRE(2 == cache.suppressed_count);
+    // Outside of the window, the frame is processed as usual and rejected by the session.
+    REQUIRE(0 == accept(10'001'300, 1, CanID, {1, 0b111'00000}));
+    REQUIRE(2 == cache.suppressed_count);
+    // A new transfer is not a duplicate.
+    REQUIRE(1 == accept(10'010'000, 0, CanID, {2, 0b111'00001}));
+    REQUIRE(0 == accept(10'010'100, 1, CanID, {2, 0b111'00001}));
+    REQUIRE(3 == cache.suppressed_count);
+
+    // The frames from the transport that the session is not bound to are not remembered, so that the session still
+    // receives the frames from its own transport even if they are late.
+    REQUIRE(0 == accept(10'020'000, 1, CanID, {3, 0b111'00010}));
+    REQUIRE(1 == accept(10'020'100, 0, CanID, {3, 0b111'00010}));
+    REQUIRE(3 == cache.suppressed_count);
+
+    // Anonymous frames are stateless, so they are never remembered.
+    REQUIRE(1 == accept(10'030'000, 0, Anonymous, {4, 0b111'00000}));
+    REQUIRE(1 == accept(10'030'100, 1, Anonymous, {4, 0b111'00000}));
+    REQUIRE(3 == cache.suppressed_count);
+
+    // The frames that hash into the same slot evict each other within the window.
+    for (std::uint32_t source = 0; source < 100; source++)
+    {
+        const auto id = 0b001'00'0'11'0000000000000'0'0000000U | (100U << 8U) | source;
+        REQUIRE(1 == accept(10'040'000 + source, 0, id, {5, 0b111'00000}));
+    }
+    REQUIRE(cache.evicted_count >= (100 - CANARD_RX_DUPLICATE_CACHE_SLOTS));
+    REQUIRE(cache.evicted_count < 100);
+
+    // Removing the cache restores the default behavior.
+    REQUIRE(0 == canardRxSetDuplicateCache(&ins.getInstance(), nullptr, 0));
+    REQUIRE(nullptr == ins.getInstance().rx_duplicate_cache);
+    REQUIRE(1 == accept(10'050'000, 0, CanID, {6, 0b111'00011}));
+    REQUIRE(0 == accept(10'050'100, 1, CanID, {6, 0b111'00011}));
+    REQUIRE(3 == cache.suppressed_count);
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxDuplicateCacheRandomized")
+{
+    using helpers::getRandomNatural;
+
+    // The cache shall not affect the reception in any way other than by saving the processing time: an instance with
+    // the cache shall deliver exactly the same transfers as an instance without it, given the same redundant streams
+    // with random latencies, losses, and transport failures.
+    std::array<helpers::Instance, 2> instances;
+    CanardRxDuplicateCache           cache{};
+    REQUIRE(0 == canardRxSetDuplicateCache(&instances.at(1).getInstance(), &cache, 5'000));
+    std::array<std::array<CanardRxSubscription, 4>, 2> subs{};
+    for (std::size_t k = 0; k < instances.size(); k++)
+    {
+        auto& ins = instances.at(k);
+        REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 8, 100'000, subs.at(k).at(0)));
+        REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 200, 64, 100'000, subs.at(k).at(1)));
+        REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 300, 64, 100'000, subs.at(k).at(2)));
+        REQUIRE(1 == ins.rxSubscribeSingleFrame(CanardTransferKindMessage, 400, 8, 100'000, subs.at(k).at(3)));
+        subs.at(k).at(1).failover_timeout_usec = 30'000;
+        subs.at(k).at(2).first_arrival_wins    = true;
+        subs.at(k).at(3).first_arrival_wins    = true;
+    }
+    const std::array<std::size_t, 4> payload_sizes{{3, 30, 30, 5}};
+
+    helpers::Instance tx_ins;
+    helpers::TxQueue  que(100, CANARD_MTU_CAN_CLASSIC);
+    struct Event
+    {
+        CanardMicrosecond         timestamp_usec;
+        std::uint8_t              iface;
+        std::uint32_t             can_id;
+        std::vector<std::uint8_t> payload;
+    };
+    std::vector<Event>                             events;
+    std::array<std::array<CanardTransferID, 4>, 3> tids{};
+    CanardMicrosecond                              now = 1'000'000;
+    std::array<bool, 2>                            failed{};
+    std::array<CanardMicrosecond, 2>               arrival{};  // The time when each transport is free to deliver.
+    for (std::size_t step = 0; step < 20'000; step++)
+    {
+        now += getRandomNatural<CanardMicrosecond>(2'000U);
+        for (auto& f : failed)  // Occasionally, a transport fails for a short while.
+        {
+            if (getRandomNatural(f ? 50U : 2'000U) == 0U)
+            {
+                f = !f;
+            }
+        }
+        const auto source    = getRandomNatural<std::uint8_t>(3U);
+        const auto sub_index = getRandomNatural<std::size_t>(4U);
+        tx_ins.setNodeID(static_cast<CanardNodeID>(10U + source));
+        std::vector<std::uint8_t> payload(payload_sizes.at(sub_index));
+        std::generate(payload.begin(), payload.end(), [] { return static_cast<std::uint8_t>(getRandomNatural(256U)); });
+        CanardTransferMetadata meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = subs.at(0).at(sub_index).port_id;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = tids.at(source).at(sub_index);
+        tids.at(source).at(sub_index) = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+        REQUIRE(0 < que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+        // Each transport delivers the frames in order, but its latency varies.
+        for (std::uint8_t iface = 0; iface < 2; iface++)
+        {
+            arrival.at(iface) = std::max(arrival.at(iface), now + getRandomNatural<CanardMicrosecond>(3'000U));
+        }
+        while (const auto* const ti = que.peek())
+        {
+            const auto* const bytes = static_cast<const std::uint8_t*>(ti->frame.payload);
+            for (std::uint8_t iface = 0; iface < 2; iface++)
+            {
+                if ((!failed.at(iface)) && (getRandomNatural(100U) > 0U))  // Random frame losses.
+                {
+                    events.push_back({arrival.at(iface),
+                                      iface,
+                                      ti->frame.extended_can_id,
+                                      std::vector<std::uint8_t>(bytes, bytes + ti->frame.payload_size)});
+                }
+                arrival.at(iface) += 100U;
+            }
+            tx_ins.getAllocator().deallocate(que.pop(ti));
+        }
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        return a.timestamp_usec < b.timestamp_usec;
+    });
+
+    std::size_t received = 0;
+    for (const auto& ev : events)
+    {
+        CanardFrame frame{};
+        frame.extended_can_id = ev.can_id;
+        frame.payload_size    = ev.payload.size();
+        frame.payload         = ev.payload.data();
+        std::array<CanardRxTransfer, 2> transfers{};
+        const auto out_ref    = instances.at(0).rxAccept(ev.timestamp_usec, frame, ev.iface, transfers.at(0), nullptr);
+        const auto out_cached = instances.at(1).rxAccept(ev.timestamp_usec, frame, ev.iface, transfers.at(1), nullptr);
+        REQUIRE(out_ref == out_cached);
+        if (out_ref > 0)
+        {
+            received++;
+            REQUIRE(transfers.at(0).metadata.port_id == transfers.at(1).metadata.port_id);
+            REQUIRE(transfers.at(0).metadata.remote_node_id == transfers.at(1).metadata.remote_node_id);
+            REQUIRE(transfers.at(0).metadata.transfer_id == transfers.at(1).metadata.transfer_id);
+            REQUIRE(transfers.at(0).timestamp_usec == transfers.at(1).timestamp_usec);
+            REQUIRE(transfers.at(0).payload_size == transfers.at(1).payload_size);
+            REQUIRE(0 == std::memcmp(transfers.at(0).payload, transfers.at(1).payload, transfers.at(0).payload_size));
+            instances.at(0).getAllocator().deallocate(transfers.at(0).payload);
+            instances.at(1).getAllocator().deallocate(transfers.at(1).payload);
+        }
+    }
+    REQUIRE(received > 10'000);
+    // Most of the duplicates are suppressed early.
+    REQUIRE(cache.suppressed_count > (events.size() / 4));
+
+    for (std::size_t k = 0; k < instances.size(); k++)
+    {
+        for (const auto& sub : subs.at(k))
+        {
+            REQUIRE(1 == instances.at(k).rxUnsubscribe(CanardTransferKindMessage, sub.port_id));
+        }
+        REQUIRE(0 == instances.at(k).getAllocator().getNumAllocatedFragments());
+    }
+}
+
+TEST_CASE("RxShards")
+{
+    using helpers::getRandomNatural;
+
+    CanardFrame frame{};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetShard(CanardTransferKindMessage, 0, 0));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetShard(CanardTransferKindMessage, 0, 65));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetShard(CanardTransferKindMessage, 8192, 4));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetShard(CanardTransferKindRequest, 512, 4));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetShard(static_cast<CanardTransferKind>(3), 0, 4));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetFrameShard(nullptr, 4));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetFrameShard(&frame, 0));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetFrameShard(&frame, 65));
+    frame.extended_can_id = 1U << 29U;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetFrameShard(&frame, 4));
+    REQUIRE(0 == canardRxGetShard(CanardTransferKindMessage, 8191, 1));
+    REQUIRE(63 == canardRxGetShard(CanardTransferKindMessage, 63, 64));
+    REQUIRE(1 == canardRxGetShard(CanardTransferKindMessage, 1, 4));
+    REQUIRE(2 == canardRxGetShard(CanardTransferKindMessage, 2, 4));
+    REQUIRE(0 == canardRxGetShard(CanardTransferKindRequest, 0, 4));  // 8192 % 4
+    REQUIRE(3 == canardRxGetShard(CanardTransferKindResponse, 3, 4));
+
+    // The frames are routed to the shard of their subscription regardless of the other fields of the CAN ID.
+    for (std::uint8_t shard_count = 1; shard_count <= CANARD_RX_SHARD_COUNT_MAX; shard_count++)
+    {
+        for (std::uint32_t subject_id = 0; subject_id <= CANARD_SUBJECT_ID_MAX; subject_id++)
+        {
+            const auto anonymous  = static_cast<std::uint32_t>(getRandomNatural(2U)) << 24U;
+            frame.extended_can_id = (static_cast<std::uint32_t>(getRandomNatural(8U)) << 26U) | anonymous |
+                                    (subject_id << 8U) | static_cast<std::uint32_t>(getRandomNatural(128U));
+            REQUIRE(canardRxGetShard(CanardTransferKindMessage, static_cast<CanardPortID>(subject_id), shard_count) ==
+                    canardRxGetFrameShard(&frame, shard_count));
+        }
+        for (std::uint32_t service_id = 0; service_id <= CANARD_SERVICE_ID_MAX; service_id++)
+        {
+            const bool request    = getRandomNatural(2U) == 0U;
+            frame.extended_can_id = (static_cast<std::uint32_t>(getRandomNatural(8U)) << 26U) | (1U << 25U) |
+                                    (static_cast<std::uint32_t>(request) << 24U) | (service_id << 14U) |
+                                    (static_cast<std::uint32_t>(getRandomNatural(128U)) << 7U) |
+                                    static_cast<std::uint32_t>(getRandomNatural(128U));
+            REQUIRE(canardRxGetShard(request ? CanardTransferKindRequest : CanardTransferKindResponse,
+                                     static_cast<CanardPortID>(service_id),
+                                     shard_count) == canardRxGetFrameShard(&frame, shard_count));
+        }
+    }
+
+    // The sharded instances jointly deliver exactly the same transfers as a single one.
+    constexpr std::uint8_t                      ShardCount = 3;
+    helpers::Instance                           reference;
+    std::array<helpers::Instance, ShardCount>   shards;
+    std::array<CanardRxSubscription, 8>         reference_subs{};
+    std::array<CanardRxSubscription, 8>         shard_subs{};
+    std::array<std::size_t, ShardCount>         received{};
+    for (std::size_t i = 0; i < reference_subs.size(); i++)
+    {
+        const auto port_id = static_cast<CanardPortID>(100U + i);
+        const auto shard   = canardRxGetShard(CanardTransferKindMessage, port_id, ShardCount);
+        REQUIRE(shard >= 0);
+        REQUIRE(1 == reference.rxSubscribe(CanardTransferKindMessage, port_id, 64, 1'000'000, reference_subs.at(i)));
+        REQUIRE(1 == shards.at(static_cast<std::size_t>(shard))
+                         .rxSubscribe(CanardTransferKindMessage, port_id, 64, 1'000'000, shard_subs.at(i)));
+    }
+    helpers::Instance tx_ins;
+    helpers::TxQueue  que(100, CANARD_MTU_CAN_CLASSIC);
+    std::array<std::array<CanardTransferID, 8>, 4> tids{};
+    CanardMicrosecond                              now = 1'000'000;
+    for (std::size_t step = 0; step < 2'000; step++)
+    {
+        const auto source    = getRandomNatural<std::size_t>(tids.size());
+        const auto sub_index = getRandomNatural<std::size_t>(reference_subs.size());
+        tx_ins.setNodeID(static_cast<CanardNodeID>(10U + source));
+        std::vector<std::uint8_t> payload(getRandomNatural<std::size_t>(30U));
+        std::generate(payload.begin(), payload.end(), [] { return static_cast<std::uint8_t>(getRandomNatural(256U)); });
+        CanardTransferMetadata meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = reference_subs.at(sub_index).port_id;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = tids.at(source).at(sub_index);
+        tids.at(source).at(sub_index) = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+        REQUIRE(0 < que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+        while (const auto* const ti = que.peek())
+        {
+            const auto shard = canardRxGetFrameShard(&ti->frame, ShardCount);
+            REQUIRE(shard >= 0);
+            std::array<CanardRxTransfer, 2> transfers{};
+            auto&                           ins       = shards.at(static_cast<std::size_t>(shard));
+            const auto                      out_ref   = reference.rxAccept(now, ti->frame, 0, transfers.at(0), nullptr);
+            const auto                      out_shard = ins.rxAccept(now, ti->frame, 0, transfers.at(1), nullptr);
+            REQUIRE(out_ref == out_shard);
+            if (out_ref > 0)
+            {
+                received.at(static_cast<std::size_t>(shard))++;
+                REQUIRE(transfers.at(0).metadata.port_id == transfers.at(1).metadata.port_id);
+                REQUIRE(transfers.at(0).payload_size == transfers.at(1).payload_size);
+                REQUIRE(0 == std::memcmp(transfers.at(0).payload, transfers.at(1).payload, payload.size()));
+                reference.getAllocator().deallocate(transfers.at(0).payload);
+                ins.getAllocator().deallocate(transfers.at(1).payload);
+            }
+            tx_ins.getAllocator().deallocate(que.pop(ti));
+            now += 100U;
+        }
+    }
+    for (const auto x : received)
+    {
+        REQUIRE(x > 300U);
+    }
+    REQUIRE(2'000U == (received.at(0) + received.at(1) + received.at(2)));
+
+    for (const auto& sub : reference_subs)
+    {
+        const auto shard = canardRxGetShard(CanardTransferKindMessage, sub.port_id, ShardCount);
+        REQUIRE(1 == reference.rxUnsubscribe(CanardTransferKindMessage, sub.port_id));
+        REQUIRE(1 == shards.at(static_cast<std::size_t>(shard)).rxUnsubscribe(CanardTransferKindMessage, sub.port_id));
+    }
+    REQUIRE(0 == reference.getAllocator().getNumAllocatedFragments());
+    for (auto& ins : shards)
+    {
+        REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+    }
+}
+
+TEST_CASE("RxDispatcher")
+{
+    using helpers::getRandomNatural;
+
+    constexpr std::uint8_t ShardCount   = 3;
+    constexpr std::size_t  NumProducers = 2;
+    constexpr std::size_t  RingCapacity = 16;
+    std::array<std::array<std::array<CanardRxFrameSlot, RingCapacity>, ShardCount>, NumProducers> slots{};
+    std::array<std::array<CanardRxFrameRing, ShardCount>, NumProducers>                             rings{};
+    std::array<CanardRxDispatcher, NumProducers>                                                    dispatchers{};
+    for (std::size_t k = 0; k < NumProducers; k++)
+    {
+        for (std::size_t i = 0; i < ShardCount; i++)
+        {
+            REQUIRE(0 == canardRxFrameRingInit(&rings.at(k).at(i), slots.at(k).at(i).data(), RingCapacity));
+        }
+        REQUIRE(0 == canardRxDispatcherInit(&dispatchers.at(k), rings.at(k).data(), ShardCount));
+    }
+
+    CanardRxDispatcher                 dispatcher{};
+    CanardFrame                        frame{};
+    const std::array<std::uint8_t, 65> data{};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatcherInit(nullptr, rings.at(0).data(), ShardCount));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatcherInit(&dispatcher, nullptr, ShardCount));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatcherInit(&dispatcher, rings.at(0).data(), 0));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatcherInit(&dispatcher, rings.at(0).data(), 65));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatch(nullptr, 0, &frame, 0));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatch(&dispatchers.at(0), 0, nullptr, 0));
+    frame.payload_size = 1;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatch(&dispatchers.at(0), 0, &frame, 0));
+    frame.payload      = data.data();
+    frame.payload_size = data.size();
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatch(&dispatchers.at(0), 0, &frame, 0));
+    frame.payload_size    = 1;
+    frame.extended_can_id = 1U << 29U;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxDispatch(&dispatchers.at(0), 0, &frame, 0));
+
+    // The frames that do not fit into the ring of their shard are dropped and counted; the other rings are unaffected.
+    frame.extended_can_id = 0b001'00'0'11'0000000000000'0'0000000U | (100U << 8U) | 42U;
+    const auto shard      = static_cast<std::size_t>(canardRxGetFrameShard(&frame, ShardCount));
+    for (std::size_t i = 0; i < RingCapacity; i++)
+    {
+        REQUIRE(1 == canardRxDispatch(&dispatchers.at(0), i, &frame, 1));
+    }
+    REQUIRE(0 == canardRxDispatch(&dispatchers.at(0), RingCapacity, &frame, 1));
+    REQUIRE(1 == rings.at(0).at(shard).overrun_count);
+    REQUIRE(0 == rings.at(1).at(shard).overrun_count);
+    for (std::size_t i = 0; i < RingCapacity; i++)
+    {
+        const CanardRxFrameSlot* const slot = canardRxFrameRingPeek(&rings.at(0).at(shard));
+        REQUIRE(slot != nullptr);
+        REQUIRE(slot->timestamp_usec == i);
+        REQUIRE(slot->extended_can_id == frame.extended_can_id);
+        REQUIRE(slot->redundant_transport_index == 1);
+        REQUIRE(slot->payload_size == 1);
+        REQUIRE(0 == canardRxFrameRingPop(&rings.at(0).at(shard)));
+    }
+    REQUIRE(nullptr == canardRxFrameRingPeek(&rings.at(0).at(shard)));
+    rings.at(0).at(shard).overrun_count = 0;
+
+    // The transfers of many sessions are interleaved across the producers and split between the shards; each shard
+    // drains its ring of every producer, and all transfers are delivered intact because the frame order is preserved.
+    std::array<helpers::Instance, ShardCount> shards;
+    std::array<CanardRxSubscription, 8>       subs{};
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        const auto port_id = static_cast<CanardPortID>(100U + i);
+        const auto index   = static_cast<std::size_t>(canardRxGetShard(CanardTransferKindMessage, port_id, ShardCount));
+        REQUIRE(1 == shards.at(index).rxSubscribe(CanardTransferKindMessage, port_id, 64, 1'000'000, subs.at(i)));
+    }
+    std::size_t received = 0;
+    const auto  drain    = [&]() {
+        std::array<CanardRxTransfer, RingCapacity> transfers{};
+        for (std::size_t i = 0; i < ShardCount; i++)
+        {
+            for (std::size_t k = 0; k < NumProducers; k++)
+            {
+                auto&         ins = shards.at(i);
+                const int32_t out =
+                    canardRxAcceptRing(&ins.getInstance(), &rings.at(k).at(i), transfers.data(), transfers.size());
+                REQUIRE(out >= 0);
+                for (std::size_t j = 0; j < static_cast<std::size_t>(out); j++)
+                {
+                    const auto& tr = transfers.at(j);
+                    REQUIRE(tr.payload_size == tr.metadata.transfer_id);  // Encodes the expected content.
+                    for (std::size_t b = 0; b < tr.payload_size; b++)
+                    {
+                        REQUIRE(static_cast<const std::uint8_t*>(tr.payload)[b] == tr.metadata.remote_node_id);
+                    }
+                    ins.getAllocator().deallocate(tr.payload);
+                    received++;
+                }
+            }
+        }
+    };
+    helpers::Instance                   tx_ins;
+    helpers::TxQueue                    que(100, CANARD_MTU_CAN_CLASSIC);
+    std::array<CanardTransferID, 8 * 4> tids{};
+    CanardMicrosecond                   now = 1'000'000;
+    for (std::size_t step = 0; step < 2'000; step++)
+    {
+        // Two sources per producer; the frames of several transfers are queued before the shards catch up.
+        const auto source    = getRandomNatural<std::size_t>(4U);
+        const auto sub_index = getRandomNatural<std::size_t>(subs.size());
+        auto&      tid       = tids.at((source * subs.size()) + sub_index);
+        tx_ins.setNodeID(static_cast<CanardNodeID>(10U + source));
+        const std::vector<std::uint8_t> payload(tid, static_cast<std::uint8_t>(10U + source));
+        CanardTransferMetadata          meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = subs.at(sub_index).port_id;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        meta.transfer_id    = tid;
+        tid                 = static_cast<CanardTransferID>((tid + 1U) & CANARD_TRANSFER_ID_MAX);
+        REQUIRE(0 < que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+        while (const auto* const ti = que.peek())
+        {
+            REQUIRE(1 == canardRxDispatch(&dispatchers.at(source / 2U), now, &ti->frame, 0));
+            tx_ins.getAllocator().deallocate(que.pop(ti));
+            now += 100U;
+        }
+        if ((step % 3U) == 2U)  // Up to 15 frames per ring; more would overrun it.
+        {
+            drain();
+        }
+    }
+    drain();
+    REQUIRE(2'000U == received);
+    for (const auto& ring : rings)
+    {
+        for (const auto& x : ring)
+        {
+            REQUIRE(0 == x.overrun_count);
+            REQUIRE(0 == x.oom_count);
+        }
+    }
+
+    for (const auto& sub : subs)
+    {
+        const auto index = canardRxGetShard(CanardTransferKindMessage, sub.port_id, ShardCount);
+        REQUIRE(1 == shards.at(static_cast<std::size_t>(index)).rxUnsubscribe(CanardTransferKindMessage, sub.port_id));
+    }
+    for (auto& ins : shards)
+    {
+        REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+    }
+}
+
+TEST_CASE("RxSubscriptionTable")
+{
+    helpers::Instance                   ins;
+    CanardRxSubscriptionTable           table{};
+    CanardRxTransfer                    transfer{};
+    std::array<CanardRxSubscription, 5> subs{};
+    auto&                               alloc = ins.getAllocator();
+
+    REQUIRE(nullptr == ins.getInstance().rx_subscription_table);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetSubscriptionTable(nullptr, &table));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxReclaim(nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxReclaim(&ins.getInstance()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxIsReclaimed(nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxIsReclaimed(&ins.getInstance()));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 10, 8, 1'000'000, subs.at(0)));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetSubscriptionTable(&ins.getInstance(), &table));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 10));
+    alloc.setAllocationCeiling(0);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardRxSetSubscriptionTable(&ins.getInstance(), &table));
+    REQUIRE(nullptr == ins.getInstance().rx_subscription_table);
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    REQUIRE(0 == canardRxSetSubscriptionTable(&ins.getInstance(), &table));
+    REQUIRE(&table == ins.getInstance().rx_subscription_table);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());  // The empty snapshot.
+    REQUIRE(1 == canardRxIsReclaimed(&ins.getInstance()));
+    REQUIRE(0 == canardRxReclaim(&ins.getInstance()));
+
+    const auto accept = [&](const CanardTransferKind         kind,
+                            const CanardPortID               port_id,
+                            const std::vector<std::uint8_t>& payload,
+                            CanardRxSubscription** const     out_subscription = nullptr) {
+        static CanardMicrosecond now = 0;
+        CanardFrame              frame{};
+        frame.extended_can_id = (kind == CanardTransferKindMessage)
+                                    ? (0b001'00'0'11'0000000000000'0'0000000U | (std::uint32_t{port_id} << 8U) | 42U)
+                                    : (0b011'10'0000000000'0000000'0000000U |
+                                       (std::uint32_t{kind == CanardTransferKindRequest} << 24U) |
+                                       (std::uint32_t{port_id} << 14U) | (std::uint32_t{7U} << 7U) | 42U);
+        frame.payload_size    = std::size(payload);
+        frame.payload         = payload.data();
+        const auto out        = ins.rxAccept(now += 1'000, frame, 0, transfer, out_subscription);
+        if (out > 0)
+        {
+            REQUIRE(port_id == transfer.metadata.port_id);
+            ins.getAllocator().deallocate(transfer.payload);
+        }
+        return out;
+    };
+    ins.setNodeID(7);
+
+    // Every change publishes a new snapshot and retires the old one, which is released at the next quiescent point.
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 300, 8, 1'000'000, subs.at(0)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 10, 8, 1'000'000, subs.at(1)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindRequest, 10, 8, 1'000'000, subs.at(2)));
+    REQUIRE(1 == ins.rxSubscribeSingleFrame(CanardTransferKindMessage, 200, 8, 1'000'000, subs.at(3)));
+    REQUIRE(5 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == canardRxReclaim(&ins.getInstance()));  // No subscriptions removed.
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    CanardRxSubscription* sub = nullptr;
+    REQUIRE(1 == accept(CanardTransferKindMessage, 10, {1, 0b111'00000}, &sub));
+    REQUIRE(&subs.at(1) == sub);
+    REQUIRE(1 == accept(CanardTransferKindRequest, 10, {2, 0b111'00000}, &sub));
+    REQUIRE(&subs.at(2) == sub);
+    REQUIRE(1 == accept(CanardTransferKindMessage, 200, {3, 0b111'00000}, &sub));
+    REQUIRE(&subs.at(3) == sub);
+    REQUIRE(1 == accept(CanardTransferKindMessage, 300, {4, 0b111'00000}, &sub));
+    REQUIRE(&subs.at(0) == sub);
+    REQUIRE(0 == accept(CanardTransferKindMessage, 20, {5, 0b111'00000}, &sub));
+    REQUIRE(nullptr == sub);
+    REQUIRE(0 == accept(CanardTransferKindResponse, 10, {6, 0b111'00000}, &sub));
+    REQUIRE(nullptr == sub);
+    const auto fragments = alloc.getNumAllocatedFragments();
+    REQUIRE(5 == fragments);  // The snapshot and the sessions.
+
+    // The sessions of a removed subscription are kept until the reader reaches a quiescent point.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 300));
+    REQUIRE(0 == ins.rxUnsubscribe(CanardTransferKindMessage, 300));
+    REQUIRE(fragments + 1 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == canardRxIsReclaimed(&ins.getInstance()));
+    REQUIRE(nullptr != subs.at(0).sessions[42]);
+    REQUIRE(0 == accept(CanardTransferKindMessage, 300, {7, 0b111'00001}));
+    REQUIRE(1 == canardRxIsReclaimed(&ins.getInstance()));
+    REQUIRE(nullptr == subs.at(0).sessions[42]);
+    REQUIRE(fragments - 1 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 200));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindRequest, 10));
+    REQUIRE(0 == canardRxIsReclaimed(&ins.getInstance()));
+    REQUIRE(2 == canardRxReclaim(&ins.getInstance()));
+    REQUIRE(1 == canardRxIsReclaimed(&ins.getInstance()));
+    REQUIRE(0 == canardRxReclaim(&ins.getInstance()));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+
+    // Out of memory leaves the published subscriptions unchanged.
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount());
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == ins.rxUnsubscribe(CanardTransferKindMessage, 10));
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == ins.rxSubscribe(CanardTransferKindMessage, 400, 8, 1'000'000, subs.at(4)));
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == ins.rxSubscribe(CanardTransferKindMessage, 10, 8, 1'000'000, subs.at(4)));
+    REQUIRE(1 == canardRxIsReclaimed(&ins.getInstance()));
+    REQUIRE(1 == ins.getMessageSubs().size());
+    REQUIRE(&subs.at(1) == ins.getMessageSubs().at(0));
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    REQUIRE(1 == accept(CanardTransferKindMessage, 10, {8, 0b111'00001}, &sub));
+    REQUIRE(&subs.at(1) == sub);
+    REQUIRE(0 == accept(CanardTransferKindMessage, 400, {9, 0b111'00001}));
+
+    // Re-subscription replaces the subscription with another object; the old one is released as usual.
+    REQUIRE(0 == ins.rxSubscribe(CanardTransferKindMessage, 10, 8, 1'000'000, subs.at(4)));
+    REQUIRE(1 == accept(CanardTransferKindMessage, 10, {10, 0b111'00010}, &sub));
+    REQUIRE(&subs.at(4) == sub);
+    REQUIRE(nullptr == subs.at(1).sessions[42]);
+    REQUIRE(1 == canardRxIsReclaimed(&ins.getInstance()));
+
+    // The current subscription of the port cannot be re-subscribed with the same object while the reader may use it.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            ins.rxSubscribe(CanardTransferKindMessage, 10, 16, 1'000'000, subs.at(4)));
+    REQUIRE(8 == subs.at(4).extent);
+    REQUIRE(nullptr != subs.at(4).sessions[42]);
+    REQUIRE(1 == accept(CanardTransferKindMessage, 10, {11, 0b111'00011}, &sub));
+    REQUIRE(&subs.at(4) == sub);
+
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetSubscriptionTable(&ins.getInstance(), nullptr));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 10));
+    REQUIRE(0 == canardRxSetSubscriptionTable(&ins.getInstance(), nullptr));  // Releases everything.
+    REQUIRE(nullptr == ins.getInstance().rx_subscription_table);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxSubscriptionTableConcurrent")
+{
+    // One thread keeps adding and removing subscriptions while the other one is receiving transfers; the transfers
+    // shall only be delivered by the subscriptions that are in place, and no memory shall be leaked or corrupted.
+    constexpr std::size_t NumPorts = 8;
+    helpers::Instance     ins;
+    CanardRxTimerWheel    wheel{};
+    REQUIRE(0 == canardRxSetTimerWheel(&ins.getInstance(), &wheel, 1'000));
+    CanardRxSubscriptionTable table{};
+    REQUIRE(0 == canardRxSetSubscriptionTable(&ins.getInstance(), &table));
+
+    struct Frame
+    {
+        std::uint32_t             can_id;
+        std::vector<std::uint8_t> payload;
+    };
+    std::vector<Frame> frames;
+    {
+        helpers::Instance                                     tx_ins;
+        helpers::TxQueue                                      que(100, CANARD_MTU_CAN_CLASSIC);
+        std::array<std::array<CanardTransferID, NumPorts>, 4> tids{};
+        for (std::size_t i = 0; i < 4'000; i++)
+        {
+            const auto node = static_cast<std::uint8_t>(i % tids.size());
+            const auto port = (i / tids.size()) % NumPorts;
+            tx_ins.setNodeID(static_cast<CanardNodeID>(node + 1U));
+            // The payload is filled with the port-ID so that a misdelivered transfer is detected.
+            const std::vector<std::uint8_t> payload(1U + ((i * 7U) % 20U), static_cast<std::uint8_t>(port));
+            CanardTransferMetadata          meta{};
+            meta.priority       = CanardPriorityNominal;
+            meta.transfer_kind  = CanardTransferKindMessage;
+            meta.port_id        = static_cast<CanardPortID>(port);
+            meta.remote_node_id = CANARD_NODE_ID_UNSET;
+            meta.transfer_id    = tids.at(node).at(port);
+            tids.at(node).at(port) = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+            REQUIRE(0 < que.push(&tx_ins.getInstance(), 0, meta, payload.size(), payload.data()));
+            while (const auto* const ti = que.peek())
+            {
+                const auto* const bytes = static_cast<const std::uint8_t*>(ti->frame.payload);
+                frames.push_back({ti->frame.extended_can_id,
+                                  std::vector<std::uint8_t>(bytes, bytes + ti->frame.payload_size)});
+                tx_ins.getAllocator().deallocate(que.pop(ti));
+            }
+        }
+    }
+
+    std::array<CanardRxSubscription, NumPorts * 2> pool{};
+    std::atomic<bool>                              writer_done{false};
+    std::atomic<std::size_t>                       changes{0};
+    std::thread                                    writer([&] {
+        std::minstd_rand                            rng(1234);  // NOLINT std::rand is not thread-safe
+        std::vector<CanardRxSubscription*>          free_objects;
+        std::vector<CanardRxSubscription*>          removed_objects;
+        std::array<CanardRxSubscription*, NumPorts> active{};
+        for (auto& x : pool)
+        {
+            free_objects.push_back(&x);
+        }
+        while (changes < 3'000)
+        {
+            if (1 == canardRxIsReclaimed(&ins.getInstance()))
+            {
+                free_objects.insert(free_objects.end(), removed_objects.begin(), removed_objects.end());
+                removed_objects.clear();
+            }
+            const auto port = static_cast<CanardPortID>(rng() % NumPorts);
+            if (active.at(port) != nullptr)
+            {
+                if (1 == canardRxUnsubscribe(&ins.getInstance(), CanardTransferKindMessage, port))
+                {
+                    removed_objects.push_back(active.at(port));
+                    active.at(port) = nullptr;
+                    changes++;
+                }
+            }
+            else if (!free_objects.empty())
+            {
+                CanardRxSubscription* const sub = free_objects.back();
+                if (1 == canardRxSubscribe(&ins.getInstance(), CanardTransferKindMessage, port, 32, 10'000, sub))
+                {
+                    free_objects.pop_back();
+                    active.at(port) = sub;
+                    changes++;
+                }
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        writer_done = true;
+    });
+
+    // The subscriptions that the writer has left in place are removed by the reader thread at the end.
+    CanardMicrosecond now      = 1'000'000;
+    std::size_t       received = 0;
+    std::size_t       cycles   = 0;
+    while (!writer_done)
+    {
+        for (const auto& frame : frames)
+        {
+            CanardFrame cf{};
+            cf.extended_can_id = frame.can_id;
+            cf.payload_size    = frame.payload.size();
+            cf.payload         = frame.payload.data();
+            CanardRxTransfer transfer{};
+            now += 10U;
+            if (ins.rxAccept(now, cf, 0, transfer, nullptr) > 0)
+            {
+                received++;
+                const auto* const bytes = static_cast<const std::uint8_t*>(transfer.payload);
+                REQUIRE(std::all_of(bytes, bytes + transfer.payload_size, [&](const std::uint8_t x) {
+                    return x == transfer.metadata.port_id;
+                }));
+                ins.getAllocator().deallocate(transfer.payload);
+            }
+        }
+        (void) ins.rxExpire(now);
+        cycles++;
+    }
+    writer.join();
+    REQUIRE(cycles > 0U);
+    REQUIRE(received > 0U);
+    for (std::size_t port = 0; port < NumPorts; port++)
+    {
+        const auto port_id = static_cast<CanardPortID>(port);
+        REQUIRE(0 <= canardRxUnsubscribe(&ins.getInstance(), CanardTransferKindMessage, port_id));
+    }
+    REQUIRE(0 <= canardRxReclaim(&ins.getInstance()));
+    REQUIRE(1 == canardRxIsReclaimed(&ins.getInstance()));
+    REQUIRE(0 == wheel.session_count);
+    REQUIRE(0 == canardRxSetSubscriptionTable(&ins.getInstance(), nullptr));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxFrameRing")
+{
+    std::array<CanardRxFrameSlot, 4> slots{};
+    CanardRxFrameRing                ring{};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingInit(nullptr, slots.data(), slots.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingInit(&ring, nullptr, slots.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingInit(&ring, slots.data(), 0));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingInit(&ring, slots.data(), 3));
+    REQUIRE(0 == canardRxFrameRingInit(&ring, slots.data(), slots.size()));
+    REQUIRE(nullptr == canardRxFrameRingReserve(nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingCommit(nullptr));
+    REQUIRE(nullptr == canardRxFrameRingPeek(nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingPop(nullptr));
+    REQUIRE(nullptr == canardRxFrameRingPeek(&ring));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingPop(&ring));
+
+    // The producer and the consumer sides do not share cache lines.
+    REQUIRE((offsetof(CanardRxFrameRing, tail) - offsetof(CanardRxFrameRing, capacity)) >= CANARD_CACHE_LINE_SIZE);
+    REQUIRE((offsetof(CanardRxFrameRing, head) - offsetof(CanardRxFrameRing, overrun_count)) >= CANARD_CACHE_LINE_SIZE);
+    REQUIRE((sizeof(CanardRxFrameRing) - offsetof(CanardRxFrameRing, oom_count)) >= CANARD_CACHE_LINE_SIZE);
+
+    // Wrap around the storage several times; the slots are used in order and each one only once per lap.
+    std::uint32_t next_in  = 0;
+    std::uint32_t next_out = 0;
+    for (std::size_t lap = 0; lap < 5; lap++)
+    {
+        while (CanardRxFrameSlot* const slot = canardRxFrameRingReserve(&ring))
+        {
+            REQUIRE(slot == canardRxFrameRingReserve(&ring));  // Same slot until committed.
+            REQUIRE(slot == &slots.at(next_in % slots.size()));
+            slot->extended_can_id = next_in++;
+            REQUIRE(0 == canardRxFrameRingCommit(&ring));
+        }
+        REQUIRE(next_in == (next_out + slots.size()));
+        REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingCommit(&ring));
+        REQUIRE(ring.overrun_count == (lap + 1U));  // The last reservation attempt of the lap found the ring full.
+        // Drain a different number of frames in every lap to shift the wrap-around point.
+        for (std::size_t i = 0; i < (1U + (lap % slots.size())); i++)
+        {
+            const CanardRxFrameSlot* const slot = canardRxFrameRingPeek(&ring);
+            REQUIRE(slot != nullptr);
+            REQUIRE(slot == canardRxFrameRingPeek(&ring));
+            REQUIRE(slot->extended_can_id == next_out++);
+            REQUIRE(0 == canardRxFrameRingPop(&ring));
+        }
+    }
+    while (const CanardRxFrameSlot* const slot = canardRxFrameRingPeek(&ring))
+    {
+        REQUIRE(slot->extended_can_id == next_out++);
+        REQUIRE(0 == canardRxFrameRingPop(&ring));
+    }
+    REQUIRE(next_in == next_out);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxFrameRingPop(&ring));
+}
+
+TEST_CASE("RxFrameRingAccept")
+{
+    helpers::Instance                   ins;
+    std::array<CanardRxFrameSlot, 8>    slots{};
+    CanardRxFrameRing                   ring{};
+    std::array<CanardRxTransfer, 2>     transfers{};
+    std::array<CanardRxSubscription, 2> subs{};
+    REQUIRE(0 == canardRxFrameRingInit(&ring, slots.data(), slots.size()));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 0b0110011001100, 16, 1'000'000, subs.at(0)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 0b0000000000001, 16, 1'000'000, subs.at(1)));
+
+    // The payload size is overridden if given, which is used to emulate a malfunctioning driver.
+    const auto push = [&](const CanardPortID               subject_id,
+                          const CanardMicrosecond          timestamp_usec,
+                          const std::uint8_t               iface,
+                          const std::vector<std::uint8_t>& payload,
+                          const std::uint8_t               payload_size = 0) {
+        CanardRxFrameSlot* const slot = canardRxFrameRingReserve(&ring);
+        REQUIRE(slot != nullptr);
+        slot->timestamp_usec = timestamp_usec;
+        slot->extended_can_id =
+            0b001'00'0'11'0000000000000'0'0000000U | static_cast<std::uint32_t>((subject_id << 8U) | 42U);
+        slot->redundant_transport_index = iface;
+        slot->payload_size = (payload_size > 0U) ? payload_size : static_cast<std::uint8_t>(payload.size());
+        std::copy(payload.begin(), payload.end(), std::begin(slot->payload));
+        REQUIRE(0 == canardRxFrameRingCommit(&ring));
+    };
+
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptRing(nullptr, &ring, transfers.data(), transfers.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptRing(&ins.getInstance(), nullptr, transfers.data(), 1));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptRing(&ins.getInstance(), &ring, nullptr, 1));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptRing(&ins.getInstance(), &ring, transfers.data(), 0));
+    REQUIRE(0 == canardRxAcceptRing(&ins.getInstance(), &ring, transfers.data(), transfers.size()));
+
+    // Unsubscribed port, mis-sized frame, two transfers, then another one that does not fit into the output array.
+    push(0b0000000000111, 1'000, 0, {0xE0});
+    push(0b0110011001100, 1'001, 0, {1, 2, 3, 0b111'00000}, CANARD_MTU_MAX + 1U);
+    push(0b0110011001100, 1'002, 1, {4, 5, 0b111'00001});
+    push(0b0000000000001, 1'003, 0, {6, 0b111'00000});
+    push(0b0000000000001, 1'004, 0, {7, 0b111'00001});
+    REQUIRE(2 == canardRxAcceptRing(&ins.getInstance(), &ring, transfers.data(), transfers.size()));
+    REQUIRE(transfers.at(0).metadata.port_id == 0b0110011001100);
+    REQUIRE(transfers.at(0).metadata.transfer_id == 1);
+    REQUIRE(transfers.at(0).timestamp_usec == 1'002);
+    REQUIRE(transfers.at(0).payload_size == 2);
+    REQUIRE(0 == std::memcmp(transfers.at(0).payload, "\x04\x05", 2));
+    REQUIRE(transfers.at(1).metadata.port_id == 0b0000000000001);
+    REQUIRE(transfers.at(1).payload_size == 1);
+    REQUIRE(0 == std::memcmp(transfers.at(1).payload, "\x06", 1));
+    ins.getAllocator().deallocate(transfers.at(0).payload);
+    ins.getAllocator().deallocate(transfers.at(1).payload);
+    const CanardRxFrameSlot* const rest = canardRxFrameRingPeek(&ring);
+    REQUIRE(rest != nullptr);
+    REQUIRE(rest->timestamp_usec == 1'004);
+
+    // Out of memory: the frame is dropped and counted, and the next one is processed regardless.
+    push(0b0000000000001, 1'005, 0, {8, 0b111'00010});
+    ins.getAllocator().setAllocationCeiling(0);
+    REQUIRE(0 == canardRxAcceptRing(&ins.getInstance(), &ring, transfers.data(), transfers.size()));
+    REQUIRE(2 == ring.oom_count);
+    REQUIRE(nullptr == canardRxFrameRingPeek(&ring));
+    ins.getAllocator().setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    push(0b0000000000001, 1'006, 0, {9, 0b111'00011});
+    REQUIRE(1 == canardRxAcceptRing(&ins.getInstance(), &ring, transfers.data(), transfers.size()));
+    REQUIRE(transfers.at(0).payload_size == 1);
+    REQUIRE(transfers.at(0).metadata.transfer_id == 3);
+    ins.getAllocator().deallocate(transfers.at(0).payload);
+    REQUIRE(0 == ring.overrun_count);
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 0b0110011001100));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 0b0000000000001));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxFrameRingConcurrent")
+{
+    // The producer thread stands in for the CAN driver; the frames shall be received in order without losses.
+    constexpr std::size_t NumTransfers = 20'000;
+    helpers::Instance     ins;
+    CanardRxSubscription  sub{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1234, 64, 1'000'000, sub));
+    std::array<CanardRxFrameSlot, 16> slots{};
+    CanardRxFrameRing                 ring{};
+    REQUIRE(0 == canardRxFrameRingInit(&ring, slots.data(), slots.size()));
+
+    std::atomic<std::size_t> producer_errors{0};  // Catch assertions are not thread-safe.
+    std::thread              producer([&] {
+        for (std::size_t i = 0; i < NumTransfers; i++)
+        {
+            CanardRxFrameSlot* slot = canardRxFrameRingReserve(&ring);
+            while (slot == nullptr)
+            {
+                std::this_thread::yield();
+                slot = canardRxFrameRingReserve(&ring);
+            }
+            // Single-frame transfers carrying the sequence number; the transfer-ID follows it.
+            slot->timestamp_usec            = 1'000'000U + i;
+            slot->extended_can_id           = 0b001'00'0'11'0000000000000'0'0000000U | (1234U << 8U) | 42U;
+            slot->redundant_transport_index = 0;
+            slot->payload_size              = 5;
+            const auto seq                  = static_cast<std::uint32_t>(i);
+            std::memcpy(&slot->payload[0], &seq, sizeof(seq));
+            slot->payload[4] = static_cast<std::uint8_t>(0b111'00000U | (i % (CANARD_TRANSFER_ID_MAX + 1U)));
+            producer_errors += (0 == canardRxFrameRingCommit(&ring)) ? 0U : 1U;
+        }
+    });
+
+    std::array<CanardRxTransfer, 7> transfers{};
+    std::size_t                     received = 0;
+    while (received < NumTransfers)
+    {
+        const std::int32_t result = canardRxAcceptRing(&ins.getInstance(), &ring, transfers.data(), transfers.size());
+        REQUIRE(result >= 0);
+        for (std::int32_t i = 0; i < result; i++)
+        {
+            const CanardRxTransfer& tr  = transfers.at(static_cast<std::size_t>(i));
+            std::uint32_t           seq = 0;
+            REQUIRE(tr.payload_size == sizeof(seq));
+            std::memcpy(&seq, tr.payload, sizeof(seq));
+            REQUIRE(seq == received);
+            received++;
+            ins.getAllocator().deallocate(tr.payload);
+        }
+        if (result == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    REQUIRE(0 == producer_errors);
+    REQUIRE(nullptr == canardRxFrameRingPeek(&ring));
+    REQUIRE(0 == ring.oom_count);
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1234));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxBacklog")
+{
+    helpers::Instance                   ins;
+    std::array<CanardRxBacklogItem, 4>  items{};
+    CanardRxBacklog                     backlog{};
+    std::array<CanardRxTransfer, 8>     transfers{};
+    std::array<CanardRxSubscription, 3> subs{};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxBacklogInit(nullptr, items.data(), items.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxBacklogInit(&backlog, nullptr, items.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxBacklogInit(&backlog, items.data(), 0));
+    REQUIRE(0 == canardRxBacklogInit(&backlog, items.data(), items.size()));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 100, 16, 1'000'000, subs.at(0)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 200, 16, 1'000'000, subs.at(1)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 300, 16, 1'000'000, subs.at(2)));
+
+    // Single-frame transfers from node 42 whose payload is the transfer-ID.
+    const auto push = [&](const std::uint8_t      priority,
+                          const CanardPortID      subject_id,
+                          const CanardTransferID  transfer_id,
+                          const CanardMicrosecond timestamp_usec) -> std::int8_t {
+        const std::array<std::uint8_t, 2> payload{{transfer_id, static_cast<std::uint8_t>(0b111'00000U | transfer_id)}};
+        CanardFrame                       frame{};
+        frame.extended_can_id = (static_cast<std::uint32_t>(priority) << 26U) | (0b11U << 21U) |
+                                static_cast<std::uint32_t>(subject_id << 8U) | 42U;
+        frame.payload_size = payload.size();
+        frame.payload      = payload.data();
+        return canardRxBacklogPush(&backlog, timestamp_usec, &frame, 1);
+    };
+
+    CanardFrame frame{};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxBacklogPush(nullptr, 0, &frame, 0));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxBacklogPush(&backlog, 0, nullptr, 0));
+    frame.payload_size = 1;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxBacklogPush(&backlog, 0, &frame, 0));
+    frame.payload_size = CANARD_MTU_MAX + 1U;
+    frame.payload      = transfers.data();
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxBacklogPush(&backlog, 0, &frame, 0));
+    REQUIRE(0 == backlog.size);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptBacklog(nullptr, &backlog, transfers.data(), 1));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptBacklog(&ins.getInstance(), nullptr, transfers.data(), 1));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptBacklog(&ins.getInstance(), &backlog, nullptr, 1));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptBacklog(&ins.getInstance(), &backlog, transfers.data(), 0));
+    REQUIRE(0 == canardRxAcceptBacklog(&ins.getInstance(), &backlog, transfers.data(), transfers.size()));
+
+    // The backlog is filled with bulk traffic; the higher-priority frames evict the oldest bulk frames.
+    for (std::uint8_t i = 0; i < 4; i++)
+    {
+        REQUIRE(1 == push(CanardPriorityOptional, 100, i, 1'000U + i));
+    }
+    REQUIRE(4 == backlog.size);
+    REQUIRE(1 == push(CanardPriorityNominal, 200, 0, 2'000));
+    REQUIRE(0 == push(CanardPriorityOptional, 100, 4, 2'001));
+    REQUIRE(1 == push(CanardPriorityExceptional, 300, 0, 2'002));
+    REQUIRE(4 == backlog.size);
+    REQUIRE(2 == backlog.eviction_count);
+    REQUIRE(1 == backlog.drop_count);
+
+    // The transfers are received highest priority first, the newer high-priority frames overtaking the older ones.
+    REQUIRE(2 == canardRxAcceptBacklog(&ins.getInstance(), &backlog, transfers.data(), 2));
+    REQUIRE(transfers.at(0).metadata.port_id == 300);
+    REQUIRE(transfers.at(0).metadata.priority == CanardPriorityExceptional);
+    REQUIRE(transfers.at(0).timestamp_usec == 2'002);
+    REQUIRE(transfers.at(1).metadata.port_id == 200);
+    REQUIRE(transfers.at(1).metadata.priority == CanardPriorityNominal);
+    ins.getAllocator().deallocate(transfers.at(0).payload);
+    ins.getAllocator().deallocate(transfers.at(1).payload);
+    REQUIRE(1 == push(CanardPriorityExceptional, 300, 1, 3'000));
+    REQUIRE(3 == canardRxAcceptBacklog(&ins.getInstance(), &backlog, transfers.data(), transfers.size()));
+    REQUIRE(transfers.at(0).metadata.port_id == 300);
+    REQUIRE(transfers.at(0).metadata.transfer_id == 1);
+    // The order of arrival is preserved within the session.
+    REQUIRE(transfers.at(1).metadata.port_id == 100);
+    REQUIRE(transfers.at(1).metadata.transfer_id == 2);
+    REQUIRE(transfers.at(1).timestamp_usec == 1'002);
+    REQUIRE(transfers.at(2).metadata.port_id == 100);
+    REQUIRE(transfers.at(2).metadata.transfer_id == 3);
+    REQUIRE(transfers.at(2).payload_size == 1);
+    REQUIRE(0 == std::memcmp(transfers.at(2).payload, "\x03", 1));
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        ins.getAllocator().deallocate(transfers.at(i).payload);
+    }
+    REQUIRE(0 == backlog.size);
+
+    // Out of memory: the frame is dropped and counted. The freed items are reused.
+    ins.getAllocator().setAllocationCeiling(0);
+    REQUIRE(1 == push(CanardPriorityHigh, 200, 1, 4'000));
+    REQUIRE(0 == canardRxAcceptBacklog(&ins.getInstance(), &backlog, transfers.data(), transfers.size()));
+    REQUIRE(1 == backlog.oom_count);
+    ins.getAllocator().setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    for (std::uint8_t i = 0; i < 4; i++)
+    {
+        REQUIRE(1 == push(CanardPrioritySlow, 200, static_cast<CanardTransferID>(2U + i), 5'000U + i));
+    }
+    REQUIRE(4 == canardRxAcceptBacklog(&ins.getInstance(), &backlog, transfers.data(), transfers.size()));
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        REQUIRE(transfers.at(i).metadata.transfer_id == (2U + i));
+        ins.getAllocator().deallocate(transfers.at(i).payload);
+    }
+    REQUIRE(2 == backlog.eviction_count);
+    REQUIRE(1 == backlog.drop_count);
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 100));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 200));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 300));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("RxTimerWheel")
+{
+    using helpers::Instance;
+
+    Instance           ins;
+    CanardRxTransfer   transfer{};
+    CanardRxTimerWheel wheel{};
+
+    const auto accept = [&](const CanardPortID               subject_id,
+                            const CanardNodeID               source_node_id,
+                            const CanardMicrosecond          timestamp_usec,
+                            const std::vector<std::uint8_t>& payload) {
+        CanardFrame frame{};
+        frame.extended_can_id = 0b001'00'0'11'0000000000000'0'0000000U |
+                                static_cast<std::uint32_t>((subject_id << 8U) | source_node_id);
+        frame.payload_size    = std::size(payload);
+        frame.payload         = payload.data();
+        const auto out        = ins.rxAccept(timestamp_usec, frame, 0, transfer, nullptr);
+        if (out > 0)
+        {
+            ins.getAllocator().deallocate(transfer.payload);
+        }
+        return out;
+    };
+
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxExpire(&ins.getInstance(), 0));  // No wheel yet.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxExpire(nullptr, 0));
+    CanardMicrosecond next = 0;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetNextExpiration(&ins.getInstance(), &next));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetTimerWheel(nullptr, &wheel, 1'000));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetTimerWheel(&ins.getInstance(), &wheel, 0));
+    REQUIRE(nullptr == ins.getInstance().rx_timer_wheel);
+    REQUIRE(0 == canardRxSetTimerWheel(&ins.getInstance(), &wheel, 1'000));
+    REQUIRE(&wheel == ins.getInstance().rx_timer_wheel);
+    REQUIRE(1'000 == wheel.tick_usec);
+    REQUIRE(0 == ins.rxExpire(100'000'000));  // Nothing to do; the idle ticks are skipped.
+    REQUIRE(100'000 == wheel.current_tick);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetNextExpiration(nullptr, &next));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxGetNextExpiration(&ins.getInstance(), nullptr));
+    REQUIRE(0 == canardRxGetNextExpiration(&ins.getInstance(), &next));  // No sessions, nothing to wait for.
+
+    CanardRxSubscription sub{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, sub));
+    // The kind of sessions cannot be changed while there are subscriptions.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetTimerWheel(&ins.getInstance(), nullptr, 0));
+    REQUIRE(&wheel == ins.getInstance().rx_timer_wheel);
+
+    // The session expires strictly after the transfer-ID timeout; the resolution is one tick.
+    REQUIRE(1 == accept(1000, 39, 100'000'000, {0b111'00000}));
+    REQUIRE(nullptr != sub.sessions[39]);
+    REQUIRE(1 == wheel.session_count);
+    REQUIRE(1 == canardRxGetNextExpiration(&ins.getInstance(), &next));
+    REQUIRE(next > 100'000'000);
+    REQUIRE(next <= 101'001'000);  // May be earlier than the actual expiration if the session is on an upper level.
+    REQUIRE(0 == ins.rxExpire(101'000'000));
+    REQUIRE(0 == ins.rxExpire(101'000'999));
+    REQUIRE(nullptr != sub.sessions[39]);
+
+    // A transfer in progress holds a payload buffer, which is released along with the session.
+    REQUIRE(0 == accept(1000, 40, 100'500'000, {1, 2, 3, 4, 5, 6, 7, 0b101'00000}));
+    REQUIRE(2 == wheel.session_count);
+    REQUIRE(3 == ins.getAllocator().getNumAllocatedFragments());  // Two sessions and one payload buffer.
+    REQUIRE(1 == ins.rxExpire(101'001'000));
+    REQUIRE(nullptr == sub.sessions[39]);
+    REQUIRE(nullptr != sub.sessions[40]);
+    REQUIRE(1 == wheel.session_count);
+    REQUIRE(2 == ins.getAllocator().getNumAllocatedFragments());
+
+    // A new transfer pushes the deadline forward; a frame that does not start a transfer does not.
+    REQUIRE(1 == accept(1000, 40, 101'400'000, {0b111'00001}));
+    REQUIRE(1 == ins.getAllocator().getNumAllocatedFragments());
+    REQUIRE(0 == accept(1000, 40, 101'500'000, {0b011'00001}));  // Not a start of transfer, rejected.
+    REQUIRE(0 == ins.rxExpire(102'400'000));
+    REQUIRE(nullptr != sub.sessions[40]);
+    REQUIRE(1 == canardRxGetNextExpiration(&ins.getInstance(), &next));
+    REQUIRE(102'401'000 == next);  // The session is on the lowest level now, so the time is exact.
+    REQUIRE(1 == ins.rxExpire(102'401'000));
+    REQUIRE(nullptr == sub.sessions[40]);
+    REQUIRE(0 == wheel.session_count);
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+
+    // The session is re-created by the next transfer from the same node.
+    REQUIRE(1 == accept(1000, 39, 102'500'000, {0b111'00000}));
+    REQUIRE(nullptr != sub.sessions[39]);
+    REQUIRE(1 == wheel.session_count);
+
+    // A session that has timed out already when it is updated is destroyed once the time advances.
+    REQUIRE(1 == accept(1000, 41, 50'000'000, {0b111'00000}));
+    REQUIRE(0 == ins.rxExpire(102'401'000));
+    REQUIRE(1 == ins.rxExpire(102'402'000));
+    REQUIRE(nullptr == sub.sessions[41]);
+    REQUIRE(nullptr != sub.sessions[39]);
+
+    // The deadlines that are beyond the reach of the wheel are kept in the overflow list.
+    CanardRxSubscription sub_long{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1001, 16, 3'600'000'000, sub_long));
+    REQUIRE(1 == accept(1001, 39, 103'000'000, {0b111'00000}));
+    REQUIRE(nullptr != wheel.overflow);
+    REQUIRE(1 == ins.rxExpire(110'000'000));  // Only the short one.
+    REQUIRE(nullptr == sub.sessions[39]);
+    // An event loop that sleeps until the reported time needs only a few wake-ups to reach the far deadline.
+    std::uint32_t wakeups = 0;
+    while (1 == canardRxGetNextExpiration(&ins.getInstance(), &next))
+    {
+        REQUIRE(next > (wheel.current_tick * wheel.tick_usec));
+        REQUIRE(next <= 3'703'001'000);
+        REQUIRE(nullptr != sub_long.sessions[39]);
+        wakeups++;
+        REQUIRE(((next == 3'703'001'000) ? 1 : 0) == ins.rxExpire(next));
+        REQUIRE(((next >= 3'702'784'000) || (nullptr != wheel.overflow)));  // Came within reach at the wrap-around.
+    }
+    REQUIRE(nullptr == sub_long.sessions[39]);
+    REQUIRE(nullptr == wheel.overflow);
+    REQUIRE(wakeups <= (CANARD_RX_TIMER_WHEEL_LEVELS + 1U));
+    REQUIRE(0 == wheel.session_count);
+
+    // Unsubscription removes the sessions from the wheel.
+    REQUIRE(1 == accept(1000, 1, 3'800'000'000, {0b111'00000}));
+    REQUIRE(1 == accept(1000, 2, 3'800'000'000, {0b111'00000}));
+    REQUIRE(1 == accept(1001, 3, 3'800'000'000, {0b111'00000}));
+    REQUIRE(3 == wheel.session_count);
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(1 == wheel.session_count);
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1001));
+    REQUIRE(0 == wheel.session_count);
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+    REQUIRE(std::all_of(std::begin(wheel.occupancy), std::end(wheel.occupancy), [](auto x) { return x == 0; }));
+    REQUIRE(nullptr == wheel.overflow);
+    REQUIRE(0 == ins.rxExpire(10'000'000'000));
+
+    // The wheel can be removed once there are no subscriptions.
+    REQUIRE(0 == canardRxSetTimerWheel(&ins.getInstance(), nullptr, 0));
+    REQUIRE(nullptr == ins.getInstance().rx_timer_wheel);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == ins.rxExpire(10'000'000'000));
+}
+
+TEST_CASE("RxTimerWheelRandomized")
+{
+    using helpers::Instance;
+    using helpers::getRandomNatural;
+
+    constexpr CanardMicrosecond                   Tick = 1'000;
+    static const std::array<CanardMicrosecond, 3> Timeouts{{250'000, 2'000'000, 40'000'000}};  // The last overflows.
+
+    Instance                                                         ins;
+    CanardRxTimerWheel                                               wheel{};
+    std::array<CanardRxSubscription, 3>                              subs{};
+    std::array<std::array<std::optional<CanardMicrosecond>, 128>, 3> model{};  // Timestamp of the last transfer.
+    std::array<std::array<CanardTransferID, 128>, 3>                 transfer_ids{};
+    REQUIRE(0 == canardRxSetTimerWheel(&ins.getInstance(), &wheel, Tick));
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage,
+                                     static_cast<CanardPortID>(i),
+                                     8,
+                                     Timeouts.at(i),
+                                     subs.at(i)));
+    }
+
+    CanardMicrosecond now = 1'000'000'000;
+    for (std::uint32_t iteration = 0U; iteration < 20'000U; iteration++)
+    {
+        if (getRandomNatural(100U) == 0U)
+        {
+            now += getRandomNatural<CanardMicrosecond>(100'000'000U);  // A long pause.
+        }
+        else
+        {
+            now += getRandomNatural<CanardMicrosecond>(10'000U);
+        }
+        if (getRandomNatural(10U) != 0U)
+        {
+            const auto         sub_index = getRandomNatural<std::size_t>(subs.size());
+            const auto         node_id   = getRandomNatural<std::uint8_t>(128U);
+            CanardTransferID&  tid       = transfer_ids.at(sub_index).at(node_id);
+            const std::uint8_t tail      = static_cast<std::uint8_t>(0b111'00000U | tid);
+            CanardFrame        frame{};
+            CanardRxTransfer   transfer{};
+            frame.extended_can_id =
+                0b001'00'0'11'0000000000000'0'0000000U | static_cast<std::uint32_t>((sub_index << 8U) | node_id);
+            frame.payload_size    = 1;
+            frame.payload         = &tail;
+            REQUIRE(1 == ins.rxAccept(now, frame, 0, transfer, nullptr));
+            ins.getAllocator().deallocate(transfer.payload);
+            tid                             = static_cast<CanardTransferID>((tid + 1U) % 32U);
+            model.at(sub_index).at(node_id) = now;
+        }
+        else
+        {
+            std::int32_t expected = 0;
+            for (std::size_t i = 0; i < subs.size(); i++)
+            {
+                for (auto& ts : model.at(i))
+                {
+                    if (ts && (((*ts + Timeouts.at(i)) / Tick) < (now / Tick)))
+                    {
+                        ts.reset();
+                        expected++;
+                    }
+                }
+            }
+            REQUIRE(expected == ins.rxExpire(now));
+        }
+        std::size_t count = 0;
+        bool        match = true;
+        for (std::size_t i = 0; i < subs.size(); i++)
+        {
+            for (std::size_t k = 0; k < model.at(i).size(); k++)
+            {
+                match = match && (model.at(i).at(k).has_value() == (subs.at(i).sessions[k] != nullptr));
+                count += model.at(i).at(k).has_value() ? 1U : 0U;
+            }
+        }
+        REQUIRE(match);
+        REQUIRE(count == wheel.session_count);
+        // The next expiration time reported for the event loop never lags behind the earliest actual expiration.
+        std::optional<CanardMicrosecond> earliest;
+        for (std::size_t i = 0; i < subs.size(); i++)
+        {
+            for (const auto& ts : model.at(i))
+            {
+                if (ts)
+                {
+                    const CanardMicrosecond t = (((*ts + Timeouts.at(i)) / Tick) + 1U) * Tick;
+                    earliest                  = earliest ? std::min(*earliest, t) : t;
+                }
+            }
+        }
+        CanardMicrosecond next = 0;
+        REQUIRE((earliest ? 1 : 0) == canardRxGetNextExpiration(&ins.getInstance(), &next));
+        REQUIRE((!earliest || (next <= *earliest)));
+        REQUIRE(count == ins.getAllocator().getNumAllocatedFragments());
+    }
+    for (std::size_t i = 0; i < subs.size(); i++)
+    {
+        REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, static_cast<CanardPortID>(i)));
+    }
+    REQUIRE(0 == wheel.session_count);
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
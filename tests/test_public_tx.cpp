@@ -4,7 +4,20 @@
 #include "exposed.hpp"
 #include "helpers.hpp"
 #include "catch.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(CANARD_CACHE_LINE_ALIGNED) && (CANARD_CACHE_LINE_ALIGNED != 0)
+static_assert(alignof(CanardInstance) == CANARD_CACHE_LINE_SIZE, "");
+static_assert(alignof(CanardTxQueue) == CANARD_CACHE_LINE_SIZE, "");
+static_assert(alignof(CanardRxSubscription) == CANARD_CACHE_LINE_SIZE, "");
+static_assert((sizeof(CanardInstance) % CANARD_CACHE_LINE_SIZE) == 0, "");
+static_assert((sizeof(CanardTxQueue) % CANARD_CACHE_LINE_SIZE) == 0, "");
+static_assert((sizeof(CanardRxSubscription) % CANARD_CACHE_LINE_SIZE) == 0, "");
+#endif
 
 TEST_CASE("TxBasic0")
 {
@@ -639,3 +652,445 @@ TEST_CASE("TxBasic1")
     REQUIRE(nullptr == canardTxPop(nullptr, nullptr));             // No effect.
     REQUIRE(nullptr == canardTxPop(&que.getInstance(), nullptr));  // No effect.
 }
+
+namespace
+{
+/// Checks that the queue of the specified kind behaves identically to the tree-based one.
+void testTxQueueKindEquivalence(const CanardTxQueueKind kind)
+{
+    helpers::Instance ins;
+    helpers::TxQueue  tree(1000, CANARD_MTU_CAN_CLASSIC, CanardTxQueueKindTree, true);
+    helpers::TxQueue  other(1000, CANARD_MTU_CAN_CLASSIC, kind, true);
+    REQUIRE(CanardTxQueueKindTree == tree.getInstance().kind);
+    REQUIRE(kind == other.getInstance().kind);
+    ins.setNodeID(42);
+
+    std::array<std::uint8_t, 64> payload{};
+    std::iota(payload.begin(), payload.end(), 0U);
+
+    // Both kinds must produce identical sequences of frames, including the FIFO order of frames with the same CAN ID.
+    CanardTransferMetadata meta{};
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    for (std::uint32_t i = 0; i < 5000; i++)
+    {
+        if ((other.getSize() < 900) && ((static_cast<std::uint32_t>(std::rand()) % 3U) != 0U))
+        {
+            meta.priority    = static_cast<CanardPriority>(static_cast<std::uint32_t>(std::rand()) % 8U);
+            meta.port_id     = static_cast<CanardPortID>(static_cast<std::uint32_t>(std::rand()) % 4U);
+            ins.setNodeID(static_cast<CanardNodeID>(static_cast<std::uint32_t>(std::rand()) % 128U));
+            meta.transfer_id = static_cast<CanardTransferID>(i % 32U);
+            const auto size  = static_cast<std::size_t>(std::rand()) % 20U;
+            const auto dl    = static_cast<CanardMicrosecond>(std::rand()) % 1000U;
+            const auto a     = tree.push(&ins.getInstance(), dl, meta, size, payload.data());
+            const auto b     = other.push(&ins.getInstance(), dl, meta, size, payload.data());
+            REQUIRE(a > 0);
+            REQUIRE(a == b);
+        }
+        else
+        {
+            const auto* const a = tree.peek();
+            const auto* const b = other.peek();
+            REQUIRE((a == nullptr) == (b == nullptr));
+            if (a != nullptr)
+            {
+                REQUIRE(a->frame.extended_can_id == b->frame.extended_can_id);
+                REQUIRE(a->tx_deadline_usec == b->tx_deadline_usec);
+                REQUIRE(a->frame.payload_size == b->frame.payload_size);
+                REQUIRE(0 == std::memcmp(a->frame.payload, b->frame.payload, a->frame.payload_size));
+                ins.getAllocator().deallocate(tree.pop(a));
+                ins.getAllocator().deallocate(other.pop(b));
+            }
+        }
+        REQUIRE(tree.getSize() == other.getSize());
+        // The deadline index works with all kinds and has the same FIFO tie-breaking, so the items are identical.
+        const auto* const ea = tree.peekEarliestDeadline();
+        const auto* const eb = other.peekEarliestDeadline();
+        REQUIRE((ea == nullptr) == (eb == nullptr));
+        if (ea != nullptr)
+        {
+            REQUIRE(ea->frame.extended_can_id == eb->frame.extended_can_id);
+            REQUIRE(ea->tx_deadline_usec == eb->tx_deadline_usec);
+            REQUIRE(ea->frame.payload_size == eb->frame.payload_size);
+        }
+    }
+
+    // Removal of arbitrary items, not only the top one, keeps the queue consistent.
+    {
+        const auto q = other.linearize();
+        REQUIRE(q.size() == other.getSize());
+        for (std::size_t i = 0; i < q.size(); i += 2U)
+        {
+            ins.getAllocator().deallocate(canardTxPop(&other.getInstance(), q.at(i)));
+            REQUIRE(other.getSize() == (q.size() - (i / 2U) - 1U));  // Also validates the structure.
+        }
+    }
+    while (const auto* const ti = other.peek())
+    {
+        ins.getAllocator().deallocate(other.pop(ti));
+    }
+    while (const auto* const ti = tree.peek())
+    {
+        ins.getAllocator().deallocate(tree.pop(ti));
+    }
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+}  // namespace
+
+TEST_CASE("TxHeap")
+{
+    testTxQueueKindEquivalence(CanardTxQueueKindHeap);
+}
+
+TEST_CASE("TxHeapCapacity")
+{
+    helpers::Instance            ins;
+    std::array<std::uint8_t, 64> payload{};
+    CanardTransferMetadata       meta{};
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    ins.setNodeID(42);
+
+    // The capacity is limited by the length of the heap storage.
+    std::array<CanardTxQueueItem*, 3> storage{};
+    CanardTxQueue que = canardTxInitHeap(100, CANARD_MTU_CAN_CLASSIC, storage.data(), storage.size());
+    REQUIRE(CanardTxQueueKindHeap == que.kind);
+    REQUIRE(100 == que.capacity);
+    REQUIRE(3 == que.heap_length);
+    REQUIRE(2 == canardTxPush(&que, &ins.getInstance(), 0, &meta, 8, payload.data()));
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardTxPush(&que, &ins.getInstance(), 0, &meta, 8, payload.data()));
+    REQUIRE(1 == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(3 == que.size);
+    REQUIRE(3 == ins.getAllocator().getNumAllocatedFragments());
+    // The regular capacity limit applies as well.
+    que.capacity = 2;
+    while (const CanardTxQueueItem* const ti = canardTxPeek(&que))
+    {
+        ins.getAllocator().deallocate(canardTxPop(&que, ti));
+    }
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardTxPush(&que, &ins.getInstance(), 0, &meta, 20, payload.data()));
+    REQUIRE(0 == que.size);
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+
+    // Without storage the queue cannot accept anything.
+    que = canardTxInitHeap(100, CANARD_MTU_CAN_CLASSIC, nullptr, 10);
+    REQUIRE(CanardTxQueueKindHeap == que.kind);
+    REQUIRE(0 == que.heap_length);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(nullptr == canardTxPeek(&que));
+    REQUIRE(nullptr == canardTxPop(&que, nullptr));
+}
+
+TEST_CASE("TxBitmap")
+{
+    testTxQueueKindEquivalence(CanardTxQueueKindBitmap);
+}
+
+TEST_CASE("TxBitmapCapacity")
+{
+    helpers::Instance            ins;
+    std::array<std::uint8_t, 64> payload{};
+    CanardTransferMetadata       meta{};
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    ins.setNodeID(42);
+
+    // One CAN ID takes a full path of 6 nodes; the frames sharing the same CAN ID take no extra nodes.
+    std::array<CanardTxBitmapNode, 7> nodes{};
+    CanardTxQueue que = canardTxInitBitmap(100, CANARD_MTU_CAN_CLASSIC, nodes.data(), nodes.size());
+    REQUIRE(CanardTxQueueKindBitmap == que.kind);
+    REQUIRE(7 == que.bitmap_free_count);
+    REQUIRE(nullptr == que.bitmap_root);
+    meta.port_id = 1000;
+    REQUIRE(2 == canardTxPush(&que, &ins.getInstance(), 0, &meta, 8, payload.data()));
+    REQUIRE(1 == que.bitmap_free_count);
+    REQUIRE(1 == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(1 == que.bitmap_free_count);
+    // A CAN ID that differs only in the lowest 5 bits shares all nodes.
+    ins.setNodeID(43);
+    REQUIRE(1 == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(1 == que.bitmap_free_count);
+    // A CAN ID that differs in the 6-th bit needs one more node, which is available.
+    ins.setNodeID(42 + 32);
+    REQUIRE(1 == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(0 == que.bitmap_free_count);
+    // A CAN ID that differs in the priority needs 5 nodes, which are not available.
+    meta.priority = CanardPriorityOptional;
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardTxPush(&que, &ins.getInstance(), 0, &meta, 20, payload.data()));
+    REQUIRE(5 == que.size);
+    REQUIRE(5 == ins.getAllocator().getNumAllocatedFragments());
+    // Frames with the same CAN ID come out in the FIFO order; the frames with the lower node-ID go first.
+    std::array<std::uint8_t, 5> order{};
+    for (auto& x : order)
+    {
+        const CanardTxQueueItem* const ti = canardTxPeek(&que);
+        REQUIRE(nullptr != ti);
+        x = static_cast<std::uint8_t>(ti->frame.extended_can_id & CANARD_NODE_ID_MAX);
+        ins.getAllocator().deallocate(canardTxPop(&que, ti));
+    }
+    REQUIRE(order == std::array<std::uint8_t, 5>{{42, 42, 42, 43, 74}});
+    REQUIRE(nullptr == canardTxPeek(&que));
+    REQUIRE(nullptr == que.bitmap_root);
+    REQUIRE(7 == que.bitmap_free_count);
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+    // Now that the nodes are released, the optional priority is accepted.
+    REQUIRE(1 == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(1 == que.bitmap_free_count);
+    ins.getAllocator().deallocate(canardTxPop(&que, canardTxPeek(&que)));
+    REQUIRE(7 == que.bitmap_free_count);
+
+    // Without storage the queue cannot accept anything.
+    que = canardTxInitBitmap(100, CANARD_MTU_CAN_CLASSIC, nullptr, 10);
+    REQUIRE(CanardTxQueueKindBitmap == que.kind);
+    REQUIRE(0 == que.bitmap_free_count);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardTxPush(&que, &ins.getInstance(), 0, &meta, 1, payload.data()));
+    REQUIRE(nullptr == canardTxPeek(&que));
+    REQUIRE(nullptr == canardTxPop(&que, nullptr));
+}
+
+TEST_CASE("TxDeadline")
+{
+    helpers::Instance            ins;
+    helpers::TxQueue             que(100, CANARD_MTU_CAN_CLASSIC, CanardTxQueueKindBitmap, true);
+    std::array<std::uint8_t, 64> payload{};
+    CanardTransferMetadata       meta{};
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    ins.setNodeID(42);
+
+    REQUIRE(nullptr == canardTxPeekEarliestDeadline(nullptr));
+    REQUIRE(nullptr == que.peekEarliestDeadline());
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxSetDeadlineIndex(nullptr, true));
+
+    // The transmission order is unrelated to the deadline order.
+    meta.priority = CanardPriorityExceptional;
+    REQUIRE(1 == que.push(&ins.getInstance(), 3'000, meta, 1, payload.data()));
+    REQUIRE(3'000 == que.peekEarliestDeadline()->tx_deadline_usec);
+    meta.priority = CanardPriorityOptional;
+    REQUIRE(1 == que.push(&ins.getInstance(), 1'000, meta, 1, payload.data()));
+    REQUIRE(1'000 == que.peekEarliestDeadline()->tx_deadline_usec);
+    meta.priority = CanardPriorityNominal;
+    meta.port_id  = 1;
+    REQUIRE(2 == que.push(&ins.getInstance(), 1'000, meta, 8, payload.data()));  // Same deadline, enqueued later.
+    meta.port_id = 2;
+    REQUIRE(1 == que.push(&ins.getInstance(), 2'000, meta, 1, payload.data()));
+    REQUIRE(5 == que.getSize());
+    REQUIRE(CanardPriorityExceptional == (que.peek()->frame.extended_can_id >> 26U));
+
+    // Items with identical deadlines are reported in the FIFO order.
+    const auto* ti = que.peekEarliestDeadline();
+    REQUIRE(1'000 == ti->tx_deadline_usec);
+    REQUIRE(CanardPriorityOptional == (ti->frame.extended_can_id >> 26U));
+
+    // The application drops the expired frames regardless of their position in the transmission order.
+    ins.getAllocator().deallocate(canardTxPop(&que.getInstance(), ti));
+    ti = que.peekEarliestDeadline();
+    REQUIRE(1'000 == ti->tx_deadline_usec);
+    REQUIRE(1U == (ti->frame.extended_can_id >> 8U) % 8192U);
+    REQUIRE(8 == ti->frame.payload_size);  // The first frame of the multi-frame transfer.
+    ins.getAllocator().deallocate(canardTxPop(&que.getInstance(), ti));
+    ti = que.peekEarliestDeadline();
+    REQUIRE(1'000 == ti->tx_deadline_usec);
+    REQUIRE(4 == ti->frame.payload_size);
+    ins.getAllocator().deallocate(canardTxPop(&que.getInstance(), ti));
+    REQUIRE(2'000 == que.peekEarliestDeadline()->tx_deadline_usec);
+    REQUIRE(2 == que.getSize());
+
+    // The setting cannot be changed while the queue is not empty.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxSetDeadlineIndex(&que.getInstance(), false));
+    REQUIRE(que.getInstance().deadline_index);
+
+    // Popping the next frame to transmit updates the deadline index as well.
+    ins.getAllocator().deallocate(que.pop(que.peek()));
+    REQUIRE(2'000 == que.peekEarliestDeadline()->tx_deadline_usec);
+    ins.getAllocator().deallocate(que.pop(que.peek()));
+    REQUIRE(nullptr == que.peekEarliestDeadline());
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+
+    // The frames of a queue with the deadline index carry the index node; those of a queue without it do not.
+    meta.port_id = 3;
+    REQUIRE(1 == que.push(&ins.getInstance(), 1'000, meta, 7, payload.data()));
+    const auto with_index = ins.getAllocator().getTotalAllocatedAmount();
+    ins.getAllocator().deallocate(que.pop(que.peek()));
+    REQUIRE(0 == canardTxSetDeadlineIndex(&que.getInstance(), false));
+    REQUIRE(!que.getInstance().deadline_index);
+    REQUIRE(1 == que.push(&ins.getInstance(), 1'000, meta, 7, payload.data()));
+    REQUIRE(nullptr == que.peekEarliestDeadline());
+    REQUIRE(nullptr == que.getInstance().deadline_root);
+    REQUIRE((with_index - ins.getAllocator().getTotalAllocatedAmount()) >= (sizeof(CanardTreeNode) + sizeof(void*)));
+    ins.getAllocator().deallocate(que.pop(que.peek()));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("TxSlots")
+{
+    helpers::Instance           ins;
+    helpers::TxQueue            que(3, CANARD_MTU_CAN_CLASSIC);
+    std::array<CanardTxSlot, 4> slots{};
+    CanardTxSlotPool            pool{};
+    ins.setNodeID(42);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxSlotPoolInit(nullptr, slots.data(), slots.size(), CANARD_MTU_CAN_CLASSIC));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxSlotPoolInit(&pool, nullptr, slots.size(), CANARD_MTU_CAN_CLASSIC));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxSlotPoolInit(&pool, slots.data(), 0, CANARD_MTU_CAN_CLASSIC));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxSlotPoolInit(&pool, slots.data(), 6, CANARD_MTU_CAN_CLASSIC));
+    REQUIRE(0 == canardTxSlotPoolInit(&pool, slots.data(), slots.size(), CANARD_MTU_CAN_CLASSIC));
+    REQUIRE(nullptr == canardTxSlotClaim(nullptr, 1));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxSlotCommit(nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushSlots(nullptr, &ins.getInstance(), &pool));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushSlots(&que.getInstance(), nullptr, &pool));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushSlots(&que.getInstance(), &ins.getInstance(), nullptr));
+    REQUIRE(0 == canardTxPushSlots(&que.getInstance(), &ins.getInstance(), &pool));
+
+    // The producers and the consumer do not share cache lines.
+    REQUIRE((offsetof(CanardTxSlotPool, tail) - offsetof(CanardTxSlotPool, payload_capacity)) >=
+            CANARD_CACHE_LINE_SIZE);
+    REQUIRE((offsetof(CanardTxSlotPool, head) - offsetof(CanardTxSlotPool, overrun_count)) >= CANARD_CACHE_LINE_SIZE);
+
+    const auto claim = [&pool](const CanardPortID port_id, const std::size_t payload_size) {
+        CanardTxSlot* const slot = canardTxSlotClaim(&pool, payload_size);
+        if (slot != nullptr)
+        {
+            REQUIRE(payload_size == slot->payload_size);
+            slot->tx_deadline_usec        = 1'000U + port_id;
+            slot->metadata.priority       = CanardPriorityNominal;
+            slot->metadata.transfer_kind  = CanardTransferKindMessage;
+            slot->metadata.port_id        = port_id;
+            slot->metadata.remote_node_id = CANARD_NODE_ID_UNSET;
+            slot->metadata.transfer_id    = 0;
+            std::fill(std::begin(slot->payload), std::end(slot->payload), static_cast<std::uint8_t>(port_id));
+        }
+        return slot;
+    };
+
+    // A slot that is claimed but not yet committed holds up the ones claimed after it.
+    CanardTxSlot* const first = claim(1, 7);
+    REQUIRE(first == &slots.at(0));
+    REQUIRE(0 == canardTxSlotCommit(claim(2, 7)));
+    REQUIRE(0 == canardTxPushSlots(&que.getInstance(), &ins.getInstance(), &pool));
+    REQUIRE(0 == que.getSize());
+    REQUIRE(0 == canardTxSlotCommit(first));
+
+    // A transfer that would take more than one frame with Classic CAN is rejected without claiming a slot.
+    REQUIRE(nullptr == claim(3, 8));
+    REQUIRE(0 == pool.overrun_count);
+    REQUIRE(claim(3, 7) == &slots.at(2));
+    REQUIRE(claim(4, 1) == &slots.at(3));
+    REQUIRE(nullptr == claim(5, 0));
+    REQUIRE(1 == pool.overrun_count);
+    REQUIRE(0 == canardTxSlotCommit(&slots.at(2)));
+    REQUIRE(0 == canardTxSlotCommit(&slots.at(3)));
+
+    // The queue can take three frames only; the transfer that does not fit stays in its slot,
+    // and the frames pushed before it are still reported.
+    REQUIRE(3 == canardTxPushSlots(&que.getInstance(), &ins.getInstance(), &pool));
+    REQUIRE(3 == que.getSize());
+    REQUIRE(0 == canardTxPushSlots(&que.getInstance(), &ins.getInstance(), &pool));
+    REQUIRE(3 == que.getSize());
+    REQUIRE(0 == pool.drop_count);
+    // The released slots can be claimed again while the retained ones cannot.
+    REQUIRE(claim(5, 1) == &slots.at(0));
+    CanardTxSlot* const invalid = claim(6, 7);
+    REQUIRE(invalid == &slots.at(1));
+    invalid->payload_size = 8;  // No longer fits into a single frame.
+    REQUIRE(claim(7, 2) == &slots.at(2));
+    REQUIRE(nullptr == claim(8, 0));
+    REQUIRE(2 == pool.overrun_count);
+    REQUIRE(0 == canardTxSlotCommit(&slots.at(0)));
+    REQUIRE(0 == canardTxSlotCommit(invalid));
+
+    // The transfers are pushed in the order of claiming.
+    const auto drain = [&] {
+        std::vector<CanardPortID> out;
+        while (const auto* const item = que.peek())
+        {
+            REQUIRE((1'000U + ((item->frame.extended_can_id >> 8U) % 8192U)) == item->tx_deadline_usec);
+            out.push_back(static_cast<CanardPortID>((item->frame.extended_can_id >> 8U) % 8192U));
+            ins.getAllocator().deallocate(que.pop(item));
+        }
+        return out;
+    };
+    REQUIRE(drain() == std::vector<CanardPortID>{1, 2, 3});
+    // The invalid transfer is dropped rather than retained, so it does not hold up the pool.
+    REQUIRE(2 == canardTxPushSlots(&que.getInstance(), &ins.getInstance(), &pool));
+    REQUIRE(1 == pool.drop_count);
+    REQUIRE(0 == canardTxSlotCommit(&slots.at(2)));
+    REQUIRE(1 == canardTxPushSlots(&que.getInstance(), &ins.getInstance(), &pool));
+    REQUIRE(drain() == std::vector<CanardPortID>{4, 5, 7});
+    REQUIRE(0 == canardTxPushSlots(&que.getInstance(), &ins.getInstance(), &pool));
+    REQUIRE(1 == pool.drop_count);
+    REQUIRE(claim(9, 0) == &slots.at(3));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("TxSlotsConcurrent")
+{
+    // Several producers stand in for interrupt handlers; every transfer shall be enqueued exactly once,
+    // and the transfers of each producer shall be enqueued in the order of publication.
+    constexpr std::size_t       NumProducers = 3;
+    constexpr std::size_t       NumTransfers = 10'000;  // Per producer.
+    helpers::Instance           ins;
+    helpers::TxQueue            que(100, CANARD_MTU_CAN_FD);
+    std::array<CanardTxSlot, 8> slots{};
+    CanardTxSlotPool            pool{};
+    std::atomic<std::size_t>    producers_running{NumProducers};
+    std::vector<std::thread>    producers;
+    ins.setNodeID(42);
+    REQUIRE(0 == canardTxSlotPoolInit(&pool, slots.data(), slots.size(), CANARD_MTU_CAN_FD));
+    for (std::size_t p = 0; p < NumProducers; p++)
+    {
+        producers.emplace_back([&, p] {
+            for (std::uint32_t i = 0; i < NumTransfers; i++)
+            {
+                CanardTxSlot* slot = canardTxSlotClaim(&pool, sizeof(i));
+                while (slot == nullptr)
+                {
+                    std::this_thread::yield();
+                    slot = canardTxSlotClaim(&pool, sizeof(i));
+                }
+                slot->tx_deadline_usec        = 0;
+                slot->metadata.priority       = CanardPriorityNominal;
+                slot->metadata.transfer_kind  = CanardTransferKindMessage;
+                slot->metadata.port_id        = static_cast<CanardPortID>(p);
+                slot->metadata.remote_node_id = CANARD_NODE_ID_UNSET;
+                slot->metadata.transfer_id    = static_cast<CanardTransferID>(i);
+                std::memcpy(&slot->payload[0], &i, sizeof(i));
+                (void) canardTxSlotCommit(slot);
+            }
+            producers_running--;
+        });
+    }
+
+    // The queue keeps frames with identical CAN ID in the FIFO order, so the sequence numbers shall be increasing.
+    std::array<std::uint32_t, NumProducers> next{};
+    bool                                    more = true;
+    while (more)
+    {
+        const bool last   = producers_running == 0U;
+        const auto result = canardTxPushSlots(&que.getInstance(), &ins.getInstance(), &pool);
+        REQUIRE(result >= 0);
+        REQUIRE(que.getSize() == static_cast<std::size_t>(result));
+        while (const auto* const item = que.peek())
+        {
+            const auto    port = (item->frame.extended_can_id >> 8U) % 8192U;
+            std::uint32_t seq  = 0;
+            std::memcpy(&seq, item->frame.payload, sizeof(seq));
+            REQUIRE(seq == next.at(port)++);
+            ins.getAllocator().deallocate(que.pop(item));
+        }
+        more = !(last && (result == 0));
+        if (result == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& th : producers)
+    {
+        th.join();
+    }
+    REQUIRE(std::all_of(next.begin(), next.end(), [](const std::uint32_t x) { return x == NumTransfers; }));
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
@@ -0,0 +1,449 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// The shared-memory bus is exercised both within one process, where every endpoint has a mapping of its own,
+// and across processes created with fork().
+
+#include "helpers.hpp"
+#include "shmcan.h"
+#include "catch.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+constexpr CanardPortID SubjectID = 1234;
+
+/// A bus with a name unique to the test process; it is removed when the test is finished.
+class BusName
+{
+public:
+    explicit BusName(const char* const suffix) : name_("/canard-test-" + std::to_string(getpid()) + "-" + suffix)
+    {
+        (void) shmcanUnlink(name_.c_str());
+    }
+    ~BusName() { (void) shmcanUnlink(name_.c_str()); }
+    BusName(const BusName&)                    = delete;
+    BusName(BusName&&)                         = delete;
+    auto operator=(const BusName&) -> BusName& = delete;
+    auto operator=(BusName&&) -> BusName&      = delete;
+
+    [[nodiscard]] auto c_str() const { return name_.c_str(); }
+
+private:
+    std::string name_;
+};
+
+/// Publishes the transfers carrying their transfer-ID in every payload byte.
+void publish(CanardInstance&      ins,
+             CanardTxQueue&       que,
+             const std::size_t    count,
+             const std::size_t    size,
+             const CanardPortID   port_id  = SubjectID,
+             const CanardPriority priority = CanardPriorityNominal)
+{
+    CanardTransferMetadata meta{};
+    meta.priority       = priority;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = port_id;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        meta.transfer_id = static_cast<CanardTransferID>(i % (CANARD_TRANSFER_ID_MAX + 1U));
+        const std::vector<std::uint8_t> payload(size, meta.transfer_id);
+        REQUIRE(0 < canardTxPush(&que, &ins, 0, &meta, payload.size(), payload.data()));
+    }
+}
+
+/// Passes the pending frames to the instance and returns the number of transfers that have been checked.
+auto receive(helpers::Instance& ins, ShmCAN& bus, std::size_t& next_transfer_id, const std::size_t size)
+    -> std::size_t
+{
+    std::size_t       out = 0;
+    CanardMicrosecond ts  = 0;
+    CanardFrame       frame{};
+    while (1 == shmcanPeek(&bus, &ts, &frame))
+    {
+        const auto* const begin = static_cast<const std::uint8_t*>(bus.bus);
+        const auto* const data  = static_cast<const std::uint8_t*>(frame.payload);
+        if (bus.reception == ShmCANReceptionLossless)
+        {
+            REQUIRE(data >= begin);  // Zero-copy: the payload is in the shared memory.
+            REQUIRE(data < (begin + bus.bus_size));
+        }
+        else
+        {
+            REQUIRE(data == &bus.rx_payload[0]);  // Copied out because it may be overwritten.
+        }
+        REQUIRE(ts > 0);
+        CanardRxTransfer transfer{};
+        if (1 == ins.rxAccept(ts, frame, 0, transfer, nullptr))
+        {
+            const auto tid = static_cast<CanardTransferID>(next_transfer_id % (CANARD_TRANSFER_ID_MAX + 1U));
+            REQUIRE(transfer.metadata.transfer_id == tid);
+            REQUIRE(transfer.payload_size == size);
+            const std::vector<std::uint8_t> expected(size, tid);
+            REQUIRE(0 == std::memcmp(transfer.payload, expected.data(), size));
+            ins.getAllocator().deallocate(transfer.payload);
+            next_transfer_id++;
+            out++;
+        }
+        shmcanPop(&bus);
+    }
+    return out;
+}
+}  // namespace
+
+TEST_CASE("ShmCANRoundtrip")
+{
+    const BusName     name("roundtrip");
+    helpers::Instance sender;
+    helpers::Instance receiver;
+    sender.getInstance().node_id = 42;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == receiver.rxSubscribe(CanardTransferKindMessage, SubjectID, 1000, 1'000'000, sub));
+    CanardTxQueue que = canardTxInit(10'000, CANARD_MTU_CAN_FD);
+    ShmCAN        a{};
+    ShmCAN        b{};
+    REQUIRE(0 == shmcanOpen(&a, name.c_str(), 16, ShmCANReceptionLossless));
+    REQUIRE(0 == shmcanOpen(&b, name.c_str(), 1024, ShmCANReceptionLossless));  // The existing capacity is kept.
+    REQUIRE(a.endpoint != b.endpoint);
+    REQUIRE(a.bus != b.bus);
+    REQUIRE(a.bus_size == b.bus_size);
+
+    // The ring is smaller than the batch, so the transmitter is held back by the lossless receivers. The sender
+    // receives too, which does not hold back the ring as long as it keeps polling, because its own frames are skipped.
+    constexpr std::size_t NumTransfers = 100;
+    publish(sender.getInstance(), que, NumTransfers, 313);
+    std::size_t       next_transfer_id = 0;
+    std::size_t       received         = 0;
+    bool              blocked          = false;
+    CanardMicrosecond ts               = 0;
+    CanardFrame       frame{};
+    while (que.size > 0)
+    {
+        const std::int32_t sent = shmcanTransmit(&a, &que, &sender.getInstance(), 0);
+        REQUIRE(sent >= 0);
+        REQUIRE(sent <= static_cast<std::int32_t>(SHMCAN_BATCH_SIZE));
+        blocked = blocked || ((sent < static_cast<std::int32_t>(SHMCAN_BATCH_SIZE)) && (que.size > 0));
+        REQUIRE(1 == shmcanWait(&b, 1'000'000));
+        received += receive(receiver, b, next_transfer_id, 313);
+        REQUIRE(0 == shmcanPeek(&a, &ts, &frame));
+    }
+    REQUIRE(0 == shmcanTransmit(&a, &que, &sender.getInstance(), 0));  // Flushes the mailbox.
+    received += receive(receiver, b, next_transfer_id, 313);
+    REQUIRE(blocked);
+    REQUIRE(received == NumTransfers);
+    REQUIRE(0 == a.drop_count);
+
+    REQUIRE(0 == shmcanPeek(&a, &ts, &frame));
+    REQUIRE(0 == shmcanWait(&a, 0));
+    REQUIRE(0 == shmcanWait(&b, 1'000));  // Times out.
+
+    shmcanClose(&a);
+    shmcanClose(&b);
+    REQUIRE(-1 == a.fd);
+    shmcanClose(&a);  // No effect.
+    REQUIRE(0 == sender.getAllocator().getNumAllocatedFragments());
+    REQUIRE(1 == receiver.rxUnsubscribe(CanardTransferKindMessage, SubjectID));
+    REQUIRE(0 == receiver.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("ShmCANArbitration")
+{
+    // When the ring is full, the frames wait in the mailboxes, and the one with the lowest CAN ID goes first.
+    // The ring can only be full if there is a lossless receiver.
+    const BusName     name("arbitration");
+    helpers::Instance ins_a;
+    helpers::Instance ins_b;
+    ins_a.getInstance().node_id = 10;
+    ins_b.getInstance().node_id = 20;
+    CanardTxQueue que_a         = canardTxInit(100, CANARD_MTU_CAN_CLASSIC);
+    CanardTxQueue que_b         = canardTxInit(100, CANARD_MTU_CAN_CLASSIC);
+    ShmCAN        a{};
+    ShmCAN        b{};
+    ShmCAN        c{};
+    REQUIRE(0 == shmcanOpen(&a, name.c_str(), 4, ShmCANReceptionNone));
+    REQUIRE(0 == shmcanOpen(&b, name.c_str(), 4, ShmCANReceptionNone));
+    REQUIRE(0 == shmcanOpen(&c, name.c_str(), 4, ShmCANReceptionLossless));
+    publish(ins_a.getInstance(), que_a, 6, 1, 100, CanardPrioritySlow);
+    publish(ins_b.getInstance(), que_b, 1, 1, 200, CanardPriorityHigh);
+    REQUIRE(5 == shmcanTransmit(&a, &que_a, &ins_a.getInstance(), 0));  // Four in the ring, one in the mailbox.
+    REQUIRE(1 == que_a.size);
+    REQUIRE(1 == shmcanTransmit(&b, &que_b, &ins_b.getInstance(), 0));  // In the mailbox.
+    REQUIRE(0 == shmcanTransmit(&a, &que_a, &ins_a.getInstance(), 0));  // Still full.
+
+    std::vector<std::uint32_t> ids;
+    const auto                 drain = [&]() {
+        CanardMicrosecond ts = 0;
+        CanardFrame       frame{};
+        while (1 == shmcanPeek(&c, &ts, &frame))
+        {
+            ids.push_back(frame.extended_can_id);
+            shmcanPop(&c);
+        }
+    };
+    CanardMicrosecond ts = 0;
+    CanardFrame       frame{};
+    REQUIRE(1 == shmcanPeek(&c, &ts, &frame));
+    ids.push_back(frame.extended_can_id);
+    shmcanPop(&c);
+    REQUIRE(0 == shmcanTransmit(&a, &que_a, &ins_a.getInstance(), 0));  // B wins the freed place.
+    drain();
+    REQUIRE(1 == shmcanTransmit(&a, &que_a, &ins_a.getInstance(), 0));  // Flushes the mailbox, then the last one.
+    drain();
+    REQUIRE(7 == ids.size());
+    REQUIRE(((ids.at(0) >> 8U) & CANARD_SUBJECT_ID_MAX) == 100U);
+    REQUIRE(((ids.at(4) >> 8U) & CANARD_SUBJECT_ID_MAX) == 200U);
+    for (const std::size_t i : {1U, 2U, 3U, 5U, 6U})
+    {
+        REQUIRE(((ids.at(i) >> 8U) & CANARD_SUBJECT_ID_MAX) == 100U);
+    }
+    REQUIRE(0 == que_a.size);
+    REQUIRE(0 == que_b.size);
+
+    // The expired frames are dropped.
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = SubjectID;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    REQUIRE(1 == canardTxPush(&que_a, &ins_a.getInstance(), 1'000, &meta, 0, nullptr));
+    REQUIRE(1 == shmcanTransmit(&a, &que_a, &ins_a.getInstance(), 2'000));
+    REQUIRE(1 == a.drop_count);
+    REQUIRE(0 == shmcanPeek(&c, &ts, &frame));
+
+    shmcanClose(&a);
+    shmcanClose(&b);
+    shmcanClose(&c);
+    REQUIRE(0 == ins_a.getAllocator().getNumAllocatedFragments());
+    REQUIRE(0 == ins_b.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("ShmCANOverrun")
+{
+    // A stopped receiver does not hold back the transmitters; it loses the oldest frames and counts them.
+    const BusName        name("overrun");
+    helpers::Instance    sender;
+    helpers::Instance    receiver;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == receiver.rxSubscribe(CanardTransferKindMessage, SubjectID, 1000, 1'000'000, sub));
+    sender.getInstance().node_id = 42;
+    CanardTxQueue que            = canardTxInit(100, CANARD_MTU_CAN_CLASSIC);
+    ShmCAN        a{};
+    ShmCAN        b{};
+    ShmCAN        c{};
+    REQUIRE(0 == shmcanOpen(&a, name.c_str(), 8, ShmCANReceptionNone));
+    REQUIRE(0 == shmcanOpen(&b, name.c_str(), 8, ShmCANReceptionOverrun));
+    publish(sender.getInstance(), que, 20, 1);
+    REQUIRE(20 == shmcanTransmit(&a, &que, &sender.getInstance(), 0));
+    std::size_t next_transfer_id = 12;  // The first 12 frames have been overwritten.
+    REQUIRE(8 == receive(receiver, b, next_transfer_id, 1));
+    REQUIRE(12 == b.overrun_count);
+
+    // A lossless receiver holds back the ring; the overrun receiver still does not.
+    REQUIRE(0 == shmcanOpen(&c, name.c_str(), 8, ShmCANReceptionLossless));
+    publish(sender.getInstance(), que, 20, 1, SubjectID + 1U);
+    REQUIRE(9 == shmcanTransmit(&a, &que, &sender.getInstance(), 0));  // Eight in the ring, one in the mailbox.
+    REQUIRE(0 == shmcanTransmit(&a, &que, &sender.getInstance(), 0));
+    CanardMicrosecond ts = 0;
+    CanardFrame       frame{};
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        REQUIRE(1 == shmcanPeek(&c, &ts, &frame));
+        shmcanPop(&c);
+    }
+    REQUIRE(0 == shmcanPeek(&c, &ts, &frame));
+    REQUIRE(0 == c.overrun_count);
+    REQUIRE(8 == shmcanTransmit(&a, &que, &sender.getInstance(), 0));
+    REQUIRE(3 == que.size);
+    b.overrun_count = 0;
+    REQUIRE(1 == shmcanPeek(&b, &ts, &frame));
+    REQUIRE(8 == b.overrun_count);  // Of the 16 frames committed since, only the last 8 are left.
+
+    shmcanClose(&a);
+    shmcanClose(&b);
+    shmcanClose(&c);
+    while (que.size > 0)
+    {
+        sender.getInstance().memory_free(&sender.getInstance(), canardTxPop(&que, canardTxPeek(&que)));
+    }
+    REQUIRE(0 == sender.getAllocator().getNumAllocatedFragments());
+    REQUIRE(1 == receiver.rxUnsubscribe(CanardTransferKindMessage, SubjectID));
+    REQUIRE(0 == receiver.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("ShmCANOverrunConcurrent")
+{
+    // The receiver reads while the transmitter overwrites the ring as fast as it can; every frame is either read
+    // intact or counted as lost.
+    const BusName name("overrun-concurrent");
+    ShmCAN        tx{};
+    ShmCAN        rx{};
+    REQUIRE(0 == shmcanOpen(&tx, name.c_str(), 4, ShmCANReceptionNone));
+    REQUIRE(0 == shmcanOpen(&rx, name.c_str(), 4, ShmCANReceptionOverrun));
+    constexpr std::size_t NumFrames = 100'000;
+    std::atomic<bool>     done{false};
+    std::thread           transmitter([&] {
+        helpers::Instance ins;
+        ins.getInstance().node_id = 42;
+        CanardTxQueue que         = canardTxInit(1, CANARD_MTU_CAN_FD);
+        for (std::size_t i = 0; i < NumFrames; i++)
+        {
+            CanardTransferMetadata meta{};
+            meta.priority       = CanardPriorityNominal;
+            meta.transfer_kind  = CanardTransferKindMessage;
+            meta.port_id        = SubjectID;
+            meta.remote_node_id = CANARD_NODE_ID_UNSET;
+            meta.transfer_id    = static_cast<CanardTransferID>(i % (CANARD_TRANSFER_ID_MAX + 1U));
+            const std::vector<std::uint8_t> payload(63, static_cast<std::uint8_t>(i));
+            (void) canardTxPush(&que, &ins.getInstance(), 0, &meta, payload.size(), payload.data());
+            (void) shmcanTransmit(&tx, &que, &ins.getInstance(), 0);
+        }
+        done = true;
+    });
+    std::size_t       received = 0;
+    std::size_t       torn     = 0;
+    CanardMicrosecond ts       = 0;
+    CanardFrame       frame{};
+    bool              more     = true;
+    while (more)
+    {
+        more = !done;
+        while (1 == shmcanPeek(&rx, &ts, &frame))
+        {
+            const auto* const data = static_cast<const std::uint8_t*>(frame.payload);
+            torn += ((frame.payload_size != 64U) || (std::count(data, data + 63, data[0]) != 63)) ? 1U : 0U;
+            received++;
+            shmcanPop(&rx);
+        }
+    }
+    transmitter.join();
+    REQUIRE(0 == torn);
+    REQUIRE(NumFrames == (received + rx.overrun_count));
+    shmcanClose(&tx);
+    shmcanClose(&rx);
+}
+
+TEST_CASE("ShmCANProcesses")
+{
+    const BusName        name("processes");
+    helpers::Instance    receiver;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == receiver.rxSubscribe(CanardTransferKindMessage, SubjectID, 1000, 1'000'000, sub));
+    ShmCAN bus{};
+    REQUIRE(0 == shmcanOpen(&bus, name.c_str(), 8, ShmCANReceptionLossless));
+
+    // A process that attaches as a lossless receiver and terminates without detaching would hold back the ring forever;
+    // its endpoint is reclaimed as soon as the ring fills up.
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+        ShmCAN zombie{};
+        _exit((0 == shmcanOpen(&zombie, name.c_str(), 8, ShmCANReceptionLossless)) ? 0 : 1);
+    }
+    int status = -1;
+    REQUIRE(pid == waitpid(pid, &status, 0));
+    REQUIRE(0 == status);
+
+    // Another process publishes the transfers; they are received here as they arrive.
+    constexpr std::size_t NumTransfers = 50;
+    pid                                = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+        helpers::Instance sender;
+        sender.getInstance().node_id = 42;
+        CanardTxQueue que            = canardTxInit(10'000, CANARD_MTU_CAN_CLASSIC);
+        ShmCAN        tx{};
+        bool          ok = 0 == shmcanOpen(&tx, name.c_str(), 8, ShmCANReceptionNone);
+        publish(sender.getInstance(), que, NumTransfers, 20);
+        for (std::size_t attempt = 0; ok && (attempt < 100'000) && (que.size > 0); attempt++)
+        {
+            ok = shmcanTransmit(&tx, &que, &sender.getInstance(), 0) >= 0;
+            (void) usleep(10);
+        }
+        ok = ok && (0 == que.size) && (0 == shmcanTransmit(&tx, &que, &sender.getInstance(), 0));
+        shmcanClose(&tx);
+        _exit(ok ? 0 : 1);
+    }
+    std::size_t next_transfer_id = 0;
+    std::size_t received         = 0;
+    for (std::size_t attempt = 0; (attempt < 10'000) && (received < NumTransfers); attempt++)
+    {
+        REQUIRE(0 <= shmcanWait(&bus, 1'000));
+        received += receive(receiver, bus, next_transfer_id, 20);
+    }
+    REQUIRE(pid == waitpid(pid, &status, 0));
+    REQUIRE(0 == status);
+    REQUIRE(received == NumTransfers);
+    shmcanClose(&bus);
+    REQUIRE(1 == receiver.rxUnsubscribe(CanardTransferKindMessage, SubjectID));
+    REQUIRE(0 == receiver.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("ShmCANErrors")
+{
+    const BusName     name("errors");
+    helpers::Instance ins;
+    CanardTxQueue     que = canardTxInit(100, CANARD_MTU_CAN_CLASSIC);
+    ShmCAN            bus{};
+    CanardMicrosecond ts = 0;
+    CanardFrame       frame{};
+    REQUIRE(-EINVAL == shmcanOpen(nullptr, name.c_str(), 8, ShmCANReceptionOverrun));
+    REQUIRE(-EINVAL == shmcanOpen(&bus, nullptr, 8, ShmCANReceptionOverrun));
+    REQUIRE(-EINVAL == shmcanOpen(&bus, name.c_str(), 0, ShmCANReceptionOverrun));
+    REQUIRE(-EINVAL == shmcanOpen(&bus, name.c_str(), 1, ShmCANReceptionOverrun));
+    REQUIRE(-EINVAL == shmcanOpen(&bus, name.c_str(), 12, ShmCANReceptionOverrun));
+    REQUIRE(-EINVAL == shmcanOpen(&bus, name.c_str(), 2'097'152, ShmCANReceptionOverrun));
+    REQUIRE(-EINVAL == shmcanOpen(&bus, name.c_str(), 8, static_cast<ShmCANReception>(3)));
+    REQUIRE(0 > shmcanOpen(&bus, "/no/slashes/inside", 8, ShmCANReceptionOverrun));
+    REQUIRE(-EINVAL == shmcanUnlink(nullptr));
+    REQUIRE(-ENOENT == shmcanUnlink(name.c_str()));
+    REQUIRE(-EINVAL == shmcanTransmit(nullptr, &que, &ins.getInstance(), 0));
+    REQUIRE(-EINVAL == shmcanTransmit(&bus, &que, &ins.getInstance(), 0));  // Not open.
+    REQUIRE(-EINVAL == shmcanPeek(nullptr, &ts, &frame));
+    REQUIRE(-EINVAL == shmcanPeek(&bus, &ts, &frame));
+    REQUIRE(-EINVAL == shmcanWait(nullptr, 0));
+    REQUIRE(-EINVAL == shmcanWait(&bus, 0));
+    shmcanPop(nullptr);    // No effect.
+    shmcanPop(&bus);       // No effect.
+    shmcanClose(nullptr);  // No effect.
+
+    // The endpoints run out.
+    std::vector<ShmCAN> endpoints(SHMCAN_ENDPOINT_MAX);
+    for (auto& ep : endpoints)
+    {
+        REQUIRE(0 == shmcanOpen(&ep, name.c_str(), 8, ShmCANReceptionOverrun));
+    }
+    REQUIRE(-ENOSPC == shmcanOpen(&bus, name.c_str(), 8, ShmCANReceptionOverrun));
+    REQUIRE(-EINVAL == shmcanTransmit(&endpoints.at(0), nullptr, &ins.getInstance(), 0));
+    REQUIRE(-EINVAL == shmcanTransmit(&endpoints.at(0), &que, nullptr, 0));
+    REQUIRE(-EINVAL == shmcanPeek(&endpoints.at(0), nullptr, &frame));
+    REQUIRE(-EINVAL == shmcanPeek(&endpoints.at(0), &ts, nullptr));
+    shmcanPop(&endpoints.at(0));  // Nothing to pop.
+    shmcanClose(&endpoints.at(0));
+    REQUIRE(0 == shmcanOpen(&bus, name.c_str(), 8, ShmCANReceptionOverrun));  // The endpoint is free again.
+    shmcanClose(&bus);
+    for (auto& ep : endpoints)
+    {
+        shmcanClose(&ep);
+    }
+    REQUIRE(0 == shmcanUnlink(name.c_str()));
+
+    // A shared-memory object that is not a bus is rejected.
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    REQUIRE(fd >= 0);
+    REQUIRE(0 == ftruncate(fd, 100'000));
+    REQUIRE(-EPROTO == shmcanOpen(&bus, name.c_str(), 8, ShmCANReceptionOverrun));
+    REQUIRE(-1 == bus.fd);
+    REQUIRE(0 == close(fd));
+}
@@ -0,0 +1,139 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+
+#include "simulator.hpp"
+#include "catch.hpp"
+#include <array>
+#include <vector>
+
+namespace
+{
+constexpr CanardPortID HeartbeatSubjectID = 7509;
+
+auto makeMessage(const CanardPortID port_id, const CanardPriority priority, const CanardTransferID transfer_id)
+    -> CanardTransferMetadata
+{
+    CanardTransferMetadata out{};
+    out.priority       = priority;
+    out.transfer_kind  = CanardTransferKindMessage;
+    out.port_id        = port_id;
+    out.remote_node_id = CANARD_NODE_ID_UNSET;
+    out.transfer_id    = transfer_id;
+    return out;
+}
+}  // namespace
+
+TEST_CASE("SimulatorArbitration")
+{
+    // Three nodes publish at the same time; the frames are transmitted back to back in the order of priority.
+    simulator::BusConfig config;
+    config.nominal_bit_rate = 500'000;
+    simulator::Bus bus(config);
+    auto&          low      = bus.addNode(10);
+    auto&          high     = bus.addNode(20);
+    auto&          nominal  = bus.addNode(30);
+    auto&          listener = bus.addNode(40);
+    listener.subscribe(CanardTransferKindMessage, 100, 100);
+    listener.subscribe(CanardTransferKindMessage, 200, 100);
+    listener.subscribe(CanardTransferKindMessage, 300, 100);
+    std::vector<std::pair<CanardPortID, CanardMicrosecond>> received;
+    listener.on_transfer = [&](const CanardRxTransfer& transfer) {
+        received.emplace_back(transfer.metadata.port_id, transfer.timestamp_usec);
+    };
+    const std::array<std::uint8_t, 3> payload{{1, 2, 3}};
+    bus.schedule(1'000'000, [&]() {
+        REQUIRE(1 == low.publish(makeMessage(100, CanardPriorityLow, 0), payload.size(), payload.data()));
+        REQUIRE(1 == nominal.publish(makeMessage(300, CanardPriorityNominal, 0), payload.size(), payload.data()));
+        REQUIRE(1 == high.publish(makeMessage(200, CanardPriorityHigh, 0), payload.size(), payload.data()));
+    });
+    bus.runUntil(2'000'000);
+    REQUIRE(bus.now() == 2'000'000);
+    REQUIRE(received.size() == 3);
+    REQUIRE(received.at(0).first == 200);
+    REQUIRE(received.at(1).first == 300);
+    REQUIRE(received.at(2).first == 100);
+    REQUIRE(bus.getStats().frames == 3);
+    REQUIRE(bus.getStats().arbitrations_contended == 2);  // The last frame has no contenders.
+    REQUIRE(bus.getStats().stuff_bits > 0);
+    // The frames occupy the bus back to back; at 500 kbit/s, each of these takes about 200 us.
+    // The reception timestamps are in microseconds while the publication time was 1 ms.
+    REQUIRE(received.at(0).second > 1'180);
+    REQUIRE(received.at(0).second < 1'240);
+    REQUIRE((received.at(2).second - 1'000U) * 1'000U == bus.getStats().busy_time);
+    REQUIRE(bus.getUtilization() == Approx(static_cast<double>(bus.getStats().busy_time) / 2e6));
+    REQUIRE(high.getStats().latency_max < nominal.getStats().latency_max);
+    REQUIRE(nominal.getStats().latency_max < low.getStats().latency_max);
+    REQUIRE(low.getStats().tx_transfers == 1);
+    REQUIRE(listener.getStats().rx_transfers == 3);
+    REQUIRE(low.getStats().memory_fragments == 0);  // The transmitted frames are freed.
+    REQUIRE(listener.getStats().memory_bytes_max > 0);
+
+    // The frames that expire while the bus is busy are dropped before they are transmitted.
+    const std::vector<std::uint8_t> large(500, 0xAA);
+    bus.schedule(3'000'000, [&]() {
+        REQUIRE(0 < high.publish(makeMessage(200, CanardPriorityHigh, 1), large.size(), large.data()));
+        REQUIRE(1 == low.publish(makeMessage(100, CanardPriorityLow, 1), payload.size(), payload.data(), 1'000'000));
+    });
+    bus.runUntil(100'000'000);
+    REQUIRE(low.getStats().tx_deadline_drops == 1);
+    REQUIRE(low.getStats().tx_transfers == 1);
+    REQUIRE(high.getStats().tx_transfers == 2);
+    REQUIRE(received.size() == 4);
+}
+
+TEST_CASE("SimulatorScale")
+{
+    // 127 nodes publish heartbeats once a second, staggered; every node receives the heartbeats of all others.
+    // The simulation is deterministic, so two runs produce identical results.
+    const auto run = [](const bool fd) {
+        simulator::BusConfig config;
+        config.fd = fd;
+        simulator::Bus bus(config);
+        for (CanardNodeID node_id = 1; node_id <= CANARD_NODE_ID_MAX; node_id++)
+        {
+            auto& node = bus.addNode(node_id);
+            node.subscribe(CanardTransferKindMessage, HeartbeatSubjectID, 7);
+            node.subscribe(CanardTransferKindMessage, 100, 1000);
+            for (std::uint64_t second = 0; second < 3; second++)
+            {
+                bus.schedule((second * 1'000'000'000U) + (node_id * 1'000U), [&node, second]() {
+                    const std::array<std::uint8_t, 7> heartbeat{};
+                    const auto meta = makeMessage(HeartbeatSubjectID,
+                                                  CanardPriorityNominal,
+                                                  static_cast<CanardTransferID>(second));
+                    REQUIRE(1 == node.publish(meta, heartbeat.size(), heartbeat.data()));
+                });
+            }
+        }
+        // One node also publishes a large transfer that competes with the heartbeats.
+        auto&                           talker = *bus.getNodes().at(0);
+        const std::vector<std::uint8_t> large(300, 0x55);
+        bus.schedule(500'000, [&]() {
+            REQUIRE(0 < talker.publish(makeMessage(100, CanardPrioritySlow, 0), large.size(), large.data()));
+        });
+        bus.runUntil(3'000'000'000U);
+        std::vector<std::uint64_t> out{bus.getStats().frames, bus.getStats().busy_time, bus.getStats().stuff_bits};
+        for (const auto& node : bus.getNodes())
+        {
+            const auto& stats = node->getStats();
+            REQUIRE(stats.rx_transfers == ((3U * (CANARD_NODE_ID_MAX - 1U)) + ((node.get() != &talker) ? 1U : 0U)));
+            REQUIRE(stats.tx_transfers == ((node.get() != &talker) ? 3U : 4U));
+            REQUIRE(stats.tx_push_failures == 0);
+            out.push_back(stats.latency_max);
+            out.push_back(stats.memory_bytes_max);
+        }
+        REQUIRE(bus.getBusLoadMeter().frame_count == bus.getStats().frames);
+        REQUIRE(bus.getBusLoadMeter().busy_nsec == bus.getStats().busy_time);
+        REQUIRE(bus.getBusLoadMeter().utilization_ppm_max > 0);
+        REQUIRE(bus.getBusLoadMeter().utilization_ppm_max < 100'000);
+        REQUIRE(bus.getUtilization() > 0.0);
+        REQUIRE(bus.getUtilization() < 0.1);
+        return out;
+    };
+    const auto classic = run(false);
+    REQUIRE(classic == run(false));
+    const auto fd = run(true);
+    REQUIRE(fd == run(true));
+    REQUIRE(fd.at(0) < classic.at(0));  // Fewer frames.
+    REQUIRE(fd.at(1) < classic.at(1));  // Less bus time.
+}
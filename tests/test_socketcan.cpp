@@ -0,0 +1,486 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 OpenCyphal Development Team.
+//
+// The SocketCAN adapter is exercised over a socketpair(AF_UNIX, SOCK_SEQPACKET), which preserves the message
+// boundaries like a raw CAN socket does, so the test does not depend on the availability of vcan in the build
+// environment. If vcan0 is available, the adapter is additionally tested against it.
+
+#include "helpers.hpp"
+#include "socketcan.h"
+#include "socketcan_uring.h"
+#include "catch.hpp"
+#include <cerrno>
+#include <cstring>
+#include <linux/can.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr CanardPortID SubjectID = 1234;
+
+class Bus
+{
+public:
+    explicit Bus(const bool can_fd)
+    {
+        std::array<int, 2> fds{};
+        REQUIRE(0 == socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0, fds.data()));
+        REQUIRE(0 == socketcanAttach(&tx, fds.at(0), can_fd));
+        REQUIRE(0 == socketcanAttach(&rx, fds.at(1), can_fd));
+    }
+    ~Bus()
+    {
+        socketcanClose(&tx, nullptr);
+        socketcanClose(&rx, nullptr);
+    }
+    Bus(const Bus&)                    = delete;
+    Bus(Bus&&)                         = delete;
+    auto operator=(const Bus&) -> Bus& = delete;
+    auto operator=(Bus&&) -> Bus&      = delete;
+
+    SocketCAN tx{};
+    SocketCAN rx{};
+};
+
+/// Publishes the transfers carrying their transfer-ID in every payload byte.
+void publish(helpers::Instance& ins, CanardTxQueue& que, const std::size_t count, const std::size_t size)
+{
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = SubjectID;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        meta.transfer_id = static_cast<CanardTransferID>(i % (CANARD_TRANSFER_ID_MAX + 1U));
+        const std::vector<std::uint8_t> payload(size, meta.transfer_id);
+        REQUIRE(0 < canardTxPush(&que, &ins.getInstance(), 0, &meta, payload.size(), payload.data()));
+    }
+}
+
+/// Passes the received frames to the instance and returns the number of transfers that have been checked.
+auto accept(helpers::Instance&             ins,
+            const CanardRxFrameSlot* const frames,
+            const std::size_t              count,
+            std::size_t&                   next_transfer_id,
+            const std::size_t              size) -> std::size_t
+{
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const CanardRxFrameSlot& slot = frames[i];
+        REQUIRE(slot.timestamp_usec > 0);
+        CanardFrame frame{};
+        frame.extended_can_id = slot.extended_can_id;
+        frame.payload_size    = slot.payload_size;
+        frame.payload         = &slot.payload[0];
+        CanardRxTransfer transfer{};
+        const auto       result = canardRxAccept(&ins.getInstance(),
+                                           1'000'000,
+                                           &frame,
+                                           slot.redundant_transport_index,
+                                           &transfer,
+                                           nullptr);
+        if (1 == result)
+        {
+            const auto tid = static_cast<CanardTransferID>(next_transfer_id % (CANARD_TRANSFER_ID_MAX + 1U));
+            REQUIRE(transfer.metadata.transfer_id == tid);
+            REQUIRE(transfer.payload_size == size);
+            const std::vector<std::uint8_t> expected(size, tid);
+            REQUIRE(0 == std::memcmp(transfer.payload, expected.data(), size));
+            ins.getAllocator().deallocate(transfer.payload);
+            next_transfer_id++;
+            out++;
+        }
+    }
+    return out;
+}
+
+/// Receives the frames pending in the socket and returns the number of transfers that have been checked.
+auto receive(helpers::Instance& ins, SocketCAN& sock, std::size_t& next_transfer_id, const std::size_t size)
+    -> std::size_t
+{
+    std::size_t                       out = 0;
+    std::array<CanardRxFrameSlot, 13> frames{};  // Not a multiple of the batch size to test partial batches.
+    std::int32_t                      count = socketcanReceive(&sock, frames.data(), frames.size());
+    while (count > 0)
+    {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(count); i++)
+        {
+            REQUIRE(frames.at(i).redundant_transport_index == sock.redundant_transport_index);
+        }
+        out += accept(ins, frames.data(), static_cast<std::size_t>(count), next_transfer_id, size);
+        count = socketcanReceive(&sock, frames.data(), frames.size());
+    }
+    REQUIRE(0 == count);
+    return out;
+}
+
+void roundtrip(const bool can_fd, const std::size_t transfer_size)
+{
+    helpers::Instance sender;
+    helpers::Instance receiver;
+    sender.getInstance().node_id = 42;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == receiver.rxSubscribe(CanardTransferKindMessage, SubjectID, 1000, 1'000'000, sub));
+    CanardTxQueue que = canardTxInit(10'000, can_fd ? CANARD_MTU_CAN_FD : CANARD_MTU_CAN_CLASSIC);
+    Bus           bus(can_fd);
+    bus.rx.redundant_transport_index = 2;
+
+    constexpr std::size_t NumTransfers = 100;
+    publish(sender, que, NumTransfers, transfer_size);
+    std::size_t next_transfer_id = 0;
+    std::size_t received         = 0;
+    std::size_t syscalls         = 0;
+    while (que.size > 0)
+    {
+        const std::int32_t sent = socketcanTransmit(&bus.tx, &que, &sender.getInstance(), 0);
+        REQUIRE(sent > 0);
+        REQUIRE(sent <= static_cast<std::int32_t>(SOCKETCAN_BATCH_SIZE));
+        syscalls++;
+        received += receive(receiver, bus.rx, next_transfer_id, transfer_size);
+    }
+    REQUIRE(0 == socketcanTransmit(&bus.tx, &que, &sender.getInstance(), 0));  // Nothing left.
+    REQUIRE(received == NumTransfers);
+    REQUIRE(syscalls < NumTransfers);  // Batched.
+    REQUIRE(0 == bus.tx.drop_count);
+    REQUIRE(0 == sender.getAllocator().getNumAllocatedFragments());
+    REQUIRE(1 == receiver.rxUnsubscribe(CanardTransferKindMessage, SubjectID));
+    REQUIRE(0 == receiver.getAllocator().getNumAllocatedFragments());
+}
+}  // namespace
+
+TEST_CASE("SocketCANRoundtrip")
+{
+    roundtrip(false, 3);    // Single-frame Classic CAN.
+    roundtrip(false, 100);  // Multi-frame Classic CAN.
+    roundtrip(true, 47);    // Single-frame CAN FD, no padding.
+    roundtrip(true, 313);   // Multi-frame CAN FD, no padding.
+}
+
+TEST_CASE("SocketCANBackpressure")
+{
+    // The kernel buffer is made small to fill it up quickly; the frames it cannot take are kept for the next attempt.
+    helpers::Instance sender;
+    helpers::Instance receiver;
+    sender.getInstance().node_id = 42;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == receiver.rxSubscribe(CanardTransferKindMessage, SubjectID, 1000, 1'000'000, sub));
+    CanardTxQueue que = canardTxInit(10'000, CANARD_MTU_CAN_CLASSIC);
+    Bus           bus(false);
+    const int     size = 1;
+    REQUIRE(0 == setsockopt(bus.tx.fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)));
+
+    constexpr std::size_t NumTransfers = 300;
+    publish(sender, que, NumTransfers, 20);
+    std::size_t next_transfer_id = 0;
+    std::size_t received         = 0;
+    bool        blocked          = false;
+    while ((que.size > 0) || (bus.tx.pending_count > 0))
+    {
+        const std::int32_t sent = socketcanTransmit(&bus.tx, &que, &sender.getInstance(), 0);
+        REQUIRE(sent >= 0);
+        if (sent == 0)
+        {
+            blocked = true;
+            REQUIRE(bus.tx.pending_count > 0);
+            received += receive(receiver, bus.rx, next_transfer_id, 20);
+        }
+    }
+    received += receive(receiver, bus.rx, next_transfer_id, 20);
+    REQUIRE(blocked);
+    REQUIRE(received == NumTransfers);
+    REQUIRE(0 == bus.tx.drop_count);
+    REQUIRE(0 == sender.getAllocator().getNumAllocatedFragments());
+    REQUIRE(1 == receiver.rxUnsubscribe(CanardTransferKindMessage, SubjectID));
+}
+
+TEST_CASE("SocketCANErrors")
+{
+    helpers::Instance ins;
+    ins.getInstance().node_id = 42;
+    CanardTxQueue                    que = canardTxInit(100, CANARD_MTU_CAN_CLASSIC);
+    std::array<CanardRxFrameSlot, 4> frames{};
+    SocketCAN                        sock{};
+    REQUIRE(-EINVAL == socketcanOpen(nullptr, "vcan0", false));
+    REQUIRE(-EINVAL == socketcanOpen(&sock, nullptr, false));
+    REQUIRE(-EINVAL == socketcanOpen(&sock, "a-very-long-interface-name", false));
+    REQUIRE(0 > socketcanOpen(&sock, "nonexistent0", false));
+    REQUIRE(-EINVAL == socketcanAttach(nullptr, 0, false));
+    REQUIRE(-EINVAL == socketcanAttach(&sock, -1, false));
+    socketcanClose(nullptr, nullptr);  // No effect.
+
+    Bus bus(false);
+    REQUIRE(-EINVAL == socketcanTransmit(nullptr, &que, &ins.getInstance(), 0));
+    REQUIRE(-EINVAL == socketcanTransmit(&bus.tx, nullptr, &ins.getInstance(), 0));
+    REQUIRE(-EINVAL == socketcanTransmit(&bus.tx, &que, nullptr, 0));
+    REQUIRE(-EINVAL == socketcanReceive(nullptr, frames.data(), frames.size()));
+    REQUIRE(-EINVAL == socketcanReceive(&bus.rx, nullptr, frames.size()));
+    REQUIRE(-EINVAL == socketcanReceive(&bus.rx, frames.data(), 0));
+    REQUIRE(0 == socketcanReceive(&bus.rx, frames.data(), frames.size()));
+
+    // The expired frames are dropped without being transmitted, including those left over from a busy interface.
+    const int size = 1;
+    REQUIRE(0 == setsockopt(bus.tx.fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)));
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = SubjectID;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    std::int32_t sent   = 1;
+    while (sent > 0)
+    {
+        REQUIRE(1 == canardTxPush(&que, &ins.getInstance(), 5'000, &meta, 0, nullptr));
+        sent = socketcanTransmit(&bus.tx, &que, &ins.getInstance(), 1'000);
+        meta.transfer_id++;
+    }
+    REQUIRE(0 == sent);
+    REQUIRE(bus.tx.pending_count > 0);
+    REQUIRE(0 == bus.tx.drop_count);
+    REQUIRE(1 == canardTxPush(&que, &ins.getInstance(), 5'000, &meta, 0, nullptr));
+    const std::size_t expired = bus.tx.pending_count + que.size;
+    REQUIRE(0 == socketcanTransmit(&bus.tx, &que, &ins.getInstance(), 5'000));
+    REQUIRE(expired == bus.tx.drop_count);
+    REQUIRE(0 == bus.tx.pending_count);
+    REQUIRE(0 == que.size);
+    while (socketcanReceive(&bus.rx, frames.data(), frames.size()) > 0)
+    {
+        // Discard the frames that have been transmitted.
+    }
+
+    // The frames that cannot be Cyphal/CAN frames are skipped.
+    std::array<can_frame, 4> raw{};
+    raw.at(0).can_id  = 123;                                 // Base frame format.
+    raw.at(1).can_id  = 123U | CAN_EFF_FLAG | CAN_RTR_FLAG;  // Remote frame.
+    raw.at(2).can_id  = CAN_ERR_FLAG | CAN_EFF_FLAG;         // Error frame.
+    raw.at(3).can_id  = 0x1ABCDEFU | CAN_EFF_FLAG;           // Valid.
+    raw.at(3).len     = 2;
+    raw.at(3).data[0] = 0xAA;
+    raw.at(3).data[1] = 0xBB;
+    for (const auto& f : raw)
+    {
+        REQUIRE(static_cast<ssize_t>(sizeof(f)) == write(bus.tx.fd, &f, sizeof(f)));
+    }
+    REQUIRE(2 == write(bus.tx.fd, "\x01\x02", 2));  // Malformed.
+    REQUIRE(1 == socketcanReceive(&bus.rx, frames.data(), frames.size()));
+    REQUIRE(frames.at(0).extended_can_id == 0x1ABCDEFU);
+    REQUIRE(frames.at(0).payload_size == 2);
+    REQUIRE(frames.at(0).payload[0] == 0xAA);
+    REQUIRE(frames.at(0).payload[1] == 0xBB);
+    REQUIRE(0 == socketcanReceive(&bus.rx, frames.data(), frames.size()));
+
+    // The frame rejected by the kernel is dropped so that it cannot block the others; here, the peer is gone.
+    bus.tx.drop_count = 0;
+    socketcanClose(&bus.rx, nullptr);
+    publish(ins, que, 2, 1);
+    REQUIRE(-EPIPE == socketcanTransmit(&bus.tx, &que, &ins.getInstance(), 0));
+    REQUIRE(1 == bus.tx.drop_count);
+    REQUIRE(1 == bus.tx.pending_count);
+    socketcanClose(&bus.tx, &ins.getInstance());
+    REQUIRE(0 == bus.tx.pending_count);
+    REQUIRE(-1 == bus.tx.fd);
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("SocketCANVirtual")
+{
+    // Exchanges the frames between two sockets on vcan0, if it exists (e.g., "ip link add dev vcan0 type vcan").
+    SocketCAN a{};
+    SocketCAN b{};
+    if ((0 != socketcanOpen(&a, "vcan0", true)) || (0 != socketcanOpen(&b, "vcan0", true)))
+    {
+        WARN("vcan0 is not available, skipping");
+        socketcanClose(&a, nullptr);
+        return;
+    }
+    helpers::Instance sender;
+    helpers::Instance receiver;
+    sender.getInstance().node_id = 42;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == receiver.rxSubscribe(CanardTransferKindMessage, SubjectID, 1000, 1'000'000, sub));
+    CanardTxQueue que = canardTxInit(100, CANARD_MTU_CAN_FD);
+    publish(sender, que, 10, 313);
+    std::size_t next_transfer_id = 0;
+    std::size_t received         = 0;
+    REQUIRE(0 < socketcanTransmit(&a, &que, &sender.getInstance(), 0));
+    for (std::size_t attempt = 0; (attempt < 1000) && (received < 10); attempt++)
+    {
+        received += receive(receiver, b, next_transfer_id, 313);
+        (void) usleep(1000);
+    }
+    REQUIRE(10 == received);
+    socketcanClose(&a, &sender.getInstance());
+    socketcanClose(&b, nullptr);
+    REQUIRE(1 == receiver.rxUnsubscribe(CanardTransferKindMessage, SubjectID));
+    REQUIRE(0 == sender.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("SocketCANUring")
+{
+    // Two redundant interfaces, each looped back via a socketpair; all four ends are serviced by the same engine.
+    SocketCANUring engine{};
+    const auto     result = socketcanUringInit(&engine);
+    if ((result == -ENOSYS) || (result == -EPERM))
+    {
+        WARN("io_uring is not available, skipping");
+        return;
+    }
+    REQUIRE(0 == result);
+    REQUIRE(-EINVAL == socketcanUringInit(nullptr));
+    helpers::Instance sender;
+    helpers::Instance receiver;
+    sender.getInstance().node_id = 42;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == receiver.rxSubscribe(CanardTransferKindMessage, SubjectID, 1000, 1'000'000, sub));
+    std::array<CanardTxQueue, 2> queues{
+        {canardTxInit(10'000, CANARD_MTU_CAN_FD), canardTxInit(10'000, CANARD_MTU_CAN_FD)}};
+    Bus bus_a(true);
+    Bus bus_b(true);
+    bus_a.rx.redundant_transport_index = 0;
+    bus_b.rx.redundant_transport_index = 1;
+    REQUIRE(-EINVAL == socketcanUringAdd(nullptr, &bus_a.tx, &queues.at(0)));
+    REQUIRE(-EINVAL == socketcanUringAdd(&engine, nullptr, &queues.at(0)));
+    REQUIRE(0 == socketcanUringAdd(&engine, &bus_a.tx, &queues.at(0)));
+    REQUIRE(1 == socketcanUringAdd(&engine, &bus_a.rx, nullptr));
+    REQUIRE(2 == socketcanUringAdd(&engine, &bus_b.tx, &queues.at(1)));
+    REQUIRE(3 == socketcanUringAdd(&engine, &bus_b.rx, nullptr));
+    REQUIRE(-ENOSPC == socketcanUringAdd(&engine, &bus_b.rx, nullptr));
+
+    std::array<CanardRxFrameSlot, 50> frames{};
+    REQUIRE(-EINVAL == socketcanUringPoll(nullptr, &sender.getInstance(), 0, 0, frames.data(), frames.size()));
+    REQUIRE(-EINVAL == socketcanUringPoll(&engine, nullptr, 0, 0, frames.data(), frames.size()));
+    REQUIRE(-EINVAL == socketcanUringPoll(&engine, &sender.getInstance(), 0, 0, nullptr, frames.size()));
+    REQUIRE(-EINVAL == socketcanUringPoll(&engine, &sender.getInstance(), 0, 0, frames.data(), 0));
+    REQUIRE(0 == socketcanUringPoll(&engine, &sender.getInstance(), 0, 0, frames.data(), frames.size()));
+
+    // The same transfers are published via both interfaces; the duplicates are removed by the library.
+    constexpr std::size_t NumTransfers = 200;
+    publish(sender, queues.at(0), NumTransfers, 313);
+    publish(sender, queues.at(1), NumTransfers, 313);
+    const std::size_t num_frames       = 2U * (queues.at(0).size + queues.at(1).size);  // Each is sent and received.
+    std::size_t       next_transfer_id = 0;
+    std::size_t       received         = 0;
+    std::size_t       frame_count      = 0;
+    engine.syscall_count               = 0;
+    for (std::size_t attempt = 0; (attempt < 10'000) && (received < NumTransfers); attempt++)
+    {
+        const std::int32_t count =
+            socketcanUringPoll(&engine, &sender.getInstance(), 0, 10'000, frames.data(), frames.size());
+        REQUIRE(count >= 0);
+        frame_count += static_cast<std::size_t>(count);
+        received += accept(receiver, frames.data(), static_cast<std::size_t>(count), next_transfer_id, 313);
+    }
+    REQUIRE(received == NumTransfers);
+    REQUIRE(engine.syscall_count < (num_frames / 10U));
+    REQUIRE(0 == queues.at(0).size);
+    REQUIRE(0 == queues.at(1).size);
+    for (std::size_t attempt = 0; (attempt < 100) && (frame_count < (num_frames / 2U)); attempt++)
+    {
+        frame_count += static_cast<std::size_t>(
+            socketcanUringPoll(&engine, &sender.getInstance(), 0, 1'000, frames.data(), frames.size()));
+    }
+    REQUIRE(frame_count == (num_frames / 2U));
+    REQUIRE(engine.interfaces[0].tx_count == (num_frames / 4U));
+    REQUIRE(engine.interfaces[2].tx_count == (num_frames / 4U));
+    REQUIRE(0 == engine.interfaces[0].drop_count);
+
+    // The expired frames are dropped without being transmitted.
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = SubjectID;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    REQUIRE(1 == canardTxPush(&queues.at(0), &sender.getInstance(), 1'000, &meta, 0, nullptr));
+    REQUIRE(0 == socketcanUringPoll(&engine, &sender.getInstance(), 2'000, 0, frames.data(), frames.size()));
+    REQUIRE(1 == engine.interfaces[0].drop_count);
+    REQUIRE(0 == queues.at(0).size);
+
+    // The frames in flight are freed on closing; the sockets remain open.
+    socketcanUringClose(&engine, &sender.getInstance());
+    REQUIRE(-1 == engine.ring_fd);
+    REQUIRE(bus_a.tx.fd >= 0);
+    socketcanUringClose(&engine, nullptr);  // No effect.
+    socketcanUringClose(nullptr, nullptr);  // No effect.
+    REQUIRE(0 == sender.getAllocator().getNumAllocatedFragments());
+    REQUIRE(1 == receiver.rxUnsubscribe(CanardTransferKindMessage, SubjectID));
+    REQUIRE(0 == receiver.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("SocketCANUringBackpressure")
+{
+    // The kernel buffer is made small to fill it up quickly; the frames it cannot take are kept for the next attempt
+    // along with the rest of their chain, which is canceled, so that none are lost or reordered.
+    SocketCANUring engine{};
+    const auto     result = socketcanUringInit(&engine);
+    if ((result == -ENOSYS) || (result == -EPERM))
+    {
+        WARN("io_uring is not available, skipping");
+        return;
+    }
+    REQUIRE(0 == result);
+    helpers::Instance sender;
+    helpers::Instance receiver;
+    sender.getInstance().node_id = 42;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == receiver.rxSubscribe(CanardTransferKindMessage, SubjectID, 1000, 1'000'000, sub));
+    CanardTxQueue que = canardTxInit(10'000, CANARD_MTU_CAN_CLASSIC);
+    Bus           bus(false);
+    const int     size = 1;
+    REQUIRE(0 == setsockopt(bus.tx.fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)));
+    REQUIRE(0 == socketcanUringAdd(&engine, &bus.tx, &que));
+
+    constexpr std::size_t NumTransfers = 300;
+    publish(sender, que, NumTransfers, 20);
+    const auto left_over = [&engine] {
+        const SocketCANUringInterface& iface = engine.interfaces[0];
+        const auto                     taken = [](const CanardTxQueueItem* const item) { return item != nullptr; };
+        return (iface.tx_in_flight == 0U) && std::any_of(std::begin(iface.tx_items), std::end(iface.tx_items), taken);
+    };
+    const std::size_t                 num_frames       = que.size;
+    std::size_t                       next_transfer_id = 0;
+    std::size_t                       received         = 0;
+    bool                              blocked          = false;
+    std::array<CanardRxFrameSlot, 13> frames{};
+    for (std::size_t attempt = 0; (attempt < 100'000) && (received < NumTransfers); attempt++)
+    {
+        REQUIRE(0 == socketcanUringPoll(&engine, &sender.getInstance(), 0, 1'000, frames.data(), frames.size()));
+        blocked = blocked || left_over();  // The receiving end is drained only after the poll.
+        received += receive(receiver, bus.rx, next_transfer_id, 20);
+    }
+    REQUIRE(blocked);
+    REQUIRE(received == NumTransfers);
+    REQUIRE(0 == que.size);
+    REQUIRE(num_frames == engine.interfaces[0].tx_count);
+    REQUIRE(0 == engine.interfaces[0].drop_count);
+
+    // The frames left over are dropped once expired, and freed on closing if they are still in flight. The receiving
+    // end is not drained, so only the first frames fit into the socket buffer.
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = SubjectID;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    for (std::size_t i = 0; i < SOCKETCAN_BATCH_SIZE; i++)
+    {
+        REQUIRE(1 == canardTxPush(&que, &sender.getInstance(), 1'000, &meta, 0, nullptr));
+        meta.transfer_id++;
+    }
+    REQUIRE(0 == socketcanUringPoll(&engine, &sender.getInstance(), 0, 1'000, frames.data(), frames.size()));
+    REQUIRE(left_over());
+    REQUIRE(0 == socketcanUringPoll(&engine, &sender.getInstance(), 2'000, 0, frames.data(), frames.size()));
+    REQUIRE(!left_over());
+    REQUIRE(0 < engine.interfaces[0].drop_count);
+    for (std::size_t i = 0; i < SOCKETCAN_BATCH_SIZE; i++)
+    {
+        REQUIRE(1 == canardTxPush(&que, &sender.getInstance(), 0, &meta, 0, nullptr));
+        meta.transfer_id++;
+    }
+    REQUIRE(0 == socketcanUringPoll(&engine, &sender.getInstance(), 0, 1'000, frames.data(), frames.size()));
+    REQUIRE(SOCKETCAN_BATCH_SIZE == engine.interfaces[0].tx_in_flight);  // Waiting for the space without spinning.
+    REQUIRE(0 == que.size);
+    socketcanUringClose(&engine, &sender.getInstance());
+    REQUIRE(0 == sender.getAllocator().getNumAllocatedFragments());
+    REQUIRE(1 == receiver.rxUnsubscribe(CanardTransferKindMessage, SubjectID));
+    REQUIRE(0 == receiver.getAllocator().getNumAllocatedFragments());
+}